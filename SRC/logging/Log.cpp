@@ -0,0 +1,555 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Filtering, rate limiting and asynchronous output for
+// OPS_LOG statements.
+//
+// Until a file is set, records are written at once through opserr, so
+// that they follow its redirection (logFile, the Python streams) and
+// appear in order with the rest of the output. Once a file is set, each
+// thread owns a fixed ring of records that it alone fills. Records
+// are drained, in order for each thread, by a background thread or by
+// flush(); draining is serialized by the output lock so that each ring
+// has a single producer and a single consumer at any time. When a ring
+// is full, records are dropped and counted rather than blocking the
+// producer.
+//
+#include "Log.h"
+#include "G3_Logging.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OpenSees {
+namespace Log {
+
+namespace {
+
+constexpr int RingSize   = 128;
+constexpr int RecordSize = 480;
+
+struct Record {
+  std::int64_t  time;
+  const Site   *site;
+  std::uint64_t suppressed;
+  char          text[RecordSize];
+};
+
+struct Ring {
+  int id;
+  std::atomic<std::uint32_t> head{0};
+  std::atomic<std::uint32_t> tail{0};
+  std::atomic<std::uint64_t> dropped{0};
+  std::atomic<bool>          owned{true};
+  Record slots[RingSize];
+
+  explicit Ring(int id) : id(id) {}
+};
+
+struct State {
+  // filtering
+  std::mutex           module_lock;
+  std::vector<Module*> modules;
+  std::atomic<int>     level{Warning};
+
+  // rate limiting
+  std::atomic<int>          burst{10};
+  std::atomic<std::int64_t> interval{10'000'000'000};
+
+  // output
+  std::mutex  output_lock;
+  FILE       *file   = nullptr;   // nullptr writes through opserr
+  Format      format = Format::Text;
+  int         rank   = -1;
+  std::atomic<bool> async{true};
+  std::atomic<bool> direct{true}; // writing through opserr
+
+  // thread buffers and registered sites
+  std::mutex                         ring_lock;
+  std::vector<std::unique_ptr<Ring>> rings;
+  std::vector<Site*>                 sites;
+
+  // background writer
+  std::mutex              writer_lock;
+  std::condition_variable writer_wake;
+  std::thread             writer;
+  bool                    stopping = false;
+
+  const std::int64_t start = now();
+
+  static std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+};
+
+State &
+state()
+{
+  // never destroyed, so that it outlives threads that log during exit
+  static State *s = new State;
+  return *s;
+}
+
+const char *
+level_name(Level level)
+{
+  switch (level) {
+    case Error:   return "error";
+    case Warning: return "warning";
+    case Info:    return "info";
+    case Debug:   return "debug";
+  }
+  return "";
+}
+
+const char *
+level_prompt(Level level)
+{
+  switch (level) {
+    case Error:   return G3_ERROR_PROMPT;
+    case Warning: return G3_WARN_PROMPT;
+    case Info:    return "INFO ";
+    case Debug:   return G3_DEBUG_PROMPT;
+  }
+  return "";
+}
+
+std::uint64_t
+hash(const char *text)
+{
+  // FNV-1a
+  std::uint64_t h = 14695981039346656037ull;
+  for (; *text != '\0'; text++)
+    h = (h ^ static_cast<unsigned char>(*text)) * 1099511628211ull;
+  return h | 1;
+}
+
+// Called with the output lock held
+void
+print(State &s, const char *format, ...)
+{
+  char text[2*RecordSize];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+
+  if (s.file == nullptr)
+    opserr << text;
+  else
+    fputs(text, s.file);
+}
+
+void
+write_escaped(State &s, const char *text)
+{
+  std::string escaped;
+  for (; *text != '\0'; text++) {
+    switch (*text) {
+      case '"':  escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n";  break;
+      case '\t': escaped += "\\t";  break;
+      default:
+        if (static_cast<unsigned char>(*text) < 0x20) {
+          char code[8];
+          snprintf(code, sizeof(code), "\\u%04x", *text);
+          escaped += code;
+        } else
+          escaped += *text;
+    }
+  }
+  print(s, "%s", escaped.c_str());
+}
+
+// Called with the output lock held
+void
+flush_output(State &s)
+{
+  if (s.file != nullptr)
+    fflush(s.file);
+}
+
+// Called with the output lock held
+void
+write_suppressed(State &s, const Site &site, std::uint64_t suppressed)
+{
+  if (s.format == Format::JSON)
+    print(s, "{\"level\": \"%s\", \"module\": \"%s\", \"rank\": %d, "
+             "\"line\": %d, \"suppressed\": %llu}\n",
+          level_name(site.level), site.module.name, s.rank < 0 ? 0 : s.rank,
+          site.line, (unsigned long long)suppressed);
+  else
+    print(s, "%s[%s] %llu similar messages from %s:%d were suppressed\n",
+          level_prompt(site.level), site.module.name,
+          (unsigned long long)suppressed, site.file, site.line);
+}
+
+// Called with the output lock held
+void
+write(State &s, const Site &site, std::int64_t time, int thread,
+      std::uint64_t suppressed, const char *text)
+{
+  if (s.format == Format::JSON) {
+    print(s, "{\"time\": %.6f, \"level\": \"%s\", \"module\": \"%s\", "
+             "\"rank\": %d, \"thread\": %d, \"file\": \"",
+          1e-9*(time - s.start), level_name(site.level), site.module.name,
+          s.rank < 0 ? 0 : s.rank, thread);
+    write_escaped(s, site.file);
+    print(s, "\", \"line\": %d, \"message\": \"", site.line);
+    write_escaped(s, text);
+    print(s, "\", \"suppressed\": %llu}\n", (unsigned long long)suppressed);
+    return;
+  }
+
+  if (s.rank >= 0)
+    print(s, "[%d] ", s.rank);
+
+  print(s, "%s[%s] %s", level_prompt(site.level), site.module.name, text);
+
+  const std::size_t n = strlen(text);
+  if (n == 0 || text[n-1] != '\n')
+    print(s, "\n");
+
+  if (suppressed > 0)
+    write_suppressed(s, site, suppressed);
+}
+
+// Called with the output lock held
+void
+drain(State &s)
+{
+  std::vector<Ring*> rings;
+  {
+    std::lock_guard<std::mutex> guard(s.ring_lock);
+    for (auto &ring : s.rings)
+      rings.push_back(ring.get());
+  }
+
+  for (Ring *ring : rings) {
+    const std::uint32_t head = ring->head.load(std::memory_order_acquire);
+    std::uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+    for (; tail != head; tail++) {
+      const Record &record = ring->slots[tail % RingSize];
+      write(s, *record.site, record.time, ring->id, record.suppressed, record.text);
+    }
+    ring->tail.store(tail, std::memory_order_release);
+
+    const std::uint64_t dropped = ring->dropped.exchange(0);
+    if (dropped > 0)
+      print(s, "%s[log] %llu messages were dropped from thread %d\n",
+            G3_WARN_PROMPT, (unsigned long long)dropped, ring->id);
+  }
+  flush_output(s);
+}
+
+void
+stop_writer()
+{
+  State &s = state();
+  {
+    std::lock_guard<std::mutex> guard(s.writer_lock);
+    s.stopping = true;
+  }
+  s.writer_wake.notify_one();
+  if (s.writer.joinable())
+    s.writer.join();
+
+  flush();
+}
+
+void
+start_writer(State &s)
+{
+  static std::once_flag started;
+  std::call_once(started, [&s]() {
+    s.writer = std::thread([&s]() {
+      std::unique_lock<std::mutex> lock(s.writer_lock);
+      while (!s.stopping) {
+        s.writer_wake.wait_for(lock, std::chrono::milliseconds(50));
+        lock.unlock();
+        {
+          std::lock_guard<std::mutex> guard(s.output_lock);
+          drain(s);
+        }
+        lock.lock();
+      }
+    });
+    std::atexit(stop_writer);
+  });
+}
+
+Ring &
+local_ring(State &s)
+{
+  struct Owner {
+    Ring *ring = nullptr;
+    ~Owner() {
+      if (ring != nullptr)
+        ring->owned.store(false, std::memory_order_release);
+    }
+  };
+  thread_local Owner owner;
+
+  if (owner.ring == nullptr) {
+    std::lock_guard<std::mutex> guard(s.ring_lock);
+    // reuse the drained ring of a thread that has exited
+    for (auto &ring : s.rings)
+      if (!ring->owned.load(std::memory_order_acquire)
+          && ring->head.load(std::memory_order_acquire) == ring->tail.load(std::memory_order_acquire)) {
+        ring->owned.store(true);
+        owner.ring = ring.get();
+        break;
+      }
+
+    if (owner.ring == nullptr) {
+      s.rings.emplace_back(new Ring(static_cast<int>(s.rings.size())));
+      owner.ring = s.rings.back().get();
+    }
+  }
+  return *owner.ring;
+}
+
+void
+apply_default(State &s)
+{
+  const int level = s.level.load();
+  for (Module *m : s.modules)
+    if (!m->filtered)
+      m->level.store(level);
+}
+
+const bool from_environment = []() {
+  const char *spec = std::getenv("OPENSEES_LOG");
+  if (spec != nullptr && *spec != '\0')
+    setFilter(spec);
+  return true;
+}();
+
+} // namespace
+
+
+Module &
+module(const char* name)
+{
+  State &s = state();
+  std::lock_guard<std::mutex> guard(s.module_lock);
+  for (Module *m : s.modules)
+    if (strcmp(m->name, name) == 0)
+      return *m;
+
+  s.modules.push_back(new Module{strdup(name), {s.level.load()}, false});
+  return *s.modules.back();
+}
+
+void
+emit(Site& site, const char* format, ...)
+{
+  State &s = state();
+  const std::int64_t time = State::now();
+
+  // Rate limit before formatting, so that suppressed messages are cheap
+  std::int64_t window = site.window.load(std::memory_order_relaxed);
+  if (time - window >= s.interval.load(std::memory_order_relaxed)
+      && site.window.compare_exchange_strong(window, time)) {
+    site.count.store(0);
+    site.last_hash.store(0);
+  }
+  if (site.count.fetch_add(1, std::memory_order_relaxed) >= s.burst.load(std::memory_order_relaxed)) {
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Record record;
+  record.time = time;
+  record.site = &site;
+
+  va_list args;
+  va_start(args, format);
+  vsnprintf(record.text, RecordSize, format, args);
+  va_end(args);
+
+  // Count, rather than write, a repeat of the last message from the site
+  const std::uint64_t h = hash(record.text);
+  if (site.last_hash.exchange(h, std::memory_order_relaxed) == h) {
+    site.repeated.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  record.suppressed = site.suppressed.exchange(0) + site.repeated.exchange(0);
+
+  if (!site.registered.exchange(true)) {
+    std::lock_guard<std::mutex> guard(s.ring_lock);
+    s.sites.push_back(&site);
+  }
+
+  Ring &ring = local_ring(s);
+
+  if (s.direct.load(std::memory_order_relaxed) || !s.async.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> guard(s.output_lock);
+    drain(s);
+    write(s, site, time, ring.id, record.suppressed, record.text);
+    flush_output(s);
+    return;
+  }
+
+  const std::uint32_t head = ring.head.load(std::memory_order_relaxed);
+  const std::uint32_t used = head - ring.tail.load(std::memory_order_acquire);
+  if (used >= RingSize) {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    s.writer_wake.notify_one();
+    return;
+  }
+
+  ring.slots[head % RingSize] = record;
+  ring.head.store(head + 1, std::memory_order_release);
+
+  start_writer(s);
+  if (used >= RingSize/2)
+    s.writer_wake.notify_one();
+}
+
+int
+parseLevel(const char* name, Level& level)
+{
+  for (Level l : {Error, Warning, Info, Debug})
+    if (strcmp(name, level_name(l)) == 0) {
+      level = l;
+      return 0;
+    }
+  return -1;
+}
+
+void
+setLevel(Level level, const char* name)
+{
+  State &s = state();
+  if (name == nullptr) {
+    std::lock_guard<std::mutex> guard(s.module_lock);
+    s.level.store(level);
+    apply_default(s);
+    return;
+  }
+
+  Module &m = module(name);
+  std::lock_guard<std::mutex> guard(s.module_lock);
+  m.filtered = true;
+  m.level.store(level);
+}
+
+int
+setFilter(const char* spec)
+{
+  std::string filter(spec);
+  std::size_t start = 0;
+  while (start <= filter.size()) {
+    std::size_t end = filter.find(',', start);
+    if (end == std::string::npos)
+      end = filter.size();
+
+    const std::string item = filter.substr(start, end - start);
+    const std::size_t eq = item.find('=');
+    Level level;
+    if (eq == std::string::npos) {
+      if (parseLevel(item.c_str(), level) != 0)
+        return -1;
+      setLevel(level);
+    } else {
+      if (parseLevel(item.substr(eq+1).c_str(), level) != 0)
+        return -1;
+      setLevel(level, item.substr(0, eq).c_str());
+    }
+    start = end + 1;
+  }
+  return 0;
+}
+
+void
+setRate(int burst, double seconds)
+{
+  State &s = state();
+  s.burst.store(burst);
+  s.interval.store(static_cast<std::int64_t>(seconds*1e9));
+}
+
+void
+setFormat(Format format)
+{
+  State &s = state();
+  std::lock_guard<std::mutex> guard(s.output_lock);
+  s.format = format;
+}
+
+int
+setFile(const char* path)
+{
+  FILE *file;
+  if (strcmp(path, "opserr") == 0)
+    file = nullptr;
+  else if (strcmp(path, "stderr") == 0)
+    file = stderr;
+  else if (strcmp(path, "stdout") == 0)
+    file = stdout;
+  else if ((file = fopen(path, "a")) == nullptr)
+    return -1;
+
+  State &s = state();
+  std::lock_guard<std::mutex> guard(s.output_lock);
+  drain(s);
+  if (s.file != nullptr && s.file != stderr && s.file != stdout)
+    fclose(s.file);
+  s.file = file;
+  s.direct.store(file == nullptr);
+  return 0;
+}
+
+void
+setAsync(bool async)
+{
+  state().async.store(async);
+  if (!async)
+    flush();
+}
+
+void
+setRank(int rank)
+{
+  State &s = state();
+  std::lock_guard<std::mutex> guard(s.output_lock);
+  s.rank = rank;
+}
+
+void
+flush()
+{
+  State &s = state();
+  std::lock_guard<std::mutex> guard(s.output_lock);
+  drain(s);
+
+  std::vector<Site*> sites;
+  {
+    std::lock_guard<std::mutex> lock(s.ring_lock);
+    sites = s.sites;
+  }
+  for (Site *site : sites) {
+    const std::uint64_t suppressed = site->suppressed.exchange(0) + site->repeated.exchange(0);
+    if (suppressed > 0)
+      write_suppressed(s, *site, suppressed);
+  }
+  flush_output(s);
+}
+
+} // namespace Log
+} // namespace OpenSees
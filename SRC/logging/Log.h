@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Structured, rate-limited logging.
+//
+// Messages are logged through the OPS_LOG macro with a level and the
+// name of a module (e.g., "material", "element", "analysis"):
+//
+//   OPS_LOG(Log::Warning, "material", "%s::setTrialStrain - did not converge", name);
+//
+// Each OPS_LOG statement is a "site" with its own state. A statement
+// whose level is filtered out costs a relaxed atomic load and a branch,
+// and its arguments are not evaluated; statements above
+// OPS_LOG_MAX_LEVEL are removed at compile time.
+//
+// Messages that pass the filter are rate limited per site, so that a
+// site may emit at most a burst of messages in each interval; messages
+// that repeat the previous one from the same site are counted rather
+// than written. The counts are reported with the next message from the
+// site, or when the log is flushed.
+//
+// By default, records are written at once through opserr, so that they
+// follow logFile and the Python streams. Once a file is set with
+// setFile, formatted records are placed in a buffer owned by the calling
+// thread and written by a background thread, unless setAsync(false), so
+// that logging never blocks on output. Records are written as text, or
+// as one JSON object per line.
+//
+// The filter can be given with the OPENSEES_LOG environment variable as
+// a comma-separated list of a default level and module=level pairs,
+// e.g., OPENSEES_LOG=warning,material=debug
+//
+#ifndef OpenSees_Log_h
+#define OpenSees_Log_h
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef OPS_LOG_MAX_LEVEL
+#  define OPS_LOG_MAX_LEVEL 3
+#endif
+
+namespace OpenSees {
+namespace Log {
+
+enum Level : int {
+  Error   = 0,
+  Warning = 1,
+  Info    = 2,
+  Debug   = 3
+};
+
+enum class Format {
+  Text, JSON
+};
+
+struct Module {
+  const char      *name;
+  std::atomic<int> level;
+  bool             filtered;  // level was set for this module explicitly
+};
+
+// Returns the module with the given name, creating it if needed; the
+// returned reference remains valid for the life of the program.
+Module& module(const char* name);
+
+struct Site {
+  Module      &module;
+  const Level  level;
+  const char  *file;
+  const int    line;
+
+  // rate limiting and deduplication state
+  std::atomic<std::int64_t>  window{0};
+  std::atomic<int>           count{0};
+  std::atomic<std::uint64_t> suppressed{0};
+  std::atomic<std::uint64_t> last_hash{0};
+  std::atomic<std::uint64_t> repeated{0};
+  std::atomic<bool>          registered{false};
+
+  Site(Module& module, Level level, const char* file, int line)
+    : module(module), level(level), file(file), line(line) {}
+
+  bool enabled() const {
+    return static_cast<int>(level) <= module.level.load(std::memory_order_relaxed);
+  }
+};
+
+void emit(Site& site, const char* format, ...)
+#if defined(__GNUC__)
+  __attribute__((format(printf, 2, 3)))
+#endif
+  ;
+
+// Filtering
+int  parseLevel(const char* name, Level& level);
+void setLevel(Level level, const char* module = nullptr);
+int  setFilter(const char* spec);
+
+// At most burst messages are written from a site in each interval
+void setRate(int burst, double seconds);
+
+// Output
+void setFormat(Format format);
+int  setFile(const char* path);   // a path, "stderr", "stdout" or "opserr"
+void setAsync(bool async);
+void setRank(int rank);
+
+// Write all buffered records and pending suppression counts
+void flush();
+
+} // namespace Log
+} // namespace OpenSees
+
+
+#define OPS_LOG(level, name, ...)                                             \
+  do {                                                                        \
+    if constexpr (static_cast<int>(level) <= OPS_LOG_MAX_LEVEL) {             \
+      static OpenSees::Log::Site ops_log_site_(                               \
+          OpenSees::Log::module(name), level, __FILE__, __LINE__);            \
+      if (ops_log_site_.enabled())                                            \
+        OpenSees::Log::emit(ops_log_site_, __VA_ARGS__);                      \
+    }                                                                         \
+  } while (0)
+
+#endif
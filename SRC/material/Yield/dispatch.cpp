@@ -1159,6 +1159,7 @@ TclBasicBuilderPlasticMaterialCommand(ClientData clientData, Tcl_Interp *interp,
 #include <YieldSurface_BC.h>
 #include <YS_Section2D01.h>
 #include <YS_Section2D02.h>
+#include <MultiSurfaceSection2d.h>
 
 #include <SoilFootingSection2d.h>
 
@@ -1316,6 +1317,54 @@ TclBasicBuilderYS_SectionCommand(ClientData clientData, Tcl_Interp *interp,
     theModel = new YS_Section2D02(tag, E, A, Iz, maxPlstkRot, ys, useKr);
   }
 
+  else if (strcmp(argv[1], "MultiSurfaceSection2d") == 0 ||
+           strcmp(argv[1], "MultiSurface2d") == 0) {
+
+    if (argc < 12 || (argc - 6) % 2 != 0) {
+      opserr << "WARNING invalid number of arguments\n";
+      printCommand(argc, argv);
+      opserr << "Want: section MultiSurfaceSection2d tag? E? A? Iz? "
+                "P1? M1? P2? M2? P3? M3? <P4? M4? ...>"
+             << "\n";
+      return 0;
+    }
+
+    double E, A, Iz;
+    int indx = 3;
+
+    if (Tcl_GetDouble(interp, argv[indx++], &E) != TCL_OK) {
+      opserr << "WARNING invalid E" << "\n";
+      opserr << " section: " << tag << "\n";
+      return 0;
+    }
+
+    if (Tcl_GetDouble(interp, argv[indx++], &A) != TCL_OK) {
+      opserr << "WARNING invalid A" << "\n";
+      opserr << " section: " << tag << "\n";
+      return 0;
+    }
+
+    if (Tcl_GetDouble(interp, argv[indx++], &Iz) != TCL_OK) {
+      opserr << "WARNING invalid Iz" << "\n";
+      opserr << " section: " << tag << "\n";
+      return 0;
+    }
+
+    // Vertices of the P-Mz interaction diagram
+    std::vector<double> vertices;
+    while (indx < argc) {
+      double value;
+      if (Tcl_GetDouble(interp, argv[indx++], &value) != TCL_OK) {
+        opserr << "WARNING invalid vertex " << (indx - 5)/2 << "\n";
+        opserr << " section: " << tag << "\n";
+        return 0;
+      }
+      vertices.push_back(value);
+    }
+
+    theModel = new MultiSurfaceSection2d(tag, E, A, Iz, vertices);
+  }
+
   // Added by S.Gajan <sgajan@ucdavis.edu>
 
   else if ((strcmp(argv[1], "soilFootingSection2d") == 0) ||
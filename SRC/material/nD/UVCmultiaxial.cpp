@@ -12,6 +12,7 @@
 #include <Information.h>
 #include <Parameter.h>
 #include <OPS_Globals.h>
+#include <Log.h>
 
 #include "classTags.h"
 static int numUVCmultiaxial = 0;
@@ -325,11 +326,16 @@ int UVCmultiaxial::returnMapping() {
 
   // Warn the user if the algorithm did not converge
   if (iterationNumber >= MAXIMUM_ITERATIONS - 1) {
-    opserr << "UVCmultiaxial::returnMapping return mapping in UVCmultiaxial did not converge!" << endln;
-    opserr << "\tDelta epsilon 11 = " << strainTrial[0] - strainConverged[0] << endln;
-    opserr << "\tDelta epsilon 22 = " << strainTrial[1] - strainConverged[1] << endln;
-    opserr << "\tDelta epsilon 12 = " << strainTrial[3] - strainConverged[3] << endln;
-    opserr << "\tExiting with yield function = " << pMultNumer << " > " << RETURN_MAP_TOL << endln;
+    OPS_LOG(OpenSees::Log::Warning, "material",
+            "UVCmultiaxial::returnMapping return mapping in UVCmultiaxial did not converge!\n"
+            "\tDelta epsilon 11 = %g\n"
+            "\tDelta epsilon 22 = %g\n"
+            "\tDelta epsilon 12 = %g\n"
+            "\tExiting with yield function = %g > %g",
+            strainTrial[0] - strainConverged[0],
+            strainTrial[1] - strainConverged[1],
+            strainTrial[3] - strainConverged[3],
+            pMultNumer, RETURN_MAP_TOL);
     ret_val = -1;
   }
 
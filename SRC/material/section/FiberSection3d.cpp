@@ -43,8 +43,20 @@ typedef SensitiveResponse<FrameSection> SectionResponse;
 
 #include "FiberResponse.h"
 
-// #include <threads/thread_pool.hpp>
 // #define N_FIBER_THREADS 6
+#ifdef N_FIBER_THREADS
+#include <vector>
+#include <threads/thread_pool.hpp>
+
+// One pool serves the fibers of all sections, which are set one section
+// at a time
+static OpenSees::thread_pool*
+fiber_pool()
+{
+  static OpenSees::thread_pool pool{N_FIBER_THREADS};
+  return &pool;
+}
+#endif
 
 ID FiberSection3d::code(4);
 
@@ -57,7 +69,7 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
 #ifdef N_FIBER_THREADS
-    pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
+    pool((void*)fiber_pool()),
 #endif
   e(eData), s(sData), ks(kData,4,4), theTorsion(0)
 {
@@ -116,7 +128,7 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial &torsion, bool
     QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
     theTorsion(0),
 #ifdef N_FIBER_THREADS
-    pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
+    pool((void*)fiber_pool()),
 #endif
     e(eData), s(sData), ks(kData, 4, 4)
 {
@@ -208,7 +220,7 @@ FiberSection3d::FiberSection3d():
   numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(true), 
 #ifdef N_FIBER_THREADS
-  pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
+  pool((void*)fiber_pool()),
 #endif
   e(eData), s(sData), ks(kData, 4,4), theTorsion(0)
 {
@@ -354,7 +366,11 @@ FiberSection3d::addFiber(UniaxialMaterial &theMat, const double Area, const doub
 
 
 #ifdef N_FIBER_THREADS
-#include <mutex>
+//
+// The fibers are set on the threads of the pool, each writing only its
+// own tangent and force; these are then summed in fiber order, so the
+// section response is the same for any number of threads.
+//
 int
 FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
 {
@@ -368,13 +384,11 @@ FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
                e2 = deforms(2),
                e3 = deforms(3);
 
-  int res = 0;
-  std::mutex resp_mutex;
+  std::vector<double> response(2*numFibers);
+  std::vector<int>    status(numFibers);
 
-  ((OpenSees::thread_pool*)pool)->submit_loop<unsigned int>(0, numFibers,
+  ((OpenSees::thread_pool*)pool)->submit_loop<int>(0, numFibers,
   [&,e0,e1,e2](int i){
-    int res = 0;
-
     const double y  = matData[3*i]   - yBar;
     const double z  = matData[3*i+1] - zBar;
     const double A  = matData[3*i+2];
@@ -382,11 +396,19 @@ FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
     // determine material strain and set it
     const double strain = e0 - y*e1 + z*e2;
     double tangent, stress;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
+    status[i] = theMaterials[i]->setTrial(strain, stress, tangent);
 
-    const double EA = tangent * A;
+    response[2*i]   = tangent * A;
+    response[2*i+1] = stress  * A;
+  }).wait();
+
+  int res = 0;
+  for (int i = 0; i < numFibers; i++) {
+    const double y  = matData[3*i]   - yBar;
+    const double z  = matData[3*i+1] - zBar;
+    const double EA = response[2*i];
+    res += status[i];
 
-    const std::lock_guard<std::mutex> lock(resp_mutex);
     kData[ 0] +=     EA;
     kData[ 1] +=  -y*EA;
     kData[ 2] +=   z*EA;
@@ -395,13 +417,11 @@ FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
     kData[10] +=  z*z*EA; 
     kData[ 6] += -y*z*EA;
 
-    double fs0 = stress * A;
+    const double fs0 = response[2*i+1];
     sData[ 0] +=    fs0;  // N
     sData[ 1] += -y*fs0;  // Mz
     sData[ 2] +=  z*fs0;  // My
-
-    return res;
-  }).wait();
+  }
 
   kData[4] = kData[1];
   kData[8] = kData[2];
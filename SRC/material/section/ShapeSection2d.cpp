@@ -0,0 +1,760 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: Plate-by-plate integration of standard steel shapes.
+// See ShapeSection2d.h
+//
+#include <math.h>
+#include <string.h>
+#include <ShapeSection2d.h>
+#include <UniaxialMaterial.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <classTags.h>
+#include <elementAPI.h>
+
+Vector ShapeSection2d::s(2);
+Matrix ShapeSection2d::ks(2,2);
+ID     ShapeSection2d::code(2);
+
+// Most segments allowed in a single plate
+static constexpr int    MaxSegments  = 64;
+// Segments of the reference rule used for calibration
+static constexpr int    RefSegments  = 2048;
+// Curvature ductility up to which the rule is calibrated
+static constexpr double MaxDuctility = 20.0;
+
+void * OPS_ADD_RUNTIME_VPV(OPS_ShapeSection2d)
+{
+  if (OPS_GetNumRemainingInputArgs() < 5) {
+    opserr << "WARNING insufficient arguments\n";
+    opserr << "Want: section Shape2d tag? matTag? shape? dimensions... <-tol tol?>\n"
+           << "  shape: WF d? tw? bf? tf? | HSS d? b? t? | Pipe D? t? | L d? b? t?"
+           << endln;
+    return 0;
+  }
+
+  int idata[2];
+  int numdata = 2;
+  if (OPS_GetIntInput(&numdata, idata) < 0) {
+    opserr << "WARNING invalid Shape2d tag or matTag" << endln;
+    return 0;
+  }
+  const int tag = idata[0];
+
+  UniaxialMaterial *theSteel = OPS_getUniaxialMaterial(idata[1]);
+  if (theSteel == 0) {
+    opserr << "WARNING material with tag " << idata[1] << " not found\n";
+    opserr << "section Shape2d: " << tag << endln;
+    return 0;
+  }
+
+  const char *name = OPS_GetString();
+  int shape;
+  if (strcmp(name, "WF") == 0 || strcmp(name, "W") == 0)
+    shape = ShapeSection2d::WideFlange;
+  else if (strcmp(name, "HSS") == 0)
+    shape = ShapeSection2d::RectangularHSS;
+  else if (strcmp(name, "Pipe") == 0)
+    shape = ShapeSection2d::Pipe;
+  else if (strcmp(name, "L") == 0 || strcmp(name, "Angle") == 0)
+    shape = ShapeSection2d::Angle;
+  else {
+    opserr << "WARNING unknown shape " << name << endln;
+    opserr << "section Shape2d: " << tag << endln;
+    return 0;
+  }
+
+  double dims[4];
+  numdata = ShapeSection2d::getNumDimensions(shape);
+  if (OPS_GetNumRemainingInputArgs() < numdata ||
+      OPS_GetDoubleInput(&numdata, dims) < 0) {
+    opserr << "WARNING invalid dimensions of shape " << name << endln;
+    opserr << "section Shape2d: " << tag << endln;
+    return 0;
+  }
+
+  double tol = 1.0e-2;
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *flag = OPS_GetString();
+    if (strcmp(flag, "-tol") == 0) {
+      numdata = 1;
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+          OPS_GetDoubleInput(&numdata, &tol) < 0 || tol <= 0.0) {
+        opserr << "WARNING invalid tol" << endln;
+        opserr << "section Shape2d: " << tag << endln;
+        return 0;
+      }
+    }
+    else {
+      opserr << "WARNING unknown option " << flag << endln;
+      opserr << "section Shape2d: " << tag << endln;
+      return 0;
+    }
+  }
+
+  for (int i = 0; i < ShapeSection2d::getNumDimensions(shape); i++)
+    if (dims[i] <= 0.0) {
+      opserr << "WARNING shape dimensions must be positive" << endln;
+      opserr << "section Shape2d: " << tag << endln;
+      return 0;
+    }
+
+  ShapeSection2d *theSection = new ShapeSection2d(tag, *theSteel, shape, dims, tol);
+  if (theSection->getNumPoints() == 0) {
+    delete theSection;
+    return 0;
+  }
+  return theSection;
+}
+
+
+double
+ShapeSection2d::Plate::area() const
+{
+  if (kind == Ring)
+    return M_PI*(y1 - y0)*b;
+  return (y1 - y0)*b;
+}
+
+double
+ShapeSection2d::Plate::moment() const
+{
+  return this->area()*0.5*(y0 + y1);
+}
+
+void
+ShapeSection2d::Plate::rule(int m, std::vector<double>& y,
+                            std::vector<double>& w) const
+{
+  // Composite Simpson rule over a parameter u in [0,1]
+  const double h = 1.0/(2*m);
+  double dAdu;
+  if (kind == Ring)
+    dAdu = M_PI*(y1 - y0)*b;     // both halves of the wall
+  else
+    dAdu = (y1 - y0)*b;
+
+  for (int k = 0; k <= 2*m; k++) {
+    const double u = k*h;
+    double yk;
+    if (kind == Ring)
+      yk = 0.5*(y0 + y1) + 0.5*(y1 - y0)*sin(M_PI*(u - 0.5));
+    else
+      yk = y0 + u*(y1 - y0);
+
+    double wk = (k == 0 || k == 2*m) ? 1.0 : (k % 2 == 1 ? 4.0 : 2.0);
+    y.push_back(yk);
+    w.push_back(wk*h/3.0*dAdu);
+  }
+}
+
+
+ShapeSection2d::ShapeSection2d(int tag, UniaxialMaterial &steel, int shp,
+                               const double *dimensions, double tolerance)
+  : SectionForceDeformation(tag, SEC_TAG_ShapeSection2d),
+    shape(shp), tol(tolerance),
+    numPoints(0), theMaterials(nullptr), yPoints(nullptr), wPoints(nullptr),
+    e(2)
+{
+  code(0) = SECTION_RESPONSE_P;
+  code(1) = SECTION_RESPONSE_MZ;
+
+  for (int i = 0; i < 4; i++)
+    dims[i] = 0.0;
+  sData[0] = sData[1] = 0.0;
+  kData[0] = kData[1] = kData[2] = kData[3] = 0.0;
+
+  if (this->setShape(shape, dimensions) != 0) {
+    opserr << "ShapeSection2d::ShapeSection2d -- invalid dimensions for section "
+           << tag << endln;
+    return;
+  }
+
+  this->calibrate(tol);
+  this->setPoints(steel);
+}
+
+ShapeSection2d::ShapeSection2d()
+  : SectionForceDeformation(0, SEC_TAG_ShapeSection2d),
+    shape(0), tol(0.0),
+    numPoints(0), theMaterials(nullptr), yPoints(nullptr), wPoints(nullptr),
+    e(2)
+{
+  code(0) = SECTION_RESPONSE_P;
+  code(1) = SECTION_RESPONSE_MZ;
+
+  for (int i = 0; i < 4; i++)
+    dims[i] = 0.0;
+  sData[0] = sData[1] = 0.0;
+  kData[0] = kData[1] = kData[2] = kData[3] = 0.0;
+}
+
+ShapeSection2d::~ShapeSection2d()
+{
+  if (theMaterials != nullptr) {
+    for (int i = 0; i < numPoints; i++)
+      if (theMaterials[i] != nullptr)
+        delete theMaterials[i];
+    delete [] theMaterials;
+  }
+  if (yPoints != nullptr)
+    delete [] yPoints;
+  if (wPoints != nullptr)
+    delete [] wPoints;
+}
+
+int
+ShapeSection2d::getNumDimensions(int shape)
+{
+  switch (shape) {
+  case WideFlange:     return 4;
+  case RectangularHSS: return 3;
+  case Pipe:           return 2;
+  case Angle:          return 3;
+  default:             return 0;
+  }
+}
+
+int
+ShapeSection2d::setShape(int shp, const double *dimensions)
+{
+  const int n = getNumDimensions(shp);
+  if (n == 0)
+    return -1;
+  for (int i = 0; i < n; i++) {
+    dims[i] = dimensions[i];
+    if (dims[i] <= 0.0)
+      return -1;
+  }
+
+  // Plates are located from the bottom of the shape; the points are
+  // shifted to the centroid in setPoints
+  plates.clear();
+  switch (shp) {
+  case WideFlange: {
+    const double d = dims[0], tw = dims[1], bf = dims[2], tf = dims[3];
+    if (2.0*tf >= d)
+      return -1;
+    plates.push_back({Plate::Rectangle, 0.0,    tf,     bf, 1});
+    plates.push_back({Plate::Rectangle, tf,     d - tf, tw, 1});
+    plates.push_back({Plate::Rectangle, d - tf, d,      bf, 1});
+    break;
+  }
+  case RectangularHSS: {
+    const double d = dims[0], b = dims[1], t = dims[2];
+    if (2.0*t >= d || 2.0*t >= b)
+      return -1;
+    plates.push_back({Plate::Rectangle, 0.0,   t,     b,     1});
+    plates.push_back({Plate::Rectangle, t,     d - t, 2.0*t, 1});
+    plates.push_back({Plate::Rectangle, d - t, d,     b,     1});
+    break;
+  }
+  case Pipe: {
+    const double D = dims[0], t = dims[1];
+    if (2.0*t >= D)
+      return -1;
+    // Thin wall at the mean radius
+    plates.push_back({Plate::Ring, 0.5*t, D - 0.5*t, t, 1});
+    break;
+  }
+  case Angle: {
+    const double d = dims[0], b = dims[1], t = dims[2];
+    if (t >= d || t >= b)
+      return -1;
+    plates.push_back({Plate::Rectangle, 0.0, t, b, 1});
+    plates.push_back({Plate::Rectangle, t,   d, t, 1});
+    break;
+  }
+  }
+  return 0;
+}
+
+void
+ShapeSection2d::calibrate(double tolerance)
+{
+  // Section totals used to normalize the errors
+  double A = 0.0, Q = 0.0;
+  double ymin = plates[0].y0, ymax = plates[0].y1;
+  for (const Plate& p : plates) {
+    A += p.area();
+    Q += p.moment();
+    ymin = fmin(ymin, p.y0);
+    ymax = fmax(ymax, p.y1);
+  }
+  const double yc = Q/A;
+
+  std::vector<double> yr, wr;
+  double Z = 0.0, I = 0.0;
+  for (const Plate& p : plates) {
+    yr.clear(); wr.clear();
+    p.rule(RefSegments, yr, wr);
+    for (unsigned k = 0; k < yr.size(); k++) {
+      Z += fabs(yr[k] - yc)*wr[k];
+      I += (yr[k] - yc)*(yr[k] - yc)*wr[k];
+    }
+  }
+
+  // Half-depth of the elastic core at the largest ductility
+  const double ell = 0.5*(ymax - ymin)/MaxDuctility;
+
+  for (Plate& p : plates) {
+    yr.clear(); wr.clear();
+    p.rule(RefSegments, yr, wr);
+
+    double Iref = 0.0;
+    for (unsigned k = 0; k < yr.size(); k++)
+      Iref += (yr[k] - yc)*(yr[k] - yc)*wr[k];
+
+    // Neutral axis positions at which the stress profile is checked
+    const int    numNA = 64;
+    const double lo = p.y0 - ell, hi = p.y1 + ell;
+
+    std::vector<double> Fref(numNA+1), Mref(numNA+1);
+    for (int j = 0; j <= numNA; j++) {
+      const double yNA = lo + (hi - lo)*j/numNA;
+      double F = 0.0, M = 0.0;
+      for (unsigned k = 0; k < yr.size(); k++) {
+        const double sig = fmax(-1.0, fmin(1.0, (yNA - yr[k])/ell));
+        F += sig*wr[k];
+        M -= (yr[k] - yc)*sig*wr[k];
+      }
+      Fref[j] = F;
+      Mref[j] = M;
+    }
+
+    std::vector<double> y, w;
+    int m = 1;
+    for ( ; m < MaxSegments; m *= 2) {
+      y.clear(); w.clear();
+      p.rule(m, y, w);
+
+      double Im = 0.0;
+      for (unsigned k = 0; k < y.size(); k++)
+        Im += (y[k] - yc)*(y[k] - yc)*w[k];
+      double err = fabs(Im - Iref)/I;
+
+      for (int j = 0; j <= numNA && err <= tolerance; j++) {
+        const double yNA = lo + (hi - lo)*j/numNA;
+        double F = 0.0, M = 0.0;
+        for (unsigned k = 0; k < y.size(); k++) {
+          const double sig = fmax(-1.0, fmin(1.0, (yNA - y[k])/ell));
+          F += sig*w[k];
+          M -= (y[k] - yc)*sig*w[k];
+        }
+        err = fmax(err, fmax(fabs(F - Fref[j])/A, fabs(M - Mref[j])/Z));
+      }
+
+      if (err <= tolerance)
+        break;
+    }
+    p.segments = m < MaxSegments ? m : MaxSegments;
+  }
+}
+
+void
+ShapeSection2d::setPoints(UniaxialMaterial &steel)
+{
+  std::vector<double> y, w;
+  double A = 0.0, Q = 0.0;
+  for (const Plate& p : plates) {
+    p.rule(p.segments, y, w);
+    A += p.area();
+    Q += p.moment();
+  }
+  const double yc = Q/A;
+
+  numPoints    = static_cast<int>(y.size());
+  yPoints      = new double[numPoints];
+  wPoints      = new double[numPoints];
+  theMaterials = new UniaxialMaterial *[numPoints];
+
+  for (int i = 0; i < numPoints; i++) {
+    yPoints[i] = y[i] - yc;
+    wPoints[i] = w[i];
+    theMaterials[i] = steel.getCopy();
+    if (theMaterials[i] == nullptr) {
+      opserr << "ShapeSection2d::ShapeSection2d -- failed to get copy of a Material\n";
+      numPoints = i;
+      return;
+    }
+  }
+}
+
+
+int
+ShapeSection2d::setTrialSectionDeformation(const Vector &deforms)
+{
+  e = deforms;
+
+  kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
+  sData[0] = 0.0; sData[1] = 0.0;
+
+  const double d0 = deforms(0),
+               d1 = deforms(1);
+
+  int res = 0;
+  for (int i = 0; i < numPoints; i++) {
+    const double y = yPoints[i];
+    const double A = wPoints[i];
+
+    double strain = d0 - y*d1;
+    double tangent, stress;
+    res += theMaterials[i]->setTrial(strain, stress, tangent);
+
+    double ks0 = tangent * A;
+    double ks1 = ks0 * -y;
+    kData[0]  += ks0;
+    kData[1]  += ks1;
+    kData[3]  += ks1 * -y;
+
+    double fs0 = stress * A;
+    sData[0] += fs0;
+    sData[1] += fs0 * -y;
+  }
+
+  kData[2] = kData[1];
+
+  return res;
+}
+
+const Vector&
+ShapeSection2d::getSectionDeformation(void)
+{
+  return e;
+}
+
+const Vector&
+ShapeSection2d::getStressResultant(void)
+{
+  s(0) = sData[0];
+  s(1) = sData[1];
+  return s;
+}
+
+const Matrix&
+ShapeSection2d::getSectionTangent(void)
+{
+  ks(0,0) = kData[0]; ks(0,1) = kData[1];
+  ks(1,0) = kData[2]; ks(1,1) = kData[3];
+  return ks;
+}
+
+const Matrix&
+ShapeSection2d::getInitialTangent(void)
+{
+  double k00 = 0.0, k01 = 0.0, k11 = 0.0;
+  for (int i = 0; i < numPoints; i++) {
+    const double y  = yPoints[i];
+    const double k  = theMaterials[i]->getInitialTangent()*wPoints[i];
+    k00 += k;
+    k01 -= k*y;
+    k11 += k*y*y;
+  }
+  ks(0,0) = k00; ks(0,1) = k01;
+  ks(1,0) = k01; ks(1,1) = k11;
+  return ks;
+}
+
+int
+ShapeSection2d::commitState(void)
+{
+  int err = 0;
+  for (int i = 0; i < numPoints; i++)
+    err += theMaterials[i]->commitState();
+  return err;
+}
+
+int
+ShapeSection2d::revertToLastCommit(void)
+{
+  int err = 0;
+  for (int i = 0; i < numPoints; i++)
+    err += theMaterials[i]->revertToLastCommit();
+
+  // Recover the committed resultants and tangent
+  this->sumResultants();
+
+  return err;
+}
+
+void
+ShapeSection2d::sumResultants(void)
+{
+  kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
+  sData[0] = 0.0; sData[1] = 0.0;
+  for (int i = 0; i < numPoints; i++) {
+    const double y = yPoints[i];
+    const double A = wPoints[i];
+    const double k = theMaterials[i]->getTangent()*A;
+    const double f = theMaterials[i]->getStress()*A;
+    kData[0] += k;
+    kData[1] -= k*y;
+    kData[3] += k*y*y;
+    sData[0] += f;
+    sData[1] -= f*y;
+  }
+  kData[2] = kData[1];
+}
+
+int
+ShapeSection2d::revertToStart(void)
+{
+  int err = 0;
+  for (int i = 0; i < numPoints; i++)
+    err += theMaterials[i]->revertToStart();
+
+  e.Zero();
+  sData[0] = sData[1] = 0.0;
+  const Matrix &k0 = this->getInitialTangent();
+  kData[0] = k0(0,0); kData[1] = k0(0,1);
+  kData[2] = k0(1,0); kData[3] = k0(1,1);
+
+  return err;
+}
+
+SectionForceDeformation *
+ShapeSection2d::getCopy(void)
+{
+  ShapeSection2d *theCopy = new ShapeSection2d();
+  theCopy->setTag(this->getTag());
+
+  theCopy->shape  = shape;
+  theCopy->tol    = tol;
+  theCopy->plates = plates;
+  for (int i = 0; i < 4; i++)
+    theCopy->dims[i] = dims[i];
+
+  theCopy->numPoints    = numPoints;
+  theCopy->yPoints      = new double[numPoints];
+  theCopy->wPoints      = new double[numPoints];
+  theCopy->theMaterials = new UniaxialMaterial *[numPoints];
+
+  for (int i = 0; i < numPoints; i++) {
+    theCopy->yPoints[i] = yPoints[i];
+    theCopy->wPoints[i] = wPoints[i];
+    theCopy->theMaterials[i] = theMaterials[i]->getCopy();
+    if (theCopy->theMaterials[i] == nullptr) {
+      opserr << "ShapeSection2d::getCopy -- failed to get copy of a Material\n";
+      theCopy->numPoints = i;
+      delete theCopy;
+      return nullptr;
+    }
+  }
+
+  theCopy->e = e;
+  for (int i = 0; i < 2; i++)
+    theCopy->sData[i] = sData[i];
+  for (int i = 0; i < 4; i++)
+    theCopy->kData[i] = kData[i];
+
+  return theCopy;
+}
+
+const ID&
+ShapeSection2d::getType()
+{
+  return code;
+}
+
+int
+ShapeSection2d::getOrder() const
+{
+  return 2;
+}
+
+int
+ShapeSection2d::sendSelf(int commitTag, Channel &theChannel)
+{
+  int res = 0;
+
+  static ID data(4);
+  data(0) = this->getTag();
+  data(1) = shape;
+  data(2) = numPoints;
+  data(3) = static_cast<int>(plates.size());
+  int dbTag = this->getDbTag();
+  res += theChannel.sendID(dbTag, commitTag, data);
+  if (res < 0) {
+    opserr << "ShapeSection2d::sendSelf - failed to send ID data\n";
+    return res;
+  }
+
+  // dimensions, tolerance and trial deformations, then the plates and
+  // the integration points
+  const int numPlates = static_cast<int>(plates.size());
+  Vector shapeData(7 + 5*numPlates + 2*numPoints);
+  for (int i = 0; i < 4; i++)
+    shapeData(i) = dims[i];
+  shapeData(4) = tol;
+  shapeData(5) = e(0);
+  shapeData(6) = e(1);
+  int loc = 7;
+  for (const Plate& plate : plates) {
+    shapeData(loc++) = plate.kind;
+    shapeData(loc++) = plate.y0;
+    shapeData(loc++) = plate.y1;
+    shapeData(loc++) = plate.b;
+    shapeData(loc++) = plate.segments;
+  }
+  for (int i = 0; i < numPoints; i++) {
+    shapeData(loc++) = yPoints[i];
+    shapeData(loc++) = wPoints[i];
+  }
+  res += theChannel.sendVector(dbTag, commitTag, shapeData);
+  if (res < 0) {
+    opserr << "ShapeSection2d::sendSelf - failed to send shape data\n";
+    return res;
+  }
+
+  if (numPoints == 0)
+    return res;
+
+  // classTag and dbTag of the material at each point
+  ID materialData(2*numPoints);
+  for (int i = 0; i < numPoints; i++) {
+    UniaxialMaterial *theMat = theMaterials[i];
+    materialData(2*i) = theMat->getClassTag();
+    int matDbTag = theMat->getDbTag();
+    if (matDbTag == 0) {
+      matDbTag = theChannel.getDbTag();
+      if (matDbTag != 0)
+        theMat->setDbTag(matDbTag);
+    }
+    materialData(2*i+1) = matDbTag;
+  }
+  res += theChannel.sendID(dbTag, commitTag, materialData);
+  if (res < 0) {
+    opserr << "ShapeSection2d::sendSelf - failed to send material data\n";
+    return res;
+  }
+
+  for (int i = 0; i < numPoints; i++)
+    res += theMaterials[i]->sendSelf(commitTag, theChannel);
+
+  return res;
+}
+
+int
+ShapeSection2d::recvSelf(int commitTag, Channel &theChannel,
+                         FEM_ObjectBroker &theBroker)
+{
+  int res = 0;
+
+  static ID data(4);
+  int dbTag = this->getDbTag();
+  res += theChannel.recvID(dbTag, commitTag, data);
+  if (res < 0) {
+    opserr << "ShapeSection2d::recvSelf - failed to recv ID data\n";
+    return res;
+  }
+  this->setTag(data(0));
+  shape = data(1);
+
+  // if the current arrays are not of the correct size, release them
+  if (numPoints != data(2)) {
+    if (theMaterials != nullptr) {
+      for (int i = 0; i < numPoints; i++)
+        if (theMaterials[i] != nullptr)
+          delete theMaterials[i];
+      delete [] theMaterials;
+      theMaterials = nullptr;
+    }
+    if (yPoints != nullptr)
+      delete [] yPoints;
+    if (wPoints != nullptr)
+      delete [] wPoints;
+    yPoints = nullptr;
+    wPoints = nullptr;
+
+    numPoints = data(2);
+    if (numPoints > 0) {
+      theMaterials = new UniaxialMaterial *[numPoints];
+      yPoints = new double[numPoints];
+      wPoints = new double[numPoints];
+      for (int i = 0; i < numPoints; i++)
+        theMaterials[i] = nullptr;
+    }
+  }
+
+  const int numPlates = data(3);
+  Vector shapeData(7 + 5*numPlates + 2*numPoints);
+  res += theChannel.recvVector(dbTag, commitTag, shapeData);
+  if (res < 0) {
+    opserr << "ShapeSection2d::recvSelf - failed to recv shape data\n";
+    return res;
+  }
+  for (int i = 0; i < 4; i++)
+    dims[i] = shapeData(i);
+  tol  = shapeData(4);
+  e(0) = shapeData(5);
+  e(1) = shapeData(6);
+  int loc = 7;
+  plates.resize(numPlates);
+  for (Plate& plate : plates) {
+    plate.kind     = static_cast<int>(shapeData(loc++));
+    plate.y0       = shapeData(loc++);
+    plate.y1       = shapeData(loc++);
+    plate.b        = shapeData(loc++);
+    plate.segments = static_cast<int>(shapeData(loc++));
+  }
+  for (int i = 0; i < numPoints; i++) {
+    yPoints[i] = shapeData(loc++);
+    wPoints[i] = shapeData(loc++);
+  }
+
+  if (numPoints == 0)
+    return res;
+
+  ID materialData(2*numPoints);
+  res += theChannel.recvID(dbTag, commitTag, materialData);
+  if (res < 0) {
+    opserr << "ShapeSection2d::recvSelf - failed to recv material data\n";
+    return res;
+  }
+
+  for (int i = 0; i < numPoints; i++) {
+    const int classTag = materialData(2*i);
+
+    // if the material is blank or not of the correct type, replace it
+    if (theMaterials[i] != nullptr && theMaterials[i]->getClassTag() != classTag) {
+      delete theMaterials[i];
+      theMaterials[i] = nullptr;
+    }
+    if (theMaterials[i] == nullptr)
+      theMaterials[i] = theBroker.getNewUniaxialMaterial(classTag);
+    if (theMaterials[i] == nullptr) {
+      opserr << "ShapeSection2d::recvSelf - failed to get a material of class "
+             << classTag << "\n";
+      return -1;
+    }
+
+    theMaterials[i]->setDbTag(materialData(2*i+1));
+    res += theMaterials[i]->recvSelf(commitTag, theChannel, theBroker);
+  }
+
+  this->sumResultants();
+
+  return res;
+}
+
+void
+ShapeSection2d::Print(OPS_Stream &s, int flag)
+{
+  static const char *names[] = {"", "WF", "HSS", "Pipe", "L"};
+
+  s << "ShapeSection2d, tag: " << this->getTag() << endln;
+  s << "\tShape: " << names[shape >= 1 && shape <= 4 ? shape : 0];
+  for (int i = 0; i < getNumDimensions(shape); i++)
+    s << " " << dims[i];
+  s << endln;
+  s << "\tTolerance: " << tol << endln;
+  s << "\tPlates (y0, y1, width, segments):" << endln;
+  for (const Plate& p : plates)
+    s << "\t\t" << p.y0 << " " << p.y1 << " " << p.b << " " << p.segments << endln;
+  s << "\tNumber of points: " << numPoints << endln;
+  if (numPoints > 0)
+    theMaterials[0]->Print(s, flag);
+}
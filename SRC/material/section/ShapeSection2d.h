@@ -0,0 +1,119 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: P-Mz section of a standard parametric steel shape
+// (wide-flange, rectangular HSS, pipe or angle) integrated plate by
+// plate.
+//
+// Each plate of the shape is integrated along the bending direction
+// with a composite Simpson rule. The number of segments of every plate
+// is chosen when the section is created so that the integration error
+// is below a given tolerance, relative to the area, plastic modulus
+// and moment of inertia of the shape, for
+//
+//   - the elastic section properties, and
+//   - elastic-perfectly plastic stress profiles with the neutral axis
+//     anywhere in the plate, up to a curvature ductility of 20.
+//
+// Plates that are cut by the neutral axis only through their thickness,
+// such as the flanges of a wide-flange shape, typically need a single
+// segment (three points), so that a shape is represented by a handful
+// of material points instead of a fiber grid.
+//
+#ifndef ShapeSection2d_h
+#define ShapeSection2d_h
+
+#define SEC_TAG_ShapeSection2d 1978
+
+#include <vector>
+#include <SectionForceDeformation.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+
+class UniaxialMaterial;
+
+class ShapeSection2d : public SectionForceDeformation
+{
+ public:
+  enum Shape : int {
+    WideFlange     = 1,   // d, tw, bf, tf
+    RectangularHSS = 2,   // d, b, t
+    Pipe           = 3,   // D, t
+    Angle          = 4    // d, b, t; bending about the axis parallel to b
+  };
+
+  ShapeSection2d(int tag, UniaxialMaterial &steel, int shape,
+                 const double *dimensions, double tol = 1.0e-2);
+  ShapeSection2d();
+  ~ShapeSection2d();
+
+  const char *getClassType(void) const {return "ShapeSection2d";};
+
+  static int getNumDimensions(int shape);
+
+  int   setTrialSectionDeformation(const Vector &deforms);
+  const Vector &getSectionDeformation(void);
+
+  const Vector &getStressResultant(void);
+  const Matrix &getSectionTangent(void);
+  const Matrix &getInitialTangent(void);
+
+  int   commitState(void);
+  int   revertToLastCommit(void);
+  int   revertToStart(void);
+
+  SectionForceDeformation *getCopy(void);
+  const ID &getType();
+  int getOrder(void) const;
+
+  int sendSelf(int cTag, Channel &theChannel);
+  int recvSelf(int cTag, Channel &theChannel,
+               FEM_ObjectBroker &theBroker);
+  void Print(OPS_Stream &s, int flag = 0);
+
+  int getNumPoints(void) const {return numPoints;}
+
+ private:
+  // Rectangle of width b over [y0, y1], or, for a Ring, a thin circular
+  // wall of thickness b between y0 and y1
+  struct Plate {
+    enum Kind : int {Rectangle, Ring};
+    int    kind;
+    double y0, y1, b;
+    int    segments;
+
+    double area() const;
+    double moment() const;   // first moment about y = 0
+    // Location and area weight of the points of an m-segment rule
+    void   rule(int m, std::vector<double>& y, std::vector<double>& w) const;
+  };
+
+  int  setShape(int shape, const double *dimensions);
+  void calibrate(double tol);
+  void setPoints(UniaxialMaterial &steel);
+  void sumResultants(void);
+
+  int    shape;
+  double dims[4];
+  double tol;
+
+  std::vector<Plate> plates;
+
+  int numPoints;
+  UniaxialMaterial **theMaterials;
+  double *yPoints;              // relative to the centroid
+  double *wPoints;              // area weights
+
+  Vector e;                     // section trial deformations
+  double sData[2];
+  double kData[4];
+
+  static Vector s;
+  static Matrix ks;
+  static ID code;
+};
+
+#endif
@@ -0,0 +1,465 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: Closest-point return mapping for section resultants
+// bounded by several yield surfaces (multi-surface force-space
+// plasticity).
+//
+// Given the committed resultants sn and a deformation increment de,
+// the return finds resultants s and plastic multipliers dg >= 0 with
+//
+//   s = sn + D (de - sum_a dg_a grad f_a(s)),   f_a(s) <= 0,
+//   dg_a f_a(s) = 0
+//
+// where D is the elastic section stiffness. The set of active surfaces
+// is found iteratively: starting from the surfaces violated by the
+// elastic predictor, surfaces that receive a negative multiplier are
+// released and surfaces that become violated are added. When the
+// gradients of the active surfaces are linearly dependent, as happens
+// at corners where more than nr surfaces meet, the surface with the
+// smallest multiplier (or smallest violation) is released. The
+// algorithmic tangent
+//
+//   Kep = X - X G (G' X G)^-1 G' X,   X = (D^-1 + sum_a dg_a Hess f_a)^-1
+//
+// is returned with the resultants.
+//
+// The surfaces are described by a policy class with
+//
+//   int    size() const;
+//   double value(int a, const double *s) const;
+//   void   gradient(int a, const double *s, double *g) const;
+//   bool   hessian(int a, const double *s, double *H) const; // false if zero
+//
+// LinearSurfaces below implements a convex polyhedron.
+//
+#ifndef ForceSpaceReturn_h
+#define ForceSpaceReturn_h
+
+#include <cmath>
+#include <vector>
+
+namespace OpenSees {
+
+// Facets n_a . s <= r_a, with r_a > 0. Values are scaled by r_a so
+// that the tolerance of the return is relative to the capacity.
+template <int nr>
+class LinearSurfaces {
+public:
+  int  size() const {return static_cast<int>(radius.size());}
+
+  void addFacet(const double *n, double r) {
+    for (int i = 0; i < nr; i++)
+      normal.push_back(n[i]/r);
+    radius.push_back(r);
+  }
+
+  void clear() {
+    normal.clear();
+    radius.clear();
+  }
+
+  double value(int a, const double *s) const {
+    const double *n = &normal[a*nr];
+    double f = -1.0;
+    for (int i = 0; i < nr; i++)
+      f += n[i]*s[i];
+    return f;
+  }
+
+  void gradient(int a, const double *, double *g) const {
+    for (int i = 0; i < nr; i++)
+      g[i] = normal[a*nr+i];
+  }
+
+  bool hessian(int, const double *, double *) const {
+    return false;
+  }
+
+  // Outward normal scaled by 1/r, and r
+  const double *getNormal(int a) const {return &normal[a*nr];}
+  double        getRadius(int a) const {return radius[a];}
+
+private:
+  std::vector<double> normal;
+  std::vector<double> radius;
+};
+
+
+template <int nr>
+class ForceSpaceReturn {
+public:
+  enum Status : int {
+    Elastic    =  0,
+    Plastic    =  1,
+    Failed     = -1
+  };
+
+  // D is the nr x nr elastic stiffness, stored by rows
+  explicit ForceSpaceReturn(const double *D = nullptr,
+                            double tol = 1.0e-10, int maxIter = 25)
+    : tol(tol), maxIter(maxIter)
+  {
+    for (int i = 0; i < nr*nr; i++)
+      K0[i] = F0[i] = 0.0;
+    if (D != nullptr)
+      setStiffness(D);
+  }
+
+  int setStiffness(const double *D) {
+    for (int i = 0; i < nr*nr; i++)
+      K0[i] = D[i];
+    return invert(K0, F0);
+  }
+
+  const double *getStiffness() const {return K0;}
+
+  //
+  // Return a single state. s and K (nr x nr, by rows) receive the
+  // resultants and tangent; active, if given, receives one flag per
+  // surface. Returns a Status.
+  //
+  template <typename Surfaces>
+  int integrate(const Surfaces& surf, const double *sn, const double *de,
+                double *s, double *K, int *active = nullptr) const;
+
+  //
+  // Return n independent states sharing the same surfaces and
+  // stiffness. State i reads sn[i*nr], de[i*nr] and writes s[i*nr],
+  // K[i*nr*nr] and status[i]. Returns the number of states that
+  // failed to converge.
+  //
+  template <typename Surfaces>
+  int integrate(const Surfaces& surf, int n, const double *sn,
+                const double *de, double *s, double *K, int *status) const
+  {
+    int failed = 0;
+    for (int i = 0; i < n; i++) {
+      status[i] = this->integrate(surf, sn + i*nr, de + i*nr,
+                                  s + i*nr, K + i*nr*nr);
+      if (status[i] == Failed)
+        failed++;
+    }
+    return failed;
+  }
+
+private:
+  // Solve A x = b for an m x m system by Gauss elimination with
+  // partial pivoting; A and b are overwritten. Returns -1 if A is
+  // singular relative to scale.
+  static int solve(double *A, double *b, int m, double scale) {
+    for (int k = 0; k < m; k++) {
+      int p = k;
+      for (int i = k+1; i < m; i++)
+        if (std::fabs(A[i*m+k]) > std::fabs(A[p*m+k]))
+          p = i;
+      if (!(std::fabs(A[p*m+k]) > 1.0e-12*scale))
+        return -1;
+      if (p != k) {
+        for (int j = 0; j < m; j++) {
+          double t = A[k*m+j]; A[k*m+j] = A[p*m+j]; A[p*m+j] = t;
+        }
+        double t = b[k]; b[k] = b[p]; b[p] = t;
+      }
+      for (int i = k+1; i < m; i++) {
+        const double l = A[i*m+k]/A[k*m+k];
+        for (int j = k; j < m; j++)
+          A[i*m+j] -= l*A[k*m+j];
+        b[i] -= l*b[k];
+      }
+    }
+    for (int k = m-1; k >= 0; k--) {
+      for (int j = k+1; j < m; j++)
+        b[k] -= A[k*m+j]*b[j];
+      b[k] /= A[k*m+k];
+    }
+    return 0;
+  }
+
+  static int invert(const double *A, double *Ainv) {
+    double scale = 0.0;
+    for (int i = 0; i < nr*nr; i++)
+      scale = std::fmax(scale, std::fabs(A[i]));
+    for (int j = 0; j < nr; j++) {
+      double W[nr*nr], x[nr];
+      for (int i = 0; i < nr*nr; i++)
+        W[i] = A[i];
+      for (int i = 0; i < nr; i++)
+        x[i] = (i == j) ? 1.0 : 0.0;
+      if (solve(W, x, nr, scale) != 0)
+        return -1;
+      for (int i = 0; i < nr; i++)
+        Ainv[i*nr+j] = x[i];
+    }
+    return 0;
+  }
+
+  double tol;
+  int    maxIter;
+  double K0[nr*nr];   // elastic stiffness
+  double F0[nr*nr];   // elastic flexibility
+};
+
+
+template <int nr>
+template <typename Surfaces>
+int
+ForceSpaceReturn<nr>::integrate(const Surfaces& surf, const double *sn,
+                                const double *de, double *s, double *K,
+                                int *active) const
+{
+  const int ns = surf.size();
+
+  // Elastic predictor
+  double str[nr];
+  for (int i = 0; i < nr; i++) {
+    str[i] = sn[i];
+    for (int j = 0; j < nr; j++)
+      str[i] += K0[i*nr+j]*de[j];
+  }
+
+  // Surfaces violated by the predictor, most violated first; at most
+  // nr of them can have independent gradients
+  int    J[nr];
+  double dg[nr];
+  int    m = 0;
+  for (int a = 0; a < ns; a++) {
+    const double f = surf.value(a, str);
+    if (!(f > tol))
+      continue;
+    int k = (m < nr) ? m++ : nr;
+    while (k > 0 && surf.value(J[k-1], str) < f) {
+      if (k < nr)
+        J[k] = J[k-1];
+      k--;
+    }
+    if (k < nr)
+      J[k] = a;
+  }
+
+  if (active != nullptr)
+    for (int a = 0; a < ns; a++)
+      active[a] = 0;
+
+  if (m == 0) {
+    for (int i = 0; i < nr; i++)
+      s[i] = str[i];
+    for (int i = 0; i < nr*nr; i++)
+      K[i] = K0[i];
+    return Elastic;
+  }
+
+  double G[nr*nr];    // gradients of the active surfaces, by columns
+  double X[nr*nr];    // algorithmic stiffness
+  double A[nr*nr];    // G' X G
+  double XG[nr*nr];   // X G
+
+  // Each pass adds or releases one surface; bound the number of
+  // passes so that a cycling active set cannot hang the analysis
+  const int maxPass = 2*ns + 2;
+  for (int pass = 0; pass < maxPass; pass++) {
+
+    for (int i = 0; i < nr; i++)
+      s[i] = str[i];
+    for (int k = 0; k < m; k++)
+      dg[k] = 0.0;
+
+    bool converged = false;
+    bool singular  = false;
+
+    for (int iter = 0; iter < maxIter; iter++) {
+
+      // Xi = D^-1 + sum dg H
+      double Xi[nr*nr];
+      for (int i = 0; i < nr*nr; i++)
+        Xi[i] = F0[i];
+      for (int k = 0; k < m; k++) {
+        double H[nr*nr];
+        if (dg[k] != 0.0 && surf.hessian(J[k], s, H))
+          for (int i = 0; i < nr*nr; i++)
+            Xi[i] += dg[k]*H[i];
+      }
+      if (invert(Xi, X) != 0) {
+        singular = true;
+        break;
+      }
+
+      // Residuals
+      double f[nr], R[nr], g[nr];
+      for (int i = 0; i < nr; i++) {
+        R[i] = 0.0;
+        for (int j = 0; j < nr; j++)
+          R[i] += F0[i*nr+j]*(s[j] - str[j]);
+      }
+      double fnorm = 0.0;
+      for (int k = 0; k < m; k++) {
+        f[k] = surf.value(J[k], s);
+        fnorm = std::fmax(fnorm, std::fabs(f[k]));
+        surf.gradient(J[k], s, g);
+        for (int i = 0; i < nr; i++) {
+          G[i*nr+k] = g[i];
+          R[i] += dg[k]*g[i];
+        }
+      }
+
+      double rnorm = 0.0, enorm = 0.0;
+      for (int i = 0; i < nr; i++) {
+        double e = 0.0;
+        for (int j = 0; j < nr; j++)
+          e += F0[i*nr+j]*str[j];
+        rnorm = std::fmax(rnorm, std::fabs(R[i]));
+        enorm = std::fmax(enorm, std::fabs(e));
+      }
+
+      // X G and G' X G
+      for (int i = 0; i < nr; i++)
+        for (int k = 0; k < m; k++) {
+          double v = 0.0;
+          for (int j = 0; j < nr; j++)
+            v += X[i*nr+j]*G[j*nr+k];
+          XG[i*nr+k] = v;
+        }
+      double Ascale = 0.0;
+      for (int k = 0; k < m; k++)
+        for (int l = 0; l < m; l++) {
+          double v = 0.0;
+          for (int i = 0; i < nr; i++)
+            v += G[i*nr+k]*XG[i*nr+l];
+          A[k*m+l] = v;
+          Ascale = std::fmax(Ascale, std::fabs(v));
+        }
+
+      if (fnorm <= tol && rnorm <= tol*enorm) {
+        converged = true;
+        break;
+      }
+
+      // ddg = (G' X G)^-1 (f - G' X R)
+      double W[nr*nr], ddg[nr];
+      for (int i = 0; i < m*m; i++)
+        W[i] = A[i];
+      for (int k = 0; k < m; k++) {
+        ddg[k] = f[k];
+        for (int i = 0; i < nr; i++)
+          ddg[k] -= XG[i*nr+k]*R[i];
+      }
+      if (solve(W, ddg, m, Ascale) != 0) {
+        singular = true;
+        break;
+      }
+
+      // ds = -X (R + G ddg)
+      for (int i = 0; i < nr; i++) {
+        double r = R[i];
+        for (int k = 0; k < m; k++)
+          r += G[i*nr+k]*ddg[k];
+        g[i] = r;
+      }
+      for (int i = 0; i < nr; i++) {
+        double ds = 0.0;
+        for (int j = 0; j < nr; j++)
+          ds -= X[i*nr+j]*g[j];
+        s[i] += ds;
+      }
+      for (int k = 0; k < m; k++)
+        dg[k] += ddg[k];
+    }
+
+    if (singular) {
+      // Dependent gradients at a corner; release the surface that
+      // carries the least plastic flow
+      if (m == 1)
+        break;
+      int drop = m-1;
+      for (int k = 0; k < m-1; k++)
+        if (dg[k] < dg[drop])
+          drop = k;
+      for (int k = drop; k < m-1; k++)
+        J[k] = J[k+1];
+      m--;
+      continue;
+    }
+
+    if (!converged)
+      break;
+
+    // Release the surface with the most negative multiplier
+    int drop = -1;
+    for (int k = 0; k < m; k++)
+      if (dg[k] < -tol && (drop < 0 || dg[k] < dg[drop]))
+        drop = k;
+    if (drop >= 0) {
+      if (m == 1)
+        break;
+      for (int k = drop; k < m-1; k++)
+        J[k] = J[k+1];
+      m--;
+      continue;
+    }
+
+    // Add the most violated inactive surface
+    int add = -1;
+    double fmax = tol;
+    for (int a = 0; a < ns; a++) {
+      bool in = false;
+      for (int k = 0; k < m; k++)
+        in = in || (J[k] == a);
+      if (in)
+        continue;
+      const double f = surf.value(a, s);
+      if (f > fmax) {
+        fmax = f;
+        add  = a;
+      }
+    }
+    if (add >= 0) {
+      if (m < nr)
+        J[m++] = add;
+      else {
+        // Replace the surface with the smallest multiplier
+        int k = 0;
+        for (int l = 1; l < m; l++)
+          if (dg[l] < dg[k])
+            k = l;
+        J[k] = add;
+      }
+      continue;
+    }
+
+    // Consistent tangent  X - X G (G' X G)^-1 G' X
+    for (int j = 0; j < nr; j++) {
+      double W[nr*nr], y[nr];
+      for (int i = 0; i < m*m; i++)
+        W[i] = A[i];
+      for (int k = 0; k < m; k++)
+        y[k] = XG[j*nr+k];
+      if (solve(W, y, m, 0.0) != 0)
+        return Failed;
+      for (int i = 0; i < nr; i++) {
+        double v = X[i*nr+j];
+        for (int k = 0; k < m; k++)
+          v -= XG[i*nr+k]*y[k];
+        K[i*nr+j] = v;
+      }
+    }
+
+    if (active != nullptr)
+      for (int k = 0; k < m; k++)
+        active[J[k]] = 1;
+
+    return Plastic;
+  }
+
+  // No admissible active set; leave the predictor
+  for (int i = 0; i < nr; i++)
+    s[i] = str[i];
+  for (int i = 0; i < nr*nr; i++)
+    K[i] = K0[i];
+  return Failed;
+}
+
+} // namespace OpenSees
+
+#endif // ForceSpaceReturn_h
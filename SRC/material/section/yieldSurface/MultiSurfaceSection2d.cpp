@@ -0,0 +1,313 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+#include <math.h>
+#include <MultiSurfaceSection2d.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <classTags.h>
+
+ID MultiSurfaceSection2d::code(2);
+
+MultiSurfaceSection2d::MultiSurfaceSection2d(void)
+  :SectionForceDeformation(0, SEC_TAG_MultiSurfaceSection2d),
+   E(0.0), A(0.0), I(0.0),
+   e(2), eCommit(2), s(2), sCommit(2), ks(2,2)
+{
+  code(0) = SECTION_RESPONSE_P;
+  code(1) = SECTION_RESPONSE_MZ;
+}
+
+MultiSurfaceSection2d::MultiSurfaceSection2d(int tag, double E_in, double A_in,
+                                             double I_in,
+                                             const std::vector<double>& v)
+  :SectionForceDeformation(tag, SEC_TAG_MultiSurfaceSection2d),
+   E(E_in), A(A_in), I(I_in), vertices(v),
+   e(2), eCommit(2), s(2), sCommit(2), ks(2,2)
+{
+  code(0) = SECTION_RESPONSE_P;
+  code(1) = SECTION_RESPONSE_MZ;
+
+  this->setSurfaces();
+}
+
+void
+MultiSurfaceSection2d::setSurfaces(void)
+{
+  ks(0,0) = E*A; ks(0,1) = 0.0;
+  ks(1,0) = 0.0; ks(1,1) = E*I;
+
+  const double D[4] = {E*A, 0.0,
+                       0.0, E*I};
+  if (yield.setStiffness(D) != 0)
+    opserr << "MultiSurfaceSection2d::MultiSurfaceSection2d -- singular stiffness\n";
+
+  // Orientation of the polygon from its signed area
+  const int tag = this->getTag();
+  const int nv = static_cast<int>(vertices.size())/2;
+  double area = 0.0;
+  for (int i = 0; i < nv; i++) {
+    const int j = (i+1) % nv;
+    area += vertices[2*i]*vertices[2*j+1] - vertices[2*j]*vertices[2*i+1];
+  }
+  const double orient = (area < 0.0) ? -1.0 : 1.0;
+
+  // One facet per edge with its outward normal
+  surfaces.clear();
+  for (int i = 0; i < nv; i++) {
+    const int j = (i+1) % nv;
+    const int k = (i+2) % nv;
+    const double dP = vertices[2*j]   - vertices[2*i];
+    const double dM = vertices[2*j+1] - vertices[2*i+1];
+    if (dP == 0.0 && dM == 0.0)
+      continue;
+
+    const double n[2] = {orient*dM, -orient*dP};
+    const double r = n[0]*vertices[2*i] + n[1]*vertices[2*i+1];
+    if (r <= 0.0) {
+      opserr << "MultiSurfaceSection2d::MultiSurfaceSection2d -- origin is not inside "
+             << "the interaction diagram of section " << tag << endln;
+      continue;
+    }
+
+    const double turn = dP*(vertices[2*k+1] - vertices[2*j+1])
+                      - dM*(vertices[2*k]   - vertices[2*j]);
+    if (orient*turn < 0.0)
+      opserr << "MultiSurfaceSection2d::MultiSurfaceSection2d -- interaction diagram "
+             << "of section " << tag << " is not convex at vertex " << j+1 << endln;
+
+    surfaces.addFacet(n, r);
+  }
+}
+
+MultiSurfaceSection2d::~MultiSurfaceSection2d(void)
+{
+
+}
+
+int
+MultiSurfaceSection2d::commitState(void)
+{
+  eCommit = e;
+  sCommit = s;
+  return 0;
+}
+
+int
+MultiSurfaceSection2d::revertToLastCommit(void)
+{
+  e = eCommit;
+  s = sCommit;
+  return 0;
+}
+
+int
+MultiSurfaceSection2d::revertToStart(void)
+{
+  e.Zero();
+  s.Zero();
+  eCommit.Zero();
+  sCommit.Zero();
+  ks(0,0) = E*A; ks(0,1) = 0.0;
+  ks(1,0) = 0.0; ks(1,1) = E*I;
+  return 0;
+}
+
+int
+MultiSurfaceSection2d::setTrial(const double *def)
+{
+  const double sn[2] = {sCommit(0), sCommit(1)};
+  const double de[2] = {def[0] - eCommit(0), def[1] - eCommit(1)};
+  double sr[2], K[4];
+
+  const int status = yield.integrate(surfaces, sn, de, sr, K);
+
+  e(0) = def[0];
+  e(1) = def[1];
+
+  // The resultants and tangent of the last converged state are kept
+  if (status != OpenSees::ForceSpaceReturn<2>::Elastic &&
+      status != OpenSees::ForceSpaceReturn<2>::Plastic)
+    return -1;
+
+  s(0) = sr[0];
+  s(1) = sr[1];
+  ks(0,0) = K[0]; ks(0,1) = K[1];
+  ks(1,0) = K[2]; ks(1,1) = K[3];
+
+  return 0;
+}
+
+int
+MultiSurfaceSection2d::setTrialSectionDeformation(const Vector &def)
+{
+  const double d[2] = {def(0), def(1)};
+  if (this->setTrial(d) != 0) {
+    opserr << "WARNING: MultiSurfaceSection2d::setTrialSectionDeformation - "
+           << "return map failed to converge [" << this->getTag() << "]\n";
+    return -1;
+  }
+  return 0;
+}
+
+int
+MultiSurfaceSection2d::setTrialSectionDeformation(MultiSurfaceSection2d *const *sections,
+                                                  const double *def, int n)
+{
+  int failed = 0;
+  for (int i = 0; i < n; i++)
+    if (sections[i]->setTrial(def + 2*i) != 0)
+      failed++;
+  return failed;
+}
+
+const Vector &
+MultiSurfaceSection2d::getSectionDeformation(void)
+{
+  return e;
+}
+
+const Vector &
+MultiSurfaceSection2d::getStressResultant(void)
+{
+  return s;
+}
+
+const Matrix &
+MultiSurfaceSection2d::getSectionTangent(void)
+{
+  return ks;
+}
+
+const Matrix &
+MultiSurfaceSection2d::getInitialTangent(void)
+{
+  static Matrix k0(2,2);
+  k0(0,0) = E*A; k0(0,1) = 0.0;
+  k0(1,0) = 0.0; k0(1,1) = E*I;
+  return k0;
+}
+
+const ID &
+MultiSurfaceSection2d::getType(void)
+{
+  return code;
+}
+
+int
+MultiSurfaceSection2d::getOrder(void) const
+{
+  return 2;
+}
+
+SectionForceDeformation *
+MultiSurfaceSection2d::getCopy(void)
+{
+  MultiSurfaceSection2d *theCopy =
+    new MultiSurfaceSection2d(this->getTag(), E, A, I, vertices);
+
+  theCopy->e       = e;
+  theCopy->s       = s;
+  theCopy->ks      = ks;
+  theCopy->eCommit = eCommit;
+  theCopy->sCommit = sCommit;
+
+  return theCopy;
+}
+
+int
+MultiSurfaceSection2d::sendSelf(int commitTag, Channel &theChannel)
+{
+  int res = 0;
+
+  int dataTag = this->getDbTag();
+
+  static ID idData(2);
+  idData(0) = this->getTag();
+  idData(1) = static_cast<int>(vertices.size());
+
+  res += theChannel.sendID(dataTag, commitTag, idData);
+  if (res < 0) {
+    opserr << "MultiSurfaceSection2d::sendSelf -- failed to send ID data\n";
+    return res;
+  }
+
+  Vector data(7 + vertices.size());
+  data(0) = E;
+  data(1) = A;
+  data(2) = I;
+  data(3) = eCommit(0);
+  data(4) = eCommit(1);
+  data(5) = sCommit(0);
+  data(6) = sCommit(1);
+  for (std::size_t i = 0; i < vertices.size(); i++)
+    data(7 + i) = vertices[i];
+
+  res += theChannel.sendVector(dataTag, commitTag, data);
+  if (res < 0) {
+    opserr << "MultiSurfaceSection2d::sendSelf -- failed to send data\n";
+    return res;
+  }
+
+  return res;
+}
+
+int
+MultiSurfaceSection2d::recvSelf(int commitTag, Channel &theChannel,
+                                FEM_ObjectBroker &theBroker)
+{
+  int res = 0;
+
+  int dataTag = this->getDbTag();
+
+  static ID idData(2);
+  res += theChannel.recvID(dataTag, commitTag, idData);
+  if (res < 0) {
+    opserr << "MultiSurfaceSection2d::recvSelf -- failed to receive ID data\n";
+    return res;
+  }
+
+  this->setTag(idData(0));
+
+  Vector data(7 + idData(1));
+  res += theChannel.recvVector(dataTag, commitTag, data);
+  if (res < 0) {
+    opserr << "MultiSurfaceSection2d::recvSelf -- failed to receive data\n";
+    return res;
+  }
+
+  E = data(0);
+  A = data(1);
+  I = data(2);
+  vertices.resize(idData(1));
+  for (int i = 0; i < idData(1); i++)
+    vertices[i] = data(7 + i);
+
+  this->setSurfaces();
+
+  eCommit(0) = data(3);
+  eCommit(1) = data(4);
+  sCommit(0) = data(5);
+  sCommit(1) = data(6);
+  e = eCommit;
+  s = sCommit;
+
+  return res;
+}
+
+void
+MultiSurfaceSection2d::Print(OPS_Stream &out, int flag)
+{
+  out << "MultiSurfaceSection2d, tag: " << this->getTag() << endln;
+  out << "\tE: " << E << endln;
+  out << "\tA: " << A << endln;
+  out << "\tI: " << I << endln;
+  out << "\tInteraction diagram (P, Mz):";
+  for (unsigned i = 0; i+1 < vertices.size(); i += 2)
+    out << " (" << vertices[i] << ", " << vertices[i+1] << ")";
+  out << endln;
+  out << "\tSection Force:" << sCommit;
+  out << "\tSection Defom:" << eCommit;
+}
@@ -0,0 +1,85 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: Elastic-perfectly plastic P-Mz section whose interaction
+// diagram is a convex polygon. Each edge of the polygon is treated as
+// an independent yield surface, so that returns to the vertices of the
+// diagram are resolved exactly and the section tangent is the
+// consistent tangent of the multi-surface return (see
+// ForceSpaceReturn.h).
+//
+#ifndef MultiSurfaceSection2d_h
+#define MultiSurfaceSection2d_h
+
+#define SEC_TAG_MultiSurfaceSection2d 1977
+
+#include <vector>
+#include <SectionForceDeformation.h>
+#include <ForceSpaceReturn.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+
+class Channel;
+class FEM_ObjectBroker;
+
+class MultiSurfaceSection2d: public SectionForceDeformation
+{
+ public:
+  // Vertices of the interaction diagram are given as (P, Mz) pairs in
+  // either orientation; the origin must lie strictly inside.
+  MultiSurfaceSection2d(int tag, double E, double A, double I,
+                        const std::vector<double>& vertices);
+  MultiSurfaceSection2d(void);
+  ~MultiSurfaceSection2d(void);
+
+  const char *getClassType(void) const {return "MultiSurfaceSection2d";};
+
+  int commitState(void);
+  int revertToLastCommit(void);
+  int revertToStart(void);
+
+  int setTrialSectionDeformation(const Vector&);
+  const Vector &getSectionDeformation(void);
+
+  const Vector &getStressResultant(void);
+  const Matrix &getSectionTangent(void);
+  const Matrix &getInitialTangent(void);
+
+  const ID &getType(void);
+  int getOrder(void) const;
+
+  SectionForceDeformation *getCopy(void);
+
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+               FEM_ObjectBroker &theBroker);
+
+  void Print(OPS_Stream &s, int flag =0);
+
+  // Set the trial deformations of n sections at once; def holds the
+  // (eps, kappa) pairs of every section. Returns the number of
+  // sections for which the return did not converge.
+  static int setTrialSectionDeformation(MultiSurfaceSection2d *const *sections,
+                                        const double *def, int n);
+
+ private:
+  int  setTrial(const double *def);
+  void setSurfaces(void);
+
+  double E, A, I;
+  std::vector<double> vertices;
+
+  OpenSees::LinearSurfaces<2>   surfaces;
+  OpenSees::ForceSpaceReturn<2> yield;
+
+  Vector e, eCommit;     // section deformations
+  Vector s, sCommit;     // section resultants
+  Matrix ks;             // section tangent
+
+  static ID code;
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include <string.h>
 #include <elementAPI.h>
 #include <OPS_Globals.h>
+#include <Log.h>
 
 void * OPS_ADD_RUNTIME_VPV(OPS_BoucWenOriginal)
 {
@@ -174,9 +175,9 @@ int BoucWenOriginal::setTrialStrain(double strain, double strainRate)
         
         // issue warning if Newton-Raphson scheme did not converge
         if (iter >= maxIter) {
-            opserr << "WARNING: BoucWenOriginal::setTrialStrain() - "
-                << "did not find the hysteretic evolution parameter z after "
-                << iter << " iterations and norm: " << fabs(delta_z) << endln;
+            OPS_LOG(OpenSees::Log::Warning, "material",
+                "BoucWenOriginal::setTrialStrain() - did not find the hysteretic "
+                "evolution parameter z after %d iterations and norm: %g", iter, fabs(delta_z));
             return -2;
         }
         
@@ -0,0 +1,88 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: Handle to an UnloadingRule, StiffnessDegradation or
+// StrengthDegradation owned by a hysteretic material.
+//
+// The value of every degradation rule is a function of its trial
+// measure and its committed state only, so it changes only when the
+// owner sets a new trial measure or commits/reverts the rule. The
+// handle remembers the last value and the measure ID resolved when
+// the rule was attached, so that repeated evaluations within and
+// across iterations do not go through the rule again.
+//
+// All other member functions of the rule remain available through
+// operator->.
+//
+// There is no batched update or evaluator generated per combination of
+// rules. Every material owns copies of its rules (getCopy), so rules are
+// never shared between materials and a batch over materials reduces to
+// calling setTrial on each of them. The rule classes are open-ended
+// (backbones may wrap other uniaxial materials), so a closed set of
+// specialized evaluators cannot cover them; the cache above removes the
+// repeated virtual calls that a specialized evaluator would avoid.
+//
+#ifndef DegradationRule_h
+#define DegradationRule_h
+
+namespace OpenSees {
+
+template <typename Rule>
+class DegradationRule {
+public:
+  DegradationRule(Rule* r = nullptr) : rule(r), measure(-1), valid(false), cache(0.0) {}
+
+  DegradationRule& operator=(Rule* r) {
+    rule  = r;
+    valid = false;
+    return *this;
+  }
+
+  operator Rule*()  const {return rule;}
+  Rule* operator->() const {return rule;}
+
+  // ID of the measure this rule responds to, as returned by the
+  // owner's setVariable
+  int  getMeasureID() const    {return measure;}
+  void setMeasureID(int id)    {measure = id;}
+
+  double getValue() {
+    if (!valid) {
+      cache = rule->getValue();
+      valid = true;
+    }
+    return cache;
+  }
+
+  int setTrialMeasure(double m) {
+    valid = false;
+    return rule->setTrialMeasure(m);
+  }
+
+  int commitState() {
+    valid = false;
+    return rule->commitState();
+  }
+
+  int revertToLastCommit() {
+    valid = false;
+    return rule->revertToLastCommit();
+  }
+
+  int revertToStart() {
+    valid = false;
+    return rule->revertToStart();
+  }
+
+private:
+  Rule  *rule;
+  int    measure;
+  bool   valid;
+  double cache;
+};
+
+} // namespace OpenSees
+
+#endif // DegradationRule_h
@@ -121,146 +121,122 @@ IMKBilin::~IMKBilin()
 int IMKBilin::setTrialStrain(double strain, double strainRate)
 {
     //all variables to the last commit
-    this->revertToLastCommit();
+    return this->update(history.begin(), strain);
+}
+
+int IMKBilin::setTrial(double strain, double &stress, double &tangent, double strainRate)
+{
+    OpenSees::IMK::History &trial = history.begin();
+    int status = this->update(trial, strain);
+    stress  = trial.Fi;
+    tangent = trial.Ktangent;
+    return status;
+}
+
+int IMKBilin::update(OpenSees::IMK::History &s, double strain) const
+{
+    using namespace OpenSees::IMK;
+
+    // Initial backbone properties indexed by direction
+    const double Fy_0[2]  = {-negFy_0,  posFy_0};
+    const double Kpc_0[2] = { negKpc_0, posKpc_0};
+    const double D[2]     = { D_neg,    D_pos};
 
     //state determination algorithm: defines the current force and tangent stiffness
-    double Ui_1 = Ui;
-    double Fi_1 = Fi;
-    U           = strain; //set trial displacement
-    Ui          = U;
-    double dU   = Ui - Ui_1;    // Incremental deformation at current step
+    const double Ui_1 = s.Ui;
+    const double Fi_1 = s.Fi;
+    s.U         = strain; //set trial displacement
+    s.Ui        = s.U;
+    const double Ui = s.Ui;
+    const double dU = Ui - Ui_1;    // Incremental deformation at current step
+
+    int  &Failure_State = s.failure;
+    bool  onBackbone    = (s.branch != 0);
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////  MAIN CODE //////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     if (Failure_State==5) {     // When a failure has already occured
-        Fi  = 0;
+        s.Fi  = 0;
     } else if (dU == 0) {   // When deformation doesn't change from the last
-        Fi  = Fi_1;
+        s.Fi  = Fi_1;
     } else {
-        double  betaS=0,betaC=0,betaK=0;
         bool    FailS=false,FailC=false,FailK=false;
+        // Direction of the current increment; the positive and negative
+        // backbones mirror each other through the sign sgn.
+        const int    d   = direction(dU);
+        const double sgn = sign(d);
+        Backbone    &bb  = s.bb[d];
     ///////////////////////////////////////////////////////////////////////////////////////////
     /////////////////// WHEN REVERSAL /////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
         if ( (onBackbone && Fi_1*dU < 0) || (onBackbone && Fi_1==0 && Ui_1*dU<=0) ) {
             onBackbone      = false;
-    /////////////////////////// UPDATE PEAK POINTS ////////////////////////////////////////////
     /////////////////// UPDATE UNLOADING STIFFNESS ////////////////////////////////////////////
-            double  EpjK    = engAcml            - 0.5*(Fi_1 / Kunload)*Fi_1;
-            double  EiK     = engAcml - engDspt  - 0.5*(Fi_1 / Kunload)*Fi_1;
-            betaK           = pow( (EiK / (engRefK - EpjK)), c_K );
-            FailK           = (betaK>1);
-            betaK           = betaK < 0 ? 0 : (betaK>1 ? 1 : betaK);
-            Kunload         *= (1 - betaK);
+            const double EpjK = s.engAcml              - 0.5*(Fi_1 / s.Kunload)*Fi_1;
+            const double EiK  = s.engAcml - s.engDspt  - 0.5*(Fi_1 / s.Kunload)*Fi_1;
+            s.Kunload      *= (1 - deterioration(EiK, engRefK, EpjK, c_K, FailK));
             if (Failure_State>1) {
-                Kunload     = 0.5*Ke;
+                s.Kunload   = 0.5*Ke;
             }
-            KgetTangent     = Kunload;
+            s.Ktangent      = s.Kunload;
         }
-        Fi	    = Fi_1 + Kunload * dU;
+        s.Fi = Fi_1 + s.Kunload * dU;
     ///////////////////////////////////////////////////////////////////////////////////////////
     /////////////////// WHEN NEW EXCURSION /////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
-        if (!onBackbone && Fi_1*Fi <= 0.0 && Failure_State>0) {
+        if (!onBackbone && Fi_1*s.Fi <= 0.0 && Failure_State>0) {
     /////////////////// UPDATE BACKBONE CURVE /////////////////////////////////////////////////
-            double Ei   = max(0.0, engAcml - engDspt);
-            betaS   = pow((Ei / (engRefS - engAcml)), c_S);
-            betaC   = pow((Ei / (engRefC - engAcml)), c_C);
-            FailS   = (betaS>1);
-            FailC   = (betaC>1);
-            betaS   = betaS < 0 ? 0 : (betaS>1 ? 1 : betaS);
-            betaC   = betaC < 0 ? 0 : (betaC>1 ? 1 : betaC);
-            engDspt = engAcml;
-        // Positive
-            if (dU > 0) {
-                double FcapProj = posFcap  - posKpc * posUcap;
-            // Yield Point
-                posFy       *= (1 - betaS * D_pos);
-                posKp       *= (1 - betaS * D_pos); // Post-Yield Stiffness
-                FcapProj    *= (1 - betaC * D_pos);
-                posUy       = posFy / Ke;
-                posKpc      = posFy < posFres ? 0 : -posKpc_0 * (posFy - posFres) / (posFy_0 - posFres);
-            // Capping Point
-                double FyProj   = posFy - posKp*posUy;
-                posUcap         = posKp <= posKpc ? 0 : (FcapProj - FyProj) / (posKp - posKpc);
-                posFcap         = FyProj + posKp*posUcap;
-            // When a part of backbone is beneath the residual strength
-                double candidateKp = (posFcap - posFres) / (posUcap - Ui_1 - (posFres - Fi_1)/Kunload);
-                if (posFcap < posFres) {
-                    posFy   = posFres;
-                    posFcap = posFres;
-                    posKp   = 0;
-                    posKpc  = 0;
-                    posUy   = posFy / Ke;
-                    posUcap = 0;
-                } else if (candidateKp > 0 && posKp > candidateKp) {
-                    posKp   = candidateKp;
-                }
-            // Global Peak on the Updated Backbone
+            const double Ei    = std::max(0.0, s.engAcml - s.engDspt);
+            const double betaS = deterioration(Ei, engRefS, s.engAcml, c_S, FailS);
+            const double betaC = deterioration(Ei, engRefC, s.engAcml, c_C, FailC);
+            s.engDspt = s.engAcml;
+
+            double FcapProj = bb.Fcap - bb.Kpc * bb.Ucap;
+        // Yield Point
+            bb.Fy       *= (1 - betaS * D[d]);
+            bb.Kp       *= (1 - betaS * D[d]); // Post-Yield Stiffness
+            FcapProj    *= (1 - betaC * D[d]);
+            bb.Uy        = bb.Fy / Ke;
+            bb.Kpc       = sgn*bb.Fy < sgn*bb.Fres ? 0 : -Kpc_0[d] * (bb.Fy - bb.Fres) / (Fy_0[d] - bb.Fres);
+        // Capping Point
+            const double FyProj = bb.Fy - bb.Kp*bb.Uy;
+            bb.Ucap      = bb.Kp <= bb.Kpc ? 0 : (FcapProj - FyProj) / (bb.Kp - bb.Kpc);
+            bb.Fcap      = FyProj + bb.Kp*bb.Ucap;
+        // When a part of backbone is beneath the residual strength
+            const double candidateKp = (bb.Fcap - bb.Fres) / (bb.Ucap - Ui_1 - (bb.Fres - Fi_1)/s.Kunload);
+            if (sgn*bb.Fcap < sgn*bb.Fres) {
+                bb.Fy   = bb.Fres;
+                bb.Fcap = bb.Fres;
+                bb.Kp   = 0;
+                bb.Kpc  = 0;
+                bb.Uy   = bb.Fy / Ke;
+                bb.Ucap = 0;
+            } else if (candidateKp > 0 && bb.Kp > candidateKp) {
+                bb.Kp   = candidateKp;
             }
-        // Negative
-            else {
-                double FcapProj = negFcap   - negKpc * negUcap;
-            // Yield Point
-                negFy	    *= (1 - betaS * D_neg);
-                negKp	    *= (1 - betaS * D_neg); // Post-Yield Stiffness
-                FcapProj    *= (1 - betaC * D_neg);
-                negUy       = negFy / Ke;
-                negKpc      = negFy > negFres ? 0 : -negKpc_0 * (negFy - negFres) / (-negFy_0 - negFres);
-            // Capping Point
-                double FyProj   = negFy - negKp*negUy;
-                negUcap         = negKp <= negKpc ? 0 : (FcapProj - FyProj) / (negKp - negKpc);
-                negFcap         = FyProj + negKp*negUcap;
-            // When a part of backbone is beneath the residual strength
-                double candidateKp = (negFcap - negFres) / (negUcap - Ui_1 - (negFres - Fi_1)/Kunload);
-                if (negFcap > negFres) {
-                    negFy   = negFres;
-                    negFcap = negFres;
-                    negKp   = 0;
-                    negKpc  = 0;
-                    negUy   = negFy / Ke;
-                    negUcap = 0;
-                } else if (candidateKp > 0 && negKp > candidateKp) {
-                    negKp   = candidateKp;
-                }
-            // Global Peak on the Updated Backbone
-            }
-    ////////////////////////// RELOADING TARGET DETERMINATION /////////////////////////////////
         }
     ///////////////////////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
     /////////////////////// COMPUTE FORCE ASSUMING IT'S ON BACKBONE ///////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
-    // Positive
-        if (dU > 0) {   // Backbone in Positive
-            double Kbackbone = (Ui < posUcap) ? posKp : posKpc;
-            double Fi_backbone = posFcap + (Ui - posUcap) * Kbackbone;
-            if (Fi_backbone < posFres || Failure_State==4) {
-                Fi_backbone = posFres;
+        {
+            // Failure_State 3 (4) means the strength was lost in the positive
+            // (negative) direction; see below.
+            const int lostHere  = 4 - d;
+            const int lostOther = 3 + d;
+            const double Kbackbone = (sgn*Ui < sgn*bb.Ucap) ? bb.Kp : bb.Kpc;
+            double Fi_backbone = bb.Fcap + (Ui - bb.Ucap) * Kbackbone;
+            if (sgn*Fi_backbone < sgn*bb.Fres || Failure_State==lostOther) {
+                Fi_backbone = bb.Fres;
             }
-            if (Failure_State==3) {
+            if (Failure_State==lostHere) {
                 Fi_backbone = 0;
             }
-            if (Fi > Fi_backbone) {
-                Fi = Fi_backbone;
-                onBackbone  = true;
-            }
-        }
-    // Negative
-        else {          // Backbone in Negative
-            double Kbackbone = (negUcap < Ui) ? negKp : negKpc;
-            double Fi_backbone = negFcap + (Ui - negUcap) * Kbackbone;
-            if (Fi_backbone > negFres || Failure_State==3) {
-                Fi_backbone = negFres;
-            }
-            if (Failure_State==4) {
-                Fi_backbone = 0;
-            }
-            if (Fi < Fi_backbone) {
-                Fi = Fi_backbone;
+            if (sgn*s.Fi > sgn*Fi_backbone) {
+                s.Fi = Fi_backbone;
                 onBackbone  = true;
             }
         }
@@ -276,37 +252,38 @@ int IMKBilin::setTrialStrain(double strain, double strainRate)
     //     3: Strength Lost in Positive. Negative Backbone Strength will be set the Residual Strength.
     //     4: Strength Lost in Negative. Positive Backbone Strength will be set the Residual Strength.
     //     5: Strength Lost in Both Positive and Negative.
+        const Backbone &pos = s.bb[Positive];
+        const Backbone &neg = s.bb[Negative];
         bool    ResP,ResN;
-        if (posKpc==0) {    // Kpc can be zero when deteriorated Fy is smaller than Fres
-            ResP    = (Fi == posFres);
+        if (pos.Kpc==0) {    // Kpc can be zero when deteriorated Fy is smaller than Fres
+            ResP    = (s.Fi == pos.Fres);
         } else {
-            double  posUres = (posFres - posFcap + posKpc * posUcap) / posKpc;
+            double  posUres = (pos.Fres - pos.Fcap + pos.Kpc * pos.Ucap) / pos.Kpc;
             ResP    = (Ui >= posUres);
         }
-        if (negKpc==0) {
-            ResN    = (Fi == negFres);
+        if (neg.Kpc==0) {
+            ResN    = (s.Fi == neg.Fres);
         } else {
-            double  negUres = (negFres - negFcap + negKpc * negUcap) / negKpc;
+            double  negUres = (neg.Fres - neg.Fcap + neg.Kpc * neg.Ucap) / neg.Kpc;
             ResN    = (Ui <= negUres);
         }
 
         bool	FailDp 	= ( dU > 0 && Ui >=  posUu_0  );
         bool	FailDn 	= ( dU < 0 && Ui <= -negUu_0  );
-        bool	FailRp 	= ( dU > 0 && onBackbone && Fi <= 0);
-        bool	FailRn 	= ( dU < 0 && onBackbone && Fi >= 0);
-        // int exFailure_State = Failure_State;
+        bool	FailRp 	= ( dU > 0 && onBackbone && s.Fi <= 0);
+        bool	FailRn 	= ( dU < 0 && onBackbone && s.Fi >= 0);
         if (FailS||FailC||FailK) {
-            Fi  = 0;
+            s.Fi  = 0;
             Failure_State   = 5;
         } else if (FailDp||FailRp) {
-            Fi  = 0;
+            s.Fi  = 0;
             if (Failure_State==4) {
                 Failure_State   = 5;
             } else {
                 Failure_State   = 3;
             }
         } else if (FailDn||FailRn) {
-            Fi  = 0;
+            s.Fi  = 0;
             if (Failure_State==3) {
                 Failure_State   = 5;
             } else {
@@ -317,18 +294,15 @@ int IMKBilin::setTrialStrain(double strain, double strainRate)
         } else if ( Failure_State == 0 && onBackbone ) {
             Failure_State   = 1;
         }
-    // Failure_State Change check
-        // if (Failure_State!=exFailure_State) {
-        //     std::cout << exFailure_State << " -> " << Failure_State << "\n";
-        // }
 
-        engAcml += 0.5*(Fi + Fi_1)*dU;   // Internal energy increment
+        s.engAcml += 0.5*(s.Fi + Fi_1)*dU;   // Internal energy increment
 
-        KgetTangent  = (Fi - Fi_1) / dU;
+        s.Ktangent  = (s.Fi - Fi_1) / dU;
     }
-    if (KgetTangent==0) {
-        KgetTangent  = 1e-6;
+    if (s.Ktangent==0) {
+        s.Ktangent  = 1e-6;
     }
+    s.branch = onBackbone ? 1 : 0;
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////// END OF MAIN CODE ///////////////////////////////////////////////////////
@@ -339,104 +313,43 @@ int IMKBilin::setTrialStrain(double strain, double strainRate)
 
 double IMKBilin::getStress(void)
 {
-    //cout << " getStress" << endln;
-    return (Fi);
+    return history.current().Fi;
 }
 
 double IMKBilin::getTangent(void)
 {
-    //cout << " getTangent" << endln;
-    return (KgetTangent);
+    return history.current().Ktangent;
 }
 
 double IMKBilin::getInitialTangent(void)
 {
-    //cout << " getInitialTangent" << endln;
     return (Ke);
 }
 
 double IMKBilin::getStrain(void)
 {
-    //cout << " getStrain" << endln;
-    return (U);
+    return history.current().U;
 }
 
 int IMKBilin::commitState(void)
 {
-    //cout << " commitState" << endln;
-
-    //commit trial  variables
-// 7 Pos U and F
-    cPosUy	    = posUy;
-    cPosFy	    = posFy;
-    cPosUcap	= posUcap;
-    cPosFcap	= posFcap;
-    cPosFres	= posFres;
-    cPosKp	    = posKp;
-    cPosKpc	    = posKpc;
-// 7 Neg U and F
-    cNegUy	    = negUy;
-    cNegFy	    = negFy;
-    cNegUcap	= negUcap;
-    cNegFcap	= negFcap;
-    cNegFres	= negFres;
-    cNegKp	    = negKp;
-    cNegKpc	    = negKpc;
-// 3 State
-    cU		    = U;
-    cUi	    	= Ui;
-    cFi	        = Fi;
-// 1 Stiffness
-    cKunload	= Kunload;
-// 2 Energy
-    cEngAcml	= engAcml;
-    cEngDspt	= engDspt;
-// 2 Flag
-    cFailure_State  = Failure_State;
-    cOnBackbone     = onBackbone;
+    history.commit();
     return 0;
 }
 
 int IMKBilin::revertToLastCommit(void)
 {
-    //cout << " revertToLastCommit" << endln;
-    //the opposite of commit trial history variables
-// 7 Positive U and F
-    posUy	        = cPosUy;
-    posFy	        = cPosFy;
-    posUcap	        = cPosUcap;
-    posFcap	        = cPosFcap;
-    posFres	        = cPosFres;
-    posKp	        = cPosKp;
-    posKpc	        = cPosKpc;
-// 7 Negative U and F
-    negUy	        = cNegUy;
-    negFy	        = cNegFy;
-    negUcap	        = cNegUcap;
-    negFcap	        = cNegFcap;
-    negFres	        = cNegFres;
-    negKp       	= cNegKp;
-    negKpc	        = cNegKpc;
-// 3 State Variables
-    U	            = cU;
-    Ui	            = cUi;
-    Fi	            = cFi;
-// 1 Stiffness
-    Kunload	        = cKunload;
-// 2 Energy
-    engAcml	        = cEngAcml;
-    engDspt	        = cEngDspt;
-// 2 Flag
-    Failure_State	= cFailure_State;
-    onBackbone      = cOnBackbone;
+    history.revert();
     return 0;
 }
 
 int IMKBilin::revertToStart(void)
 {
+    using OpenSees::IMK::Positive;
+    using OpenSees::IMK::Negative;
     /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\\
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% ONE TIME CALCULATIONS %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\\
-    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 // 14 Initial Values
     posUy_0  	= posFy_0   / Ke;
     posUcap_0	= posUy_0   + posUp_0;
@@ -451,36 +364,41 @@ int IMKBilin::revertToStart(void)
     engRefS	    = LAMBDA_S  * posFy_0;
     engRefC	    = LAMBDA_C  * posFy_0;
     engRefK	    = LAMBDA_K  * posFy_0;
-// 7 Positive U and F
-    posUy		= cPosUy	    = posUy_0;
-    posFy    	= cPosFy 	    = posFy_0;
-    posUcap  	= cPosUcap	    = posUcap_0;
-    posFcap  	= cPosFcap	    = posFcap_0;
-    posFres  	= cPosFres	    = posFy_0*posFresFy_0;
-    posKp    	= cPosKp 	    =  posKp_0;
-    posKpc   	= cPosKpc   	= -posKpc_0;
 
+    OpenSees::IMK::History init {};
+// 7 Positive U and F
+    OpenSees::IMK::Backbone &pos = init.bb[Positive];
+    pos.Uy		= posUy_0;
+    pos.Fy    	= posFy_0;
+    pos.Ucap  	= posUcap_0;
+    pos.Fcap  	= posFcap_0;
+    pos.Fres  	= posFy_0*posFresFy_0;
+    pos.Kp    	=  posKp_0;
+    pos.Kpc   	= -posKpc_0;
 // 7 Negative U and F
-    negUy    	= cNegUy	    = -negUy_0;
-    negFy    	= cNegFy	    = -negFy_0;
-    negUcap  	= cNegUcap	    = -negUcap_0;
-    negFcap  	= cNegFcap	    = -negFcap_0;
-    negFres  	= cNegFres	    = -negFy_0*negFresFy_0;
-    negKp    	= cNegKp	    =  negKp_0;
-    negKpc   	= cNegKpc	    = -negKpc_0;
+    OpenSees::IMK::Backbone &neg = init.bb[Negative];
+    neg.Uy    	= -negUy_0;
+    neg.Fy    	= -negFy_0;
+    neg.Ucap  	= -negUcap_0;
+    neg.Fcap  	= -negFcap_0;
+    neg.Fres  	= -negFy_0*negFresFy_0;
+    neg.Kp    	=  negKp_0;
+    neg.Kpc   	= -negKpc_0;
 // 3 State Values
-    U	        = cU	        = 0;
-    Ui      	= cUi 	        = 0;
-    Fi 	        = cFi 	        = 0;
+    init.U	        = 0;
+    init.Ui      	= 0;
+    init.Fi 	    = 0;
 // 2 Stiffness
-    Kunload	    = cKunload	    = Ke;
-    KgetTangent = Ke;
+    init.Kunload    = Ke;
+    init.Ktangent   = Ke;
 // 2 Energy
-    engAcml 	= cEngAcml	    = 0.0;
-    engDspt	    = cEngDspt	    = 0.0;
+    init.engAcml 	= 0.0;
+    init.engDspt	= 0.0;
 // 2 Flag
-    Failure_State   = cFailure_State    = 0;
-    onBackbone      = cOnBackbone       = false;
+    init.failure    = 0;
+    init.branch     = 0;
+
+    history.reset(init);
     return 0;
 }
 
@@ -501,7 +419,7 @@ int IMKBilin::sendSelf(int cTag, Channel &theChannel)
 {
     int res = 0;
 
-    static Vector data(57);
+    static Vector data(35 + OpenSees::IMK::HistorySize);
     data(0) = this->getTag();
 // 21 Fixed Input Material Parameters 1-25
     data(1)  	= Ke;
@@ -539,64 +457,9 @@ int IMKBilin::sendSelf(int cTag, Channel &theChannel)
     data(32)	= engRefS;
     data(33)	= engRefC;
     data(34)	= engRefK;
-// 7 Positive U and F 51-62
-    /*
-    data(51) 	= posUy;
-    data(52) 	= posFy;
-    data(53) 	= posUcap;
-    data(54) 	= posFcap;
-    data(60) 	= posFres;
-    data(61) 	= posKp;
-    data(62) 	= posKpc;
-// 3 State Variables 63-65
-    data(63)    = U;
-    data(64) 	= Ui;
-    data(65) 	= Fi;
-// 1 Stiffness 66 67
-    data(67) 	= Kunload;
-// 2 Energy 68 69
-    data(68) 	= engAcml;
-    data(69) 	= engDspt;
-// 7 Negative U and F 71-82
-    data(71) 	= negUy;
-    data(72) 	= negFy;
-    data(73) 	= negUcap;
-    data(74) 	= negFcap;
-    data(80) 	= negFres;
-    data(81) 	= negKp;
-    data(82) 	= negKpc;
-// 2 Flag 85 86
-    data(85)	= Failure_State;
-    data(86) 	= onBackbone;
-    */
-// 7 Positive U and F 101-112
-    data(35)	= cPosUy;
-    data(36)	= cPosFy;
-    data(37)	= cPosUcap;
-    data(38)	= cPosFcap;
-    data(39)	= cPosFres;
-    data(40)	= cPosKp;
-    data(41)	= cPosKpc;
-// 3 State Variables 113-115
-    data(42)   = cU;
-    data(43)	= cUi;
-    data(44)	= cFi;
-// 2 Stiffness 116 117
-    data(45)	= cKunload;
-// 2 Energy 118 119
-    data(46)   = cEngAcml;
-    data(47)   = cEngDspt;
-// 7 Negative U and F 121-132
-    data(48)	= cNegUy;
-    data(49)	= cNegFy;
-    data(50)	= cNegUcap;
-    data(51)	= cNegFcap;
-    data(52)	= cNegFres;
-    data(53)	= cNegKp;
-    data(54)	= cNegKpc;
-// 2 Flag 135 136
-    data(55)	= cFailure_State;
-    data(56)	= cOnBackbone ? 1.0 : -1.0 ;
+// Committed history
+    OpenSees::IMK::pack(history.committed(), data, 35);
+
     res = theChannel.sendVector(this->getDbTag(), cTag, data);
     if (res < 0)
         opserr << "IMKBilin::sendSelf() - failed to send data\n";
@@ -607,7 +470,7 @@ int IMKBilin::sendSelf(int cTag, Channel &theChannel)
 int IMKBilin::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
     int res = 0;
-    static Vector data(57);
+    static Vector data(35 + OpenSees::IMK::HistorySize);
     res = theChannel.recvVector(this->getDbTag(), cTag, data);
 
     if (res < 0) {
@@ -652,66 +515,10 @@ int IMKBilin::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroke
         engRefS			= data(32);
         engRefC			= data(33);
         engRefK			= data(34);
-	/*
-    // 3 State Variables
-        U               = data(63);
-        Ui				= data(64);
-        Fi				= data(65);
-    // 1 Stiffness
-        Kunload	    	= data(67);
-    // 7 Positive U and F
-        posUy			= data(51);
-        posFy			= data(52);
-        posUcap		    = data(53);
-        posFcap		   	= data(54);
-        posFres		   	= data(60);
-        posKp			= data(61);
-        posKpc		    = data(62);
-    // 7 Negative U and F
-        negUy			= data(71);
-        negFy			= data(72);
-        negUcap		    = data(73);
-        negFcap		   	= data(74);
-        negFres		    = data(80);
-        negKp			= data(81);
-        negKpc		    = data(82);
-    // 2 Flag
-        Failure_State	= data(85);
-        onBackbone		= data(86);
-    // 2 Energy
-        engAcml			= data(68);
-        engDspt		    = data(69);
-	*/
-    // 7 Positive U and F
-        cPosUy			= data(35);
-        cPosFy			= data(36);
-        cPosUcap		= data(37);
-        cPosFcap		= data(38);
-        cPosFres		= data(39);
-        cPosKp			= data(40);
-        cPosKpc			= data(41);
-    // 3 State Variables
-        cU              = data(42);
-        cUi				= data(43);
-        cFi				= data(44);
-    // 1 Stiffness
-        cKunload		= data(45);
-    // 2 Energy
-        cEngAcml        = data(46);
-        cEngDspt        = data(47);
-    // 7 Negative U and F
-        cNegUy			= data(48);
-        cNegFy			= data(49);
-        cNegUcap		= data(50);
-        cNegFcap		= data(51);
-        cNegFres		= data(52);
-        cNegKp			= data(53);
-        cNegKpc			= data(54);
-    // 2 Flag
-        cFailure_State	= int(data(55));
-        cOnBackbone		= data(56) > 0.0 ? true : false;
-
-	this->revertToLastCommit();
+    // Committed history
+        OpenSees::IMK::unpack(history.committed(), data, 35);
+
+        this->revertToLastCommit();
     }
 
     return res;
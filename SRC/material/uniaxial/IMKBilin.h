@@ -30,6 +30,7 @@
 #define IMKBilin_h
 
 #include <UniaxialMaterial.h>
+#include <IMKDeterioration.h>
 
 class IMKBilin : public UniaxialMaterial
 {
@@ -42,6 +43,7 @@ public:
     ~IMKBilin();
     const char *getClassType(void) const { return "IMKBilin"; };
     int setTrialStrain(double strain, double strainRate = 0.0);
+    int setTrial(double strain, double &stress, double &tangent, double strainRate = 0.0);
     double  getStrain(void);
     double  getStress(void);
     double  getTangent(void);
@@ -89,36 +91,10 @@ private:
     double  engRefS;
     double  engRefC;
     double  engRefK;
-// History Variables 
-// 7 Positive U and F
-    double  posUy,          cPosUy;
-    double  posFy,          cPosFy;
-    double  posUcap,        cPosUcap;
-    double  posFcap,        cPosFcap;
-    double  posFres,        cPosFres;
-    double  posKp,          cPosKp;
-    double  posKpc,         cPosKpc;
-// 7 Negative U and F
-    double  negUy,          cNegUy;
-    double  negFy,          cNegFy;
-    double  negUcap,        cNegUcap;
-    double  negFcap,        cNegFcap;
-    double  negFres,        cNegFres;
-    double  negKp,          cNegKp;
-    double  negKpc,         cNegKpc;
-// 3 State Variables 
-    double  U,              cU;
-    double  Ui,             cUi;
-    double  Fi,             cFi;
-// 2 Stiffness
-    double  KgetTangent;
-    double  Kunload,        cKunload;
-// 2 Energy
-    double  engAcml,        cEngAcml;
-    double  engDspt,        cEngDspt;
-// 2 Flag
-    int     Failure_State,  cFailure_State;
-    bool    onBackbone,     cOnBackbone;
+// History Variables
+    OpenSees::IMK::TrialHistory<OpenSees::IMK::History> history;
+
+    int update(OpenSees::IMK::History&, double strain) const;
 };
 
 #endif
@@ -0,0 +1,213 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: Shared state engine for the energy-based deterioration
+// models of Ibarra, Medina and Krawinkler (IMKBilin, IMKPeakOriented,
+// IMKPinching).
+//
+// The complete history of a spring is held in a single trivially
+// copyable History block. Two of these blocks are kept by a
+// TrialHistory; committing swaps the role of the two blocks instead
+// of copying every variable, and reverting simply discards the trial
+// block.
+//
+// Backbone data is stored per loading direction and indexed by
+// Direction, so that the positive and negative excursions can share
+// a single code path.
+//
+// Springs are evaluated one at a time, through UniaxialMaterial or
+// their setTrial(strain, stress, tangent); there is no batched path.
+//
+#ifndef IMKDeterioration_h
+#define IMKDeterioration_h
+
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+namespace OpenSees {
+namespace IMK {
+
+enum Direction : int {
+  Negative = 0,
+  Positive = 1
+};
+
+// Sign of a direction, i.e. -1 for Negative and +1 for Positive
+inline constexpr double
+sign(int d)
+{
+  return 2.0*d - 1.0;
+}
+
+// Direction of a deformation increment
+inline constexpr int
+direction(double du)
+{
+  return du > 0.0 ? Positive : Negative;
+}
+
+// Backbone of a single loading direction. All quantities carry the
+// sign of their direction.
+struct Backbone {
+  double Uy,     Fy;      // yield point
+  double Ucap,   Fcap;    // capping point
+  double Ulocal, Flocal;  // peak of the last excursion
+  double Uglobal,Fglobal; // peak of all excursions
+  double Ures,   Fres;    // residual point
+  double Kp,     Kpc;     // post-yield and post-capping stiffness
+};
+
+struct History {
+  Backbone bb[2];         // indexed by Direction
+  double U, Ui, Fi;       // deformation and force
+  double Kunload;         // unloading stiffness
+  double Kreload;         // reloading stiffness
+  double Ktangent;        // tangent reported to the element
+  double Upinch, Fpinch;  // pinching point
+  double engAcml;         // total dissipated energy
+  double engDspt;         // energy dissipated up to the last excursion
+  int    branch;          // active branch of the hysteretic law
+  int    failure;         // failure state
+};
+
+static_assert(std::is_trivially_copyable<History>::value,
+              "IMK::History must be trivially copyable");
+
+
+// Number of doubles required to pack a History
+static constexpr int HistorySize = 2*12 + 10 + 2;
+
+template <typename VectorType>
+int
+pack(const History& h, VectorType& data, int i)
+{
+  for (int d = 0; d < 2; d++) {
+    const Backbone& b = h.bb[d];
+    data(i++) = b.Uy;      data(i++) = b.Fy;
+    data(i++) = b.Ucap;    data(i++) = b.Fcap;
+    data(i++) = b.Ulocal;  data(i++) = b.Flocal;
+    data(i++) = b.Uglobal; data(i++) = b.Fglobal;
+    data(i++) = b.Ures;    data(i++) = b.Fres;
+    data(i++) = b.Kp;      data(i++) = b.Kpc;
+  }
+  data(i++) = h.U;
+  data(i++) = h.Ui;
+  data(i++) = h.Fi;
+  data(i++) = h.Kunload;
+  data(i++) = h.Kreload;
+  data(i++) = h.Ktangent;
+  data(i++) = h.Upinch;
+  data(i++) = h.Fpinch;
+  data(i++) = h.engAcml;
+  data(i++) = h.engDspt;
+  data(i++) = h.branch;
+  data(i++) = h.failure;
+  return i;
+}
+
+template <typename VectorType>
+int
+unpack(History& h, const VectorType& data, int i)
+{
+  for (int d = 0; d < 2; d++) {
+    Backbone& b = h.bb[d];
+    b.Uy      = data(i++); b.Fy      = data(i++);
+    b.Ucap    = data(i++); b.Fcap    = data(i++);
+    b.Ulocal  = data(i++); b.Flocal  = data(i++);
+    b.Uglobal = data(i++); b.Fglobal = data(i++);
+    b.Ures    = data(i++); b.Fres    = data(i++);
+    b.Kp      = data(i++); b.Kpc     = data(i++);
+  }
+  h.U        = data(i++);
+  h.Ui       = data(i++);
+  h.Fi       = data(i++);
+  h.Kunload  = data(i++);
+  h.Kreload  = data(i++);
+  h.Ktangent = data(i++);
+  h.Upinch   = data(i++);
+  h.Fpinch   = data(i++);
+  h.engAcml  = data(i++);
+  h.engDspt  = data(i++);
+  h.branch   = static_cast<int>(data(i++));
+  h.failure  = static_cast<int>(data(i++));
+  return i;
+}
+
+
+//
+// Pair of History blocks with commit-by-swap semantics.
+//
+// begin()     copies the committed block into the trial block and
+//             returns it for modification;
+// commit()    swaps the roles of the trial and committed blocks;
+// revert()    discards the trial block;
+// current()   returns the trial block if one is pending, otherwise
+//             the committed block.
+//
+template <typename T>
+class TrialHistory {
+public:
+  TrialHistory() : itrial(0), pending(false) {}
+
+  void reset(const T& init) {
+    block[0] = block[1] = init;
+    pending  = false;
+  }
+
+  T& begin() {
+    block[itrial] = block[1-itrial];
+    pending = true;
+    return block[itrial];
+  }
+
+  const T& current() const {
+    return pending ? block[itrial] : block[1-itrial];
+  }
+
+  T& committed() {
+    return block[1-itrial];
+  }
+
+  const T& committed() const {
+    return block[1-itrial];
+  }
+
+  void commit() {
+    if (pending) {
+      itrial  = 1 - itrial;
+      pending = false;
+    }
+  }
+
+  void revert() {
+    pending = false;
+  }
+
+private:
+  T    block[2];
+  int  itrial;
+  bool pending;
+};
+
+
+// Cyclic deterioration coefficient
+//
+//   beta = ( Ei / (Eref - Ej) )^c
+//
+// clamped to [0,1]. fail is set when the available energy has been
+// exhausted, i.e. when the unclamped value exceeds one.
+inline double
+deterioration(double Ei, double Eref, double Ej, double c, bool& fail)
+{
+  const double b = std::pow(Ei / (Eref - Ej), c);
+  fail = fail || (b > 1.0);
+  return b < 0.0 ? 0.0 : (b > 1.0 ? 1.0 : b);
+}
+
+} // namespace IMK
+} // namespace OpenSees
+
+#endif // IMKDeterioration_h
@@ -121,167 +121,175 @@ IMKPinching::~IMKPinching()
 int IMKPinching::setTrialStrain(double strain, double strainRate)
 {
     //all variables to the last commit
-    this->revertToLastCommit();
+    return this->update(history.begin(), strain);
+}
+
+int IMKPinching::setTrial(double strain, double &stress, double &tangent, double strainRate)
+{
+    OpenSees::IMK::History &trial = history.begin();
+    int status = this->update(trial, strain);
+    stress  = trial.Fi;
+    tangent = trial.Ktangent;
+    return status;
+}
+
+int IMKPinching::update(OpenSees::IMK::History &s, double strain) const
+{
+    using OpenSees::IMK::deterioration;
+    OpenSees::IMK::Backbone &pos = s.bb[OpenSees::IMK::Positive];
+    OpenSees::IMK::Backbone &neg = s.bb[OpenSees::IMK::Negative];
 
     //state determination algorithm: defines the current force and tangent stiffness
-    const double Ui_1 = Ui;
-    const double Fi_1 = Fi;
-    Ui = strain; //set trial displacement
-    const double dU = Ui - Ui_1;    // Incremental deformation at current step
+    const double Ui_1 = s.Ui;
+    const double Fi_1 = s.Fi;
+    s.Ui = strain; //set trial displacement
+    const double dU = s.Ui - Ui_1;    // Incremental deformation at current step
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////  MAIN CODE //////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    if (Failure_Flag) {     // When a failure has already occured
-        Fi = 0;
+    if (s.failure) {     // When a failure has already occured
+        s.Fi = 0;
     } else if (dU == 0) {   // When deformation doesn't change from the last
-        Fi = Fi_1;
+        s.Fi = Fi_1;
     } else {
         double betaS = 0, betaC = 0, betaK = 0, betaA = 0;
         bool FailS = false, FailC = false, FailK = false, FailA = false;
-        const bool onBackbone = (Branch > 1);
+        const bool onBackbone = (s.branch > 1);
     ///////////////////////////////////////////////////////////////////////////////////////////
     /////////////////// WHEN REVERSAL /////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
         if ( (onBackbone && Fi_1 * dU < 0) || (onBackbone && Fi_1 == 0 && Ui_1 * dU <= 0) ) {
-            Branch = 1;
+            s.branch = 1;
     /////////////////////////// UPDATE PEAK POINTS ////////////////////////////////////////////
             if ( Fi_1 > 0 ){
-                posUlocal = Ui_1;           // UPDATE LOCAL
-                posFlocal = Fi_1;
-                if ( Ui_1 > posUglobal ) {    // UPDATE GLOBAL
-                    posUglobal = Ui_1;
-                    posFglobal = Fi_1;
+                pos.Ulocal = Ui_1;           // UPDATE LOCAL
+                pos.Flocal = Fi_1;
+                if ( Ui_1 > pos.Uglobal ) {    // UPDATE GLOBAL
+                    pos.Uglobal = Ui_1;
+                    pos.Fglobal = Fi_1;
                 }
             } else {
-                negUlocal = Ui_1;           // UPDATE LOCAL
-                negFlocal = Fi_1;
-                if ( Ui_1 < negUglobal ) {    // UPDATE GLOBAL
-                    negUglobal = Ui_1;
-                    negFglobal = Fi_1;
+                neg.Ulocal = Ui_1;           // UPDATE LOCAL
+                neg.Flocal = Fi_1;
+                if ( Ui_1 < neg.Uglobal ) {    // UPDATE GLOBAL
+                    neg.Uglobal = Ui_1;
+                    neg.Fglobal = Fi_1;
                 }
             }
     /////////////////// UPDATE UNLOADING STIFFNESS ////////////////////////////////////////////
-            const double  EpjK = engAcml - 0.5 * (Fi_1 / Kunload) * Fi_1;
-            const double  EiK = engAcml - engDspt - 0.5 * (Fi_1 / Kunload) * Fi_1;
-            betaK = pow( (EiK / (engRefK - EpjK)), c_K );
-            FailK = (betaK > 1);
-            betaK = betaK < 0 ? 0 : (betaK > 1 ? 1 : betaK);
-            Kunload *= (1 - betaK);
+            const double  EpjK = s.engAcml - 0.5 * (Fi_1 / s.Kunload) * Fi_1;
+            const double  EiK = s.engAcml - s.engDspt - 0.5 * (Fi_1 / s.Kunload) * Fi_1;
+            betaK = deterioration(EiK, engRefK, EpjK, c_K, FailK);
+            s.Kunload *= (1 - betaK);
         }
-        Fi = Fi_1 + Kunload * dU;
+        s.Fi = Fi_1 + s.Kunload * dU;
     ///////////////////////////////////////////////////////////////////////////////////////////
     /////////////////// WHEN NEW EXCURSION /////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
-        if (Branch == 1 && Fi_1 * Fi <= 0.0) {
+        if (s.branch == 1 && Fi_1 * s.Fi <= 0.0) {
     /////////////////// UPDATE BACKBONE CURVE /////////////////////////////////////////////////
-            const double Ei = max(0.0, engAcml - engDspt);
-            betaS = pow((Ei / (engRefS - engAcml)), c_S);
-            betaC = pow((Ei / (engRefC - engAcml)), c_C);
-            betaA = pow((Ei / (engRefA - engAcml)), c_A);
-            FailS = (betaS > 1);
-            FailC = (betaC > 1);
-            FailA = (betaA > 1);
-            betaS = betaS < 0 ? 0 : (betaS > 1 ? 1 : betaS);
-            betaC = betaC < 0 ? 0 : (betaC > 1 ? 1 : betaC);
-            betaA = betaA < 0 ? 0 : (betaA > 1 ? 1 : betaA);
-            engDspt = engAcml;
+            const double Ei = max(0.0, s.engAcml - s.engDspt);
+            betaS = deterioration(Ei, engRefS, s.engAcml, c_S, FailS);
+            betaC = deterioration(Ei, engRefC, s.engAcml, c_C, FailC);
+            betaA = deterioration(Ei, engRefA, s.engAcml, c_A, FailA);
+            s.engDspt = s.engAcml;
         // Positive
             if (dU > 0) {
-                double FcapProj = posFcap - posKpc * posUcap;
+                double FcapProj = pos.Fcap - pos.Kpc * pos.Ucap;
             // Yield Point
-                posFy *= (1 - betaS * D_pos);
-                posKp *= (1 - betaS * D_pos); // Post-Yield Stiffness
+                pos.Fy *= (1 - betaS * D_pos);
+                pos.Kp *= (1 - betaS * D_pos); // Post-Yield Stiffness
                 FcapProj *= (1 - betaC * D_pos);
-                posUglobal *= (1 + betaA * D_pos); // Accelerated Reloading Stiffness
-                posUy = posFy / Ke;
+                pos.Uglobal *= (1 + betaA * D_pos); // Accelerated Reloading Stiffness
+                pos.Uy = pos.Fy / Ke;
             // Capping Point
-                const double FyProj = posFy - posKp*posUy;
-                posUcap = posKp <= posKpc ? 0 : (FcapProj - FyProj) / (posKp - posKpc);
-                posFcap = FyProj + posKp*posUcap;
+                const double FyProj = pos.Fy - pos.Kp*pos.Uy;
+                pos.Ucap = pos.Kp <= pos.Kpc ? 0 : (FcapProj - FyProj) / (pos.Kp - pos.Kpc);
+                pos.Fcap = FyProj + pos.Kp*pos.Ucap;
             // When a part of backbone is beneath the residual strength
             // Global Peak on the Updated Backbone
-                if (posUglobal < posUy) {           // Elastic Branch
-                    posFglobal = Ke * posUglobal;
+                if (pos.Uglobal < pos.Uy) {           // Elastic Branch
+                    pos.Fglobal = Ke * pos.Uglobal;
                 }
-                else if (posUglobal < posUcap) {    // Post-Yield Branch
-                    posFglobal = posFy + posKp * (posUglobal - posUy);
+                else if (pos.Uglobal < pos.Ucap) {    // Post-Yield Branch
+                    pos.Fglobal = pos.Fy + pos.Kp * (pos.Uglobal - pos.Uy);
                 }
                 else {                              // Post-Capping Branch
-                    posFglobal = posFcap + posKpc * (posUglobal - posUcap);
+                    pos.Fglobal = pos.Fcap + pos.Kpc * (pos.Uglobal - pos.Ucap);
                 }
-                if (posFglobal < posFres) {     // Residual Branch
-                    posFglobal = posFres;
+                if (pos.Fglobal < pos.Fres) {     // Residual Branch
+                    pos.Fglobal = pos.Fres;
                 }
-                posUres = (posFres - posFcap + posKpc * posUcap) / posKpc;
+                pos.Ures = (pos.Fres - pos.Fcap + pos.Kpc * pos.Ucap) / pos.Kpc;
             }
         // Negative
             else {
-                double FcapProj = negFcap - negKpc * negUcap;
+                double FcapProj = neg.Fcap - neg.Kpc * neg.Ucap;
             // Yield Point
-                negFy *= (1 - betaS * D_neg);
-                negKp *= (1 - betaS * D_neg); // Post-Yield Stiffness
+                neg.Fy *= (1 - betaS * D_neg);
+                neg.Kp *= (1 - betaS * D_neg); // Post-Yield Stiffness
                 FcapProj *= (1 - betaC * D_neg);
-                negUglobal *= (1 + betaA * D_neg); // Accelerated Reloading Stiffness
-                negUy = negFy / Ke;
+                neg.Uglobal *= (1 + betaA * D_neg); // Accelerated Reloading Stiffness
+                neg.Uy = neg.Fy / Ke;
             // Capping Point
-                const double FyProj = negFy - negKp * negUy;
-                negUcap = negKp <= negKpc ? 0 : (FcapProj - FyProj) / (negKp - negKpc);
-                negFcap = FyProj + negKp * negUcap;
+                const double FyProj = neg.Fy - neg.Kp * neg.Uy;
+                neg.Ucap = neg.Kp <= neg.Kpc ? 0 : (FcapProj - FyProj) / (neg.Kp - neg.Kpc);
+                neg.Fcap = FyProj + neg.Kp * neg.Ucap;
             // When a part of backbone is beneath the residual strength
             // Global Peak on the Updated Backbone
-                if (negUy < negUglobal) {           // Elastic Branch
-                    negFglobal = Ke * negUglobal;
+                if (neg.Uy < neg.Uglobal) {           // Elastic Branch
+                    neg.Fglobal = Ke * neg.Uglobal;
                 }
-                else if (negUcap < negUglobal) {    // Post-Yield Branch
-                    negFglobal = negFy + negKp * (negUglobal - negUy);
+                else if (neg.Ucap < neg.Uglobal) {    // Post-Yield Branch
+                    neg.Fglobal = neg.Fy + neg.Kp * (neg.Uglobal - neg.Uy);
                 }
                 else {                              // Post-Capping Branch
-                    negFglobal = negFcap + negKpc * (negUglobal - negUcap);
+                    neg.Fglobal = neg.Fcap + neg.Kpc * (neg.Uglobal - neg.Ucap);
                 }
-                if (negFres < negFglobal) {     // Residual Branch
-                    negFglobal = negFres;
+                if (neg.Fres < neg.Fglobal) {     // Residual Branch
+                    neg.Fglobal = neg.Fres;
                 }
-                negUres = (negFres - negFcap + negKpc * negUcap) / negKpc;
+                neg.Ures = (neg.Fres - neg.Fcap + neg.Kpc * neg.Ucap) / neg.Kpc;
             }
     ////////////////////////// RELOADING TARGET DETERMINATION /////////////////////////////////
             if (dU > 0) {
-                const double u0 = Ui_1 - (Fi_1 / Kunload);
-                const double Uplstc = posUglobal - (posFglobal / Kunload);
-                Upinch = (1 - kappaD) * Uplstc;
-                Fpinch = kappaF * posFglobal * (Upinch - u0) / (posUglobal - u0);
-                const double Kpinch = Fpinch / (Upinch - u0);
-                const double Kglobal = posFglobal / (posUglobal - u0);
-                const double Klocal = posFlocal / (posUlocal - u0);
-                if (u0 < Upinch) {
-                    Branch = 2;
-                    Kreload = Kpinch;
-                } else  if ( u0 < posUlocal && posFlocal < posFglobal && Klocal > Kglobal) {
-                    Branch = 3;
-                    Kreload = Klocal;
+                const double u0 = Ui_1 - (Fi_1 / s.Kunload);
+                const double Uplstc = pos.Uglobal - (pos.Fglobal / s.Kunload);
+                s.Upinch = (1 - kappaD) * Uplstc;
+                s.Fpinch = kappaF * pos.Fglobal * (s.Upinch - u0) / (pos.Uglobal - u0);
+                const double Kpinch = s.Fpinch / (s.Upinch - u0);
+                const double Kglobal = pos.Fglobal / (pos.Uglobal - u0);
+                const double Klocal = pos.Flocal / (pos.Ulocal - u0);
+                if (u0 < s.Upinch) {
+                    s.branch = 2;
+                    s.Kreload = Kpinch;
+                } else  if ( u0 < pos.Ulocal && pos.Flocal < pos.Fglobal && Klocal > Kglobal) {
+                    s.branch = 3;
+                    s.Kreload = Klocal;
                 } else {
-                    Branch = 4;
-                    Kreload = Kglobal;
+                    s.branch = 4;
+                    s.Kreload = Kglobal;
                 }
             }
             else {
-                const double u0 = Ui_1 - (Fi_1 / Kunload);
-                const double Uplstc = negUglobal - (negFglobal / Kunload);
-                Upinch = (1 - kappaD) * Uplstc;
-                Fpinch = kappaF * negFglobal * (Upinch - u0) / (negUglobal - u0);
-                const double Kpinch = Fpinch / (Upinch - u0);
-                const double Kglobal = negFglobal / (negUglobal - u0);
-                const double Klocal = negFlocal / (negUlocal - u0);
-                if (u0 > Upinch) {
-                    Branch = 12;
-                    Kreload = Kpinch;
-                } else  if ( u0 > negUlocal && negFlocal > negFglobal && Klocal > Kglobal) {
-                    Branch = 13;
-                    Kreload = Klocal;
+                const double u0 = Ui_1 - (Fi_1 / s.Kunload);
+                const double Uplstc = neg.Uglobal - (neg.Fglobal / s.Kunload);
+                s.Upinch = (1 - kappaD) * Uplstc;
+                s.Fpinch = kappaF * neg.Fglobal * (s.Upinch - u0) / (neg.Uglobal - u0);
+                const double Kpinch = s.Fpinch / (s.Upinch - u0);
+                const double Kglobal = neg.Fglobal / (neg.Uglobal - u0);
+                const double Klocal = neg.Flocal / (neg.Ulocal - u0);
+                if (u0 > s.Upinch) {
+                    s.branch = 12;
+                    s.Kreload = Kpinch;
+                } else  if ( u0 > neg.Ulocal && neg.Flocal > neg.Fglobal && Klocal > Kglobal) {
+                    s.branch = 13;
+                    s.Kreload = Klocal;
                 } else {
-                    Branch = 14;
-                    Kreload = Kglobal;
+                    s.branch = 14;
+                    s.Kreload = Kglobal;
                 }
             }
          }
@@ -307,80 +315,80 @@ int IMKPinching::setTrialStrain(double strain, double strainRate)
     //      17: Residual Branch         -
     // Branch shifting from 2 -> 3 -> 4 -> 5 -> 6 -> 7
         // int exBranch = Branch;
-        if (Branch == 0 && Ui > posUy) {            // Yield in Positive
-            Branch = 5;
-        } else if (Branch == 0 && Ui < negUy) {     // Yield in Negative
-            Branch = 15;
-        } else if (Branch == 1 && Fi_1 > 0 && Ui > posUlocal) {
-            const double Kpinch = (Fpinch - posFlocal) / (Upinch - posUlocal);
-            const double Kglobal = (posFglobal - posFlocal) / (posUglobal - posUlocal);
-            if (posUlocal < Upinch && posFlocal < Fpinch && Upinch < posUglobal && Fpinch < posFglobal && Kpinch < Kglobal) {
-                Kreload = Kpinch;
-                Branch = 2;                        // Pinching Branch
+        if (s.branch == 0 && s.Ui > pos.Uy) {            // Yield in Positive
+            s.branch = 5;
+        } else if (s.branch == 0 && s.Ui < neg.Uy) {     // Yield in Negative
+            s.branch = 15;
+        } else if (s.branch == 1 && Fi_1 > 0 && s.Ui > pos.Ulocal) {
+            const double Kpinch = (s.Fpinch - pos.Flocal) / (s.Upinch - pos.Ulocal);
+            const double Kglobal = (pos.Fglobal - pos.Flocal) / (pos.Uglobal - pos.Ulocal);
+            if (pos.Ulocal < s.Upinch && pos.Flocal < s.Fpinch && s.Upinch < pos.Uglobal && s.Fpinch < pos.Fglobal && Kpinch < Kglobal) {
+                s.Kreload = Kpinch;
+                s.branch = 2;                        // Pinching Branch
             } else {
-                Kreload = Kglobal;
-                Branch = 4;                        // Towards Global Peak
+                s.Kreload = Kglobal;
+                s.branch = 4;                        // Towards Global Peak
             }
-        } else if (Branch == 1 && Fi_1 < 0 && Ui < negUlocal) {    // Back to Reloading (Negative)
-            const double Kpinch = (Fpinch - negFlocal) / (Upinch - negUlocal);
-            const double Kglobal = (negFglobal - negFlocal) / (negUglobal - negUlocal);
-            if (negUglobal < Upinch && negFglobal < Fpinch && Upinch < negUlocal && Fpinch < negFlocal && Kpinch < Kglobal) {
-                Kreload = Kpinch;
-                Branch = 12;                   // Pinching Branch
+        } else if (s.branch == 1 && Fi_1 < 0 && s.Ui < neg.Ulocal) {    // Back to Reloading (Negative)
+            const double Kpinch = (s.Fpinch - neg.Flocal) / (s.Upinch - neg.Ulocal);
+            const double Kglobal = (neg.Fglobal - neg.Flocal) / (neg.Uglobal - neg.Ulocal);
+            if (neg.Uglobal < s.Upinch && neg.Fglobal < s.Fpinch && s.Upinch < neg.Ulocal && s.Fpinch < neg.Flocal && Kpinch < Kglobal) {
+                s.Kreload = Kpinch;
+                s.branch = 12;                   // Pinching Branch
             } else {
-                Kreload = Kglobal;
-                Branch = 14;                   // Towards Global Peak
+                s.Kreload = Kglobal;
+                s.branch = 14;                   // Towards Global Peak
             }
         }
     // Positive
-        if (Branch == 2 && Ui > Upinch) {
-            const double Kglobal = (posFglobal - Fpinch) / (posUglobal - Upinch);
-            const double Klocal = (posFlocal - Fpinch) / (posUlocal - Upinch);
-            if (Upinch < posUlocal && Fpinch < posFlocal && posFlocal < posFglobal && Klocal > Kglobal) {
-                Kreload = Klocal;
-                Branch = 3;
+        if (s.branch == 2 && s.Ui > s.Upinch) {
+            const double Kglobal = (pos.Fglobal - s.Fpinch) / (pos.Uglobal - s.Upinch);
+            const double Klocal = (pos.Flocal - s.Fpinch) / (pos.Ulocal - s.Upinch);
+            if (s.Upinch < pos.Ulocal && s.Fpinch < pos.Flocal && pos.Flocal < pos.Fglobal && Klocal > Kglobal) {
+                s.Kreload = Klocal;
+                s.branch = 3;
             } else {
-                Kreload = Kglobal;
-                Branch = 4;
+                s.Kreload = Kglobal;
+                s.branch = 4;
             }
         }
-        if (Branch == 3 && Ui > posUlocal) {
-            Kreload = (posFglobal - posFlocal) / (posUglobal - posUlocal);
-            Branch = 4;
+        if (s.branch == 3 && s.Ui > pos.Ulocal) {
+            s.Kreload = (pos.Fglobal - pos.Flocal) / (pos.Uglobal - pos.Ulocal);
+            s.branch = 4;
         }
-        if (Branch == 4 && Ui > posUglobal) {
-            Branch = 5;
+        if (s.branch == 4 && s.Ui > pos.Uglobal) {
+            s.branch = 5;
         }
-        if (Branch == 5 && Ui > posUcap) {
-            Branch = 6;
+        if (s.branch == 5 && s.Ui > pos.Ucap) {
+            s.branch = 6;
         }
-        if (Branch == 6 && Ui > posUres) {
-            Branch = 7;
+        if (s.branch == 6 && s.Ui > pos.Ures) {
+            s.branch = 7;
         }
     // Negative
-        if (Branch == 12 && Ui < Upinch) {
-            const double Kglobal = (negFglobal - Fpinch) / (negUglobal - Upinch);
-            const double Klocal = (negFlocal - Fpinch) / (negUlocal - Upinch);
-            if (negFglobal < negFlocal && negUlocal < Upinch && negFlocal < Fpinch && Klocal > Kglobal) {
-                Kreload = Klocal;
-                Branch = 13;
+        if (s.branch == 12 && s.Ui < s.Upinch) {
+            const double Kglobal = (neg.Fglobal - s.Fpinch) / (neg.Uglobal - s.Upinch);
+            const double Klocal = (neg.Flocal - s.Fpinch) / (neg.Ulocal - s.Upinch);
+            if (neg.Fglobal < neg.Flocal && neg.Ulocal < s.Upinch && neg.Flocal < s.Fpinch && Klocal > Kglobal) {
+                s.Kreload = Klocal;
+                s.branch = 13;
             } else {
-                Kreload = Kglobal;
-                Branch = 14;
+                s.Kreload = Kglobal;
+                s.branch = 14;
             }
         }
-        if (Branch == 13 && Ui < negUlocal) {
-            Kreload = (negFglobal - negFlocal) / (negUglobal - negUlocal);
-            Branch = 14;
+        if (s.branch == 13 && s.Ui < neg.Ulocal) {
+            s.Kreload = (neg.Fglobal - neg.Flocal) / (neg.Uglobal - neg.Ulocal);
+            s.branch = 14;
         }
-        if (Branch == 14 && Ui < negUglobal) {
-            Branch = 15;
+        if (s.branch == 14 && s.Ui < neg.Uglobal) {
+            s.branch = 15;
         }
-        if (Branch == 15 && Ui < negUcap) {
-            Branch = 16;
+        if (s.branch == 15 && s.Ui < neg.Ucap) {
+            s.branch = 16;
         }
-        if (Branch == 16 && Ui < negUres) {
-            Branch = 17;
+        if (s.branch == 16 && s.Ui < neg.Ures) {
+            s.branch = 17;
         }
     // Branch Change check
         // if (Branch!=exBranch) {
@@ -391,59 +399,59 @@ int IMKPinching::setTrialStrain(double strain, double strainRate)
     /////////////////////// COMPUTE FORCE BASED ON BRANCH /////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
-        if (Branch == 0) {
-            Fi = Ke * Ui;
-        } else if (Branch == 1) {
-            Fi = Fi_1 + Kunload * dU;
+        if (s.branch == 0) {
+            s.Fi = Ke * s.Ui;
+        } else if (s.branch == 1) {
+            s.Fi = Fi_1 + s.Kunload * dU;
     // Positive
-        } else if (Branch == 2) {
-            Fi = Fpinch + Kreload * (Ui - Upinch);
-        } else if (Branch == 3) {
-            Fi = posFlocal + Kreload * (Ui - posUlocal);
-        } else if (Branch == 4) {
-            Fi = posFglobal + Kreload * (Ui - posUglobal);
-        } else if (Branch == 5) {
-            Fi = posFcap + posKp * (Ui - posUcap);
-        } else if (Branch == 6) {
-            Fi = posFcap + posKpc * (Ui - posUcap);
-        } else if (Branch == 7) {
-            Fi = posFres;
+        } else if (s.branch == 2) {
+            s.Fi = s.Fpinch + s.Kreload * (s.Ui - s.Upinch);
+        } else if (s.branch == 3) {
+            s.Fi = pos.Flocal + s.Kreload * (s.Ui - pos.Ulocal);
+        } else if (s.branch == 4) {
+            s.Fi = pos.Fglobal + s.Kreload * (s.Ui - pos.Uglobal);
+        } else if (s.branch == 5) {
+            s.Fi = pos.Fcap + pos.Kp * (s.Ui - pos.Ucap);
+        } else if (s.branch == 6) {
+            s.Fi = pos.Fcap + pos.Kpc * (s.Ui - pos.Ucap);
+        } else if (s.branch == 7) {
+            s.Fi = pos.Fres;
     // Negative
-        } else if (Branch == 12) {
-            Fi = Fpinch + Kreload * (Ui - Upinch);
-        } else if (Branch == 13) {
-            Fi = negFlocal + Kreload * (Ui - negUlocal);
-        } else if (Branch == 14) {
-            Fi = negFglobal + Kreload * (Ui - negUglobal);
-        } else if (Branch == 15) {
-            Fi = negFcap + negKp * (Ui - negUcap);
-        } else if (Branch == 16) {
-            Fi = negFcap + negKpc * (Ui - negUcap);
-        } else if (Branch == 17) {
-            Fi = negFres;
+        } else if (s.branch == 12) {
+            s.Fi = s.Fpinch + s.Kreload * (s.Ui - s.Upinch);
+        } else if (s.branch == 13) {
+            s.Fi = neg.Flocal + s.Kreload * (s.Ui - neg.Ulocal);
+        } else if (s.branch == 14) {
+            s.Fi = neg.Fglobal + s.Kreload * (s.Ui - neg.Uglobal);
+        } else if (s.branch == 15) {
+            s.Fi = neg.Fcap + neg.Kp * (s.Ui - neg.Ucap);
+        } else if (s.branch == 16) {
+            s.Fi = neg.Fcap + neg.Kpc * (s.Ui - neg.Ucap);
+        } else if (s.branch == 17) {
+            s.Fi = neg.Fres;
         }
     ///////////////////////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
     // CHECK FOR FAILURE
     ///////////////////////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////////
-        const bool FailPp = ( posFglobal == 0 );
-        const bool FailPn = ( negFglobal == 0 );
-        const bool FailDp = ( dU > 0 && Ui >=  posUu_0 );
-        const bool FailDn = ( dU < 0 && Ui <= -negUu_0 );
-        const bool FailRp = ( Branch == 7 && Fi <= 0);
-        const bool FailRn = ( Branch == 17 && Fi >= 0);
+        const bool FailPp = ( pos.Fglobal == 0 );
+        const bool FailPn = ( neg.Fglobal == 0 );
+        const bool FailDp = ( dU > 0 && s.Ui >=  posUu_0 );
+        const bool FailDn = ( dU < 0 && s.Ui <= -negUu_0 );
+        const bool FailRp = ( s.branch == 7 && s.Fi <= 0);
+        const bool FailRn = ( s.branch == 17 && s.Fi >= 0);
         if (FailS || FailC || FailA || FailK || FailPp || FailPn || FailRp || FailRn || FailDp || FailDn) {
-            Fi = 0;
-            Failure_Flag = true;
+            s.Fi = 0;
+            s.failure = 1;
         }
 
-        engAcml += 0.5 * (Fi + Fi_1) * dU;   // Internal energy increment
+        s.engAcml += 0.5 * (s.Fi + Fi_1) * dU;   // Internal energy increment
 
-        KgetTangent = (Fi - Fi_1) / dU;
+        s.Ktangent = (s.Fi - Fi_1) / dU;
     }
-    if (KgetTangent == 0) {
-        KgetTangent = 1e-6;
+    if (s.Ktangent == 0) {
+        s.Ktangent = 1e-6;
     }
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -455,122 +463,33 @@ int IMKPinching::setTrialStrain(double strain, double strainRate)
 
 double IMKPinching::getStress(void)
 {
-    //cout << " getStress" << endln;
-    return (Fi);
+    return history.current().Fi;
 }
 
 double IMKPinching::getTangent(void)
 {
-    //cout << " getTangent" << endln;
-    return (KgetTangent);
+    return history.current().Ktangent;
 }
 
 double IMKPinching::getInitialTangent(void)
 {
-    //cout << " getInitialTangent" << endln;
     return (Ke);
 }
 
 double IMKPinching::getStrain(void)
 {
-    //cout << " getStrain" << endln;
-    return (Ui);
+    return history.current().Ui;
 }
 
 int IMKPinching::commitState(void)
 {
-    //cout << " commitState" << endln;
-
-    //commit trial  variables
-// 12 Pos U and F
-    cPosUy = posUy;
-    cPosFy = posFy;
-    cPosUcap = posUcap;
-    cPosFcap = posFcap;
-    cPosUlocal = posUlocal;
-    cPosFlocal = posFlocal;
-    cPosUglobal = posUglobal;
-    cPosFglobal = posFglobal;
-    cPosUres = posUres;
-    cPosFres = posFres;
-    cPosKp = posKp;
-    cPosKpc = posKpc;
-// 12 Neg U and F
-    cNegUy = negUy;
-    cNegFy = negFy;
-    cNegUcap = negUcap;
-    cNegFcap = negFcap;
-    cNegUlocal = negUlocal;
-    cNegFlocal = negFlocal;
-    cNegUglobal = negUglobal;
-    cNegFglobal = negFglobal;
-    cNegUres = negUres;
-    cNegFres = negFres;
-    cNegKp = negKp;
-    cNegKpc = negKpc;
-// 2 Pinching
-    cFpinch = Fpinch;
-    cUpinch = Upinch;
-// 3 State
-    cUi = Ui;
-    cFi = Fi;
-// 2 Stiffness
-    cKreload = Kreload;
-    cKunload = Kunload;
-// 2 Energy
-    cEngAcml = engAcml;
-    cEngDspt = engDspt;
-// 2 Flag
-    cFailure_Flag = Failure_Flag;
-    cBranch = Branch;
+    history.commit();
     return 0;
 }
 
 int IMKPinching::revertToLastCommit(void)
 {
-    //cout << " revertToLastCommit" << endln;
-    //the opposite of commit trial history variables
-// 12 Positive U and F
-    posUy = cPosUy;
-    posFy = cPosFy;
-    posUcap = cPosUcap;
-    posFcap = cPosFcap;
-    posUlocal = cPosUlocal;
-    posFlocal = cPosFlocal;
-    posUglobal = cPosUglobal;
-    posFglobal = cPosFglobal;
-    posUres = cPosUres;
-    posFres = cPosFres;
-    posKp = cPosKp;
-    posKpc = cPosKpc;
-// 12 Negative U and F
-    negUy = cNegUy;
-    negFy = cNegFy;
-    negUcap = cNegUcap;
-    negFcap = cNegFcap;
-    negUlocal = cNegUlocal;
-    negFlocal = cNegFlocal;
-    negUglobal = cNegUglobal;
-    negFglobal = cNegFglobal;
-    negUres = cNegUres;
-    negFres = cNegFres;
-    negKp = cNegKp;
-    negKpc = cNegKpc;
-// 2 Pinching
-    Fpinch = cFpinch;
-    Upinch = cUpinch;
-// 3 State Variables
-    Ui = cUi;
-    Fi = cFi;
-// 2 Stiffness
-    Kreload = cKreload;
-    Kunload = cKunload;
-// 2 Energy
-    engAcml = cEngAcml;
-    engDspt = cEngDspt;
-// 2 Flag
-    Failure_Flag = cFailure_Flag;
-    Branch = cBranch;
+    history.revert();
     return 0;
 }
 
@@ -594,48 +513,53 @@ int IMKPinching::revertToStart(void)
     engRefC = LAMBDA_C * posFy_0;
     engRefA = LAMBDA_A * posFy_0;
     engRefK = LAMBDA_K * posFy_0;
+OpenSees::IMK::History init {};
+    OpenSees::IMK::Backbone &pos = init.bb[OpenSees::IMK::Positive];
+    OpenSees::IMK::Backbone &neg = init.bb[OpenSees::IMK::Negative];
 // 12 Positive U and F
-    posUy = cPosUy = posUy_0;
-    posFy = cPosFy = posFy_0;
-    posUcap = cPosUcap = posUcap_0;
-    posFcap = cPosFcap = posFcap_0;
-    posUlocal = cPosUlocal = posUy_0;
-    posFlocal = cPosFlocal = posFy_0;
-    posUglobal = cPosUglobal = posUy_0;
-    posFglobal = cPosFglobal = posFy_0;
-    posFres = cPosFres = posFy_0*posFresFy_0;
-    posKp = cPosKp =  posKp_0;
-    posKpc = cPosKpc = -posKpc_0;
-    posUres = cPosUres = (posFres - posFcap) / posKpc + posUcap;
+    pos.Uy = posUy_0;
+    pos.Fy = posFy_0;
+    pos.Ucap = posUcap_0;
+    pos.Fcap = posFcap_0;
+    pos.Ulocal = posUy_0;
+    pos.Flocal = posFy_0;
+    pos.Uglobal = posUy_0;
+    pos.Fglobal = posFy_0;
+    pos.Fres = posFy_0*posFresFy_0;
+    pos.Kp =  posKp_0;
+    pos.Kpc = -posKpc_0;
+    pos.Ures = (pos.Fres - pos.Fcap) / pos.Kpc + pos.Ucap;
 // 12 Negative U and F
-    negUy = cNegUy = -negUy_0;
-    negFy = cNegFy = -negFy_0;
-    negUcap = cNegUcap = -negUcap_0;
-    negFcap = cNegFcap = -negFcap_0;
-    negUlocal = cNegUlocal = -negUy_0;
-    negFlocal = cNegFlocal = -negFy_0;
-    negUglobal = cNegUglobal = -negUy_0;
-    negFglobal = cNegFglobal = -negFy_0;
-    negFres = cNegFres = -negFy_0*negFresFy_0;
-    negKp = cNegKp =  negKp_0;
-    negKpc = cNegKpc = -negKpc_0;
-    negUres = cNegUres = (negFres - negFcap) / negKpc + negUcap;
+    neg.Uy = -negUy_0;
+    neg.Fy = -negFy_0;
+    neg.Ucap = -negUcap_0;
+    neg.Fcap = -negFcap_0;
+    neg.Ulocal = -negUy_0;
+    neg.Flocal = -negFy_0;
+    neg.Uglobal = -negUy_0;
+    neg.Fglobal = -negFy_0;
+    neg.Fres = -negFy_0*negFresFy_0;
+    neg.Kp =  negKp_0;
+    neg.Kpc = -negKpc_0;
+    neg.Ures = (neg.Fres - neg.Fcap) / neg.Kpc + neg.Ucap;
 // 3 State Values
-    Ui = cUi = 0;
-    Fi = cFi = 0;
+    init.Ui = 0;
+    init.Fi = 0;
 // 2 Stiffness
-    Kreload = cKreload = Ke;
-    Kunload = cKunload = Ke;
-    KgetTangent = Ke;
+    init.Kreload = Ke;
+    init.Kunload = Ke;
+    init.Ktangent = Ke;
 // 2 Energy
-    engAcml = cEngAcml = 0.0;
-    engDspt = cEngDspt = 0.0;
+    init.engAcml = 0.0;
+    init.engDspt = 0.0;
 // 2 Flag
-    Failure_Flag = cFailure_Flag = false;
-    Branch = cBranch = 0;
+    init.failure = 0;
+    init.branch = 0;
 // 2 Pinching
-    Fpinch = cFpinch = 0.0;
-    Upinch = cUpinch = 0.0;
+    init.Fpinch = 0.0;
+    init.Upinch = 0.0;
+
+    history.reset(init);
     return 0;
 }
 
@@ -656,7 +580,7 @@ int IMKPinching::sendSelf(int cTag, Channel &theChannel)
 {
     int res = 0;
 
-    static Vector data(137);
+    static Vector data(45 + OpenSees::IMK::HistorySize);
     data(0) = this->getTag();
 // 25 Fixed Input Material Parameters 1-25
     data(1) = Ke;
@@ -699,90 +623,9 @@ int IMKPinching::sendSelf(int cTag, Channel &theChannel)
     data(42) = engRefC;
     data(43) = engRefA;
     data(44) = engRefK;
-// 12 Positive U and F 51-62
-/*    
-    data(51) = posUy;
-    data(52) = posFy;
-    data(53) = posUcap;
-    data(54) = posFcap;
-    data(55) = posUlocal;
-    data(56) = posFlocal;
-    data(57) = posUglobal;
-    data(58) = posFglobal;
-    data(59) = posUres;
-    data(60) = posFres;
-    data(51) = posKp;
-    data(62) = posKpc;
-// 3 State Variables 63-65
-    data(64) = Ui;
-    data(65) = Fi;
-// 2 Stiffness 66 67
-    data(66) = Kreload;
-    data(67) = Kunload;
-// 2 Energy 68 69
-    data(68) = engAcml;
-    data(69) = engDspt;
-// 12 Negative U and F 71-82
-    data(71) = negUy;
-    data(72) = negFy;
-    data(73) = negUcap;
-    data(74) = negFcap;
-    data(75) = negUlocal;
-    data(76) = negFlocal;
-    data(77) = negUglobal;
-    data(78) = negFglobal;
-    data(79) = negUres;
-    data(80) = negFres;
-    data(81) = negKp;
-    data(82) = negKpc;
-// 2 Pinching 83 84
-    data(83) = Fpinch;
-    data(84) = Upinch;
-// 2 Flag 85 86
-    data(85) = Failure_Flag;
-    data(86) = Branch;
-*/
-// 12 Positive U and F 101-112
-    data(101) = cPosUy;
-    data(102) = cPosFy;
-    data(103) = cPosUcap;
-    data(104) = cPosFcap;
-    data(105) = cPosUlocal;
-    data(106) = cPosFlocal;
-    data(107) = cPosUglobal;
-    data(108) = cPosFglobal;
-    data(109) = cPosUres;
-    data(110) = cPosFres;
-    data(111) = cPosKp;
-    data(112) = cPosKpc;
-// 3 State Variables 113-115
-    data(114) = cUi;
-    data(115) = cFi;
-// 2 Stiffness 116 117
-    data(116) = cKreload;
-    data(117) = cKunload;
-// 2 Energy 118 119
-    data(118) = cEngAcml;
-    data(119) = cEngDspt;
-// 12 Negative U and F 121-132
-    data(121) = cNegUy;
-    data(122) = cNegFy;
-    data(123) = cNegUcap;
-    data(124) = cNegFcap;
-    data(125) = cNegUlocal;
-    data(126) = cNegFlocal;
-    data(127) = cNegUglobal;
-    data(128) = cNegFglobal;
-    data(129) = cNegUres;
-    data(130) = cNegFres;
-    data(131) = cNegKp;
-    data(132) = cNegKpc;
-// 2 Pinching 133 134
-    data(133) = cFpinch;
-    data(134) = cUpinch;
-// 2 Flag 135 136
-    data(135) = cFailure_Flag;
-    data(136) = cBranch;
+// Committed history
+    OpenSees::IMK::pack(history.committed(), data, 45);
+
     res = theChannel.sendVector(this->getDbTag(), cTag, data);
     if (res < 0)
         opserr << "IMKPinching::sendSelf() - failed to send data\n";
@@ -792,7 +635,7 @@ int IMKPinching::sendSelf(int cTag, Channel &theChannel)
 int IMKPinching::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
     int res = 0;
-    static Vector data(137);
+    static Vector data(45 + OpenSees::IMK::HistorySize);
     res = theChannel.recvVector(this->getDbTag(), cTag, data);
 
     if (res < 0) {
@@ -842,92 +685,10 @@ int IMKPinching::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBr
         engRefC = data(42);
         engRefA = data(43);
         engRefK = data(44);
-    // 12 Positive U and F
-	/*
-        posUy = data(51);
-        posFy = data(52);
-        posUcap = data(53);
-        posFcap = data(54);
-        posUlocal = data(55);
-        posFlocal = data(56);
-        posUglobal = data(57);
-        posFglobal = data(58);
-        posUres = data(59);
-        posFres = data(60);
-        posKp = data(61);
-        posKpc = data(62);
-    // 3 State Variables
-        Ui = data(64);
-        Fi = data(65);
-    // 2 Stiffness
-        Kreload = data(66);
-        Kunload = data(67);
-    // 2 Energy
-        engAcml = data(68);
-        engDspt = data(69);
-    // 12 Negative U and F
-        negUy = data(71);
-        negFy = data(72);
-        negUcap = data(73);
-        negFcap = data(74);
-        negUlocal = data(75);
-        negFlocal = data(76);
-        negUglobal = data(77);
-        negFglobal = data(78);
-        negUres = data(79);
-        negFres = data(80);
-        negKp = data(81);
-        negKpc = data(82);
-    // 2 Pinching
-        Fpinch = data(83);
-        Upinch = data(84);
-    // 2 Flag
-        Failure_Flag = data(85);
-        Branch = data(86);
-	*/
-    // 12 Positive U and F
-        cPosUy = data(101);
-        cPosFy = data(102);
-        cPosUcap = data(103);
-        cPosFcap = data(104);
-        cPosUlocal = data(105);
-        cPosFlocal = data(106);
-        cPosUglobal = data(107);
-        cPosFglobal = data(108);
-        cPosUres = data(109);
-        cPosFres = data(110);
-        cPosKp = data(111);
-        cPosKpc = data(112);
-    // 3 State Variables
-        cUi = data(114);
-        cFi = data(115);
-    // 2 Stiffness
-        cKreload = data(116);
-        cKunload = data(117);
-    // 2 Energy
-        cEngAcml = data(118);
-        cEngDspt = data(119);
-    // 12 Negative U and F
-        cNegUy = data(121);
-        cNegFy = data(122);
-        cNegUcap = data(123);
-        cNegFcap = data(124);
-        cNegUlocal = data(125);
-        cNegFlocal = data(126);
-        cNegUglobal = data(127);
-        cNegFglobal = data(128);
-        cNegUres = data(129);
-        cNegFres = data(130);
-        cNegKp = data(131);
-        cNegKpc = data(132);
-    // 2 Pinching
-        cFpinch = data(133);
-        cUpinch = data(134);
-    // 2 Flag
-        cFailure_Flag = data(135);
-        cBranch = data(136);
-
-	this->revertToLastCommit();
+    // Committed history
+        OpenSees::IMK::unpack(history.committed(), data, 45);
+
+        this->revertToLastCommit();
     }
 
     return res;
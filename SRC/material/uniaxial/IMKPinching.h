@@ -29,6 +29,7 @@
 #define IMKPinching_h
 
 #include <UniaxialMaterial.h>
+#include <IMKDeterioration.h>
 
 class IMKPinching : public UniaxialMaterial
 {
@@ -41,6 +42,7 @@ public:
     ~IMKPinching();
     const char *getClassType(void) const { return "IMKPinching"; };
     int setTrialStrain(double strain, double strainRate = 0.0);
+    int setTrial(double strain, double &stress, double &tangent, double strainRate = 0.0);
     double  getStrain(void);
     double  getStress(void);
     double  getTangent(void);
@@ -94,47 +96,9 @@ private:
     double  engRefA;
     double  engRefK;
 // History Variables
-// 12 Positive U and F
-    double  posUy,          cPosUy;
-    double  posFy,          cPosFy;
-    double  posUcap,        cPosUcap;
-    double  posFcap,        cPosFcap;
-    double  posUlocal,      cPosUlocal;
-    double  posFlocal,      cPosFlocal;
-    double  posUglobal,     cPosUglobal;
-    double  posFglobal,     cPosFglobal;
-    double  posUres,        cPosUres;
-    double  posFres,        cPosFres;
-    double  posKp,          cPosKp;
-    double  posKpc,         cPosKpc;
-// 12 Negative U and F
-    double  negUy,          cNegUy;
-    double  negFy,          cNegFy;
-    double  negUcap,        cNegUcap;
-    double  negFcap,        cNegFcap;
-    double  negUlocal,      cNegUlocal;
-    double  negFlocal,      cNegFlocal;
-    double  negUglobal,     cNegUglobal;
-    double  negFglobal,     cNegFglobal;
-    double  negUres,        cNegUres;
-    double  negFres,        cNegFres;
-    double  negKp,          cNegKp;
-    double  negKpc,         cNegKpc;
-// 2 Pinching
-    double  Fpinch,         cFpinch;
-    double  Upinch,         cUpinch;
-// 3 State Variables
-    double  Ui,             cUi;
-    double  Fi,             cFi;
-// 3 Stiffness
-    double  Kreload,        cKreload, KgetTangent;
-    double  Kunload,        cKunload;
-// 2 Energy
-    double  engAcml,        cEngAcml;
-    double  engDspt,        cEngDspt;
-// 2 Flag
-    bool    Failure_Flag,   cFailure_Flag;
-    int     Branch,         cBranch;
+    OpenSees::IMK::TrialHistory<OpenSees::IMK::History> history;
+
+    int update(OpenSees::IMK::History&, double strain) const;
 };
 
 #endif
\ No newline at end of file
@@ -276,7 +276,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
  
   Information tmpInfo; // This is a fix for change in interface -- MHS
  
-  posUnlRuleID = this->setVariable(posUnlRule->getMeasure(), tmpInfo);
+  posUnlRule.setMeasureID(this->setVariable(posUnlRule->getMeasure(), tmpInfo));
   
   negUnlRule = unl.getCopy(this);
   
@@ -284,7 +284,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of unloading rule" << endln;
   
   negUnlRule->setNegative(true);
-  negUnlRuleID = this->setVariable(negUnlRule->getMeasure(), tmpInfo);
+  negUnlRule.setMeasureID(this->setVariable(negUnlRule->getMeasure(), tmpInfo));
   
   
   posStfDegr = stf.getCopy(this);
@@ -292,7 +292,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
   if (posStfDegr == 0)
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of stiffness degradation" << endln;
   
-  posStfDegrID = this->setVariable(posStfDegr->getMeasure(), tmpInfo);
+  posStfDegr.setMeasureID(this->setVariable(posStfDegr->getMeasure(), tmpInfo));
   
   negStfDegr = stf.getCopy(this);
   
@@ -300,7 +300,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of stiffness degradation" << endln;
   
   negStfDegr->setNegative(true);
-  negStfDegrID = this->setVariable(negStfDegr->getMeasure(), tmpInfo);
+  negStfDegr.setMeasureID(this->setVariable(negStfDegr->getMeasure(), tmpInfo));
   
   
   posStrDegr = str.getCopy(this);
@@ -308,7 +308,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
   if (posStrDegr == 0)
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of strength degradation" << endln;
   
-  posStrDegrID = this->setVariable(posStrDegr->getMeasure(), tmpInfo);
+  posStrDegr.setMeasureID(this->setVariable(posStrDegr->getMeasure(), tmpInfo));
   
   negStrDegr = str.getCopy(this);
   
@@ -316,7 +316,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of strength degradation" << endln;
   
   negStrDegr->setNegative(true);
-  negStrDegrID = this->setVariable(negStrDegr->getMeasure(), tmpInfo);
+  negStrDegr.setMeasureID(this->setVariable(negStrDegr->getMeasure(), tmpInfo));
   
   
   // Initialize history variables
@@ -377,7 +377,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
   
   Information tmpInfo; // This is a fix for change in interface -- MHS
 
-  posUnlRuleID = this->setVariable(posUnlRule->getMeasure(), tmpInfo);
+  posUnlRule.setMeasureID(this->setVariable(posUnlRule->getMeasure(), tmpInfo));
   
   negUnlRule = negUnl.getCopy(this);
   
@@ -385,7 +385,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of unloading rule" << endln;
   
   negUnlRule->setNegative(true);
-  negUnlRuleID = this->setVariable(negUnlRule->getMeasure(), tmpInfo);
+  negUnlRule.setMeasureID(this->setVariable(negUnlRule->getMeasure(), tmpInfo));
   
   
   posStfDegr = posStiff.getCopy(this);
@@ -393,7 +393,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
   if (posStfDegr == 0)
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of stiffness degradation" << endln;
   
-  posStfDegrID = this->setVariable(posStfDegr->getMeasure(), tmpInfo);
+  posStfDegr.setMeasureID(this->setVariable(posStfDegr->getMeasure(), tmpInfo));
   
   negStfDegr = negStiff.getCopy(this);
   
@@ -401,7 +401,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of stiffness degradation" << endln;
   
   negStfDegr->setNegative(true);
-  negStfDegrID = this->setVariable(negStfDegr->getMeasure(), tmpInfo);
+  negStfDegr.setMeasureID(this->setVariable(negStfDegr->getMeasure(), tmpInfo));
   
   
   posStrDegr = posStr.getCopy(this);
@@ -409,7 +409,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
   if (posStrDegr == 0)
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of strength degradation" << endln;
   
-  posStrDegrID = this->setVariable(posStrDegr->getMeasure(), tmpInfo);
+  posStrDegr.setMeasureID(this->setVariable(posStrDegr->getMeasure(), tmpInfo));
   
   negStrDegr = negStr.getCopy(this);
   
@@ -417,7 +417,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of strength degradation" << endln;
   
   negStrDegr->setNegative(true);
-  negStrDegrID = this->setVariable(negStrDegr->getMeasure(), tmpInfo);
+  negStrDegr.setMeasureID(this->setVariable(negStrDegr->getMeasure(), tmpInfo));
   
   // Initialize history variables
   this->revertToStart();
@@ -467,7 +467,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
   
   Information tmpInfo; // This is a fix for change in interface -- MHS
 
-  posUnlRuleID = this->setVariable(posUnlRule->getMeasure(), tmpInfo);
+  posUnlRule.setMeasureID(this->setVariable(posUnlRule->getMeasure(), tmpInfo));
   
   negUnlRule = negUnl.getCopy(this);
   
@@ -475,14 +475,14 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of unloading rule" << endln;
   
   negUnlRule->setNegative(true);
-  negUnlRuleID = this->setVariable(negUnlRule->getMeasure(), tmpInfo);
+  negUnlRule.setMeasureID(this->setVariable(negUnlRule->getMeasure(), tmpInfo));
     
   posStfDegr = posStiff.getCopy(this);
   
   if (posStfDegr == 0)
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of stiffness degradation" << endln;
   
-  posStfDegrID = this->setVariable(posStfDegr->getMeasure(), tmpInfo);
+  posStfDegr.setMeasureID(this->setVariable(posStfDegr->getMeasure(), tmpInfo));
   
   negStfDegr = negStiff.getCopy(this);
   
@@ -490,7 +490,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of stiffness degradation" << endln;
   
   negStfDegr->setNegative(true);
-  negStfDegrID = this->setVariable(negStfDegr->getMeasure(), tmpInfo);
+  negStfDegr.setMeasureID(this->setVariable(negStfDegr->getMeasure(), tmpInfo));
   
   
   posStrDegr = posStr.getCopy(this);
@@ -498,7 +498,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
   if (posStrDegr == 0)
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of strength degradation" << endln;
   
-  posStrDegrID = this->setVariable(posStrDegr->getMeasure(), tmpInfo);
+  posStrDegr.setMeasureID(this->setVariable(posStrDegr->getMeasure(), tmpInfo));
   
   negStrDegr = negStr.getCopy(this);
   
@@ -506,7 +506,7 @@ OOHystereticMaterial::OOHystereticMaterial(int tag,
     opserr << "OOHystereticMaterial::OOHystereticMaterial -- failed to get copy of strength degradation" << endln;
   
   negStrDegr->setNegative(true);
-  negStrDegrID = this->setVariable(negStrDegr->getMeasure(), tmpInfo);
+  negStrDegr.setMeasureID(this->setVariable(negStrDegr->getMeasure(), tmpInfo));
   
   // Initialize history variables
   this->revertToStart();
@@ -570,7 +570,7 @@ OOHystereticMaterial::setTrialStrain(double strain, double strainRate)
   if (Tstrain > CtargMax) {
     TrotMax = Tstrain;
     TtargMax = Tstrain;
-    tmp = posStrDegr->getValue();
+    tmp = posStrDegr.getValue();
     Ttangent = tmp*posEnvelope->getTangent(Tstrain);
     Tstress = tmp*posEnvelope->getStress(Tstrain);
     TenergyD = CenergyD + 0.5*(Cstress+Tstress)*dStrain;
@@ -578,7 +578,7 @@ OOHystereticMaterial::setTrialStrain(double strain, double strainRate)
   else if (Tstrain < CtargMin) {
     TrotMin = Tstrain;
     TtargMin = Tstrain;
-    tmp = negStrDegr->getValue();
+    tmp = negStrDegr.getValue();
     Ttangent = tmp*negEnvelope->getTangent(-Tstrain);
     Tstress = -tmp*negEnvelope->getStress(-Tstrain);
     TenergyD = CenergyD + 0.5*(Cstress+Tstress)*dStrain;
@@ -591,11 +591,20 @@ OOHystereticMaterial::setTrialStrain(double strain, double strainRate)
   }
   
   //(dStrain < 0.0) ? negativeIncrement(dStrain) : positiveIncrement(dStrain);
-  //cerr << dStrain << ' ' << posStfDegr->getValue() << endl;
+  //cerr << dStrain << ' ' << posStfDegr.getValue() << endl;
   
   return 0;
 }
 
+int
+OOHystereticMaterial::setTrial(double strain, double &stress, double &tangent, double strainRate)
+{
+  int status = this->setTrialStrain(strain, strainRate);
+  stress  = Tstress;
+  tangent = Ttangent;
+  return status;
+}
+
 double
 OOHystereticMaterial::getStrain(void)
 {
@@ -624,33 +633,28 @@ void
 OOHystereticMaterial::positiveIncrement(double dStrain)
 {
   // Get current degradation values
-  double vun = negUnlRule->getValue();
-  double vkp = posStfDegr->getValue();
-  double vsp = posStrDegr->getValue();
+  double vun = negUnlRule.getValue();
+  double vkp = posStfDegr.getValue();
+  double vsp = posStrDegr.getValue();
   
   if (TloadIndicator == 2) {
     TloadIndicator = 1;
     
     if (Cstress <= 0.0) {
       
-      Information info;
-      
       // Unloading rule
-      this->getVariable(negUnlRuleID,info);
-      negUnlRule->setTrialMeasure(info.theDouble);
+      negUnlRule.setTrialMeasure(this->getMeasure(negUnlRule.getMeasureID()));
       
       // Stiffness degradation
-      this->getVariable(posStfDegrID,info);
-      posStfDegr->setTrialMeasure(info.theDouble);
+      posStfDegr.setTrialMeasure(this->getMeasure(posStfDegr.getMeasureID()));
       
       // Strength degradation
-      this->getVariable(posStrDegrID,info);
-      posStrDegr->setTrialMeasure(info.theDouble);
+      posStrDegr.setTrialMeasure(this->getMeasure(posStrDegr.getMeasureID()));
       
       // Get updated degradation values
-      vun = negUnlRule->getValue();
-      vkp = posStfDegr->getValue();
-      vsp = posStrDegr->getValue();
+      vun = negUnlRule.getValue();
+      vkp = posStfDegr.getValue();
+      vsp = posStrDegr.getValue();
       
       TrotNu = Cstrain - Cstress/(E1n*vun);
       TtargMax = TtargMax*vkp;
@@ -658,7 +662,7 @@ OOHystereticMaterial::positiveIncrement(double dStrain)
     }
   }
   
-  double vup = posUnlRule->getValue();
+  double vup = posUnlRule.getValue();
   
   //TrotMax = (TrotMax > rot1p) ? TrotMax : rot1p;
   if (TrotMax < rot1p) {
@@ -667,11 +671,7 @@ OOHystereticMaterial::positiveIncrement(double dStrain)
   }
   
   double maxmom = vsp*posEnvelope->getStress(TtargMax);
-  double E = negEnvelope->getTangent(-CrotMin);
-  double rotlim = (E < 0) ? CrotMin + negEnvelope->getStress(-CrotMin)/E : NEG_INF_STRAIN;
-  if (rotlim > NEG_INF_STRAIN && negEnvelope->getStress(-rotlim) > 0.0)
-    rotlim = NEG_INF_STRAIN;
-  double rotrel = (rotlim > TrotNu) ? rotlim : TrotNu;
+  double rotrel = (rotlimNeg > TrotNu) ? rotlimNeg : TrotNu;
   
   double rotmp1 = rotrel + pinchY*(TtargMax-rotrel);
   double rotmp2 = TtargMax - (1.0-pinchY)*maxmom/(vup*E1p);
@@ -731,9 +731,9 @@ void
 OOHystereticMaterial::negativeIncrement(double dStrain)
 {
   // Get current degradation values
-  double vup = posUnlRule->getValue();
-  double vkn = negStfDegr->getValue();
-  double vsn = negStrDegr->getValue();
+  double vup = posUnlRule.getValue();
+  double vkn = negStfDegr.getValue();
+  double vsn = negStrDegr.getValue();
   
   //cerr << TtargMin << endl;
   
@@ -742,24 +742,19 @@ OOHystereticMaterial::negativeIncrement(double dStrain)
     
     if (Cstress >= 0.0) {
       
-      Information info;
-      
       // Unloading rule
-      this->getVariable(posUnlRuleID,info);
-      posUnlRule->setTrialMeasure(info.theDouble);
+      posUnlRule.setTrialMeasure(this->getMeasure(posUnlRule.getMeasureID()));
       
       // Stiffness degradation
-      this->getVariable(negStfDegrID,info);
-      negStfDegr->setTrialMeasure(info.theDouble);
+      negStfDegr.setTrialMeasure(this->getMeasure(negStfDegr.getMeasureID()));
       
       // Strength degradation
-      this->getVariable(negStrDegrID,info);
-      negStrDegr->setTrialMeasure(info.theDouble);
+      negStrDegr.setTrialMeasure(this->getMeasure(negStrDegr.getMeasureID()));
       
       // Get updated degradation values
-      vup = posUnlRule->getValue();
-      vkn = negStfDegr->getValue();
-      vsn = negStrDegr->getValue();
+      vup = posUnlRule.getValue();
+      vkn = negStfDegr.getValue();
+      vsn = negStrDegr.getValue();
       
       TrotPu = Cstrain - Cstress/(E1p*vup);      
       TtargMin = TtargMin*vkn;
@@ -768,7 +763,7 @@ OOHystereticMaterial::negativeIncrement(double dStrain)
     }
   }
   
-  double vun = negUnlRule->getValue();
+  double vun = negUnlRule.getValue();
   
   //TrotMin = (TrotMin < rot1n) ? TrotMin : rot1n;
   if (TrotMin > rot1n) {
@@ -779,12 +774,7 @@ OOHystereticMaterial::negativeIncrement(double dStrain)
   //cerr << "B: " << TtargMin << endl;
   
   double minmom = -vsn*negEnvelope->getStress(-TtargMin);
-  double E = posEnvelope->getTangent(CrotMax);
-  double rotlim = (E < 0) ? CrotMax - posEnvelope->getStress(CrotMax)/E : POS_INF_STRAIN;
-  if (rotlim < POS_INF_STRAIN && posEnvelope->getStress(rotlim) > 0.0)
-    rotlim = POS_INF_STRAIN;
-  
-  double rotrel = (rotlim < TrotPu) ? rotlim : TrotPu;
+  double rotrel = (rotlimPos < TrotPu) ? rotlimPos : TrotPu;
   
   double rotmp1 = rotrel + pinchY*(TtargMin-rotrel);
   double rotmp2 = TtargMin - (1.0-pinchY)*minmom/(vun*E1n);
@@ -840,6 +830,40 @@ OOHystereticMaterial::negativeIncrement(double dStrain)
     TenergyD = CenergyD + 0.5*(Cstress+Tstress)*dStrain;
 }
 
+void
+OOHystereticMaterial::setLimits(void)
+{
+  // Deformation at which the committed softening branch of each
+  // backbone would reach zero force; these only change on commit.
+  double E = posEnvelope->getTangent(CrotMax);
+  rotlimPos = (E < 0) ? CrotMax - posEnvelope->getStress(CrotMax)/E : POS_INF_STRAIN;
+  if (rotlimPos < POS_INF_STRAIN && posEnvelope->getStress(rotlimPos) > 0.0)
+    rotlimPos = POS_INF_STRAIN;
+
+  E = negEnvelope->getTangent(-CrotMin);
+  rotlimNeg = (E < 0) ? CrotMin + negEnvelope->getStress(-CrotMin)/E : NEG_INF_STRAIN;
+  if (rotlimNeg > NEG_INF_STRAIN && negEnvelope->getStress(-rotlimNeg) > 0.0)
+    rotlimNeg = NEG_INF_STRAIN;
+}
+
+double
+OOHystereticMaterial::getMeasure(int varID)
+{
+  switch (varID) {
+  case 1:
+    return Cstrain/rot1p;
+  case 2:
+    return Cstrain/rot1n;
+  case 3:
+    return TenergyD;
+  default: {
+    Information info;
+    this->getVariable(varID, info);
+    return info.theDouble;
+  }
+  }
+}
+
 int
 OOHystereticMaterial::commitState(void)
 {
@@ -856,15 +880,17 @@ OOHystereticMaterial::commitState(void)
   Cstrain = Tstrain;
   
   //firstIter = true;
+
+  this->setLimits();
   
   int err = 0;
   
-  err += posUnlRule->commitState();
-  err += negUnlRule->commitState();
-  err += posStfDegr->commitState();
-  err += negStfDegr->commitState();
-  err += posStrDegr->commitState();
-  err += negStrDegr->commitState();
+  err += posUnlRule.commitState();
+  err += negUnlRule.commitState();
+  err += posStfDegr.commitState();
+  err += negStfDegr.commitState();
+  err += posStrDegr.commitState();
+  err += negStrDegr.commitState();
 
   return err;
 }
@@ -885,15 +911,17 @@ OOHystereticMaterial::revertToLastCommit(void)
   Tstrain = Cstrain;
   
   firstIter = true;
+
+  this->setLimits();
   
   int err = 0;
   
-  err += posUnlRule->revertToLastCommit();
-  err += negUnlRule->revertToLastCommit();
-  err += posStfDegr->revertToLastCommit();
-  err += negStfDegr->revertToLastCommit();
-  err += posStrDegr->revertToLastCommit();
-  err += negStrDegr->revertToLastCommit();
+  err += posUnlRule.revertToLastCommit();
+  err += negUnlRule.revertToLastCommit();
+  err += posStfDegr.revertToLastCommit();
+  err += negStfDegr.revertToLastCommit();
+  err += posStrDegr.revertToLastCommit();
+  err += negStrDegr.revertToLastCommit();
   
   return err;
 }
@@ -916,15 +944,17 @@ OOHystereticMaterial::revertToStart(void)
   Ttangent = E1p;
   
   firstIter = true;
+
+  this->setLimits();
   
   int err = 0;
   
-  err += posUnlRule->revertToStart();
-  err += negUnlRule->revertToStart();
-  err += posStfDegr->revertToStart();
-  err += negStfDegr->revertToStart();
-  err += posStrDegr->revertToStart();
-  err += negStrDegr->revertToStart();
+  err += posUnlRule.revertToStart();
+  err += negUnlRule.revertToStart();
+  err += posStfDegr.revertToStart();
+  err += negStfDegr.revertToStart();
+  err += posStrDegr.revertToStart();
+  err += negStrDegr.revertToStart();
   
   return err;
 }
@@ -952,6 +982,7 @@ OOHystereticMaterial::getCopy(void)
   theCopy->Cstrain = Cstrain;
   
   theCopy->Ttangent = Ttangent;
+  theCopy->setLimits();
   
   return theCopy;
 }
@@ -979,6 +1010,7 @@ OOHystereticMaterial::getCopy(SectionForceDeformation *s)
   theCopy->Cstrain = Cstrain;
   
   theCopy->Ttangent = Ttangent;
+  theCopy->setLimits();
   
   return theCopy;
 }
@@ -1041,12 +1073,12 @@ OOHystereticMaterial::sendSelf(int commitTag, Channel &theChannel)
   ID idata(1 + 2*8 + 6);
   idata(0) = this->getTag();
 
-  idata(17) = posUnlRuleID;
-  idata(18) = negUnlRuleID;
-  idata(19) = posStfDegrID;
-  idata(20) = negStfDegrID;
-  idata(21) = posStrDegrID;
-  idata(22) = negStrDegrID;    
+  idata(17) = posUnlRule.getMeasureID();
+  idata(18) = negUnlRule.getMeasureID();
+  idata(19) = posStfDegr.getMeasureID();
+  idata(20) = negStfDegr.getMeasureID();
+  idata(21) = posStrDegr.getMeasureID();
+  idata(22) = negStrDegr.getMeasureID();    
   
   int tmpdbTag;
 
@@ -1198,12 +1230,12 @@ OOHystereticMaterial::recvSelf(int commitTag, Channel &theChannel,
 
   this->setTag(idata(0));
 
-  posUnlRuleID = idata(17);
-  negUnlRuleID = idata(18);
-  posStfDegrID = idata(19);
-  negStfDegrID = idata(20);
-  posStrDegrID = idata(21);
-  negStrDegrID = idata(22);    
+  posUnlRule.setMeasureID(idata(17));
+  negUnlRule.setMeasureID(idata(18));
+  posStfDegr.setMeasureID(idata(19));
+  negStfDegr.setMeasureID(idata(20));
+  posStrDegr.setMeasureID(idata(21));
+  negStrDegr.setMeasureID(idata(22));
   
   int tmpdbTag;
   int tmpClassTag;
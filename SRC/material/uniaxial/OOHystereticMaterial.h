@@ -36,6 +36,7 @@
 #define OOHystereticMaterial_h
 
 #include <UniaxialMaterial.h>
+#include <DegradationRule.h>
 
 class HystereticBackbone;
 class StiffnessDegradation;
@@ -69,6 +70,7 @@ class OOHystereticMaterial : public UniaxialMaterial
   const char *getClassType(void) const {return "OOHystereticMaterial";}
 
   int setTrialStrain(double strain, double strainRate = 0.0);
+  int setTrial(double strain, double &stress, double &tangent, double strainRate = 0.0);
   double getStrain(void);
   double getStress(void);
   double getTangent(void);
@@ -120,30 +122,27 @@ class OOHystereticMaterial : public UniaxialMaterial
   
   // Yield strains
   double rot1p, rot1n;
+
+  // Release points of the committed unloading branches
+  double rotlimPos, rotlimNeg;
   
   // Unloading from positive backbone
-  UnloadingRule *posUnlRule;
-  int posUnlRuleID;
+  OpenSees::DegradationRule<UnloadingRule> posUnlRule;
   
   // Unloading from negative backbone
-  UnloadingRule *negUnlRule;
-  int negUnlRuleID;
+  OpenSees::DegradationRule<UnloadingRule> negUnlRule;
   
   // Stiffness degradation of positive backbone
-  StiffnessDegradation *posStfDegr;
-  int posStfDegrID;
+  OpenSees::DegradationRule<StiffnessDegradation> posStfDegr;
 
   // Stiffness degradation of negative backbone
-  StiffnessDegradation *negStfDegr;
-  int negStfDegrID;
+  OpenSees::DegradationRule<StiffnessDegradation> negStfDegr;
   
   // Strength degradation of positive backbone
-  StrengthDegradation *posStrDegr;
-  int posStrDegrID;
+  OpenSees::DegradationRule<StrengthDegradation> posStrDegr;
   
   // Strength degradation of negative backbone
-  StrengthDegradation *negStrDegr;
-  int negStrDegrID;
+  OpenSees::DegradationRule<StrengthDegradation> negStrDegr;
   
   // Trial history variables
   double TrotMax;
@@ -176,6 +175,8 @@ class OOHystereticMaterial : public UniaxialMaterial
   
   void positiveIncrement(double dStrain);
   void negativeIncrement(double dStrain);
+  void setLimits(void);
+  double getMeasure(int varID);
   
   bool firstIter;
 };
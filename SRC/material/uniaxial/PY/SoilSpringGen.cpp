@@ -0,0 +1,517 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: Generation of PySimple1, TzSimple1 and QzSimple1 springs
+// from a layered soil profile. The capacity relations follow
+// PySimple1Gen and TzSimple1Gen (Scott Brandenberg).
+//
+#include "SoilSpringGen.h"
+#include <PySimple1.h>
+#include <TzSimple1.h>
+#include <QzSimple1.h>
+#include <classTags.h>
+#include <OPS_Globals.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+
+namespace OpenSees {
+
+static constexpr double deg = M_PI/180.0;
+
+// number of sublayers used to integrate capacities over a tributary length
+static constexpr int NumSublayers = 10;
+
+static inline double
+linterp(double x1, double x2, double y1, double y2, double x3)
+{
+  return y1 + (x3 - x1)*(y2 - y1)/(x2 - x1);
+}
+
+
+SoilProfile::SoilProfile()
+{
+
+}
+
+int
+SoilProfile::setLayers(int n, const double *ztop, const double *zbot,
+                       const int *type, const int *curve)
+{
+  if (n <= 0)
+    return -1;
+
+  for (int i = 0; i < n; i++) {
+    if (ztop[i] < zbot[i] || (i > 0 && ztop[i] > zbot[i-1])) {
+      opserr << "SoilProfile - layers must be ordered from the top down\n";
+      return -1;
+    }
+    if (type[i] < Clay || type[i] > Specified) {
+      opserr << "SoilProfile - invalid type " << type[i] << " for layer " << i << "\n";
+      return -1;
+    }
+  }
+
+  zt.assign(ztop, ztop + n);
+  zb.assign(zbot, zbot + n);
+  kind.assign(type, type + n);
+  if (curve != nullptr)
+    curves.assign(curve, curve + n);
+  else
+    curves.assign(n, 1);
+
+  for (int f = 0; f < NumFields; f++) {
+    const double init = (f == Multiplier) ? 1.0 : 0.0;
+    values[f][0].assign(n, init);
+    values[f][1].assign(n, init);
+  }
+
+  this->accumulate();
+  return 0;
+}
+
+int
+SoilProfile::setField(Field f, const double *top, const double *bot)
+{
+  if (f < 0 || f >= NumFields || zt.empty())
+    return -1;
+
+  const int n = this->numLayers();
+  values[f][0].assign(top, top + n);
+  values[f][1].assign(bot, bot + n);
+
+  if (f == Gamma)
+    this->accumulate();
+  return 0;
+}
+
+int
+SoilProfile::field(const char *name)
+{
+  static const char* const names[NumFields] = {
+    "gamma", "b", "perimeter", "cu", "e50", "phi", "delta", "ca",
+    "Sr", "ru", "Cd", "c", "pult", "y50", "tult", "z50", "qult", "mp"
+  };
+  for (int f = 0; f < NumFields; f++)
+    if (strcmp(name, names[f]) == 0)
+      return f;
+  return -1;
+}
+
+int
+SoilProfile::read(const char *filename)
+{
+  FILE *file = fopen(filename, "rb");
+  if (file == nullptr) {
+    opserr << "SoilProfile - could not open " << filename << "\n";
+    return -1;
+  }
+
+  int status = -1;
+  int32_t header[2];
+  if (fread(header, sizeof(int32_t), 2, file) == 2 && header[0] > 0
+      && header[1] > 0 && header[1] <= NumFields) {
+
+    const int n  = header[0],
+              nf = header[1];
+    std::vector<int32_t> type(2*n);
+    std::vector<double>  data(2*n + 2*nf*n);
+
+    if (fread(type.data(), sizeof(int32_t), 2*n, file) == std::size_t(2*n) &&
+        fread(data.data(), sizeof(double), data.size(), file) == data.size()) {
+
+      std::vector<int> t(type.begin(), type.begin() + n),
+                       c(type.begin() + n, type.end());
+
+      status = this->setLayers(n, &data[0], &data[n], t.data(), c.data());
+
+      const double *top = &data[2*n],
+                   *bot = top + nf*n;
+      for (int f = 0; f < nf && status == 0; f++)
+        status = this->setField(static_cast<Field>(f), top + f*n, bot + f*n);
+    }
+  }
+
+  if (status != 0)
+    opserr << "SoilProfile - failed to read profile from " << filename << "\n";
+
+  fclose(file);
+  return status;
+}
+
+void
+SoilProfile::accumulate()
+{
+  // Vertical stress at the top of every layer, so that the stress at
+  // an arbitrary elevation only requires the layer that contains it.
+  const int n = this->numLayers();
+  overburden.assign(n, 0.0);
+  for (int i = 1; i < n; i++)
+    overburden[i] = overburden[i-1]
+                  + 0.5*(values[Gamma][0][i-1] + values[Gamma][1][i-1])*(zt[i-1] - zb[i-1]);
+}
+
+int
+SoilProfile::layer(double z) const
+{
+  if (zt.empty() || z > zt.front() || z < zb.back())
+    return -1;
+
+  // first layer whose bottom lies at or below z
+  auto it = std::lower_bound(zb.begin(), zb.end(), z, std::greater<double>());
+  int i = static_cast<int>(it - zb.begin());
+  return (i < this->numLayers() && z <= zt[i]) ? i : -1;
+}
+
+double
+SoilProfile::value(Field f, int i, double z) const
+{
+  if (zt[i] == zb[i])
+    return values[f][0][i];
+  return linterp(zt[i], zb[i], values[f][0][i], values[f][1][i], z);
+}
+
+double
+SoilProfile::stress(double z) const
+{
+  const int i = this->layer(z);
+  if (i < 0)
+    return 0.0;
+
+  return overburden[i] + 0.5*(values[Gamma][0][i] + this->value(Gamma, i, z))*(zt[i] - z);
+}
+
+
+//
+// Capacity relations
+//
+namespace {
+
+struct Point {
+  int    layer;
+  double z, depth, stress;
+};
+
+// API sand (LPile) with the smoothed depth factor of PySimple1Gen
+double
+pultSand(const SoilProfile& soil, const Point& p)
+{
+  if (p.depth == 0.0)
+    return 0.00001;
+
+  const double b     = soil.value(SoilProfile::Diameter, p.layer, p.z),
+               phi   = soil.value(SoilProfile::Phi, p.layer, p.z),
+               alpha = 0.5*phi*deg,
+               beta  = (45.0 + 0.5*phi)*deg,
+               depth = p.depth,
+               Ko    = 0.4,
+               Ka    = pow(tan(45*deg - alpha), 2.0);
+
+  const double pu1 = p.stress*(Ko*depth*tan(phi*deg)*sin(beta)/(tan(beta - phi*deg)*cos(alpha))
+                   + tan(beta)/tan(beta - phi*deg)*(b + depth*tan(beta)*tan(alpha))
+                   + Ko*depth*tan(beta)*(tan(phi*deg)*sin(beta) - tan(alpha)) - Ka*b);
+  const double pu2 = Ka*b*p.stress*(pow(tan(beta), 8.0) - 1.0)
+                   + Ko*b*p.stress*tan(phi*deg)*pow(tan(beta), 4.0);
+
+  const double A = depth < 5*b ? 0.032*pow(5 - depth/b, 2.6) + 0.88 : 0.88;
+
+  return std::min(pu1, pu2)*A;
+}
+
+double
+pult(const SoilProfile& soil, const Point& p)
+{
+  switch (soil.type(p.layer)) {
+    case SoilProfile::Clay: {
+      // Matlock soft clay
+      const double b  = soil.value(SoilProfile::Diameter, p.layer, p.z),
+                   cu = soil.value(SoilProfile::Cu, p.layer, p.z);
+      return std::min(3 + p.stress/cu + 0.5/b*p.depth, 9.0)*cu*b;
+    }
+    case SoilProfile::Sand:
+      return pultSand(soil, p);
+
+    case SoilProfile::LiquefiedSand: {
+      if (p.depth == 0.0)
+        return 0.00001;
+      const double b  = soil.value(SoilProfile::Diameter, p.layer, p.z),
+                   sr = soil.value(SoilProfile::Sr, p.layer, p.z),
+                   ru = soil.value(SoilProfile::Ru, p.layer, p.z);
+      return linterp(0.0, 1.0, pultSand(soil, p), 9.0*sr*p.stress*b, ru);
+    }
+    case SoilProfile::Specified:
+    default:
+      return soil.value(SoilProfile::Pult, p.layer, p.z);
+  }
+}
+
+double
+y50(const SoilProfile& soil, const Point& p)
+{
+  switch (soil.type(p.layer)) {
+    case SoilProfile::Clay:
+      return 2.5*soil.value(SoilProfile::Diameter, p.layer, p.z)
+                *soil.value(SoilProfile::E50, p.layer, p.z);
+
+    case SoilProfile::Sand:
+    case SoilProfile::LiquefiedSand: {
+      if (p.depth == 0.0)
+        return 0.00001;
+      // Curve fit of figure 3.29 in Reese et al. (2000); 271.447
+      // converts from pci to kN/m3. Liquefied sand uses the y50 of
+      // the drained sand.
+      const double phi = soil.value(SoilProfile::Phi, p.layer, p.z);
+      const double k = (0.3141*pow(phi,3) - 32.114*pow(phi,2) + 1109.2*phi - 12808)*271.447
+                     * sqrt(p.stress/50.0);
+      return 0.549*pultSand(soil, p)/k/p.depth;
+    }
+    case SoilProfile::Specified:
+    default:
+      return soil.value(SoilProfile::Y50, p.layer, p.z);
+  }
+}
+
+double
+perimeter(const SoilProfile& soil, const Point& p)
+{
+  const double per = soil.value(SoilProfile::Perimeter, p.layer, p.z);
+  return per > 0.0 ? per : M_PI*soil.value(SoilProfile::Diameter, p.layer, p.z);
+}
+
+double
+tult(const SoilProfile& soil, const Point& p)
+{
+  const double per = perimeter(soil, p);
+  switch (soil.type(p.layer)) {
+    case SoilProfile::Clay:
+      return soil.value(SoilProfile::Ca, p.layer, p.z)*per;
+
+    case SoilProfile::Sand:
+      if (p.depth == 0.0)
+        return 0.00001;  // TzSimple1 does not support tult = 0
+      return 0.4*p.stress*tan(soil.value(SoilProfile::Delta, p.layer, p.z)*deg)*per;
+
+    case SoilProfile::LiquefiedSand:
+      return linterp(0.0, 1.0,
+                     0.4*p.stress*tan(soil.value(SoilProfile::Delta, p.layer, p.z)*deg)*per,
+                     soil.value(SoilProfile::Sr, p.layer, p.z)*per*p.stress,
+                     soil.value(SoilProfile::Ru, p.layer, p.z));
+
+    case SoilProfile::Specified:
+    default:
+      return soil.value(SoilProfile::Tult, p.layer, p.z);
+  }
+}
+
+double
+z50(const SoilProfile& soil, const Point& p)
+{
+  if (soil.type(p.layer) == SoilProfile::Specified)
+    return soil.value(SoilProfile::Z50, p.layer, p.z);
+
+  // zult at 0.5% of the diameter of an equivalent circular section
+  return 0.005*perimeter(soil, p)/M_PI/8.0;
+}
+
+int
+curveType(const SoilProfile& soil, int layer)
+{
+  switch (soil.type(layer)) {
+    case SoilProfile::Clay:          return 1;
+    case SoilProfile::Sand:
+    case SoilProfile::LiquefiedSand: return 2;
+    default:                         return soil.curve(layer);
+  }
+}
+
+Point
+locate(const SoilProfile& soil, double z)
+{
+  Point p;
+  p.layer  = soil.layer(z);
+  p.z      = z;
+  p.depth  = soil.top() - z;
+  p.stress = soil.stress(z);
+  return p;
+}
+
+// Tributary coordinates of every node of a pile, clipped to the profile
+void
+tributary(const SoilProfile& soil, const double *z, int n,
+          std::vector<double>& z1, std::vector<double>& z2)
+{
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [z](int a, int b) {return z[a] > z[b];});
+
+  z1.assign(z, z + n);
+  z2.assign(z, z + n);
+  for (int k = 0; k < n; k++) {
+    const int i = order[k];
+    if (k > 0)
+      z1[i] = 0.5*(z[i] + z[order[k-1]]);
+    if (k < n - 1)
+      z2[i] = 0.5*(z[i] + z[order[k+1]]);
+
+    z1[i] = std::min(std::max(z1[i], soil.bottom()), soil.top());
+    z2[i] = std::min(std::max(z2[i], soil.bottom()), soil.top());
+  }
+}
+
+// Integrate a capacity over the tributary length [z1,z2]
+template <typename Capacity>
+double
+integrate(const SoilProfile& soil, double z1, double z2, Capacity capacity)
+{
+  const double dz = (z2 - z1)/NumSublayers,
+               dl = fabs(dz);
+  double sum = 0.0;
+  for (int k = 0; k < NumSublayers; k++) {
+    const Point p = locate(soil, z1 + dz/2.0 + k*dz);
+    if (p.layer < 0)
+      continue;
+    sum += capacity(soil, p)*dl*soil.value(SoilProfile::Multiplier, p.layer, p.z);
+  }
+  return sum;
+}
+
+} // namespace
+
+
+int
+PyParameters(const SoilProfile& soil, const double *z, int n,
+             int *soilType, double *pu, double *y, double *drag, double *dashpot)
+{
+  std::vector<double> z1, z2;
+  tributary(soil, z, n, z1, z2);
+
+  for (int i = 0; i < n; i++) {
+    const Point p = locate(soil, z[i]);
+    if (p.layer < 0) {
+      opserr << "PyParameters - elevation " << z[i] << " lies outside the soil profile\n";
+      return -1;
+    }
+    soilType[i] = curveType(soil, p.layer);
+    y[i]        = y50(soil, p);
+    drag[i]     = soil.value(SoilProfile::Drag, p.layer, p.z);
+    dashpot[i]  = soil.value(SoilProfile::Dashpot, p.layer, p.z);
+    pu[i]       = integrate(soil, z1[i], z2[i], pult);
+  }
+  return 0;
+}
+
+int
+TzParameters(const SoilProfile& soil, const double *z, int n,
+             int *tzType, double *tu, double *zf, double *dashpot)
+{
+  std::vector<double> z1, z2;
+  tributary(soil, z, n, z1, z2);
+
+  for (int i = 0; i < n; i++) {
+    const Point p = locate(soil, z[i]);
+    if (p.layer < 0) {
+      opserr << "TzParameters - elevation " << z[i] << " lies outside the soil profile\n";
+      return -1;
+    }
+    tzType[i]  = curveType(soil, p.layer);
+    zf[i]      = z50(soil, p);
+    dashpot[i] = soil.value(SoilProfile::Dashpot, p.layer, p.z);
+    tu[i]      = integrate(soil, z1[i], z2[i], tult);
+  }
+  return 0;
+}
+
+int
+QzParameters(const SoilProfile& soil, const double *z, int n,
+             int *qzType, double *qu, double *zf, double *dashpot)
+{
+  for (int i = 0; i < n; i++) {
+    const Point p = locate(soil, z[i]);
+    if (p.layer < 0) {
+      opserr << "QzParameters - elevation " << z[i] << " lies outside the soil profile\n";
+      return -1;
+    }
+
+    const double b    = soil.value(SoilProfile::Diameter, p.layer, p.z),
+                 area = 0.25*M_PI*b*b;
+
+    dashpot[i] = soil.value(SoilProfile::Dashpot, p.layer, p.z);
+
+    switch (soil.type(p.layer)) {
+      case SoilProfile::Clay:
+        // Reese and O'Neill (1987) drilled shafts in clay
+        qzType[i] = 1;
+        qu[i]     = 9.0*soil.value(SoilProfile::Cu, p.layer, p.z)*area;
+        zf[i]     = 0.0125*b;
+        break;
+
+      case SoilProfile::Sand:
+      case SoilProfile::LiquefiedSand: {
+        // Vijayvergiya (1977), with qult reached at 5% of the diameter
+        const double phi = soil.value(SoilProfile::Phi, p.layer, p.z)*deg,
+                     Nq  = exp(M_PI*tan(phi))*pow(tan(M_PI/4.0 + 0.5*phi), 2.0),
+                     ru  = soil.type(p.layer) == SoilProfile::LiquefiedSand
+                         ? soil.value(SoilProfile::Ru, p.layer, p.z) : 0.0;
+        qzType[i] = 2;
+        qu[i]     = std::max(Nq*p.stress*area*(1.0 - ru), 0.00001);
+        zf[i]     = 0.05*b*0.125;
+        break;
+      }
+      case SoilProfile::Specified:
+      default:
+        qzType[i] = soil.curve(p.layer);
+        qu[i]     = soil.value(SoilProfile::Qult, p.layer, p.z);
+        zf[i]     = soil.value(SoilProfile::Z50, p.layer, p.z);
+        break;
+    }
+  }
+  return 0;
+}
+
+
+int
+GenerateSoilSprings(const char *kind, const SoilProfile& soil,
+                    const double *z, int n, int startTag,
+                    std::vector<UniaxialMaterial*>& springs)
+{
+  std::vector<int>    type(n);
+  std::vector<double> ult(n), z50(n), drag(n), dashpot(n);
+
+  springs.reserve(springs.size() + n);
+
+  if (strcmp(kind, "py") == 0 || strcmp(kind, "PySimple1") == 0) {
+    if (PyParameters(soil, z, n, type.data(), ult.data(), z50.data(), drag.data(), dashpot.data()) != 0)
+      return -1;
+    for (int i = 0; i < n; i++)
+      springs.push_back(new PySimple1(startTag + i, MAT_TAG_PySimple1, type[i],
+                                      ult[i], z50[i], drag[i], dashpot[i]));
+  }
+  else if (strcmp(kind, "tz") == 0 || strcmp(kind, "TzSimple1") == 0) {
+    if (TzParameters(soil, z, n, type.data(), ult.data(), z50.data(), dashpot.data()) != 0)
+      return -1;
+    for (int i = 0; i < n; i++)
+      springs.push_back(new TzSimple1(startTag + i, MAT_TAG_TzSimple1, type[i],
+                                      ult[i], z50[i], dashpot[i]));
+  }
+  else if (strcmp(kind, "qz") == 0 || strcmp(kind, "QzSimple1") == 0) {
+    if (QzParameters(soil, z, n, type.data(), ult.data(), z50.data(), dashpot.data()) != 0)
+      return -1;
+    for (int i = 0; i < n; i++)
+      springs.push_back(new QzSimple1(startTag + i, type[i],
+                                      ult[i], z50[i], 0.0, dashpot[i]));
+  }
+  else {
+    opserr << "GenerateSoilSprings - unknown spring type " << kind << "\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+} // namespace OpenSees
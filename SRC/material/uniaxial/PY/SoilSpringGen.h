@@ -0,0 +1,125 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+** ****************************************************************** */
+//
+// Description: Generation of PySimple1, TzSimple1 and QzSimple1 springs
+// from a layered soil profile.
+//
+// This is an array-based counterpart to PySimple1Gen and TzSimple1Gen.
+// The soil profile is held column-wise (one array per property, with
+// values at the top and bottom of every layer) and may be filled
+// directly from arrays or from a binary file. Spring parameters are
+// evaluated for a whole array of elevations at once and the materials
+// are created in memory; no intermediate Tcl files are written.
+//
+// The ultimate capacities are integrated over the tributary length of
+// each spring using the same ten-sublayer rule as PySimple1Gen.
+//
+#ifndef SoilSpringGen_h
+#define SoilSpringGen_h
+
+#include <vector>
+
+class UniaxialMaterial;
+
+namespace OpenSees {
+
+class SoilProfile {
+public:
+  enum Type : int {
+    Clay          = 1,  // py1 / tz1 / qz1
+    Sand          = 2,  // py2 / tz2 / qz2
+    LiquefiedSand = 3,  // py3 / tz3 / qz3
+    Specified     = 4   // py4 / tz4 / qz4; capacities given directly
+  };
+
+  enum Field : int {
+    Gamma,      // effective unit weight
+    Diameter,   // pile diameter b
+    Perimeter,  // pile perimeter; pi*b when not given
+    Cu,         // undrained shear strength
+    E50,        // strain at 50% of the peak deviator stress
+    Phi,        // friction angle (degrees)
+    Delta,      // pile-soil interface friction angle (degrees)
+    Ca,         // pile-soil adhesion
+    Sr,         // residual strength ratio of liquefied sand
+    Ru,         // excess pore pressure ratio
+    Drag,       // PySimple1 drag resistance ratio
+    Dashpot,    // viscous damping coefficient
+    Pult,       // specified capacities, used by Specified layers
+    Y50,
+    Tult,
+    Z50,
+    Qult,
+    Multiplier, // multiplier applied to the integrated capacity
+    NumFields
+  };
+
+  SoilProfile();
+
+  // Layers must be ordered from the top down and must not overlap.
+  // curve gives the PySimple1/TzSimple1/QzSimple1 type used by
+  // Specified layers and may be null.
+  int setLayers(int n, const double *ztop, const double *zbot,
+                const int *type, const int *curve = nullptr);
+  int setField(Field field, const double *top, const double *bot);
+
+  // Read a profile written as
+  //
+  //   int32   numLayers, numFields
+  //   int32   type[numLayers], curve[numLayers]
+  //   double  ztop[numLayers], zbot[numLayers]
+  //   double  top[numFields][numLayers], bot[numFields][numLayers]
+  //
+  int read(const char *filename);
+
+  static int field(const char *name);
+
+  int    numLayers() const {return static_cast<int>(zt.size());}
+  double top()    const {return zt.empty() ? 0.0 : zt.front();}
+  double bottom() const {return zb.empty() ? 0.0 : zb.back();}
+
+  // Index of the layer containing elevation z, or -1
+  int    layer(double z) const;
+  int    type(int i)  const {return kind[i];}
+  int    curve(int i) const {return curves[i];}
+  // Value of a field at elevation z within layer i
+  double value(Field f, int i, double z) const;
+  // Vertical effective stress at elevation z
+  double stress(double z) const;
+
+private:
+  void accumulate();
+
+  std::vector<double> zt, zb;
+  std::vector<int>    kind, curves;
+  std::vector<double> values[NumFields][2];
+  std::vector<double> overburden;    // vertical stress at the top of each layer
+};
+
+
+// Each of the following evaluates the parameters of n springs located
+// at the elevations z. For p-y and t-z springs, z must hold the nodes
+// of a single pile; the tributary length of each node extends half way
+// to its neighbours. Returns 0 on success.
+int PyParameters(const SoilProfile&, const double *z, int n,
+                 int *soilType, double *pult, double *y50,
+                 double *drag, double *dashpot);
+
+int TzParameters(const SoilProfile&, const double *z, int n,
+                 int *tzType, double *tult, double *z50, double *dashpot);
+
+int QzParameters(const SoilProfile&, const double *z, int n,
+                 int *qzType, double *qult, double *z50, double *dashpot);
+
+
+// Create the springs with tags startTag, startTag+1, ...; the caller
+// takes ownership of the materials appended to springs.
+int GenerateSoilSprings(const char *kind, const SoilProfile&,
+                        const double *z, int n, int startTag,
+                        std::vector<UniaxialMaterial*>& springs);
+
+} // namespace OpenSees
+
+#endif // SoilSpringGen_h
@@ -32,6 +32,7 @@
 #include <QzLiq1.h> // Sumeet
 #include <PySimple1Gen.h>
 #include <TzSimple1Gen.h>
+#include <SoilSpringGen.h>
 #include <TimeSeries.h>
 
 #include <BasicModelBuilder.h>
@@ -39,7 +40,9 @@
 #include <tcl.h>
 
 #include <Vector.h>
+#include <G3_Logging.h>
 #include <string.h>
+#include <vector>
 
 
 int seriesTag;
@@ -516,3 +519,166 @@ TclBasicBuilder_addPyTzQzMaterial(ClientData clientData, Tcl_Interp *interp,
 
   return theMaterial;
 }
+
+
+static int
+GetDoubleList(Tcl_Interp *interp, const char *list, std::vector<double>& values)
+{
+  int argc;
+  TCL_Char **argv;
+  if (Tcl_SplitList(interp, list, &argc, &argv) != TCL_OK)
+    return TCL_ERROR;
+
+  values.resize(argc);
+  for (int i = 0; i < argc; i++)
+    if (Tcl_GetDouble(interp, argv[i], &values[i]) != TCL_OK) {
+      Tcl_Free((char *)argv);
+      return TCL_ERROR;
+    }
+
+  Tcl_Free((char *)argv);
+  return TCL_OK;
+}
+
+static int
+GetIntList(Tcl_Interp *interp, const char *list, std::vector<int>& values)
+{
+  std::vector<double> data;
+  if (GetDoubleList(interp, list, data) != TCL_OK)
+    return TCL_ERROR;
+  values.assign(data.begin(), data.end());
+  return TCL_OK;
+}
+
+//
+// soilSprings $kind $startTag -elevation {z...}
+//     (-file $profile | -layers {ztop...} {zbot...} {type...})
+//     <-curve {type...}> <-field $name {top...} {bot...}>...
+//
+// kind is one of py, tz or qz. One material is created for every
+// elevation, with tags starting at startTag; the list of new tags is
+// returned.
+//
+int
+TclCommand_addSoilSprings(ClientData clientData, Tcl_Interp *interp,
+                          int argc, TCL_Char ** const argv)
+{
+  BasicModelBuilder* builder = static_cast<BasicModelBuilder*>(clientData);
+
+  const char *usage = "soilSprings kind? startTag? -elevation {z...} "
+                      "(-file path | -layers {ztop...} {zbot...} {type...}) "
+                      "<-curve {type...}> <-field name {top...} {bot...}>";
+  if (argc < 5) {
+    opserr << G3_ERROR_PROMPT << "insufficient arguments, want: " << usage << "\n";
+    return TCL_ERROR;
+  }
+
+  int startTag;
+  if (Tcl_GetInt(interp, argv[2], &startTag) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "invalid startTag " << argv[2] << "\n";
+    return TCL_ERROR;
+  }
+
+  OpenSees::SoilProfile soil;
+  std::vector<double> z, ztop, zbot;
+  std::vector<int>    type, curve;
+  const char *file = nullptr;
+  struct FieldData {int field; std::vector<double> top, bot;};
+  std::vector<FieldData> fields;
+
+  for (int i = 3; i < argc; i++) {
+    if (strcmp(argv[i], "-elevation") == 0 && i+1 < argc) {
+      if (GetDoubleList(interp, argv[++i], z) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid elevations\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-file") == 0 && i+1 < argc) {
+      file = argv[++i];
+    }
+    else if (strcmp(argv[i], "-layers") == 0 && i+3 < argc) {
+      if (GetDoubleList(interp, argv[i+1], ztop) != TCL_OK ||
+          GetDoubleList(interp, argv[i+2], zbot) != TCL_OK ||
+          GetIntList(interp,    argv[i+3], type) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid layers\n";
+        return TCL_ERROR;
+      }
+      i += 3;
+    }
+    else if (strcmp(argv[i], "-curve") == 0 && i+1 < argc) {
+      if (GetIntList(interp, argv[++i], curve) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid curve types\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-field") == 0 && i+3 < argc) {
+      FieldData data;
+      data.field = OpenSees::SoilProfile::field(argv[i+1]);
+      if (data.field < 0) {
+        opserr << G3_ERROR_PROMPT << "unknown soil property " << argv[i+1] << "\n";
+        return TCL_ERROR;
+      }
+      if (GetDoubleList(interp, argv[i+2], data.top) != TCL_OK ||
+          GetDoubleList(interp, argv[i+3], data.bot) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid values for " << argv[i+1] << "\n";
+        return TCL_ERROR;
+      }
+      fields.push_back(std::move(data));
+      i += 3;
+    }
+    else {
+      opserr << G3_ERROR_PROMPT << "unexpected argument " << argv[i] << ", want: " << usage << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  if (file != nullptr) {
+    if (soil.read(file) != 0)
+      return TCL_ERROR;
+  }
+  else {
+    const std::size_t n = ztop.size();
+    if (n == 0 || zbot.size() != n || type.size() != n
+        || (!curve.empty() && curve.size() != n)) {
+      opserr << G3_ERROR_PROMPT << "inconsistent layer data\n";
+      return TCL_ERROR;
+    }
+    if (soil.setLayers(n, ztop.data(), zbot.data(), type.data(),
+                       curve.empty() ? nullptr : curve.data()) != 0)
+      return TCL_ERROR;
+  }
+
+  for (const FieldData& data : fields) {
+    if (data.top.size() != std::size_t(soil.numLayers()) ||
+        data.bot.size() != std::size_t(soil.numLayers())) {
+      opserr << G3_ERROR_PROMPT << "soil property requires one value per layer\n";
+      return TCL_ERROR;
+    }
+    soil.setField(static_cast<OpenSees::SoilProfile::Field>(data.field),
+                  data.top.data(), data.bot.data());
+  }
+
+  if (z.empty()) {
+    opserr << G3_ERROR_PROMPT << "no elevations given, want: " << usage << "\n";
+    return TCL_ERROR;
+  }
+
+  std::vector<UniaxialMaterial*> springs;
+  if (OpenSees::GenerateSoilSprings(argv[1], soil, z.data(), z.size(), startTag, springs) != 0)
+    return TCL_ERROR;
+
+  Tcl_Obj *tags = Tcl_NewListObj(0, nullptr);
+  for (std::size_t i = 0; i < springs.size(); i++) {
+    if (builder->addTaggedObject<UniaxialMaterial>(*springs[i]) != TCL_OK) {
+      opserr << G3_ERROR_PROMPT << "could not add uniaxialMaterial "
+             << springs[i]->getTag() << " to the model builder\n";
+      for (std::size_t j = i; j < springs.size(); j++)
+        delete springs[j];
+      return TCL_ERROR;
+    }
+    Tcl_ListObjAppendElement(interp, tags, Tcl_NewIntObj(springs[i]->getTag()));
+  }
+
+  Tcl_SetObjResult(interp, tags);
+  return TCL_OK;
+}
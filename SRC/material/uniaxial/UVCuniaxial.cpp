@@ -13,6 +13,7 @@
 
 #include <elementAPI.h>
 #include <OPS_Globals.h>
+#include <Log.h>
 
 
 
@@ -290,9 +291,10 @@ void UVCuniaxial::returnMapping(double strainIncrement) {
 
   // Warn the user if the algorithm did not converge
   if (iterationNumber == MAXIMUM_ITERATIONS - 1) {
-    opserr << "WARNING: return mapping in UVCuniaxial does not converge!" << endln;
-    opserr << "\tStrain increment = " << strainIncrement << endln;
-    opserr << "\tExiting with phi = " << phi << " > " << RETURN_MAP_TOL << endln;
+    OPS_LOG(OpenSees::Log::Warning, "material",
+            "return mapping in UVCuniaxial does not converge!\n"
+            "\tStrain increment = %g\n"
+            "\tExiting with phi = %g > %g", strainIncrement, phi, RETURN_MAP_TOL);
   }
 
   // Condition for plastic loading is whether or not iterations were performed
@@ -51,6 +51,7 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
+#include <Log.h>
 
 #define OPS_Export 
 #define PI 3.14159265358979323846
@@ -463,7 +464,8 @@ void ConfinedConcrete01::bglModel(std::vector<double> semiLength, double & epscu
 		  } while (fabs(DEc) > tol && iter < maxNumIter);
 
 		  if (iter == maxNumIter) {
-			  printf("WARNING: Does not converge with specified maximum number of iterations.\n");
+			  OPS_LOG(OpenSees::Log::Warning, "material",
+			          "ConfinedConcrete01 - does not converge with specified maximum number of iterations");
 		  }
 		  totalIter += iter;
 // -----In the next iteration Ec^(k+1)=E*c^k
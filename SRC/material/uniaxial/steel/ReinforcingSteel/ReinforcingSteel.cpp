@@ -47,6 +47,7 @@
 #endif
 
 #include <elementAPI.h>
+#include <Log.h>
 
 void * OPS_ADD_RUNTIME_VPV(OPS_ReinforcingSteel)
 {
@@ -958,7 +959,7 @@ ReinforcingSteel::SetMP()
                     converged = true;
             }
             if (numIter >= maxIter) {
-                opserr << "WARNING: ReinforcingSteel::SetMP() - did not converge finding a\n";
+                OPS_LOG(OpenSees::Log::Warning, "material", "ReinforcingSteel::SetMP() - did not converge finding a");
                 return -1;
             }
 
@@ -983,7 +984,7 @@ ReinforcingSteel::SetMP()
                     converged = true;
             }
             if (numIter >= maxIter) {
-                opserr << "WARNING: ReinforcingSteel::SetMP() - did not converge finding ao\n";
+                OPS_LOG(OpenSees::Log::Warning, "material", "ReinforcingSteel::SetMP() - did not converge finding ao");
                 return -2;
             }
             if (ao >= 1.0)
@@ -1015,7 +1016,7 @@ ReinforcingSteel::SetMP()
                     converged = true;
             }
             if (numIter >= maxIter) {
-                opserr << "WARNING: ReinforcingSteel::SetMP() - did not converge finding da and ao\n";
+                OPS_LOG(OpenSees::Log::Warning, "material", "ReinforcingSteel::SetMP() - did not converge finding da and ao");
                 da = da / 100.0;
                 ao = ao_last;
                 ao = ao - 2 * MPfunc(ao)*da / (MPfunc(ao + da) - MPfunc(ao - da));
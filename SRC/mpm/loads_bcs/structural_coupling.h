@@ -0,0 +1,85 @@
+#ifndef MPM_STRUCTURAL_COUPLING_H_
+#define MPM_STRUCTURAL_COUPLING_H_
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <Eigen/Dense>
+#ifdef USE_MPI
+#include "ReductionMPI.h"
+#endif
+
+#include "logger.h"
+#include "mesh.h"
+
+namespace mpm {
+
+//! StructuralCoupling class to couple mesh nodes to a structural model
+//! \brief Exchange velocities and forces with structural nodes
+//! \details Each coupled mesh node follows the velocity of a structural
+//! node, which is imposed through acceleration constraints that are
+//! updated at every step from the velocity mapped to the node, so that the
+//! node reaches the structural velocity at the end of the step. The
+//! reaction of the constraint is the force of the material on the
+//! structure, which is accumulated over the steps until it is taken.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class StructuralCoupling {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Constructor
+  //! \param[in] node_ids Ids of the coupled mesh nodes
+  StructuralCoupling(const std::vector<mpm::Index>& node_ids);
+
+  //! Number of coupled nodes
+  unsigned size() const { return node_ids_.size(); }
+
+  //! Assign acceleration constraints to the coupled nodes
+  //! \param[in] mesh Mesh of the analysis
+  bool initialise(const std::shared_ptr<mpm::Mesh<Tdim>>& mesh);
+
+  //! Assign the velocity of the structure at a coupled node
+  //! \param[in] i Index of the coupled node
+  //! \param[in] velocity Velocity of the structural node
+  void assign_velocity(unsigned i, const VectorDim& velocity) {
+    velocity_.at(i) = velocity;
+  }
+
+  //! Update the constraints for the velocities of the structure and
+  //! accumulate their reactions, after the nodal forces of a step are
+  //! computed
+  //! \param[in] dt Time step size
+  //! \param[in] phase Index corresponding to the phase
+  void apply_constraints(double dt, unsigned phase);
+
+  //! Return the force of the material on the structure at each coupled
+  //! node, averaged over the steps since the last call, and restart the
+  //! accumulation; the forces are summed over the MPI ranks
+  std::vector<VectorDim> take_forces();
+
+ private:
+  //! Coupled mesh node ids
+  std::vector<mpm::Index> node_ids_;
+  //! Coupled mesh nodes
+  std::vector<std::shared_ptr<mpm::NodeBase<Tdim>>> nodes_;
+  //! Velocity of the structure at each coupled node
+  std::vector<VectorDim> velocity_;
+  //! Accumulated force on the structure at each coupled node
+  std::vector<VectorDim> force_;
+  //! Forces of the last call to take_forces
+  std::vector<VectorDim> average_;
+  //! Number of steps accumulated
+  unsigned nsteps_{0};
+  //! MPI rank
+  int mpi_rank_{0};
+  //! Logger
+  std::unique_ptr<spdlog::logger> console_;
+};  // StructuralCoupling class
+}  // namespace mpm
+
+#include "structural_coupling.tcc"
+
+#endif  // MPM_STRUCTURAL_COUPLING_H_
@@ -0,0 +1,96 @@
+//! Constructor
+template <unsigned Tdim>
+mpm::StructuralCoupling<Tdim>::StructuralCoupling(
+    const std::vector<mpm::Index>& node_ids)
+    : node_ids_{node_ids} {
+  velocity_.resize(node_ids_.size(), VectorDim::Zero());
+  force_.resize(node_ids_.size(), VectorDim::Zero());
+  average_.resize(node_ids_.size(), VectorDim::Zero());
+  console_ =
+      std::make_unique<spdlog::logger>("StructuralCoupling", mpm::stdout_sink);
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_);
+#endif
+}
+
+//! Assign acceleration constraints to the coupled nodes
+template <unsigned Tdim>
+bool mpm::StructuralCoupling<Tdim>::initialise(
+    const std::shared_ptr<mpm::Mesh<Tdim>>& mesh) {
+  bool status = true;
+  try {
+    nodes_.clear();
+    for (const auto node_id : node_ids_) {
+      auto node = mesh->node(node_id);
+      if (node == nullptr)
+        throw std::runtime_error("Coupled node " + std::to_string(node_id) +
+                                 " is not in the mesh");
+      // The constraints are updated at every step
+      for (unsigned dir = 0; dir < Tdim; ++dir)
+        if (!node->assign_acceleration_constraint(dir, 0.))
+          throw std::runtime_error(
+              "Failed to assign coupling constraint at node " +
+              std::to_string(node_id));
+      nodes_.emplace_back(node);
+    }
+  } catch (std::exception& exception) {
+    console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
+    status = false;
+  }
+  return status;
+}
+
+//! Update the constraints and accumulate their reactions
+template <unsigned Tdim>
+void mpm::StructuralCoupling<Tdim>::apply_constraints(double dt,
+                                                      unsigned phase) {
+  const double tolerance = 1.0E-15;
+  for (unsigned i = 0; i < nodes_.size(); ++i) {
+    const auto& node = nodes_[i];
+    const double mass = node->mass(phase);
+    if (mass <= tolerance) continue;
+
+    // Acceleration that takes the nodal velocity to that of the structure
+    const VectorDim acceleration =
+        (velocity_[i] - node->velocity(phase)) / dt;
+    for (unsigned dir = 0; dir < Tdim; ++dir)
+      node->update_acceleration_constraint(dir, acceleration(dir));
+
+    // The values at nodes shared by several ranks are complete on each of
+    // them, so the reaction is counted on the lowest of these ranks only
+    const std::set<unsigned> ranks = node->mpi_ranks();
+    const int owner = ranks.empty() ? 0 : static_cast<int>(*ranks.begin());
+    if (owner != mpi_rank_) continue;
+
+    // The material is pushed by the reaction of the constraint, and
+    // pushes the structure by the opposite force
+    const VectorDim reaction = mass * acceleration -
+                               node->external_force(phase) -
+                               node->internal_force(phase);
+    force_[i] -= reaction;
+  }
+  ++nsteps_;
+}
+
+//! Return the averaged forces on the structure
+template <unsigned Tdim>
+std::vector<typename mpm::StructuralCoupling<Tdim>::VectorDim>
+    mpm::StructuralCoupling<Tdim>::take_forces() {
+  // Forces of the last call are kept when no step was taken since
+  if (nsteps_ == 0) return average_;
+
+  for (unsigned i = 0; i < force_.size(); ++i)
+    average_[i] = force_[i] / static_cast<double>(nsteps_);
+
+#ifdef USE_MPI
+  int mpi_size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  if (mpi_size > 1 && !average_.empty())
+    OpenSees::allreduce_sum(average_[0].data(), Tdim * average_.size(),
+                            MPI_COMM_WORLD);
+#endif
+
+  for (auto& force : force_) force.setZero();
+  nsteps_ = 0;
+  return average_;
+}
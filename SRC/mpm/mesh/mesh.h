@@ -15,6 +15,11 @@
 #ifdef USE_MPI
 #include "mpi.h"
 #endif
+// Reproducible sums over ranks
+#include "Reduction.h"
+#ifdef USE_MPI
+#include "ReductionMPI.h"
+#endif
 // OpenMP
 #ifdef _OPENMP
 #include <omp.h>
@@ -137,44 +137,52 @@ void mpm::Mesh<Tdim>::nodal_halo_exchange(Tgetfunctor getter,
   MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
 
   if (mpi_size > 1) {
-    // Vector of send requests
+    // Send buffers, which must remain valid until the sends complete
+    std::vector<Ttype> send_buffers(nnodes);
     std::vector<MPI_Request> send_requests;
     send_requests.reserve(ncomms_);
 
-    unsigned j = 0;
     // Non-blocking send
     for (unsigned i = 0; i < nnodes; ++i) {
-      Ttype property = getter(domain_shared_nodes_[i]);
+      send_buffers[i] = getter(domain_shared_nodes_[i]);
       std::set<unsigned> node_mpi_ranks = domain_shared_nodes_[i]->mpi_ranks();
       for (auto& node_rank : node_mpi_ranks) {
         if (node_rank != mpi_rank) {
-          MPI_Isend(&property, Tnparam, MPI_DOUBLE, node_rank, 0,
-                    MPI_COMM_WORLD, &send_requests[j]);
-          ++j;
+          send_requests.emplace_back();
+          MPI_Isend(&send_buffers[i], Tnparam, MPI_DOUBLE, node_rank, 0,
+                    MPI_COMM_WORLD, &send_requests.back());
         }
       }
     }
 
-    // send complete
-    for (unsigned i = 0; i < ncomms_; ++i)
-      MPI_Wait(&send_requests[i], MPI_STATUS_IGNORE);
-
+    // Contributions of each rank to a node, in the order of the ranks
+    std::vector<Ttype> contributions;
     for (unsigned i = 0; i < nnodes; ++i) {
-      // Get value at current node
-      Ttype property = getter(domain_shared_nodes_[i]);
-
       std::set<unsigned> node_mpi_ranks = domain_shared_nodes_[i]->mpi_ranks();
+      contributions.resize(node_mpi_ranks.size());
       // Receive from all shared ranks
+      unsigned k = 0;
       for (auto& node_rank : node_mpi_ranks) {
-        if (node_rank != mpi_rank) {
-          Ttype value;
-          MPI_Recv(&value, Tnparam, MPI_DOUBLE, node_rank, 0, MPI_COMM_WORLD,
-                   MPI_STATUS_IGNORE);
-          property += value;
-        }
+        if (node_rank != mpi_rank)
+          MPI_Recv(&contributions[k], Tnparam, MPI_DOUBLE, node_rank, 0,
+                   MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        else
+          contributions[k] = send_buffers[i];
+        ++k;
       }
+
+      // Every rank adds the contributions in the same order, so all hold
+      // the same value
+      Ttype property;
+      OpenSees::sum_ordered(
+          reinterpret_cast<const double*>(contributions.data()), k, Tnparam,
+          reinterpret_cast<double*>(&property));
       setter(domain_shared_nodes_[i], property);
     }
+
+    // send complete
+    MPI_Waitall(send_requests.size(), send_requests.data(),
+                MPI_STATUSES_IGNORE);
   }
 }
 
@@ -194,8 +202,10 @@ void mpm::Mesh<Tdim>::nodal_halo_exchange(Tgetfunctor getter,
        nitr != domain_shared_nodes_.cend(); ++nitr)
     prop_get.at((*nitr)->ghost_id()) = getter((*nitr));
 
-  MPI_Allreduce(prop_get.data(), prop_set.data(), nhalo_nodes_ * Tnparam,
-                MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  // Sum in the order selected for the run (see Reduction.h)
+  prop_set = prop_get;
+  OpenSees::allreduce_sum(reinterpret_cast<double*>(prop_set.data()),
+                          nhalo_nodes_ * Tnparam, MPI_COMM_WORLD);
 
 #pragma omp parallel for schedule(runtime)
   for (auto nitr = domain_shared_nodes_.cbegin();
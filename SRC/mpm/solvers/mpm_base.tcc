@@ -51,6 +51,20 @@ mpm::MPMBase<Tdim>::MPMBase(const std::shared_ptr<IO>& io) : mpm::MPM(io) {
     if (analysis_.find("locate_particles") != analysis_.end())
       locate_particles_ = analysis_["locate_particles"].template get<bool>();
 
+    // Summation of nodal values shared between ranks (native/ordered/
+    // compensated); ordered and compensated give reproducible results
+    if (analysis_.find("reduction") != analysis_.end()) {
+      OpenSees::Summation reduction;
+      if (OpenSees::parse_summation(
+              analysis_["reduction"].template get<std::string>().c_str(),
+              reduction))
+        OpenSees::summation() = reduction;
+      else
+        console_->warn("{} #{}: Reduction type is not supported, using {}",
+                       __FILE__, __LINE__,
+                       OpenSees::summation_name(OpenSees::summation()));
+    }
+
     // Stress rate method (None/Jaumann)
     try {
       if (analysis_.find("stress_rate") != analysis_.end()) {
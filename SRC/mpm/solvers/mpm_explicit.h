@@ -6,6 +6,7 @@
 #endif
 
 #include "mpm_base.h"
+#include "structural_coupling.h"
 
 namespace mpm {
 
@@ -22,6 +23,31 @@ class MPMExplicit : public MPMBase<Tdim> {
   //! Solve
   bool solve() override;
 
+  //! Initialise the analysis up to the first step
+  bool initialise_analysis();
+
+  //! Solve a single step and advance to the next
+  void solve_step();
+
+  //! Time step size
+  double dt() const { return dt_; }
+
+  //! Current time
+  double time() const { return step_ * dt_; }
+
+  //! Current step
+  mpm::Index step() const { return step_; }
+
+  //! Number of steps
+  mpm::Index nsteps() const { return nsteps_; }
+
+  //! Couple mesh nodes to a structural model, before initialise_analysis
+  //! \param[in] coupling Coupled nodes
+  void structural_coupling(
+      const std::shared_ptr<mpm::StructuralCoupling<Tdim>>& coupling) {
+    coupling_ = coupling;
+  }
+
  protected:
   // Generate a unique id for the analysis
   using mpm::MPMBase<Tdim>::uuid_;
@@ -87,6 +113,10 @@ class MPMExplicit : public MPMBase<Tdim> {
   bool pressure_smoothing_{false};
   //! Interface
   bool interface_{false};
+  //! MPI rank
+  int mpi_rank_{0};
+  //! Coupling to a structural model
+  std::shared_ptr<mpm::StructuralCoupling<Tdim>> coupling_{nullptr};
 
 };  // MPMExplicit class
 }  // namespace mpm
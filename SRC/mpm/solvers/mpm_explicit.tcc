@@ -22,24 +22,35 @@ mpm::MPMExplicit<Tdim>::MPMExplicit(const std::shared_ptr<IO>& io)
 //! MPM Explicit solver
 template <unsigned Tdim>
 bool mpm::MPMExplicit<Tdim>::solve() {
+  bool status = this->initialise_analysis();
+  if (!status) return status;
+
+  auto solver_begin = std::chrono::steady_clock::now();
+  // Main loop
+  while (step_ < nsteps_) this->solve_step();
+
+  auto solver_end = std::chrono::steady_clock::now();
+  console_->info("Rank {}, Explicit {} solver duration: {} ms", mpi_rank_,
+                 mpm_scheme_->scheme(),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     solver_end - solver_begin)
+                     .count());
+
+  return status;
+}
+
+//! Initialise the analysis up to the first step
+template <unsigned Tdim>
+bool mpm::MPMExplicit<Tdim>::initialise_analysis() {
   bool status = true;
 
   console_->info("MPM analysis type {}", io_->analysis_type());
 
-  // Initialise MPI rank and size
-  int mpi_rank = 0;
-  int mpi_size = 1;
-
 #ifdef USE_MPI
   // Get MPI rank
-  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
-  // Get number of MPI ranks
-  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_);
 #endif
 
-  // Phase
-  const unsigned phase = 0;
-
   // Test if checkpoint resume is needed
   bool resume = false;
   if (analysis_.find("resume") != analysis_.end())
@@ -104,83 +115,87 @@ bool mpm::MPMExplicit<Tdim>::solve() {
   // Initialise loading conditions
   this->initialise_loads();
 
+  // Constraints of the nodes coupled to a structural model
+  if (coupling_) status = coupling_->initialise(mesh_);
+
   // Write initial outputs
   if (!resume) this->write_outputs(this->step_);
 
-  auto solver_begin = std::chrono::steady_clock::now();
-  // Main loop
-  for (; step_ < nsteps_; ++step_) {
+  return status;
+}
 
-    if (mpi_rank == 0) console_->info("Step: {} of {}.\n", step_, nsteps_);
+//! Solve a single step and advance to the next
+template <unsigned Tdim>
+void mpm::MPMExplicit<Tdim>::solve_step() {
+  // Phase
+  const unsigned phase = 0;
+
+  if (mpi_rank_ == 0) console_->info("Step: {} of {}.\n", step_, nsteps_);
 
 #ifdef USE_MPI
 #ifdef USE_GRAPH_PARTITIONING
-    // Run load balancer at a specified frequency
-    if (step_ % nload_balance_steps_ == 0 && step_ != 0)
-      this->mpi_domain_decompose(false);
+  // Run load balancer at a specified frequency
+  if (step_ % nload_balance_steps_ == 0 && step_ != 0)
+    this->mpi_domain_decompose(false);
 #endif
 #endif
 
-    // Inject particles
-    mesh_->inject_particles(step_ * dt_);
+  // Inject particles
+  mesh_->inject_particles(step_ * dt_);
 
-    // Initialise nodes, cells and shape functions
-    mpm_scheme_->initialise();
+  // Initialise nodes, cells and shape functions
+  mpm_scheme_->initialise();
 
-    // Initialise nodal properties and append material ids to node
-    contact_->initialise();
+  // Initialise nodal properties and append material ids to node
+  contact_->initialise();
 
-    // Mass momentum and compute velocity at nodes
-    mpm_scheme_->compute_nodal_kinematics(velocity_update_, phase);
+  // Mass momentum and compute velocity at nodes
+  mpm_scheme_->compute_nodal_kinematics(velocity_update_, phase);
 
-    // Map material properties to nodes
-    contact_->compute_contact_forces();
+  // Map material properties to nodes
+  contact_->compute_contact_forces();
 
-    // Update stress first
-    mpm_scheme_->precompute_stress_strain(phase, pressure_smoothing_,
-                                          stress_rate_);
+  // Update stress first
+  mpm_scheme_->precompute_stress_strain(phase, pressure_smoothing_,
+                                        stress_rate_);
 
-    // Compute forces
-    mpm_scheme_->compute_forces(gravity_, phase, step_,
-                                set_node_concentrated_force_);
+  // Compute forces
+  mpm_scheme_->compute_forces(gravity_, phase, step_,
+                              set_node_concentrated_force_);
 
-    // Apply Absorbing Constraint
-    if (absorbing_boundary_) {
-      mpm_scheme_->absorbing_boundary_properties();
-      this->nodal_absorbing_constraints();
-    }
+  // Apply Absorbing Constraint
+  if (absorbing_boundary_) {
+    mpm_scheme_->absorbing_boundary_properties();
+    this->nodal_absorbing_constraints();
+  }
+
+  // Velocities of the structure and forces on it at coupled nodes
+  if (coupling_) coupling_->apply_constraints(dt_, phase);
 
-    // Particle kinematics
-    mpm_scheme_->compute_particle_kinematics(velocity_update_, blending_ratio_,
-                                             phase, "Cundall", damping_factor_,
-                                             step_, update_defgrad_);
+  // Particle kinematics
+  mpm_scheme_->compute_particle_kinematics(velocity_update_, blending_ratio_,
+                                           phase, "Cundall", damping_factor_,
+                                           step_, update_defgrad_);
 
-    // Mass momentum and compute velocity at nodes
-    mpm_scheme_->postcompute_nodal_kinematics(velocity_update_, phase);
+  // Mass momentum and compute velocity at nodes
+  mpm_scheme_->postcompute_nodal_kinematics(velocity_update_, phase);
 
-    // Update Stress Last
-    mpm_scheme_->postcompute_stress_strain(phase, pressure_smoothing_,
-                                           stress_rate_);
+  // Update Stress Last
+  mpm_scheme_->postcompute_stress_strain(phase, pressure_smoothing_,
+                                         stress_rate_);
 
-    // Locate particles
-    mpm_scheme_->locate_particles(this->locate_particles_);
+  // Locate particles
+  mpm_scheme_->locate_particles(this->locate_particles_);
 
 #ifdef USE_MPI
 #ifdef USE_GRAPH_PARTITIONING
-    mesh_->transfer_halo_particles();
-    MPI_Barrier(MPI_COMM_WORLD);
+  mesh_->transfer_halo_particles();
+  MPI_Barrier(MPI_COMM_WORLD);
 #endif
 #endif
 
-    // Write outputs
-    this->write_outputs(this->step_ + 1);
-  }
-  auto solver_end = std::chrono::steady_clock::now();
-  console_->info("Rank {}, Explicit {} solver duration: {} ms", mpi_rank,
-                 mpm_scheme_->scheme(),
-                 std::chrono::duration_cast<std::chrono::milliseconds>(
-                     solver_end - solver_begin)
-                     .count());
+  // Write outputs
+  this->write_outputs(this->step_ + 1);
 
-  return status;
+  ++step_;
 }
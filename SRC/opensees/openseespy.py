@@ -22,7 +22,7 @@ import os
 import json
 from functools import partial
 
-from .tcl import Interpreter, _lift
+from .tcl import Interpreter, InterpreterError, _lift
 
 # something to compare the output of model.analyze to:
 successful = 0
@@ -140,6 +140,21 @@ class OpenSeesPy:
         # Enable OpenSeesPy command behaviors
         self.eval("pragma openseespy")
 
+        # Commands are dispatched directly through the compiled module
+        # when it is available; the module must be imported after the
+        # interpreter has loaded OpenSees (see _lift).
+        self._dispatch = None
+        self._tangent  = None
+        self._residual = None
+        try:
+            from opensees import OpenSeesPyRT
+            interpaddr = self._interp._tcl.interpaddr()
+            self._dispatch = partial(OpenSeesPyRT.invoke,       interpaddr)
+            self._tangent  = partial(OpenSeesPyRT.get_tangent,  interpaddr)
+            self._residual = partial(OpenSeesPyRT.get_residual, interpaddr)
+        except Exception:
+            pass
+
     def _invoke_proc(self, proc_name: str, *args, _final=None, _return_string=False, **kwds)->str:
         """
         Invoke the Interpreter's eval method, calling
@@ -150,7 +165,19 @@ class OpenSeesPy:
         For example, key-word arguments contained in the `kwds`
         dict are converted to a sequence of "-key" and "value"
         strings.
+
+        When possible, arguments are passed to the command directly as
+        typed words, without building and parsing a Tcl script.
         """
+        if self._dispatch is not None and _final is None and self._echo is None:
+            words = _as_obj_args(args, kwds)
+            if words is not None:
+                try:
+                    return self._dispatch(proc_name, words,
+                                          as_list=(proc_name == "eigen"),
+                                          as_string=_return_string)
+                except RuntimeError as e:
+                    raise InterpreterError(str(e)) from None
 
         tcl_args = (_as_str_arg(i) for i in args)
         tcl_kwds = (
@@ -402,6 +429,25 @@ class OpenSeesPy:
         return self._invoke_proc("fiber", *args, **kwds)
         return self._invoke_proc("fiber", *args, "-section", section, **kwds)
 
+    def soilSprings(self, kind: str, tag: int, elevation, layers=None, file=None, curve=None, **fields):
+        """
+        Create p-y, t-z or q-z springs (kind is "py", "tz" or "qz") at
+        the given elevations, with tags starting at tag. The profile is
+        either read from a binary file, or given as layers=(ztop, zbot, type)
+        together with one (top, bottom) pair of arrays for each soil
+        property, e.g. gamma=(gt, gb), cu=(ct, cb), b=(bt, bb).
+        """
+        args = ["-elevation", elevation]
+        if file is not None:
+            args += ["-file", file]
+        if layers is not None:
+            args += ["-layers", *layers]
+        if curve is not None:
+            args += ["-curve", curve]
+        for name, (top, bot) in fields.items():
+            args += ["-field", name, top, bot]
+        return self._invoke_proc("soilSprings", kind, tag, *args)
+
 
 
 class Model:
@@ -430,6 +476,44 @@ class Model:
         """April 2024"""
         return self._openseespy._interp.serialize()
 
+    def asarrays(self):
+        """Return the model as a dict of columnar arrays"""
+        return self._openseespy._interp.serialize_arrays()
+
+    def fromarrays(self, model: dict):
+        """Add nodes, constraints and nodal loads from a dict of columnar arrays"""
+        self._openseespy._interp.deserialize_arrays(model)
+
+    def materialHistory(self, tag, strain, parameters=(), values=None, target=None, threads=0):
+        """
+        Run copies of uniaxialMaterial `tag` through a strain history in
+        native code. Each row of `values` gives the values of `parameters`
+        for one variant, and variants run in parallel on `threads` threads
+        (all available if 0). Returns a dict with "stress", "tangent" and
+        "status" arrays, and the sum of squared differences from `target`
+        as "residual" if a target is given. Materials that keep scratch
+        storage shared by their class must be run with threads=1.
+        """
+        return self._history("uniaxial_history", tag, strain, parameters, values, target, int(threads))
+
+    def sectionHistory(self, tag, deformation, parameters=(), values=None, target=None):
+        """
+        Run copies of section `tag` through a history of section
+        deformations with shape (steps, order); see materialHistory.
+        The variants run one after the other, since many sections return
+        their resultants in storage shared by the class.
+        """
+        return self._history("section_history", tag, deformation, parameters, values, target)
+
+    def _history(self, name, tag, history, parameters, values, target, *args):
+        from opensees import OpenSeesPyRT
+        try:
+            return getattr(OpenSeesPyRT, name)(self._openseespy._interp._tcl.interpaddr(),
+                                               int(tag), history, list(parameters),
+                                               values, target, *args)
+        except (RuntimeError, ValueError) as e:
+            raise InterpreterError(str(e)) from None
+
 
     def element(self, type, tag, *args, **kwds):
         if tag is None:
@@ -450,16 +534,51 @@ class Model:
     def getIterationCount(self):
         return self._openseespy._invoke_proc("numIter")
 
-    def getResidual(self):
+    def getResidual(self, copy=True):
+        """
+        Return the unbalance of the current analysis. When copy is False,
+        and the compiled module is available, the result is a read-only
+        view of the right-hand side of the analysis' linear system, valid
+        until the system changes size or the analysis is wiped.
+        """
         import numpy as np
+        if self._openseespy._residual is not None:
+            try:
+                return self._openseespy._residual(copy=copy)
+            except RuntimeError as e:
+                raise InterpreterError(str(e)) from None
+
         residual_string = self._openseespy._invoke_proc("printB", "-ret", _return_string=True)
         n = sum(1 for _ in _split_iter(residual_string))
         return np.fromiter(map(float, _split_iter(residual_string)), count=n, dtype=float)
 
 
-    def getTangent(self, **kwds):
+    def getTangent(self, sparse=False, **kwds):
+        """
+        Return the tangent of the current analysis; if any of the keywords
+        m, c or k are given, the tangent is formed as m*M + c*C + k*K.
+
+        When the compiled module is available, the tangent is assembled in
+        compressed row storage and, if sparse is True, returned as a
+        scipy.sparse.csr_matrix that shares this storage. Otherwise a dense
+        array is returned.
+        """
         import numpy as np
 
+        if self._openseespy._tangent is not None and set(kwds) <= {"m", "c", "k"}:
+            try:
+                data, indices, indptr, n = self._openseespy._tangent(**kwds)
+            except RuntimeError as e:
+                raise InterpreterError(str(e)) from None
+
+            if sparse:
+                from scipy.sparse import csr_matrix
+                return csr_matrix((data, indices, indptr), shape=(n, n), copy=False)
+
+            A = np.zeros((n, n))
+            A[np.repeat(np.arange(n), np.diff(indptr)), indices] = data
+            return A
+
         tangent_string = self._openseespy._invoke_proc("printA", "-ret", _return_string=True, **kwds)
 
         nn = sum(1 for _ in _split_iter(tangent_string))
@@ -483,6 +602,10 @@ class Model:
             import gc
             del tangent_string
             gc.collect()
+
+        if sparse:
+            from scipy.sparse import csr_matrix
+            return csr_matrix(A)
         return A; #.reshape([int(np.sqrt(len(A)))]*2)
 
     def surface(self, split, element: str=None, args=None, points=None, name=None, kwds=None):
@@ -583,6 +706,78 @@ def _as_str_arg(arg, name: str = None):
 
 
 
+# Strings that Tcl would pass through as a single word unchanged
+_SIMPLE_WORD = re.compile(r"[^\s{}\[\]$\"\\;]+")
+
+def _is_number(arg):
+    # bool is excluded since it is passed as its string
+    return isinstance(arg, (int, float)) and not isinstance(arg, bool) \
+        or type(arg).__module__ == "numpy" and hasattr(arg, "dtype") and arg.ndim == 0
+
+
+def _as_obj_args(args, kwds):
+    """
+    Convert args and kwds to the list of words that _as_str_arg
+    would produce after Tcl parsing, or None if this requires
+    Tcl substitution (strings with white space or special
+    characters, dicts and arbitrary objects).
+
+    A tuple is joined into the script unbraced by _as_str_arg, so
+    its items become separate words; only tuples of numbers and
+    simple strings are converted here, since the str() of a nested
+    tuple or list is not parsed into its items.
+    """
+    words = []
+
+    def add(arg):
+        if isinstance(arg, str):
+            if arg == "":
+                return True
+            if _SIMPLE_WORD.fullmatch(arg) is None:
+                return False
+            words.append(arg)
+
+        elif isinstance(arg, tuple):
+            return all((isinstance(a, str) or isinstance(a, bool) or _is_number(a)) and add(a)
+                       for a in arg)
+
+        elif isinstance(arg, bool) or _is_number(arg):
+            words.append(arg)
+
+        elif isinstance(arg, list) or type(arg).__name__ == "ndarray":
+            if not _is_list(arg):
+                return False
+            words.append(arg)
+
+        else:
+            return False
+        return True
+
+    def _is_list(arg):
+        if type(arg).__name__ == "ndarray":
+            return arg.dtype.kind in "fiu"
+        return all(
+            _is_list(a) if isinstance(a, list) or type(a).__name__ == "ndarray"
+            else (_is_number(a) or isinstance(a, str) and _SIMPLE_WORD.fullmatch(a) is not None)
+            for a in arg
+        )
+
+    for arg in args:
+        if not add(arg):
+            return None
+
+    for key, val in kwds.items():
+        if isinstance(val, bool):
+            if val:
+                words.append(f"-{key.replace('_','-')}")
+        else:
+            words.append(f"-{key}")
+            if not add(val):
+                return None
+
+    return words
+
+
 # The global singleton, for backwards compatibility
 _openseespy = OpenSeesPy()
 
@@ -758,6 +953,15 @@ __all__ = [
     "send",
     "recv",
     "Bcast",
+    "broadcast",
+    "gather",
+    "scatter",
+    "allreduce",
+    "isend",
+    "irecv",
+    "waitRequest",
+    "testRequest",
+    "reduction",
     "frictionModel",
     "computeGradients",
     "sensitivityAlgorithm",
@@ -810,6 +1014,7 @@ __all__ = [
     "strengthControl",
     "unloadingRule",
     "partition",
+    "checkpoint",
     "pressureConstraint",
     "domainCommitTag",
 #   "runFOSMAnalysis",
@@ -185,6 +185,30 @@ class Interpreter:
             os.remove(file)
         return model
 
+    def serialize_arrays(self)->dict:
+        """
+        Return the model as a dict of columnar NumPy arrays, built in
+        memory by the compiled module instead of through a JSON file.
+        See OpenSeesPyRT.get_model for the layout.
+        """
+        from opensees import OpenSeesPyRT
+        try:
+            return OpenSeesPyRT.get_model(self._tcl.interpaddr())
+        except RuntimeError as e:
+            raise InterpreterError(str(e)) from None
+
+    def deserialize_arrays(self, model: dict):
+        """
+        Add the nodes, constraints and nodal loads in a dict with the
+        layout of serialize_arrays to the model. The load patterns that
+        the loads refer to must already exist.
+        """
+        from opensees import OpenSeesPyRT
+        try:
+            OpenSeesPyRT.set_model(self._tcl.interpaddr(), model)
+        except (RuntimeError, ValueError) as e:
+            raise InterpreterError(str(e)) from None
+
     def export(self, *args):
         import io
         import opensees.emit.mesh
@@ -27,6 +27,8 @@ extern "C" {
 
 #include <Channel.h>
 #include <Message.h>
+#include <Profiler.h>
+#include <Log.h>
 
 int Init_OpenSees(Tcl_Interp *interp);
 
@@ -34,13 +36,9 @@ void Init_MachineRuntime(Tcl_Interp* interp, MachineBroker* theMachineBroker);
 
 void Init_Communication(Tcl_Interp* interp, MachineBroker* theMachineBroker);
 
-extern int init_g3_tcl_utils(Tcl_Interp*);
+void Init_DistributedModel(Tcl_Interp* interp, MachineBroker*, FEM_ObjectBroker*);
 
-static int 
-doNothing(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
-{
-  return TCL_OK;
-}
+extern int init_g3_tcl_utils(Tcl_Interp*);
 
 
 extern "C" int 
@@ -72,6 +70,10 @@ Libopenseesmp_Init(Tcl_Interp* interp)
   int pid = theMachineBroker->getPID();
   int np  = theMachineBroker->getNP();
 
+  // profiles and logs are reported per rank
+  OpenSees::Profiler::setRank(pid);
+  OpenSees::Log::setRank(pid);
+
   // TODO: These need to be stored so they can be passed
   // to some SOE constructors
   Channel **theChannels = nullptr;
@@ -161,7 +163,7 @@ Libopenseesmp_Init(Tcl_Interp* interp)
   Init_Communication(interp, theMachineBroker);
   init_g3_tcl_utils(interp);       // Add utility commands (linspace, range, etc.)
 
-  Tcl_CreateCommand(interp, "partition", &doNothing, (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+  Init_DistributedModel(interp, theMachineBroker, theBroker);
 
 
   return 0;
@@ -26,6 +26,8 @@ extern "C" {
 #include <ActorSubdomain.h>
 #include <TclPackageClassBroker.h>
 #include <DomainPartitioner.h>
+#include <Profiler.h>
+#include <Log.h>
 
 #include <mpi.h>
 
@@ -67,6 +69,10 @@ Libopenseessp_Init(Tcl_Interp* interp)
   int pid = theMachineBroker->getPID();
   int np = theMachineBroker->getNP();
 
+  // profiles and logs are reported per rank
+  OpenSees::Profiler::setRank(pid);
+  OpenSees::Log::setRank(pid);
+
   //
   // depending on rank we do something
   //
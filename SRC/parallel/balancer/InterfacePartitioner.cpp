@@ -0,0 +1,538 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Partitions of the element graph that keep constrained
+// nodes together and minimize the interface degrees of freedom.
+//
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include "InterfacePartitioner.h"
+#include <G3_Logging.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <Domain.h>
+#include <Element.h>
+#include <Node.h>
+#include <MP_Constraint.h>
+#include <MP_ConstraintIter.h>
+#include <ID.h>
+
+namespace OpenSees {
+
+// Passes over the groups on the boundary of the parts
+static constexpr int MaxPasses = 20;
+
+namespace {
+
+//
+// The elements of the graph, by vertex, and the nodes they share
+//
+struct ElementGraph {
+  std::vector<Vertex*>          vertices;
+  std::vector<double>           weight;     // of each element
+  std::vector<std::vector<int>> nodes;      // of each element
+  std::vector<std::vector<int>> elements;   // at each node
+  std::vector<int>              dofs;       // of each node
+  std::vector<std::pair<int, int>> constraints; // constrained and retained nodes
+};
+
+}
+
+static void
+build(Domain& domain, Graph& theGraph, ElementGraph& graph)
+{
+  std::map<int, int> index;
+  auto node_index = [&](int tag) {
+    auto [entry, added] = index.insert({tag, static_cast<int>(graph.dofs.size())});
+    if (added) {
+      Node *node = domain.getNode(tag);
+      graph.dofs.push_back(node != nullptr ? node->getNumberDOF() : 0);
+      graph.elements.emplace_back();
+    }
+    return entry->second;
+  };
+
+  VertexIter& theVertices = theGraph.getVertices();
+  Vertex *vertex;
+  while ((vertex = theVertices()) != nullptr) {
+    const int e = static_cast<int>(graph.vertices.size());
+    graph.vertices.push_back(vertex);
+    graph.nodes.emplace_back();
+
+    // elements are weighted by their degrees of freedom
+    double weight = 1.0;
+    Element *element = domain.getElement(vertex->getRef());
+    if (element != nullptr) {
+      const ID& external = element->getExternalNodes();
+      for (int j = 0; j < external.Size(); j++) {
+        const int n = node_index(external(j));
+        std::vector<int>& nodes = graph.nodes[e];
+        if (std::find(nodes.begin(), nodes.end(), n) == nodes.end()) {
+          nodes.push_back(n);
+          graph.elements[n].push_back(e);
+        }
+      }
+      weight = std::max(1, element->getNumDOF());
+    }
+    graph.weight.push_back(weight);
+  }
+
+  // the nodes of every constraint are indexed, also those without
+  // elements, such as the retained node of a diaphragm
+  MP_ConstraintIter& theMPs = domain.getMPs();
+  MP_Constraint *mp;
+  while ((mp = theMPs()) != nullptr)
+    graph.constraints.push_back({node_index(mp->getNodeConstrained()),
+                                 node_index(mp->getNodeRetained())});
+}
+
+//
+// The nodes tied together by the constraints, by the first node of each
+// set; a node without elements, such as the retained node of a diaphragm,
+// ties together the nodes constrained to it
+//
+static std::vector<int>
+tied_nodes(const ElementGraph& graph)
+{
+  std::vector<int> root(graph.dofs.size());
+  std::iota(root.begin(), root.end(), 0);
+
+  auto find = [&](int n) {
+    while (root[n] != n)
+      n = root[n] = root[root[n]];
+    return n;
+  };
+
+  for (const auto& [constrained, retained] : graph.constraints) {
+    const int a = find(constrained), b = find(retained);
+    if (a != b)
+      root[std::max(a, b)] = std::min(a, b);
+  }
+
+  for (std::size_t n = 0; n < root.size(); n++)
+    root[n] = find(static_cast<int>(n));
+  return root;
+}
+
+// The distinct parts of the elements at node n
+static std::vector<int>
+node_parts(const ElementGraph& graph, const std::vector<int>& part, int n)
+{
+  std::vector<int> parts;
+  for (int e : graph.elements[n])
+    parts.push_back(part[e]);
+  std::sort(parts.begin(), parts.end());
+  parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+  return parts;
+}
+
+static void
+measure(const ElementGraph& graph, const std::vector<int>& part, int numParts,
+        PartitionMetrics& metrics)
+{
+  metrics = PartitionMetrics{};
+  metrics.numParts = numParts;
+  metrics.elements.assign(numParts, 0);
+  metrics.nodes.assign(numParts, 0);
+  metrics.dofs.assign(numParts, 0);
+  metrics.weight.assign(numParts, 0.0);
+
+  const int numElements = static_cast<int>(part.size());
+  for (int e = 0; e < numElements; e++) {
+    metrics.elements[part[e]]++;
+    metrics.weight[part[e]] += graph.weight[e];
+  }
+
+  for (std::size_t n = 0; n < graph.dofs.size(); n++) {
+    const std::vector<int> parts = node_parts(graph, part, static_cast<int>(n));
+    for (int p : parts) {
+      metrics.nodes[p]++;
+      metrics.dofs[p] += graph.dofs[n];
+    }
+    if (parts.size() > 1) {
+      metrics.interfaceNodes++;
+      metrics.interfaceDOFs += graph.dofs[n];
+    }
+  }
+
+  // each pair of elements sharing a node is counted once
+  std::vector<int> seen(numElements, -1);
+  for (int e = 0; e < numElements; e++)
+    for (int n : graph.nodes[e])
+      for (int f : graph.elements[n])
+        if (f > e && seen[f] != e) {
+          seen[f] = e;
+          if (part[f] != part[e])
+            metrics.edgeCut++;
+        }
+
+  // a node without elements stands for the nodes tied to it, and is on
+  // the parts that hold elements at all of them
+  const std::vector<int> root = tied_nodes(graph);
+  std::map<int, std::vector<int>> tiedParts;
+  for (std::size_t n = 0; n < root.size(); n++) {
+    if (graph.elements[n].empty())
+      continue;
+    const std::vector<int> parts = node_parts(graph, part, static_cast<int>(n));
+    auto [entry, added] = tiedParts.insert({root[n], parts});
+    if (!added) {
+      std::vector<int> common;
+      std::set_intersection(entry->second.begin(), entry->second.end(),
+                            parts.begin(), parts.end(), std::back_inserter(common));
+      entry->second = common;
+    }
+  }
+
+  auto constraint_parts = [&](int n, std::vector<int>& parts) {
+    if (!graph.elements[n].empty()) {
+      parts = node_parts(graph, part, n);
+      return true;
+    }
+    auto tied = tiedParts.find(root[n]);
+    if (tied == tiedParts.end())
+      return false;
+    parts = tied->second;
+    return true;
+  };
+
+  for (const auto& [constrained, retained] : graph.constraints) {
+    std::vector<int> a, b, common;
+    if (!constraint_parts(constrained, a) || !constraint_parts(retained, b))
+      continue;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+    if (common.empty())
+      metrics.cutConstraints++;
+  }
+
+  const double total = std::accumulate(metrics.weight.begin(), metrics.weight.end(), 0.0);
+  if (total > 0.0)
+    metrics.imbalance = *std::max_element(metrics.weight.begin(), metrics.weight.end())
+                        * numParts / total;
+}
+
+//
+// Bind an element at each of the nodes tied together by the constraints,
+// preferring elements already on a common part, and move each group to
+// the part holding most of its weight, unless this leaves a part without
+// elements; the groups that cannot be moved are left on several parts
+//
+static void
+bind(const ElementGraph& graph, std::vector<int>& part, std::vector<int>& group)
+{
+  const int numElements = static_cast<int>(part.size());
+  group.resize(numElements);
+  std::iota(group.begin(), group.end(), 0);
+
+  auto find = [&](int e) {
+    while (group[e] != e)
+      e = group[e] = group[group[e]];
+    return e;
+  };
+
+  // the element at the first node of each set with elements
+  const std::vector<int> root = tied_nodes(graph);
+  std::map<int, int> anchor;
+  for (std::size_t n = 0; n < root.size(); n++) {
+    const std::vector<int>& at = graph.elements[n];
+    if (at.empty())
+      continue;
+
+    auto [entry, added] = anchor.insert({root[n], at.front()});
+    if (added)
+      continue;
+
+    const int r = entry->second;
+    int c = at.front();
+    for (int e : at)
+      if (part[e] == part[r]) {
+        c = e;
+        break;
+      }
+
+    const int a = find(c), b = find(r);
+    if (a != b)
+      group[std::max(a, b)] = std::min(a, b);
+  }
+
+  std::map<int, std::map<int, double>> load;
+  std::map<int, std::map<int, int>>    members;
+  std::map<int, std::vector<int>>      elements;
+  std::vector<int> count(1 + *std::max_element(part.begin(), part.end()), 0);
+  for (int e = 0; e < numElements; e++) {
+    group[e] = find(e);
+    load[group[e]][part[e]] += graph.weight[e];
+    members[group[e]][part[e]]++;
+    elements[group[e]].push_back(e);
+    count[part[e]]++;
+  }
+
+  for (const auto& [g, parts] : load) {
+    if (parts.size() < 2)
+      continue;
+
+    // the heaviest part that leaves elements on each of the others
+    const std::map<int, int>& on = members[g];
+    int target = -1;
+    for (const auto& [p, w] : parts) {
+      bool keeps = true;
+      for (const auto& [q, k] : on)
+        if (q != p && count[q] == k)
+          keeps = false;
+      if (keeps && (target < 0 || w > parts.at(target)))
+        target = p;
+    }
+
+    // a group that cannot be moved is released, and its constraints
+    // are reported as cut
+    if (target < 0) {
+      for (int e : elements[g])
+        group[e] = e;
+      continue;
+    }
+
+    for (const auto& [q, k] : on) {
+      count[q] -= k;
+      count[target] += k;
+    }
+    for (int e : elements[g])
+      part[e] = target;
+  }
+}
+
+//
+// Move groups on the boundary of the parts to neighboring parts. A move
+// is made if it reduces the interface degrees of freedom, if it relieves
+// a part heavier than the limit, or if it leaves the interface unchanged
+// and brings the two parts closer in weight; no move makes a part
+// heavier than the limit or leaves a part empty. Each move reduces the
+// excess weight, the interface, or the spread of the weights, in that
+// order, so the passes end.
+//
+static void
+improve(const ElementGraph& graph, const std::vector<int>& group,
+        std::vector<int>& part, int numParts, double tolerance)
+{
+  const int numElements = static_cast<int>(part.size());
+
+  // groups in the order of their first element, with their elements,
+  // weights, and the number of their elements at each of their nodes
+  std::vector<int> unit(numElements, -1), first;
+  for (int e = 0; e < numElements; e++)
+    if (group[e] == e) {
+      unit[e] = static_cast<int>(first.size());
+      first.push_back(e);
+    }
+
+  const int numUnits = static_cast<int>(first.size());
+  std::vector<std::vector<int>> members(numUnits);
+  std::vector<double> unitWeight(numUnits, 0.0);
+  for (int e = 0; e < numElements; e++) {
+    const int u = unit[group[e]];
+    members[u].push_back(e);
+    unitWeight[u] += graph.weight[e];
+  }
+
+  std::vector<std::vector<std::pair<int, int>>> unitNodes(numUnits);
+  for (int u = 0; u < numUnits; u++) {
+    std::vector<int> nodes;
+    for (int e : members[u])
+      nodes.insert(nodes.end(), graph.nodes[e].begin(), graph.nodes[e].end());
+    std::sort(nodes.begin(), nodes.end());
+    for (std::size_t i = 0; i < nodes.size(); ) {
+      std::size_t j = i;
+      while (j < nodes.size() && nodes[j] == nodes[i])
+        j++;
+      unitNodes[u].push_back({nodes[i], static_cast<int>(j - i)});
+      i = j;
+    }
+  }
+
+  // the number of elements of each part at each node
+  std::vector<std::map<int, int>> count(graph.dofs.size());
+  for (int e = 0; e < numElements; e++)
+    for (int n : graph.nodes[e])
+      count[n][part[e]]++;
+
+  std::vector<double> weight(numParts, 0.0);
+  std::vector<int>    units(numParts, 0);
+  for (int u = 0; u < numUnits; u++) {
+    weight[part[first[u]]] += unitWeight[u];
+    units[part[first[u]]]++;
+  }
+  const double limit = (1.0 + tolerance)
+                     * std::accumulate(weight.begin(), weight.end(), 0.0) / numParts;
+
+  auto cost = [&](int n, std::size_t numNodeParts) {
+    return numNodeParts > 1 ? graph.dofs[n] : 0;
+  };
+
+  // reduction of the interface degrees of freedom by moving u from a to b
+  auto gain = [&](int u, int a, int b) {
+    int reduction = 0;
+    for (const auto& [n, k] : unitNodes[u]) {
+      const std::map<int, int>& at = count[n];
+      const std::size_t now = at.size();
+      std::size_t moved = now;
+      if (at.at(a) == k)
+        moved--;
+      if (at.find(b) == at.end())
+        moved++;
+      reduction += cost(n, now) - cost(n, moved);
+    }
+    return reduction;
+  };
+
+  for (int pass = 0; pass < MaxPasses; pass++) {
+    int moves = 0;
+    for (int u = 0; u < numUnits; u++) {
+      const int a = part[first[u]];
+      if (units[a] == 1)
+        continue;
+
+      std::vector<int> candidates;
+      for (const auto& [n, k] : unitNodes[u])
+        for (const auto& [p, c] : count[n])
+          if (p != a)
+            candidates.push_back(p);
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+      int best = -1, bestGain = 0;
+      for (int b : candidates) {
+        if (weight[b] + unitWeight[u] > limit)
+          continue;
+        const int g = gain(u, a, b);
+        if (best < 0 || g > bestGain || (g == bestGain && weight[b] < weight[best])) {
+          best = b;
+          bestGain = g;
+        }
+      }
+      if (best < 0)
+        continue;
+
+      if (bestGain > 0 || weight[a] > limit
+          || (bestGain == 0 && weight[a] - weight[best] > unitWeight[u])) {
+        for (int e : members[u]) {
+          for (int n : graph.nodes[e]) {
+            if (--count[n][a] == 0)
+              count[n].erase(a);
+            count[n][best]++;
+          }
+          part[e] = best;
+        }
+        weight[a]    -= unitWeight[u];
+        weight[best] += unitWeight[u];
+        units[a]--;
+        units[best]++;
+        moves++;
+      }
+    }
+    if (moves == 0)
+      break;
+  }
+}
+
+
+InterfacePartitioner::InterfacePartitioner(Domain& domain, GraphPartitioner& initial)
+  : domain(domain), initial(initial), tolerance(0.05), refine(true)
+{
+
+}
+
+int
+InterfacePartitioner::partition(Graph& theGraph, int numParts)
+{
+  parts.clear();
+  if (numParts < 1)
+    return -1;
+
+  ElementGraph graph;
+  build(domain, theGraph, graph);
+
+  const int numElements = static_cast<int>(graph.vertices.size());
+  std::vector<int> part(numElements, 0);
+
+  if (!assignment.empty()) {
+    for (int e = 0; e < numElements; e++) {
+      const int tag = graph.vertices[e]->getRef();
+      auto assigned = assignment.find(tag);
+      if (assigned == assignment.end() || assigned->second < 0 || assigned->second >= numParts) {
+        opserr << G3_ERROR_PROMPT << "element " << tag << " has no part of " << numParts
+               << " in the assignment\n";
+        return -1;
+      }
+      part[e] = assigned->second;
+    }
+    measure(graph, part, numParts, before);
+    after = before;
+  }
+
+  else {
+    if (initial.partition(theGraph, numParts) < 0)
+      return -1;
+
+    // the parts are the colors, from 1
+    for (int e = 0; e < numElements; e++)
+      part[e] = std::min(std::max(graph.vertices[e]->getColor() - 1, 0), numParts - 1);
+
+    measure(graph, part, numParts, before);
+    if (refine) {
+      std::vector<int> group;
+      bind(graph, part, group);
+      improve(graph, group, part, numParts, tolerance);
+    }
+    measure(graph, part, numParts, after);
+  }
+
+  for (int e = 0; e < numElements; e++) {
+    graph.vertices[e]->setColor(part[e] + 1);
+    parts[graph.vertices[e]->getRef()] = part[e];
+  }
+
+  for (int p = 0; p < numParts; p++)
+    if (after.elements[p] == 0)
+      opserr << G3_WARN_PROMPT << "part " << p << " of the model has no elements\n";
+
+  if (after.cutConstraints > 0)
+    opserr << G3_WARN_PROMPT << after.cutConstraints
+           << " MP constraints have no part holding both of their nodes\n";
+
+  return 0;
+}
+
+const PartitionMetrics&
+InterfacePartitioner::getMetrics(bool initial) const
+{
+  return initial ? before : after;
+}
+
+int
+InterfacePartitioner::writeAssignment(const char* filename) const
+{
+  std::ofstream file(filename);
+  for (const auto& [tag, part] : parts)
+    file << tag << " " << part << "\n";
+  file.close();
+  return file ? 0 : -1;
+}
+
+int
+InterfacePartitioner::readAssignment(const char* filename, std::map<int, int>& parts)
+{
+  std::ifstream file(filename);
+  if (!file)
+    return -1;
+
+  parts.clear();
+  int tag, part;
+  while (file >> tag >> part)
+    parts[tag] = part;
+  return file.eof() ? 0 : -1;
+}
+
+} // namespace OpenSees
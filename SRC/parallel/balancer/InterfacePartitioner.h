@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// InterfacePartitioner colors the element graph of a domain for a
+// DomainPartitioner. The graph is first partitioned by another
+// GraphPartitioner (e.g., Metis), which balances the number of elements
+// and minimizes the number of edges cut. The coloring is then adjusted
+// for the domain:
+//
+//   1) The constrained and retained nodes of each MP_Constraint, which
+//      include those of rigid links and diaphragms, are kept on a common
+//      part, by binding an element of each node into one group that is
+//      moved as a whole. A node without elements, such as the retained
+//      node of a diaphragm, binds the nodes constrained to it. A group
+//      that would leave a part without elements is not moved, and its
+//      constraints are reported as cut.
+//
+//   2) Groups on the boundary of the parts are moved to neighboring parts
+//      where this reduces the number of interface degrees of freedom, i.e.,
+//      those of nodes on more than one part, which is the size of the
+//      system that couples the parts; the parts are weighted by the
+//      number of element degrees of freedom and kept within a tolerance
+//      of the mean.
+//
+// Alternatively, the parts may be assigned from a file written by an
+// earlier partition of the same model, so that it can be reused.
+//
+// The quality of the coloring before and after the adjustment is
+// reported by getMetrics.
+//
+#ifndef OpenSees_InterfacePartitioner_h
+#define OpenSees_InterfacePartitioner_h
+
+#include <map>
+#include <vector>
+#include <GraphPartitioner.h>
+
+class Domain;
+class Graph;
+
+namespace OpenSees {
+
+struct PartitionMetrics {
+  int    numParts       = 0;
+  int    edgeCut        = 0;    // pairs of elements sharing a node on different parts
+  int    interfaceNodes = 0;    // nodes on more than one part
+  int    interfaceDOFs  = 0;    // their degrees of freedom, counted once
+  int    cutConstraints = 0;    // MP constraints without a part holding both nodes,
+                                // or the nodes tied to one without elements
+  double imbalance      = 0.0;  // heaviest part relative to the mean
+
+  // for each part
+  std::vector<int>    elements, nodes, dofs;
+  std::vector<double> weight;
+};
+
+
+class InterfacePartitioner : public GraphPartitioner
+{
+public:
+  InterfacePartitioner(Domain& domain, GraphPartitioner& initial);
+
+  // Allowed excess of the heaviest part over the mean, e.g., 0.05
+  void setTolerance(double tol) {tolerance = tol;}
+
+  // Keep the coloring of the initial partitioner
+  void setRefine(bool flag)     {refine = flag;}
+
+  // Assign each element tag to a part, from 0, instead of partitioning
+  void setAssignment(const std::map<int, int>& parts) {assignment = parts;}
+
+  int partition(Graph& theGraph, int numParts);
+
+  // Quality of the initial and final coloring of the last partition
+  const PartitionMetrics& getMetrics(bool initial = false) const;
+
+  // The part of each element in the last partition, by element tag, as
+  // lines of "tag part"
+  int writeAssignment(const char* filename) const;
+  static int readAssignment(const char* filename, std::map<int, int>& parts);
+
+private:
+  Domain&           domain;
+  GraphPartitioner& initial;
+  double tolerance;
+  bool   refine;
+
+  std::map<int, int> assignment;
+  std::map<int, int> parts;      // of the last partition
+  PartitionMetrics   before, after;
+};
+
+} // namespace OpenSees
+
+#endif
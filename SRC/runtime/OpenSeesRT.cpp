@@ -14,6 +14,7 @@
 #include <runtimeAPI.h>
 #include "G3_Runtime.h"
 #include <logging/G3_Logging.h>
+#include <logging/Log.h>
 #include <handler/OPS_Stream.h>
 #include <StandardStream.h>
 #include "commands/strings.cpp"
@@ -77,6 +78,7 @@ Openseesrt_Init(Tcl_Interp *interp)
   if (verbosity != nullptr) {
     if (strcmp(verbosity, "DEBUG") == 0) {
       G3_SetStreamLevel(G3_LevelDebug, true);
+      OpenSees::Log::setLevel(OpenSees::Log::Debug);
     }
   }
 
@@ -14,18 +14,24 @@
 #include <StandardStream.h>
 #include <FileStream.h>
 
+#include <string>
+#include <vector>
+#include <algorithm>
 #include <Matrix.h>
 #include <Domain.h> // for modal damping
 #include <AnalysisModel.h>
+#include <TimeSeries.h>
 
 #include "BasicAnalysisBuilder.h"
+#include "ModalSuperposition.h"
+#include "EventFunction.h"
+#include <threads/thread_pool.hpp>
 
 #include <EigenSOE.h>
 #include <LinearSOE.h>
 // for printA
 #include <FullGenLinLapackSolver.h>
 #include <FullGenLinSOE.h>
-#include <GimmeMCK.h>
 
 #include <LoadControl.h>
 #include <EquiSolnAlgo.h>
@@ -59,8 +65,8 @@ Tcl_CmdProc TclCommand_setNumberer;
 //
 // Add commands to the interpreter that take the AnalysisBuilder as clientData.
 //
-int
-G3_AddTclAnalysisAPI(Tcl_Interp *interp, Domain* domain)
+BasicAnalysisBuilder*
+G3_AddTclAnalysisBuilder(Tcl_Interp *interp, Domain* domain)
 {
 
   BasicAnalysisBuilder *builder = new BasicAnalysisBuilder(domain);
@@ -77,6 +83,13 @@ G3_AddTclAnalysisAPI(Tcl_Interp *interp, Domain* domain)
         tcl_analysis_cmds[i].func, 
         (ClientData) builder, nullptr);
 
+  return builder;
+}
+
+int
+G3_AddTclAnalysisAPI(Tcl_Interp *interp, Domain* domain)
+{
+  G3_AddTclAnalysisBuilder(interp, domain);
   return TCL_OK;
 }
 
@@ -448,6 +461,400 @@ modalDamping(ClientData clientData, Tcl_Interp *interp, int argc,
   return TCL_OK;
 }
 
+//
+// modalHistory dof dt ?options? -node tag dof ... -series tag ... -values {ag ...} ...
+//
+// Integrate the response to uniform base excitation in direction dof by
+// superposition of the modes from the last eigen analysis. Each record
+// is either a TimeSeries sampled every dt, or a list of accelerations
+// spaced dt apart. Returns one list for each record holding the peak
+// relative displacement of each response dof, or its history when
+// -history is given.
+//
+static int
+modalHistory(ClientData clientData, Tcl_Interp *interp, int argc,
+             TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  BasicAnalysisBuilder *builder = (BasicAnalysisBuilder*)clientData;
+  Domain *domain = builder->getDomain();
+
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "want " << argv[0] << " dof dt ?options?\n";
+    return TCL_ERROR;
+  }
+
+  int direction;
+  double dt;
+  if (Tcl_GetInt(interp, argv[1], &direction) != TCL_OK || direction < 1) {
+    opserr << G3_ERROR_PROMPT << "invalid excitation dof " << argv[1] << "\n";
+    return TCL_ERROR;
+  }
+  if (Tcl_GetDouble(interp, argv[2], &dt) != TCL_OK || dt <= 0.0) {
+    opserr << G3_ERROR_PROMPT << "invalid time step " << argv[2] << "\n";
+    return TCL_ERROR;
+  }
+
+  int numModes = 0,
+      numThreads = 1;
+  double scale = 1.0;
+  bool staticCorrection = true,
+       history = false;
+  std::vector<double> damping;
+  std::vector<std::pair<int,int>> responses;
+  std::vector<std::vector<double>> records;
+
+  for (int i = 3; i < argc; i++) {
+    if (strcmp(argv[i], "-modes") == 0) {
+      if (++i == argc || Tcl_GetInt(interp, argv[i], &numModes) != TCL_OK || numModes < 0) {
+        opserr << G3_ERROR_PROMPT << "-modes requires a number of modes\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-threads") == 0) {
+      if (++i == argc || Tcl_GetInt(interp, argv[i], &numThreads) != TCL_OK || numThreads < 1) {
+        opserr << G3_ERROR_PROMPT << "-threads requires a positive integer\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-scale") == 0) {
+      if (++i == argc || Tcl_GetDouble(interp, argv[i], &scale) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-scale requires a factor\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-damp") == 0) {
+      double zeta;
+      while (i + 1 < argc && Tcl_GetDouble(nullptr, argv[i+1], &zeta) == TCL_OK) {
+        damping.push_back(zeta);
+        i++;
+      }
+      if (damping.empty()) {
+        opserr << G3_ERROR_PROMPT << "-damp requires at least one damping ratio\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[i], "-noStatic") == 0)
+      staticCorrection = false;
+
+    else if (strcmp(argv[i], "-history") == 0)
+      history = true;
+
+    else if (strcmp(argv[i], "-node") == 0) {
+      int tag, dof;
+      if (i + 2 >= argc ||
+          Tcl_GetInt(interp, argv[i+1], &tag) != TCL_OK ||
+          Tcl_GetInt(interp, argv[i+2], &dof) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-node requires a node tag and dof\n";
+        return TCL_ERROR;
+      }
+      responses.emplace_back(tag, dof - 1);
+      i += 2;
+    }
+    else if (strcmp(argv[i], "-series") == 0) {
+      G3_Runtime *rt = G3_getRuntime(interp);
+      int tag;
+      while (i + 1 < argc && Tcl_GetInt(nullptr, argv[i+1], &tag) == TCL_OK) {
+        TimeSeries *series = G3_getTimeSeries(rt, tag);
+        if (series == nullptr) {
+          opserr << G3_ERROR_PROMPT << "no TimeSeries with tag " << tag << "\n";
+          return TCL_ERROR;
+        }
+        const int n = static_cast<int>(series->getDuration()/dt + 1.0e-9) + 1;
+        std::vector<double> ag(n);
+        for (int j = 0; j < n; j++)
+          ag[j] = series->getFactor(j*dt);
+        delete series;
+        records.push_back(std::move(ag));
+        i++;
+      }
+    }
+    else if (strcmp(argv[i], "-values") == 0) {
+      int n;
+      Tcl_Obj **items;
+      Tcl_Obj *list = Tcl_NewStringObj(i + 1 < argc ? argv[i+1] : "", -1);
+      Tcl_IncrRefCount(list);
+      if (i + 1 == argc || Tcl_ListObjGetElements(interp, list, &n, &items) != TCL_OK) {
+        Tcl_DecrRefCount(list);
+        opserr << G3_ERROR_PROMPT << "-values requires a list of accelerations\n";
+        return TCL_ERROR;
+      }
+      std::vector<double> ag(n);
+      for (int j = 0; j < n; j++) {
+        if (Tcl_GetDoubleFromObj(interp, items[j], &ag[j]) != TCL_OK) {
+          Tcl_DecrRefCount(list);
+          opserr << G3_ERROR_PROMPT << "invalid acceleration at position " << j << "\n";
+          return TCL_ERROR;
+        }
+      }
+      Tcl_DecrRefCount(list);
+      records.push_back(std::move(ag));
+      i++;
+    }
+    else {
+      opserr << G3_ERROR_PROMPT << "unknown option " << argv[i] << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  // Default to the damping ratios given to modalDamping
+  if (damping.empty()) {
+    const Vector *factors = domain->getModalDampingFactors();
+    if (factors != nullptr && factors->Size() > 0)
+      for (int i = 0; i < factors->Size(); i++)
+        damping.push_back((*factors)(i));
+    else
+      damping.push_back(0.0);
+  }
+  if (damping.size() != 1 && numModes == 0)
+    numModes = static_cast<int>(damping.size());
+
+  OpenSees::ModalSuperposition modal(*builder);
+  if (modal.setup(direction - 1, numModes, damping, staticCorrection) != 0)
+    return TCL_ERROR;
+
+  for (const auto& [tag, dof] : responses) {
+    if (modal.addResponse(tag, dof) < 0) {
+      opserr << G3_ERROR_PROMPT << "node " << tag << " has no equation for dof " << dof + 1 << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  //
+  // Integrate the records
+  //
+  const int nr = modal.getNumResponses(),
+            nrec = static_cast<int>(records.size());
+
+  std::vector<std::vector<double>> peaks(nrec, std::vector<double>(nr)),
+                                   histories(nrec);
+  std::vector<int> status(nrec, 0);
+
+  auto run = [&](int k) {
+    std::vector<double> &ag = records[k];
+    for (double &a : ag)
+      a *= scale;
+    const int n = static_cast<int>(ag.size());
+    if (history)
+      histories[k].resize(static_cast<std::size_t>(nr)*n);
+    status[k] = modal.integrate(ag.data(), n, dt, peaks[k].data(),
+                                history ? histories[k].data() : nullptr);
+  };
+
+  if (numThreads > 1 && nrec > 1) {
+    OpenSees::thread_pool pool(std::min(numThreads, nrec));
+    pool.detach_loop<int>(0, nrec, run);
+    pool.wait();
+  } else
+    for (int k = 0; k < nrec; k++)
+      run(k);
+
+  Tcl_Obj *result = Tcl_NewListObj(nrec, nullptr);
+  for (int k = 0; k < nrec; k++) {
+    if (status[k] != 0) {
+      Tcl_DecrRefCount(result);
+      opserr << G3_ERROR_PROMPT << "failed to integrate record " << k + 1 << "\n";
+      return TCL_ERROR;
+    }
+
+    Tcl_Obj *record = Tcl_NewListObj(nr, nullptr);
+    const int n = static_cast<int>(records[k].size());
+    for (int r = 0; r < nr; r++) {
+      if (history) {
+        Tcl_Obj *values = Tcl_NewListObj(n, nullptr);
+        for (int j = 0; j < n; j++)
+          Tcl_ListObjAppendElement(interp, values, Tcl_NewDoubleObj(histories[k][static_cast<std::size_t>(r)*n + j]));
+        Tcl_ListObjAppendElement(interp, record, values);
+      } else
+        Tcl_ListObjAppendElement(interp, record, Tcl_NewDoubleObj(peaks[k][r]));
+    }
+    Tcl_ListObjAppendElement(interp, result, record);
+  }
+  Tcl_SetObjResult(interp, result);
+  return TCL_OK;
+}
+
+//
+// stateEvent node    $tag $node $dof $threshold ?-vel|-accel? ?options?
+// stateEvent gap     $tag $iNode $jNode $dof $gap ?options?
+// stateEvent element $tag $ele $component $threshold ?options? -response $args...
+// stateEvent source  $tag $ele ?options?
+// stateEvent remove  $tag
+// stateEvent tolerance $dt
+// stateEvent growth  $factor
+// stateEvent log     ?-clear?
+// stateEvent stopped
+//
+// where options are -rising, -falling or -either, and -stop to end the
+// analysis when the event is located. Events are located by variable
+// transient analysis, analyze $n $dt $dtMin $dtMax $Jd, which returns 0
+// when a -stop event ends it; stateEvent stopped then returns the time
+// and tag of that event, and an empty list if the analysis ran to its end.
+//
+static int
+specifyEvent(ClientData clientData, Tcl_Interp *interp, int argc,
+             TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  BasicAnalysisBuilder *builder = (BasicAnalysisBuilder*)clientData;
+  using OpenSees::EventFunction;
+
+  if (argc < 2) {
+    opserr << G3_ERROR_PROMPT << "want stateEvent node|gap|element|source|remove|tolerance|growth|log|stopped ...\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "stopped") == 0) {
+    Tcl_Obj *list = Tcl_NewListObj(0, nullptr);
+    if (const auto* event = builder->getStopEvent()) {
+      Tcl_ListObjAppendElement(interp, list, Tcl_NewDoubleObj(event->first));
+      Tcl_ListObjAppendElement(interp, list, Tcl_NewIntObj(event->second));
+    }
+    Tcl_SetObjResult(interp, list);
+    return TCL_OK;
+  }
+
+  if (strcmp(argv[1], "log") == 0) {
+    Tcl_Obj *list = Tcl_NewListObj(0, nullptr);
+    for (const auto& [time, tag] : builder->getEventLog()) {
+      Tcl_Obj *item[2] = {Tcl_NewDoubleObj(time), Tcl_NewIntObj(tag)};
+      Tcl_ListObjAppendElement(interp, list, Tcl_NewListObj(2, item));
+    }
+    if (argc > 2 && strcmp(argv[2], "-clear") == 0)
+      builder->clearEventLog();
+    Tcl_SetObjResult(interp, list);
+    return TCL_OK;
+  }
+
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "stateEvent " << argv[1] << " - not enough arguments\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "tolerance") == 0 || strcmp(argv[1], "growth") == 0) {
+    double value;
+    if (Tcl_GetDouble(interp, argv[2], &value) != TCL_OK || value <= 0.0) {
+      opserr << G3_ERROR_PROMPT << "stateEvent " << argv[1] << " - invalid value " << argv[2] << "\n";
+      return TCL_ERROR;
+    }
+    if (argv[1][0] == 't')
+      builder->setEventTolerance(value);
+    else if (value < 1.0) {
+      opserr << G3_ERROR_PROMPT << "stateEvent growth - factor must be at least 1\n";
+      return TCL_ERROR;
+    } else
+      builder->setEventGrowth(value);
+    return TCL_OK;
+  }
+
+  int tag;
+  if (Tcl_GetInt(interp, argv[2], &tag) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "stateEvent " << argv[1] << " - invalid tag " << argv[2] << "\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "remove") == 0) {
+    if (builder->removeEvent(tag) != 0) {
+      opserr << G3_ERROR_PROMPT << "no event with tag " << tag << "\n";
+      return TCL_ERROR;
+    }
+    return TCL_OK;
+  }
+
+  // Number of integer and floating point arguments after the tag
+  int numInt, numDouble;
+  if (strcmp(argv[1], "node") == 0) {
+    numInt = 2; numDouble = 1;
+  } else if (strcmp(argv[1], "gap") == 0) {
+    numInt = 3; numDouble = 1;
+  } else if (strcmp(argv[1], "element") == 0) {
+    numInt = 2; numDouble = 1;
+  } else if (strcmp(argv[1], "source") == 0) {
+    numInt = 1; numDouble = 0;
+  } else {
+    opserr << G3_ERROR_PROMPT << "unknown event type " << argv[1] << "\n";
+    return TCL_ERROR;
+  }
+
+  if (argc < 3 + numInt + numDouble) {
+    opserr << G3_ERROR_PROMPT << "stateEvent " << argv[1] << " - not enough arguments\n";
+    return TCL_ERROR;
+  }
+
+  int ints[3];
+  double value = 0.0;
+  for (int i = 0; i < numInt; i++)
+    if (Tcl_GetInt(interp, argv[3 + i], &ints[i]) != TCL_OK) {
+      opserr << G3_ERROR_PROMPT << "stateEvent " << argv[1] << " - invalid integer " << argv[3 + i] << "\n";
+      return TCL_ERROR;
+    }
+  if (numDouble > 0 && Tcl_GetDouble(interp, argv[3 + numInt], &value) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "stateEvent " << argv[1] << " - invalid value " << argv[3 + numInt] << "\n";
+    return TCL_ERROR;
+  }
+
+  // Options
+  EventFunction::Direction direction = strcmp(argv[1], "gap") == 0
+                                     ? EventFunction::Falling : EventFunction::Either;
+  OpenSees::NodeEvent::Quantity quantity = OpenSees::NodeEvent::Displacement;
+  bool terminal = false;
+  std::vector<std::string> response;
+
+  for (int i = 3 + numInt + numDouble; i < argc; i++) {
+    if (strcmp(argv[i], "-rising") == 0)
+      direction = EventFunction::Rising;
+    else if (strcmp(argv[i], "-falling") == 0)
+      direction = EventFunction::Falling;
+    else if (strcmp(argv[i], "-either") == 0)
+      direction = EventFunction::Either;
+    else if (strcmp(argv[i], "-stop") == 0)
+      terminal = true;
+    else if (strcmp(argv[i], "-disp") == 0)
+      quantity = OpenSees::NodeEvent::Displacement;
+    else if (strcmp(argv[i], "-vel") == 0)
+      quantity = OpenSees::NodeEvent::Velocity;
+    else if (strcmp(argv[i], "-accel") == 0)
+      quantity = OpenSees::NodeEvent::Acceleration;
+    else if (strcmp(argv[i], "-response") == 0) {
+      response.assign(argv + i + 1, argv + argc);
+      break;
+    }
+    else {
+      opserr << G3_ERROR_PROMPT << "stateEvent " << argv[1] << " - unknown option " << argv[i] << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  EventFunction *event = nullptr;
+  switch (argv[1][0]) {
+    case 'n':
+      event = new OpenSees::NodeEvent(tag, ints[0], ints[1] - 1, value, quantity, direction, terminal);
+      break;
+    case 'g':
+      event = new OpenSees::GapEvent(tag, ints[0], ints[1], ints[2] - 1, value, direction, terminal);
+      break;
+    case 'e':
+      if (response.empty()) {
+        opserr << G3_ERROR_PROMPT << "stateEvent element - -response arguments are required\n";
+        return TCL_ERROR;
+      }
+      event = new OpenSees::ElementEvent(tag, ints[0], response, ints[1] - 1, value, direction, terminal);
+      break;
+    default:
+      event = new OpenSees::SourceEvent(tag, ints[0], direction, terminal);
+      break;
+  }
+
+  // Check the event now so that errors are reported where it is defined
+  if (event->initialize(*builder->getDomain()) != 0) {
+    delete event;
+    return TCL_ERROR;
+  }
+
+  builder->addEvent(event);
+  return TCL_OK;
+}
+
 static int
 resetModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
 {
@@ -517,19 +924,6 @@ printA(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const ar
 
   FileStream outputFile;
   OPS_Stream *output = &opserr;
-  LinearSOE  *oldSOE = builder->getLinearSOE();
-
-
-  // Cant allocate theSolver on stack because theSOE is going to 
-  // delete it
-  FullGenLinLapackSolver *theSolver = new FullGenLinLapackSolver();
-  FullGenLinSOE theSOE(*theSolver);
-
-  builder->set(&theSOE, false);
-  // invoke domainChange which constructs a graph and passes
-  // it to the SOE. Otherwise, getA() returns null
-  builder->domainChanged();
-
 
   bool ret = false;
   double m = 0.0, c = 0.0, k = 0.0;
@@ -585,28 +979,17 @@ printA(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const ar
   //
   // Form the tangent
   //
-  TransientIntegrator *oldint = nullptr;
-
-  // construct integrator here so that it is not
-  // destructed when the `if` scope ends
-  GimmeMCK integrator(m, c, k, 0.0);
-  if (do_mck) {
-    oldint = builder->getTransientIntegrator();
-    builder->set(integrator, false);
-    integrator.formTangent(0);
-    integrator.revertToLastStep();
-  }
-
-  else if (builder->getStaticIntegrator() != nullptr) {
-    builder->getStaticIntegrator()->formTangent();
-    builder->getStaticIntegrator()->revertToLastStep();
-  }
+  // Cant allocate theSolver on stack because theSOE is going to 
+  // delete it
+  FullGenLinLapackSolver *theSolver = new FullGenLinLapackSolver();
+  FullGenLinSOE theSOE(*theSolver);
 
-  else if (builder->getTransientIntegrator() != nullptr) {
-    builder->getTransientIntegrator()->formTangent(0);
-    builder->getTransientIntegrator()->revertToLastStep();
+  const double mck[3] = {m, c, k};
+  if (builder->formTangent(theSOE, do_mck ? mck : nullptr) < 0) {
+    opserr << OpenSees::PromptValueError 
+           << "failed to form the tangent\n";
+    return TCL_ERROR;
   }
-  builder->getDomain()->revertToLastCommit();
 
   const Matrix *A = theSOE.getA();
   if (A == nullptr) {
@@ -648,13 +1031,6 @@ printA(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const ar
     }
   }
 
-  // put the original SOE back.
-  if (oldSOE != nullptr)
-    builder->set(oldSOE, true);
-
-  if (oldint != nullptr)
-    builder->set(*oldint, true);
-
   return res;
 }
 
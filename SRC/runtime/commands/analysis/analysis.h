@@ -22,6 +22,8 @@ static Tcl_CmdProc resetModel;
 static Tcl_CmdProc analyzeModel;
 static Tcl_CmdProc specifyConstraintHandler;
 static Tcl_CmdProc modalDamping;
+static Tcl_CmdProc modalHistory;
+static Tcl_CmdProc specifyEvent;
 
 // commands/analysis/integrator.cpp
 extern Tcl_CmdProc specifyIntegrator;
@@ -66,10 +68,12 @@ struct char_cmd {
     {"analysis",            &specifyAnalysis},
 
     {"analyze",             &analyzeModel},
+    {"stateEvent",          &specifyEvent},
     {"initialize",          &initializeAnalysis},
     {"modalProperties",     &modalProperties},
     {"modalDamping",        &modalDamping},
     {"modalDampingQ",       &modalDamping},
+    {"modalHistory",        &modalHistory},
     {"responseSpectrum",    &responseSpectrum},
     {"printA",              &printA},
     {"printB",              &printB},
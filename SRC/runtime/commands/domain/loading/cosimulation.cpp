@@ -0,0 +1,253 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Co-simulation of the structural model with an explicit
+// material point model of SRC/mpm that runs in the same process:
+//
+//   pattern CoSimulation $tag -mpm $input ?-dir $directory?
+//           -nodes {$node $mpmNode ...} ?-concurrent? ?-factor $f?
+//
+// Each structural node is paired with a node of the background mesh of the
+// material point model, which follows the velocity of the structural node;
+// the force of the material on the mesh node is applied to the structural
+// node (see CoSimulationPattern). The material point model advances with
+// the step of its input file, several times for each step of the
+// structure when it is smaller, and should have steps enough to cover the
+// structural analysis; an exchange past the end of the MPM run fails, and
+// the forces of the last exchange remain applied. With -concurrent, it
+// advances on a separate thread while the structure solves the step.
+//
+// Under MPI, every process holds the structural model and its part of the
+// material point model, and the forces are summed over the processes. The
+// material point model then shares MPI_COMM_WORLD with the structure, so
+// -concurrent is only allowed on a single process.
+//
+#include <tcl.h>
+#include <string.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <BasicModelBuilder.h>
+#include <G3_Logging.h>
+#include <Parsing.h>
+#include <Domain.h>
+#include <Node.h>
+#include <LoadPattern.h>
+#include <CoSimulationPattern.h>
+#include <CoupledSolver.h>
+
+#include "mpm_explicit.h"
+
+namespace {
+
+template <unsigned Tdim>
+class MPMCoupledSolver : public OpenSees::CoupledSolver
+{
+public:
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  MPMCoupledSolver(const std::shared_ptr<mpm::IO>& io, const std::vector<mpm::Index>& ids)
+    : mpm(io),
+      coupling(std::make_shared<mpm::StructuralCoupling<Tdim>>(ids)),
+      forces(ids.size(), VectorDim::Zero())
+  {
+    mpm.structural_coupling(coupling);
+  }
+
+  int initialise() {
+    try {
+      return mpm.initialise_analysis() ? 0 : -1;
+    } catch (std::exception& error) {
+      opserr << G3_ERROR_PROMPT << "failed to initialise the MPM analysis; " << error.what() << "\n";
+      return -1;
+    }
+  }
+
+  int    getNumPoints() const {return static_cast<int>(coupling->size());}
+  int    getNumComponents() const {return Tdim;}
+  double getTime() const {return mpm.time();}
+
+  int setVelocity(int i, const double* velocity) {
+    coupling->assign_velocity(i, Eigen::Map<const VectorDim>(velocity));
+    return 0;
+  }
+
+  int advance(double time) {
+    try {
+      // Stop within half a step of time
+      while (mpm.step() < mpm.nsteps() && mpm.time() + 0.5*mpm.dt() <= time)
+        mpm.solve_step();
+      if (mpm.time() + 0.5*mpm.dt() <= time) {
+        opserr << G3_ERROR_PROMPT << "the MPM analysis ended at time " << mpm.time()
+               << ", before time " << time << "\n";
+        return -1;
+      }
+      forces = coupling->take_forces();
+    } catch (std::exception& error) {
+      opserr << G3_ERROR_PROMPT << "MPM step failed; " << error.what() << "\n";
+      return -1;
+    }
+    return 0;
+  }
+
+  int getForce(int i, double* force) const {
+    Eigen::Map<VectorDim> result(force);
+    result = forces[i];
+    return 0;
+  }
+
+private:
+  mpm::MPMExplicit<Tdim> mpm;
+  std::shared_ptr<mpm::StructuralCoupling<Tdim>> coupling;
+  std::vector<VectorDim> forces;
+};
+
+
+template <unsigned Tdim>
+std::unique_ptr<OpenSees::CoupledSolver>
+create_mpm(const std::string& input, const std::string& directory,
+           const std::vector<mpm::Index>& ids)
+{
+  // The MPM input is read by its command line parser
+  std::vector<std::string> args {"mpm", "-f", directory, "-i", input};
+  std::vector<char*> argv;
+  for (std::string& arg : args)
+    argv.push_back(&arg[0]);
+
+  try {
+    auto io = std::make_shared<mpm::IO>(static_cast<int>(argv.size()), argv.data());
+    if (io->analysis_type().find("MPMExplicit") != 0 ||
+        io->analysis_type().find("TwoPhase") != std::string::npos) {
+      opserr << G3_ERROR_PROMPT << "the MPM analysis must be single phase explicit, not "
+             << io->analysis_type().c_str() << "\n";
+      return nullptr;
+    }
+
+    auto solver = std::make_unique<MPMCoupledSolver<Tdim>>(io, ids);
+    if (solver->initialise() != 0)
+      return nullptr;
+    return solver;
+
+  } catch (std::exception& error) {
+    opserr << G3_ERROR_PROMPT << "failed to create the MPM analysis; " << error.what() << "\n";
+    return nullptr;
+  }
+}
+
+} // namespace
+
+
+LoadPattern *
+TclDispatch_newCoSimulationPattern(ClientData clientData, Tcl_Interp *interp,
+                                   int argc, TCL_Char ** const argv, int tag)
+{
+  BasicModelBuilder *builder = static_cast<BasicModelBuilder*>(clientData);
+
+  std::string input, directory = "./";
+  std::vector<int> nodes;
+  std::vector<mpm::Index> ids;
+  double factor = 1.0;
+  auto exchange = OpenSees::CoSimulationPattern::Exchange::Staggered;
+
+  for (int i = 3; i < argc; i++) {
+    if (strcmp(argv[i], "-mpm") == 0 && i + 1 < argc)
+      input = argv[++i];
+
+    else if (strcmp(argv[i], "-dir") == 0 && i + 1 < argc)
+      directory = argv[++i];
+
+    else if (strcmp(argv[i], "-nodes") == 0 && i + 1 < argc) {
+      int size;
+      TCL_Char **list;
+      if (Tcl_SplitList(interp, argv[++i], &size, &list) != TCL_OK)
+        return nullptr;
+      if (size % 2 != 0) {
+        opserr << G3_ERROR_PROMPT << "-nodes wants pairs of a node and an MPM node\n";
+        Tcl_Free((char *)list);
+        return nullptr;
+      }
+      for (int j = 0; j < size; j += 2) {
+        int node, id;
+        if (Tcl_GetInt(interp, list[j], &node) != TCL_OK ||
+            Tcl_GetInt(interp, list[j+1], &id) != TCL_OK || id < 0) {
+          opserr << G3_ERROR_PROMPT << "invalid node pair " << list[j] << " " << list[j+1] << "\n";
+          Tcl_Free((char *)list);
+          return nullptr;
+        }
+        nodes.push_back(node);
+        ids.push_back(static_cast<mpm::Index>(id));
+      }
+      Tcl_Free((char *)list);
+    }
+
+    else if (strcmp(argv[i], "-concurrent") == 0)
+      exchange = OpenSees::CoSimulationPattern::Exchange::Concurrent;
+
+    else if ((strcmp(argv[i], "-factor") == 0 || strcmp(argv[i], "-fact") == 0) && i + 1 < argc) {
+      if (Tcl_GetDouble(interp, argv[++i], &factor) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid factor " << argv[i] << "\n";
+        return nullptr;
+      }
+    }
+
+    else {
+      opserr << G3_ERROR_PROMPT << "unknown option " << argv[i] << "\n";
+      return nullptr;
+    }
+  }
+
+  if (input.empty() || nodes.empty()) {
+    opserr << G3_ERROR_PROMPT << "want: pattern CoSimulation tag -mpm input "
+           << "-nodes {node mpmNode ...} <-dir directory> <-concurrent> <-factor f>\n";
+    return nullptr;
+  }
+
+  const int ndm = builder->getNDM();
+  Domain *domain = builder->getDomain();
+  for (int tag : nodes) {
+    Node *node = domain->getNode(tag);
+    if (node == nullptr) {
+      opserr << G3_ERROR_PROMPT << "coupled node " << tag << " not found\n";
+      return nullptr;
+    }
+    if (node->getNumberDOF() < ndm) {
+      opserr << G3_ERROR_PROMPT << "coupled node " << tag
+             << " must have a translational dof in each dimension\n";
+      return nullptr;
+    }
+  }
+
+#ifdef USE_MPI
+  // The material point model communicates from its own thread
+  int level;
+  MPI_Query_thread(&level);
+  if (exchange == OpenSees::CoSimulationPattern::Exchange::Concurrent && level < MPI_THREAD_MULTIPLE) {
+    opserr << G3_ERROR_PROMPT << "-concurrent requires MPI initialized with MPI_THREAD_MULTIPLE\n";
+    return nullptr;
+  }
+  // The MPM forces are summed over MPI_COMM_WORLD, which the structural
+  // model also communicates on from the main thread
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  if (exchange == OpenSees::CoSimulationPattern::Exchange::Concurrent && size > 1) {
+    opserr << G3_ERROR_PROMPT << "-concurrent cannot be used on more than one process\n";
+    return nullptr;
+  }
+#endif
+
+  std::unique_ptr<OpenSees::CoupledSolver> solver;
+  if (ndm == 2)
+    solver = create_mpm<2>(input, directory, ids);
+  else if (ndm == 3)
+    solver = create_mpm<3>(input, directory, ids);
+  else
+    opserr << G3_ERROR_PROMPT << "co-simulation needs a model of 2 or 3 dimensions\n";
+
+  if (solver == nullptr)
+    return nullptr;
+
+  return new OpenSees::CoSimulationPattern(tag, std::move(solver), nodes, exchange, factor);
+}
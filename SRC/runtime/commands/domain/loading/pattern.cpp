@@ -68,6 +68,11 @@ extern TimeSeriesIntegrator *TclDispatch_newSeriesIntegrator(ClientData clientDa
 extern TimeSeries *TclSeriesCommand(ClientData clientData, Tcl_Interp *interp,
                                     TCL_Char * const arg);
 
+#ifdef OPS_USE_MPM
+extern LoadPattern *TclDispatch_newCoSimulationPattern(ClientData clientData, Tcl_Interp *interp,
+                                                       int argc, TCL_Char ** const argv, int tag);
+#endif
+
 //
 // This command creates a scope where the following commands
 // behave differently:
@@ -694,6 +699,15 @@ TclCommand_addPattern(ClientData clientData, Tcl_Interp *interp, int argc,
   }    // end else if DRMLoadPattern
 #endif // OPSDEF_DRM
 
+#ifdef OPS_USE_MPM
+  else if (strcmp(argv[1], "CoSimulation") == 0) {
+    thePattern = TclDispatch_newCoSimulationPattern(clientData, interp, argc, argv, patternID);
+    if (thePattern == nullptr)
+      return TCL_ERROR;
+    commandEndMarker = argc;
+  }
+#endif
+
 #ifdef _H5DRM
   else if ((strcmp(argv[1], "H5DRM") == 0) || 
            (strcmp(argv[1], "h5drm") == 0)) {
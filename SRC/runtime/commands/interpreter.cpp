@@ -23,6 +23,11 @@ class ProgressBar;
 Tcl_ObjCmdProc TclObjCommand_progress;
 extern ProgressBar* progress_bar_ptr;
 
+Tcl_ObjCmdProc TclObjCommand_profile;
+Tcl_ObjCmdProc TclObjCommand_logging;
+Tcl_ObjCmdProc TclObjCommand_spectrum;
+int OPS_InitProfile(Tcl_Interp*);
+
 
 const char *getInterpPWD(Tcl_Interp *interp);
 
@@ -393,6 +398,9 @@ Init_OpenSees(Tcl_Interp *interp)
   Tcl_CreateObjCommand(interp, "source",           OPS_SourceCmd, nullptr, nullptr);
   Tcl_CreateObjCommand(interp, "pragma",           TclObjCommand_pragma, nullptr, nullptr);
   Tcl_CreateObjCommand(interp, "progress",         TclObjCommand_progress, (ClientData)&progress_bar_ptr, nullptr);
+  Tcl_CreateObjCommand(interp, "profile",          TclObjCommand_profile, nullptr, nullptr);
+  Tcl_CreateObjCommand(interp, "logging",          TclObjCommand_logging, nullptr, nullptr);
+  Tcl_CreateObjCommand(interp, "spectrum",         TclObjCommand_spectrum, nullptr, nullptr);
 
   //
   static int ncmd = sizeof(InterpreterCommands)/sizeof(char_cmd);
@@ -403,6 +411,7 @@ Init_OpenSees(Tcl_Interp *interp)
         InterpreterCommands[i].func, 
         (ClientData) nullptr, nullptr);
 
+  OPS_InitProfile(interp);
   return TCL_OK;
 }
 
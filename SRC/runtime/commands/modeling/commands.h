@@ -34,6 +34,9 @@ extern Tcl_CmdProc  TclCommand_doBlock3D;
 // uniaxial.cpp
 extern Tcl_CmdProc  TclCommand_addUniaxialMaterial;
 
+// material/uniaxial/PY/commands.cpp
+extern Tcl_CmdProc  TclCommand_addSoilSprings;
+
 // section.cpp
 extern Tcl_CmdProc  TclCommand_addSection;
 extern Tcl_CmdProc  TclCommand_addPatch;
@@ -114,6 +117,7 @@ struct char_cmd {
 // Materials & sections
   {"uniaxialMaterial",     TclCommand_addUniaxialMaterial},
   {"nDMaterial",           TclCommand_addNDMaterial},
+  {"soilSprings",          TclCommand_addSoilSprings},
   {"material",             TclCommand_addMaterial},
   {"beamIntegration",      TclCommand_addBeamIntegration},
 
@@ -114,6 +114,7 @@ SectionTest_setStrainSection(ClientData clientData, Tcl_Interp *interp,
   return TCL_OK;
 }
 
+// Results are printed with enough digits to be read back exactly
 static int
 SectionTest_getStressSection(ClientData clientData, Tcl_Interp *interp,
                                   int argc, TCL_Char ** const argv)
@@ -122,7 +123,7 @@ SectionTest_getStressSection(ClientData clientData, Tcl_Interp *interp,
   const Vector &stress = theSection->getStressResultant();
   for (int i = 0; i < stress.Size(); ++i) {
     char buffer[40];
-    sprintf(buffer, "%.10e ", stress(i));
+    sprintf(buffer, "%.17g ", stress(i));
     Tcl_AppendResult(interp, buffer, NULL);
   }
   return TCL_OK;
@@ -138,7 +139,7 @@ SectionTest_getTangSection(ClientData clientData, Tcl_Interp *interp,
   for (int i = 0; i < tangent.noRows(); ++i)
     for (int j = 0; j < tangent.noCols(); j++) {
       char buffer[40];
-      sprintf(buffer, "%.10e ", tangent(i, j));
+      sprintf(buffer, "%.17g ", tangent(i, j));
       Tcl_AppendResult(interp, buffer, NULL);
     }
   return TCL_OK;
@@ -169,7 +170,7 @@ SectionTest_getResponseSection(ClientData clientData, Tcl_Interp *interp,
 
   for (int i = 0; i < data.Size(); ++i) {
     char buffer[40];
-    sprintf(buffer, "%.10e ", data(i));
+    sprintf(buffer, "%.17g ", data(i));
     Tcl_AppendResult(interp, buffer, NULL);
   }
 
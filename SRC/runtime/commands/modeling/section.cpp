@@ -81,6 +81,7 @@ extern OPS_Routine OPS_UniaxialSection;
 extern OPS_Routine OPS_ParallelSection;
 extern OPS_Routine OPS_Bidirectional;
 extern OPS_Routine OPS_Elliptical2;
+extern OPS_Routine OPS_ShapeSection2d;
 extern OPS_Routine OPS_ReinforcedConcreteLayeredMembraneSection; // M. J. Nunez - UChile
 extern OPS_Routine OPS_LayeredMembraneSection; // M. J. Nunez - UChile
 
@@ -211,11 +212,20 @@ TclCommand_addSection(ClientData clientData, Tcl_Interp *interp,
       return TCL_ERROR;
   }
 
+  else if (strcmp(argv[1], "Shape2d") == 0 ||
+           strcmp(argv[1], "ShapeSection2d") == 0) {
+    void *theMat = OPS_ShapeSection2d(rt, argc, argv);
+    if (theMat != 0)
+      theSection = (SectionForceDeformation *)theMat;
+    else
+      return TCL_ERROR;
+  }
+
   else if (strcmp(argv[1], "WFSection2d") == 0 ||
            strcmp(argv[1], "WSection2d") == 0) {
 
-      opserr << "WFSection2d has been removed; use the from_aisc utility to "
-             << "generate AISC sections from Python.\n";
+      opserr << "WFSection2d has been removed; use section Shape2d or the from_aisc "
+             << "utility to generate AISC sections from Python.\n";
       return TCL_ERROR;
 #if 0
     void *theMat = OPS_WFSection2d(rt, argc, argv);
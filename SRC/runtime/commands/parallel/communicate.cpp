@@ -1,21 +1,142 @@
-
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Communication commands for parallel interpreters.
+//
+// The send and recv commands exchange strings. The commands below move
+// lists of doubles, which are read from and returned as Tcl double
+// objects without conversion to text:
+//
+//   broadcast ?-root $r? ?$values?
+//   gather    ?-root $r | -all? $values
+//   scatter   ?-root $r? ?{$values ...}?
+//   allreduce ?-op sum|prod|min|max? $values
+//   isend     -pid $p ?-tag $t? $values
+//   irecv     -pid $p|ANY ?-tag $t?
+//   waitRequest $request
+//   testRequest $request
+//   reduction ?native|ordered|compensated?
+//
+// The lists given to gather and scatter may differ in length by rank.
+// A collective fails on every process when it fails on any, e.g. when the
+// root has no values or the processes give different roots.
+// The reduction command selects how sums over processes are formed,
+// both by allreduce and by the analysis (see Reduction.h), and returns
+// the current selection. Making a selection is a collective, which fails
+// on every process unless all select the same summation.
+// These messages use a duplicate of MPI_COMM_WORLD, so they are never
+// matched with those of send and recv or of the analysis.
+//
 #include <tcl.h>
 #include <mpi.h>
 #include <string.h>
+#include <initializer_list>
+#include <map>
+#include <vector>
 #include <Logging.h>
+#include <G3_Logging.h>
 #include <Parsing.h>
 #include <MachineBroker.h>
+#include <ReductionMPI.h>
 
 
 static int opsBarrier(ClientData, Tcl_Interp *, int, TCL_Char ** const argv);
 static int opsSend(ClientData, Tcl_Interp *, int, TCL_Char ** const argv);
 static int opsRecv(ClientData, Tcl_Interp *, int,TCL_Char ** const argv);
 
+static Tcl_ObjCmdProc TclObjCommand_broadcast;
+static Tcl_ObjCmdProc TclObjCommand_gather;
+static Tcl_ObjCmdProc TclObjCommand_scatter;
+static Tcl_ObjCmdProc TclObjCommand_allreduce;
+static Tcl_ObjCmdProc TclObjCommand_isend;
+static Tcl_ObjCmdProc TclObjCommand_irecv;
+static Tcl_ObjCmdProc TclObjCommand_waitRequest;
+static Tcl_ObjCmdProc TclObjCommand_testRequest;
+static Tcl_ObjCmdProc TclObjCommand_reduction;
+
+namespace {
+
+//
+// A pending isend, which holds its buffer until it completes, or irecv.
+// Since the length of a message is not known in advance, a receive is
+// posted once a probe finds its message, either when irecv is called or
+// when the request is first waited on or tested; until then its request
+// is MPI_REQUEST_NULL. Receives that are posted later may therefore take
+// messages that arrive before those of receives still waiting.
+//
+struct Request {
+  bool                send;
+  MPI_Request         request;
+  int                 source, tag;
+  std::vector<double> buffer;
+};
+
+// Shared by the commands below, and freed with the last of them
+struct Communicator {
+  MPI_Comm comm;
+  int      rank, size;
+  int      users = 0;
+  int      nextRequest = 1;
+  std::map<int, Request> requests;
+};
+
+}
+
+static void
+deleteCommunicator(ClientData clientData)
+{
+  Communicator *world = static_cast<Communicator*>(clientData);
+  if (--world->users > 0)
+    return;
+
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (!finalized) {
+    for (auto& [id, request] : world->requests) {
+      if (request.request == MPI_REQUEST_NULL)
+        continue;
+      if (request.send)
+        MPI_Request_free(&request.request);
+      else {
+        // the buffer of a posted receive is released below
+        MPI_Cancel(&request.request);
+        MPI_Wait(&request.request, MPI_STATUS_IGNORE);
+      }
+    }
+    MPI_Comm_free(&world->comm);
+  }
+  delete world;
+}
+
 void Init_Communication(Tcl_Interp* interp, MachineBroker* theMachineBroker)
 {
   Tcl_CreateCommand(interp, "send",      &opsSend, (ClientData)theMachineBroker, (Tcl_CmdDeleteProc *)NULL);
   Tcl_CreateCommand(interp, "recv",      &opsRecv, (ClientData)theMachineBroker, (Tcl_CmdDeleteProc *)NULL);
   Tcl_CreateCommand(interp, "barrier",   &opsBarrier, (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+
+  Communicator *world = new Communicator;
+  MPI_Comm_dup(MPI_COMM_WORLD, &world->comm);
+  MPI_Comm_rank(world->comm, &world->rank);
+  MPI_Comm_size(world->comm, &world->size);
+
+  const struct {const char* name; Tcl_ObjCmdProc* proc;} commands[] = {
+    {"broadcast",   TclObjCommand_broadcast  },
+    {"gather",      TclObjCommand_gather     },
+    {"scatter",     TclObjCommand_scatter    },
+    {"allreduce",   TclObjCommand_allreduce  },
+    {"isend",       TclObjCommand_isend      },
+    {"irecv",       TclObjCommand_irecv      },
+    {"waitRequest", TclObjCommand_waitRequest},
+    {"testRequest", TclObjCommand_testRequest},
+    {"reduction",   TclObjCommand_reduction  },
+  };
+  for (const auto& command : commands) {
+    world->users++;
+    Tcl_CreateObjCommand(interp, command.name, command.proc, (ClientData)world, deleteCommunicator);
+  }
 }
 
 
@@ -151,3 +272,507 @@ opsBarrier(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** cons
   return MPI_Barrier(MPI_COMM_WORLD);
 }
 
+
+
+//
+// Numeric collectives
+//
+static int
+get_doubles(Tcl_Interp *interp, Tcl_Obj *list, std::vector<double>& values)
+{
+  int n;
+  Tcl_Obj **items;
+  if (Tcl_ListObjGetElements(interp, list, &n, &items) != TCL_OK)
+    return TCL_ERROR;
+
+  values.resize(n);
+  for (int i = 0; i < n; i++)
+    if (Tcl_GetDoubleFromObj(interp, items[i], &values[i]) != TCL_OK)
+      return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+static Tcl_Obj*
+new_list(const double* values, int n)
+{
+  Tcl_Obj *list = Tcl_NewListObj(0, nullptr);
+  for (int i = 0; i < n; i++)
+    Tcl_ListObjAppendElement(nullptr, list, Tcl_NewDoubleObj(values[i]));
+  return list;
+}
+
+static int
+get_rank(Tcl_Interp *interp, Tcl_Obj *obj, const Communicator& world, int& rank)
+{
+  if (Tcl_GetIntFromObj(interp, obj, &rank) != TCL_OK)
+    return TCL_ERROR;
+  if (rank < 0 || rank >= world.size) {
+    opserr << G3_ERROR_PROMPT << "invalid pid " << rank << "\n";
+    return TCL_ERROR;
+  }
+  return TCL_OK;
+}
+
+// Parse ?-root $r? followed by at most one list
+static int
+parse_rooted(Tcl_Interp *interp, int objc, Tcl_Obj *const objv[],
+             const Communicator& world, int& root, Tcl_Obj*& data)
+{
+  root = 0;
+  data = nullptr;
+  for (int i = 1; i < objc; i++) {
+    if (strcmp(Tcl_GetString(objv[i]), "-root") == 0 && i + 1 < objc) {
+      if (get_rank(interp, objv[++i], world, root) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (data == nullptr)
+      data = objv[i];
+    else {
+      opserr << G3_ERROR_PROMPT << "unexpected argument " << Tcl_GetString(objv[i]) << "\n";
+      return TCL_ERROR;
+    }
+  }
+  return TCL_OK;
+}
+
+//
+// Every process takes part in a collective or none does. A process that
+// cannot (an invalid argument, or no values on the root) still joins this
+// agreement, so that the others fail with it rather than wait for it in
+// the collective. The keys, e.g. the root, must be the same on all.
+//
+static int
+agree(const Communicator& world, const char* name, bool ok, std::initializer_list<int> keys = {})
+{
+  std::vector<int> local{ok ? 1 : 0};
+  for (int key : keys) {
+    local.push_back( key);
+    local.push_back(-key);
+  }
+  std::vector<int> low(local.size());
+  MPI_Allreduce(local.data(), low.data(), static_cast<int>(local.size()), MPI_INT, MPI_MIN, world.comm);
+
+  if (low[0] == 0) {
+    if (ok)
+      opserr << G3_ERROR_PROMPT << name << " failed on another process\n";
+    return TCL_ERROR;
+  }
+  for (std::size_t i = 1; i < low.size(); i += 2)
+    if (low[i] != -low[i+1]) {
+      opserr << G3_ERROR_PROMPT << name << " arguments differ between processes\n";
+      return TCL_ERROR;
+    }
+  return TCL_OK;
+}
+
+static int
+TclObjCommand_broadcast(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  int root;
+  Tcl_Obj *data;
+  bool ok = parse_rooted(interp, objc, objv, world, root, data) == TCL_OK;
+
+  std::vector<double> values;
+  if (ok && world.rank == root) {
+    if (data == nullptr) {
+      opserr << G3_ERROR_PROMPT << "broadcast requires values on the root\n";
+      ok = false;
+    }
+    else
+      ok = get_doubles(interp, data, values) == TCL_OK;
+  }
+
+  if (agree(world, "broadcast", ok, {root}) != TCL_OK)
+    return TCL_ERROR;
+
+  int n = static_cast<int>(values.size());
+  MPI_Bcast(&n, 1, MPI_INT, root, world.comm);
+  values.resize(n);
+  MPI_Bcast(values.data(), n, MPI_DOUBLE, root, world.comm);
+
+  Tcl_SetObjResult(interp, new_list(values.data(), n));
+  return TCL_OK;
+}
+
+static int
+TclObjCommand_gather(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  int root = 0;
+  bool all = false, ok = true;
+  Tcl_Obj *data = nullptr;
+  for (int i = 1; ok && i < objc; i++) {
+    const char *arg = Tcl_GetString(objv[i]);
+    if (strcmp(arg, "-all") == 0)
+      all = true;
+    else if (strcmp(arg, "-root") == 0 && i + 1 < objc)
+      ok = get_rank(interp, objv[++i], world, root) == TCL_OK;
+    else
+      data = objv[i];
+  }
+
+  std::vector<double> values;
+  if (ok && (data == nullptr || get_doubles(interp, data, values) != TCL_OK)) {
+    opserr << G3_ERROR_PROMPT << "gather requires a list of values\n";
+    ok = false;
+  }
+
+  if (agree(world, "gather", ok, {all ? -1 : root}) != TCL_OK)
+    return TCL_ERROR;
+
+  int n = static_cast<int>(values.size());
+  const bool receive = all || world.rank == root;
+
+  std::vector<int> counts(receive ? world.size : 0),
+                   offsets(receive ? world.size : 0);
+  if (all)
+    MPI_Allgather(&n, 1, MPI_INT, counts.data(), 1, MPI_INT, world.comm);
+  else
+    MPI_Gather(&n, 1, MPI_INT, counts.data(), 1, MPI_INT, root, world.comm);
+
+  int total = 0;
+  for (std::size_t p = 0; p < counts.size(); p++) {
+    offsets[p] = total;
+    total += counts[p];
+  }
+
+  std::vector<double> gathered(total);
+  if (all)
+    MPI_Allgatherv(values.data(), n, MPI_DOUBLE, gathered.data(), counts.data(),
+                   offsets.data(), MPI_DOUBLE, world.comm);
+  else
+    MPI_Gatherv(values.data(), n, MPI_DOUBLE, gathered.data(), counts.data(),
+                offsets.data(), MPI_DOUBLE, root, world.comm);
+
+  Tcl_Obj *result = Tcl_NewListObj(0, nullptr);
+  for (std::size_t p = 0; p < counts.size(); p++)
+    Tcl_ListObjAppendElement(interp, result, new_list(&gathered[offsets[p]], counts[p]));
+
+  Tcl_SetObjResult(interp, result);
+  return TCL_OK;
+}
+
+static int
+TclObjCommand_scatter(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  int root;
+  Tcl_Obj *data;
+  bool ok = parse_rooted(interp, objc, objv, world, root, data) == TCL_OK;
+
+  std::vector<double> values;
+  std::vector<int> counts, offsets;
+  if (ok && world.rank == root) {
+    int np;
+    Tcl_Obj **lists;
+    if (data == nullptr || Tcl_ListObjGetElements(interp, data, &np, &lists) != TCL_OK
+        || np != world.size) {
+      opserr << G3_ERROR_PROMPT << "scatter requires a list of values for each of the "
+             << world.size << " processes on the root\n";
+      ok = false;
+    }
+    else {
+      counts.resize(np);
+      offsets.resize(np);
+      for (int p = 0; ok && p < np; p++) {
+        std::vector<double> part;
+        ok = get_doubles(interp, lists[p], part) == TCL_OK;
+        offsets[p] = static_cast<int>(values.size());
+        counts[p]  = static_cast<int>(part.size());
+        values.insert(values.end(), part.begin(), part.end());
+      }
+    }
+  }
+
+  if (agree(world, "scatter", ok, {root}) != TCL_OK)
+    return TCL_ERROR;
+
+  int n;
+  MPI_Scatter(counts.data(), 1, MPI_INT, &n, 1, MPI_INT, root, world.comm);
+
+  std::vector<double> received(n);
+  MPI_Scatterv(values.data(), counts.data(), offsets.data(), MPI_DOUBLE,
+               received.data(), n, MPI_DOUBLE, root, world.comm);
+
+  Tcl_SetObjResult(interp, new_list(received.data(), n));
+  return TCL_OK;
+}
+
+static int
+TclObjCommand_allreduce(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  static const char *names[] = {"sum", "prod", "min", "max"};
+  static const MPI_Op ops[]   = {MPI_SUM, MPI_PROD, MPI_MIN, MPI_MAX};
+
+  int index = 0;
+  bool ok = true;
+  Tcl_Obj *data = nullptr;
+  for (int i = 1; ok && i < objc; i++) {
+    const char *arg = Tcl_GetString(objv[i]);
+    if (strcmp(arg, "-op") == 0 && i + 1 < objc) {
+      const char *name = Tcl_GetString(objv[++i]);
+      for (index = 0; index < 4 && strcmp(name, names[index]) != 0; index++)
+        ;
+      if (index == 4) {
+        opserr << G3_ERROR_PROMPT << "unknown reduction " << name << ", expected sum, prod, min or max\n";
+        ok = false;
+      }
+    }
+    else
+      data = objv[i];
+  }
+
+  std::vector<double> values;
+  if (ok && (data == nullptr || get_doubles(interp, data, values) != TCL_OK)) {
+    opserr << G3_ERROR_PROMPT << "allreduce requires a list of values\n";
+    ok = false;
+  }
+
+  // every process must apply the same operation to the same number of values
+  int n = static_cast<int>(values.size());
+  if (agree(world, "allreduce", ok, {index, n}) != TCL_OK)
+    return TCL_ERROR;
+
+  const MPI_Op op = ops[index];
+
+  // sums are formed as selected by the reduction command; the other
+  // operations do not depend on the order of their operands
+  if (op == MPI_SUM) {
+    OpenSees::allreduce_sum(values.data(), n, world.comm);
+    Tcl_SetObjResult(interp, new_list(values.data(), n));
+    return TCL_OK;
+  }
+
+  std::vector<double> reduced(n);
+  MPI_Allreduce(values.data(), reduced.data(), n, MPI_DOUBLE, op, world.comm);
+
+  Tcl_SetObjResult(interp, new_list(reduced.data(), n));
+  return TCL_OK;
+}
+
+static int
+TclObjCommand_reduction(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  if (objc > 1) {
+    // an unknown name is selection -1, so that the processes agree to fail
+    OpenSees::Summation mode = OpenSees::Summation::Native;
+    const bool ok = OpenSees::parse_summation(Tcl_GetString(objv[1]), mode);
+    if (!ok)
+      opserr << G3_ERROR_PROMPT << "unknown summation " << Tcl_GetString(objv[1])
+             << ", expected native, ordered or compensated\n";
+
+    // every process must form sums the same way
+    if (agree(world, "reduction", ok, {ok ? static_cast<int>(mode) : -1}) != TCL_OK)
+      return TCL_ERROR;
+
+    OpenSees::summation() = mode;
+  }
+
+  Tcl_SetObjResult(interp, Tcl_NewStringObj(OpenSees::summation_name(OpenSees::summation()), -1));
+  return TCL_OK;
+}
+
+
+//
+// Non-blocking point-to-point
+//
+static int
+parse_message(Tcl_Interp *interp, int objc, Tcl_Obj *const objv[], const Communicator& world,
+              int& pid, int& tag, Tcl_Obj** data)
+{
+  bool found = false;
+  tag = 0;
+  for (int i = 1; i < objc; i++) {
+    const char *arg = Tcl_GetString(objv[i]);
+    if (strcmp(arg, "-pid") == 0 && i + 1 < objc) {
+      found = true;
+      const char *other = Tcl_GetString(objv[++i]);
+      if (data == nullptr && (strcmp(other, "ANY") == 0 || strcmp(other, "ANY_SOURCE") == 0
+                           || strcmp(other, "MPI_ANY_SOURCE") == 0))
+        pid = MPI_ANY_SOURCE;
+      else if (get_rank(interp, objv[i], world, pid) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (strcmp(arg, "-tag") == 0 && i + 1 < objc) {
+      if (Tcl_GetIntFromObj(interp, objv[++i], &tag) != TCL_OK)
+        return TCL_ERROR;
+      if (tag < 0) {
+        opserr << G3_ERROR_PROMPT << "message tags must not be negative\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (data != nullptr && *data == nullptr)
+      *data = objv[i];
+    else {
+      opserr << G3_ERROR_PROMPT << "unexpected argument " << arg << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  if (!found) {
+    opserr << G3_ERROR_PROMPT << "a pid is required\n";
+    return TCL_ERROR;
+  }
+  if (pid == world.rank) {
+    opserr << G3_ERROR_PROMPT << "cannot communicate with self\n";
+    return TCL_ERROR;
+  }
+  return TCL_OK;
+}
+
+//
+// Post the receive of a request once its message is found, sized to the
+// message. The probe is matched, so the message it finds is removed from
+// those that later probes see and is the one that the receive takes.
+// Returns false if the message has not arrived and wait is false.
+//
+static bool
+post_receive(Communicator& world, Request& pending, bool wait)
+{
+  int found = 1;
+  MPI_Message message;
+  MPI_Status status;
+  if (wait)
+    MPI_Mprobe(pending.source, pending.tag, world.comm, &message, &status);
+  else
+    MPI_Improbe(pending.source, pending.tag, world.comm, &found, &message, &status);
+
+  if (!found)
+    return false;
+
+  int n;
+  MPI_Get_count(&status, MPI_DOUBLE, &n);
+  pending.buffer.resize(n);
+  MPI_Imrecv(pending.buffer.data(), n, MPI_DOUBLE, &message, &pending.request);
+  return true;
+}
+
+static int
+TclObjCommand_isend(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  int pid, tag;
+  Tcl_Obj *data = nullptr;
+  if (parse_message(interp, objc, objv, world, pid, tag, &data) != TCL_OK)
+    return TCL_ERROR;
+
+  Request request{true, MPI_REQUEST_NULL, pid, tag};
+  if (data == nullptr || get_doubles(interp, data, request.buffer) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "isend requires a list of values\n";
+    return TCL_ERROR;
+  }
+
+  const int id = world.nextRequest++;
+  Request& pending = world.requests.emplace(id, std::move(request)).first->second;
+  MPI_Isend(pending.buffer.data(), static_cast<int>(pending.buffer.size()), MPI_DOUBLE,
+            pid, tag, world.comm, &pending.request);
+
+  Tcl_SetObjResult(interp, Tcl_NewIntObj(id));
+  return TCL_OK;
+}
+
+static int
+TclObjCommand_irecv(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  int pid, tag;
+  if (parse_message(interp, objc, objv, world, pid, tag, nullptr) != TCL_OK)
+    return TCL_ERROR;
+
+  const int id = world.nextRequest++;
+  Request& pending = world.requests.emplace(id, Request{false, MPI_REQUEST_NULL, pid, tag}).first->second;
+  post_receive(world, pending, false);
+
+  Tcl_SetObjResult(interp, Tcl_NewIntObj(id));
+  return TCL_OK;
+}
+
+static int
+get_request(Tcl_Interp *interp, int objc, Tcl_Obj *const objv[], Communicator& world,
+            std::map<int, Request>::iterator& request)
+{
+  int id;
+  if (objc != 2) {
+    Tcl_WrongNumArgs(interp, 1, objv, "request");
+    return TCL_ERROR;
+  }
+  if (Tcl_GetIntFromObj(interp, objv[1], &id) != TCL_OK)
+    return TCL_ERROR;
+
+  request = world.requests.find(id);
+  if (request == world.requests.end()) {
+    opserr << G3_ERROR_PROMPT << "no pending request " << id << "\n";
+    return TCL_ERROR;
+  }
+  return TCL_OK;
+}
+
+// Release a completed request; the values of a receive become the result
+static void
+complete(Tcl_Interp *interp, Communicator& world, std::map<int, Request>::iterator request)
+{
+  Request& pending = request->second;
+  if (pending.send)
+    Tcl_SetObjResult(interp, Tcl_NewListObj(0, nullptr));
+  else
+    Tcl_SetObjResult(interp, new_list(pending.buffer.data(), static_cast<int>(pending.buffer.size())));
+  world.requests.erase(request);
+}
+
+static int
+TclObjCommand_waitRequest(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  std::map<int, Request>::iterator request;
+  if (get_request(interp, objc, objv, world, request) != TCL_OK)
+    return TCL_ERROR;
+
+  Request& pending = request->second;
+  if (!pending.send && pending.request == MPI_REQUEST_NULL)
+    post_receive(world, pending, true);
+
+  MPI_Wait(&pending.request, MPI_STATUS_IGNORE);
+  complete(interp, world, request);
+  return TCL_OK;
+}
+
+//
+// Returns {} if the request is pending, otherwise completes it and
+// returns a list holding its result
+//
+static int
+TclObjCommand_testRequest(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  Communicator& world = *static_cast<Communicator*>(clientData);
+
+  std::map<int, Request>::iterator request;
+  if (get_request(interp, objc, objv, world, request) != TCL_OK)
+    return TCL_ERROR;
+
+  int done = 0;
+  Request& pending = request->second;
+  if (pending.send || pending.request != MPI_REQUEST_NULL || post_receive(world, pending, false))
+    MPI_Test(&pending.request, &done, MPI_STATUS_IGNORE);
+
+  if (!done) {
+    Tcl_SetObjResult(interp, Tcl_NewListObj(0, nullptr));
+    return TCL_OK;
+  }
+
+  complete(interp, world, request);
+  Tcl_Obj *result = Tcl_GetObjResult(interp);
+  Tcl_SetObjResult(interp, Tcl_NewListObj(1, &result));
+  return TCL_OK;
+}
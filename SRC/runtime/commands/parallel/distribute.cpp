@@ -0,0 +1,884 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file implements the partition command of OpenSeesMP,
+// which distributes a model among the processes through files written
+// once, so that each process reads and holds only its own part.
+//
+//   partition -save $np $prefix ?-import $file? ?-export $file?
+//                               ?-tolerance $tol? ?-metis?
+//
+//      Partition the model of this process into np parts and write part
+//      i, for process i, to the file database $prefix.i. The nodes on the
+//      boundary of each part are written to $prefix.i.interface together
+//      with the other parts that share them. The components of the model
+//      are moved into the parts, so the domain is left empty; if the parts
+//      cannot be written, the model is moved back into the domain. This
+//      is typically run once, by a single process.
+//
+//      The parts found by Metis are adjusted by an InterfacePartitioner,
+//      which keeps the nodes of each MP constraint on a common part and
+//      reduces the interface degrees of freedom, with the heaviest part
+//      within tol (0.05) of the mean; -metis keeps the parts of Metis.
+//      The part of each element is written to the file given by -export,
+//      and -import reuses such a file. The command returns a dictionary
+//      of the quality of the partition: edgeCut, interfaceNodes,
+//      interfaceDOFs, cutConstraints and imbalance, and the elements and
+//      dofs of each part.
+//
+//   partition -load $prefix
+//
+//      Restore the part of this process into the domain of the current
+//      model, and read its interface. The command fails on every process
+//      if any of them fails to read its part.
+//
+//   partition -neighbors
+//
+//      Return a dictionary from each process that shares nodes with this
+//      one to the tags of the nodes shared, as read by partition -load.
+//
+// Long analyses are checkpointed with
+//
+//   checkpoint save $prefix
+//
+//      Process 0 removes the manifest of any earlier checkpoint under the
+//      prefix, then every process writes the committed state of its part
+//      to $prefix.<rank> at the same time. Once all the parts are written,
+//      process 0 writes $prefix.manifest with the number of parts and the
+//      time; a checkpoint without a manifest is incomplete. Successive
+//      checkpoints should alternate between two prefixes, so that one is
+//      complete whenever a job is stopped.
+//
+//   checkpoint restore $prefix
+//
+//      Replace the model of each process with its part of the checkpoint.
+//      When the number of processes differs from the number of parts,
+//      process 0 merges the parts and partitions the model again into
+//      $prefix.np<n>.<rank>, which each process then reads. The models
+//      are replaced only once every process has read its part and found
+//      it at the time in the manifest; until every process has taken its
+//      part, the model it replaces is kept aside and put back on failure.
+//      The recorders and parameters of the model are removed.
+//
+// Once a part is loaded, the eigen command of the model finds the modes
+// of the whole model with OpenSees::DistributedEigen, exchanging values
+// at the shared nodes with the neighbors of this process.
+//
+// Any other use of partition is accepted and ignored, as in scripts
+// written for OpenSeesSP.
+//
+#include <tcl.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <algorithm>
+#include <mpi.h>
+#include <G3_Logging.h>
+#include <runtimeAPI.h>
+#include <Parsing.h>
+#include <MachineBroker.h>
+#include <FEM_ObjectBroker.h>
+#include <FileDatastore.h>
+#include <Domain.h>
+#include <PartitionedDomain.h>
+#include <Subdomain.h>
+#include <SubdomainIter.h>
+#include <DomainPartitioner.h>
+#include <Metis.h>
+#include <InterfacePartitioner.h>
+#include "partitioning.h"
+#include <ID.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <SP_Constraint.h>
+#include <SP_ConstraintIter.h>
+#include <MP_Constraint.h>
+#include <MP_ConstraintIter.h>
+#include <LoadPattern.h>
+#include <LoadPatternIter.h>
+#include <NodalLoad.h>
+#include <NodalLoadIter.h>
+#include <ElementalLoad.h>
+#include <ElementalLoadIter.h>
+#include <Parameter.h>
+#include <ParameterIter.h>
+#include <DOF_Group.h>
+#include <BasicAnalysisBuilder.h>
+#include <DistributedEigen.h>
+#include <ReductionMPI.h>
+
+//
+// Exchange of values at the equations of shared nodes; the equations of
+// the nodes shared with each neighbor are listed in the order of their
+// tags, so both processes pack them alike. Unless the native summation
+// is selected, the contributions to each shared equation are added in
+// the order of the processes holding it, so that all of them hold
+// identical values.
+//
+class SharedNodeInterface : public OpenSees::PartitionInterface
+{
+public:
+  SharedNodeInterface(const std::map<int, std::vector<int>>& neighbors)
+    : neighbors(neighbors)
+  {
+    MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+  }
+
+  ~SharedNodeInterface()
+  {
+    MPI_Comm_free(&comm);
+  }
+
+  int setup(Domain& domain, int numEqn)
+  {
+    links.clear();
+    for (const auto& [rank, shared] : neighbors) {
+      Link link{rank};
+      std::vector<int> nodes(shared);
+      std::sort(nodes.begin(), nodes.end());
+      for (int tag : nodes) {
+        Node *node = domain.getNode(tag);
+        DOF_Group *group = node != nullptr ? node->getDOF_GroupPtr() : nullptr;
+        if (group == nullptr) {
+          opserr << G3_ERROR_PROMPT << "shared node " << tag << " has not been numbered\n";
+          return -1;
+        }
+        const ID& equations = group->getID();
+        for (int i = 0; i < equations.Size(); i++)
+          link.equations.push_back(equations(i) < numEqn ? equations(i) : -1);
+      }
+      link.send.resize(link.equations.size());
+      link.receive.resize(link.equations.size());
+      links.push_back(std::move(link));
+    }
+
+    // the sources of each shared equation, by rank; a link of -1 is
+    // the value of this process
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    std::map<int, std::vector<std::pair<int, Source>>> sources;
+    for (std::size_t i = 0; i < links.size(); i++)
+      for (std::size_t j = 0; j < links[i].equations.size(); j++)
+        if (links[i].equations[j] >= 0)
+          sources[links[i].equations[j]].push_back({links[i].rank, {static_cast<int>(i), static_cast<int>(j)}});
+
+    slots.clear();
+    for (auto& [equation, ranked] : sources) {
+      ranked.push_back({rank, {-1, 0}});
+      std::sort(ranked.begin(), ranked.end(),
+                [](const auto& a, const auto& b) {return a.first < b.first;});
+      Slot slot{equation};
+      for (const auto& source : ranked)
+        slot.sources.push_back(source.second);
+      slots.push_back(std::move(slot));
+    }
+    return 0;
+  }
+
+  void assemble(double* x)
+  {
+    std::vector<MPI_Request> requests(2*links.size());
+    for (std::size_t i = 0; i < links.size(); i++) {
+      Link& link = links[i];
+      for (std::size_t j = 0; j < link.equations.size(); j++)
+        link.send[j] = link.equations[j] >= 0 ? x[link.equations[j]] : 0.0;
+      const int count = static_cast<int>(link.send.size());
+      MPI_Irecv(link.receive.data(), count, MPI_DOUBLE, link.rank, 0, comm, &requests[2*i]);
+      MPI_Isend(link.send.data(),    count, MPI_DOUBLE, link.rank, 0, comm, &requests[2*i+1]);
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+    const OpenSees::Summation mode = OpenSees::summation();
+    if (mode == OpenSees::Summation::Native) {
+      for (const Link& link : links)
+        for (std::size_t j = 0; j < link.equations.size(); j++)
+          if (link.equations[j] >= 0)
+            x[link.equations[j]] += link.receive[j];
+      return;
+    }
+
+    std::vector<double> values;
+    for (const Slot& slot : slots) {
+      values.clear();
+      for (const Source& source : slot.sources)
+        values.push_back(source.link < 0 ? x[slot.equation]
+                                         : links[source.link].receive[source.index]);
+      OpenSees::sum_ordered(values.data(), static_cast<int>(values.size()), 1,
+                            &x[slot.equation], mode);
+    }
+  }
+
+  void sum(double* values, int n)
+  {
+    OpenSees::allreduce_sum(values, n, comm);
+  }
+
+  int getRank()
+  {
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    return rank;
+  }
+
+private:
+  struct Link {
+    int rank;
+    std::vector<int>    equations;
+    std::vector<double> send, receive;
+  };
+
+  struct Source {
+    int link, index;
+  };
+
+  struct Slot {
+    int equation;
+    std::vector<Source> sources;
+  };
+
+  const std::map<int, std::vector<int>>& neighbors;
+  std::vector<Link> links;
+  std::vector<Slot> slots;
+  MPI_Comm comm;
+};
+
+struct DistributedModel {
+  MachineBroker    *machine;
+  FEM_ObjectBroker *broker;
+
+  // processes sharing nodes with this one, and the nodes shared
+  std::map<int, std::vector<int>> neighbors;
+
+  SharedNodeInterface *exchange = nullptr;
+};
+
+static Tcl_CmdProc TclCommand_partitionMP;
+static Tcl_CmdProc TclCommand_checkpoint;
+
+void
+Init_DistributedModel(Tcl_Interp* interp, MachineBroker* theMachineBroker, FEM_ObjectBroker* theBroker)
+{
+  DistributedModel *model = new DistributedModel{theMachineBroker, theBroker};
+  Tcl_CreateCommand(interp, "partition", &TclCommand_partitionMP, (ClientData)model, (Tcl_CmdDeleteProc *)NULL);
+  Tcl_CreateCommand(interp, "checkpoint", &TclCommand_checkpoint, (ClientData)model, (Tcl_CmdDeleteProc *)NULL);
+}
+
+//
+// Move the nodes, elements, constraints and load patterns of one domain
+// into another; the tags are gathered first since the iterators are not
+// valid once a component is removed. A component the other domain does
+// not accept is put back, and the move stops there.
+//
+template <class Iter, class Object>
+static std::vector<int>
+get_tags(Iter& iter)
+{
+  std::vector<int> tags;
+  Object *object;
+  while ((object = iter()) != nullptr)
+    tags.push_back(object->getTag());
+  return tags;
+}
+
+static int
+transfer(Domain& from, Domain& to)
+{
+  std::vector<int> patterns = get_tags<LoadPatternIter, LoadPattern>(from.getLoadPatterns()),
+                   mps      = get_tags<MP_ConstraintIter, MP_Constraint>(from.getMPs()),
+                   sps      = get_tags<SP_ConstraintIter, SP_Constraint>(from.getSPs()),
+                   elements = get_tags<ElementIter, Element>(from.getElements()),
+                   nodes    = get_tags<NodeIter, Node>(from.getNodes());
+
+  for (int tag : nodes) {
+    Node *node = from.removeNode(tag);
+    if (!to.addNode(node)) {
+      from.addNode(node);
+      return -1;
+    }
+  }
+
+  for (int tag : elements) {
+    Element *element = from.removeElement(tag);
+    if (!to.addElement(element)) {
+      from.addElement(element);
+      return -1;
+    }
+  }
+
+  for (int tag : sps) {
+    SP_Constraint *sp = from.removeSP_Constraint(tag);
+    if (!to.addSP_Constraint(sp)) {
+      from.addSP_Constraint(sp);
+      return -1;
+    }
+  }
+
+  for (int tag : mps) {
+    MP_Constraint *mp = from.removeMP_Constraint(tag);
+    if (!to.addMP_Constraint(mp)) {
+      from.addMP_Constraint(mp);
+      return -1;
+    }
+  }
+
+  for (int tag : patterns) {
+    LoadPattern *pattern = from.removeLoadPattern(tag);
+    if (!to.addLoadPattern(pattern)) {
+      from.addLoadPattern(pattern);
+      return -1;
+    }
+  }
+
+  to.setCurrentTime(from.getCurrentTime());
+  to.setCommittedTime(from.getCurrentTime());
+  return 0;
+}
+
+//
+// Add the components of a part to a domain holding other parts; nodes,
+// constraints and loads already present, i.e., those on the boundary of
+// the parts, are left behind in the part.
+//
+static int
+merge(Domain& from, Domain& to)
+{
+  for (int tag : get_tags<NodeIter, Node>(from.getNodes()))
+    if (to.getNode(tag) == nullptr && !to.addNode(from.removeNode(tag)))
+      return -1;
+
+  for (int tag : get_tags<ElementIter, Element>(from.getElements()))
+    if (!to.addElement(from.removeElement(tag)))
+      return -1;
+
+  for (int tag : get_tags<SP_ConstraintIter, SP_Constraint>(from.getSPs()))
+    if (to.getSP_Constraint(tag) == nullptr && !to.addSP_Constraint(from.removeSP_Constraint(tag)))
+      return -1;
+
+  for (int tag : get_tags<MP_ConstraintIter, MP_Constraint>(from.getMPs()))
+    if (to.getMP_Constraint(tag) == nullptr && !to.addMP_Constraint(from.removeMP_Constraint(tag)))
+      return -1;
+
+  for (int tag : get_tags<LoadPatternIter, LoadPattern>(from.getLoadPatterns())) {
+    LoadPattern *pattern = to.getLoadPattern(tag);
+    if (pattern == nullptr) {
+      if (!to.addLoadPattern(from.removeLoadPattern(tag)))
+        return -1;
+      continue;
+    }
+
+    // each part holds the loads of the same pattern on its own components
+    LoadPattern *part = from.getLoadPattern(tag);
+    for (int load : get_tags<NodalLoadIter, NodalLoad>(part->getNodalLoads())) {
+      NodalLoad *nodal = part->removeNodalLoad(load);
+      if (!pattern->addNodalLoad(nodal))
+        delete nodal;
+    }
+    for (int load : get_tags<ElementalLoadIter, ElementalLoad>(part->getElementalLoads())) {
+      ElementalLoad *elemental = part->removeElementalLoad(load);
+      if (!pattern->addElementalLoad(elemental))
+        delete elemental;
+    }
+    for (int sp : get_tags<SP_ConstraintIter, SP_Constraint>(part->getSPs())) {
+      SP_Constraint *constraint = part->removeSP_Constraint(sp);
+      if (!pattern->addSP_Constraint(constraint))
+        delete constraint;
+    }
+  }
+
+  to.setCurrentTime(from.getCurrentTime());
+  to.setCommittedTime(from.getCurrentTime());
+  return 0;
+}
+
+static std::string
+part_name(const char* prefix, int rank)
+{
+  return std::string(prefix) + "." + std::to_string(rank);
+}
+
+//
+// The interface of a part: the number of shared nodes, then for each node
+// its tag, the number of other processes sharing it and their ranks
+//
+static bool
+write_interface(const std::string& name, const std::map<int, std::vector<int>>& others)
+{
+  std::vector<int> data{static_cast<int>(others.size())};
+  for (const auto& [tag, ranks] : others) {
+    data.push_back(tag);
+    data.push_back(static_cast<int>(ranks.size()));
+    data.insert(data.end(), ranks.begin(), ranks.end());
+  }
+
+  std::ofstream interface(name + ".interface", std::ios::binary);
+  interface.write(reinterpret_cast<const char*>(data.data()), data.size()*sizeof(int));
+  return static_cast<bool>(interface);
+}
+
+//
+// Put a model that was moved into a partitioned domain back into the
+// domain it came from; its components may be in the partitioned domain,
+// in its subdomains, or in the pieces taken from them. The nodes shared
+// by the parts are restored from the copies held by the parts.
+//
+static void
+recover(PartitionedDomain& whole, std::vector<std::unique_ptr<Domain>>& pieces,
+        Domain& domain, double time)
+{
+  for (auto& piece : pieces)
+    merge(*piece, domain);
+
+  Subdomain *theSub;
+  SubdomainIter &theSubdomains = whole.getSubdomains();
+  while ((theSub = theSubdomains()) != nullptr)
+    merge(*theSub, domain);
+
+  merge(whole, domain);
+  domain.setCurrentTime(time);
+  domain.setCommittedTime(time);
+}
+
+static int
+savePartitions(DistributedModel& model, Domain& domain, int np, const char* prefix,
+               const PartitionOptions& options = PartitionOptions{},
+               OpenSees::PartitionMetrics* metrics = nullptr)
+{
+  // the partitioners must outlive the domain that refers to them
+  PartitionedDomain whole;
+  Metis graphPartitioner;
+  OpenSees::InterfacePartitioner refined(whole, graphPartitioner);
+  DomainPartitioner partitioner(refined);
+
+  if (setup_partitioner(refined, options) != 0)
+    return -1;
+
+  // the files must be writable before the model is moved into the parts
+  if (!options.to.empty() && !std::ofstream(options.to, std::ios::app)) {
+    opserr << G3_ERROR_PROMPT << "cannot write the parts of the elements to " << options.to.c_str() << "\n";
+    return -1;
+  }
+  for (int rank = 0; rank < np; rank++) {
+    const std::string name = part_name(prefix, rank) + ".interface";
+    if (!std::ofstream(name, std::ios::app)) {
+      opserr << G3_ERROR_PROMPT << "cannot write part " << rank << " to " << name.c_str() << "\n";
+      return -1;
+    }
+  }
+
+  const double time = domain.getCurrentTime();
+  whole.setPartitioner(&partitioner);
+  if (transfer(domain, whole) != 0) {
+    opserr << G3_ERROR_PROMPT << "failed to move the model into a partitioned domain\n";
+    transfer(whole, domain);
+    return -1;
+  }
+
+  // on failure, the model is moved back into the domain
+  std::vector<std::unique_ptr<Domain>> pieces;
+
+  for (int i = 1; i <= np; i++)
+    whole.addSubdomain(new Subdomain(i));
+
+  if (whole.partition(np, false, 0, 0) < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to partition the model\n";
+    recover(whole, pieces, domain, time);
+    return -1;
+  }
+
+  if (metrics != nullptr)
+    *metrics = refined.getMetrics();
+
+  if (!options.to.empty() && refined.writeAssignment(options.to.c_str()) != 0) {
+    opserr << G3_ERROR_PROMPT << "failed to write the parts of the elements to " << options.to.c_str() << "\n";
+    recover(whole, pieces, domain, time);
+    return -1;
+  }
+
+  // find the processes sharing each boundary node; subdomain i is
+  // written for process i - 1
+  std::map<int, std::vector<int>> sharing;
+  Subdomain *theSub;
+  SubdomainIter &theSubdomains = whole.getSubdomains();
+  while ((theSub = theSubdomains()) != nullptr) {
+    const ID& external = theSub->getExternalNodes();
+    for (int j = 0; j < external.Size(); j++)
+      sharing[external(j)].push_back(theSub->getTag() - 1);
+  }
+
+  SubdomainIter &theParts = whole.getSubdomains();
+  while ((theSub = theParts()) != nullptr) {
+    const int rank = theSub->getTag() - 1;
+    const std::string name = part_name(prefix, rank);
+
+    std::map<int, std::vector<int>> others;
+    const ID& external = theSub->getExternalNodes();
+    for (int j = 0; j < external.Size(); j++) {
+      std::vector<int>& ranks = others[external(j)];
+      for (int owner : sharing[external(j)])
+        if (owner != rank)
+          ranks.push_back(owner);
+    }
+
+    pieces.push_back(std::make_unique<Domain>());
+    Domain& piece = *pieces.back();
+    if (transfer(*theSub, piece) != 0) {
+      opserr << G3_ERROR_PROMPT << "failed to extract part " << rank << "\n";
+      recover(whole, pieces, domain, time);
+      return -1;
+    }
+    // the parts are at the time of the model, which the subdomains
+    // need not have been given
+    piece.setCurrentTime(time);
+    piece.setCommittedTime(time);
+
+    FileDatastore store(name.c_str(), piece, *model.broker);
+    if (store.commitState(0) < 0) {
+      opserr << G3_ERROR_PROMPT << "failed to write part " << rank << " to " << name.c_str() << "\n";
+      recover(whole, pieces, domain, time);
+      return -1;
+    }
+
+    if (!write_interface(name, others)) {
+      opserr << G3_ERROR_PROMPT << "failed to write the interface of part " << rank << "\n";
+      recover(whole, pieces, domain, time);
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+static int
+loadPartition(DistributedModel& model, Domain& domain, const std::string& name)
+{
+  const int rank = model.machine->getPID();
+
+  FileDatastore store(name.c_str(), domain, *model.broker);
+  if (store.restoreState(0) < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to read part " << rank << " from " << name.c_str() << "\n";
+    return -1;
+  }
+
+  model.neighbors.clear();
+  std::ifstream interface(name + ".interface", std::ios::binary);
+  int numNodes = 0;
+  if (!interface.read(reinterpret_cast<char*>(&numNodes), sizeof(int))) {
+    opserr << G3_ERROR_PROMPT << "failed to read the interface of part " << rank << "\n";
+    return -1;
+  }
+
+  for (int i = 0; i < numNodes; i++) {
+    int header[2];
+    if (!interface.read(reinterpret_cast<char*>(header), sizeof(header)))
+      break;
+    std::vector<int> owners(header[1]);
+    if (!interface.read(reinterpret_cast<char*>(owners.data()), owners.size()*sizeof(int)))
+      break;
+    for (int owner : owners)
+      model.neighbors[owner].push_back(header[0]);
+  }
+
+  if (!interface) {
+    opserr << G3_ERROR_PROMPT << "the interface of part " << rank << " is incomplete\n";
+    return -1;
+  }
+  return 0;
+}
+
+// Eigen analyses of the model span all of the parts once one is loaded;
+// the exchange is created collectively, so this is called by all of the
+// processes or by none
+static void
+attachEigen(Tcl_Interp* interp, DistributedModel& model)
+{
+  Tcl_CmdInfo info;
+  if (Tcl_GetCommandInfo(interp, "eigen", &info) && info.clientData != nullptr) {
+    if (model.exchange == nullptr)
+      model.exchange = new SharedNodeInterface(model.neighbors);
+    static_cast<BasicAnalysisBuilder*>(info.clientData)->setPartition(model.exchange);
+  }
+}
+
+static int
+TclCommand_partitionMP(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
+{
+  DistributedModel& model = *static_cast<DistributedModel*>(clientData);
+
+  if (argc < 2 || argv[1][0] != '-')
+    return TCL_OK;
+
+  if (strcmp(argv[1], "-neighbors") == 0) {
+    Tcl_Obj *result = Tcl_NewDictObj();
+    for (const auto& [rank, nodes] : model.neighbors) {
+      Tcl_Obj *tags = Tcl_NewListObj(0, nullptr);
+      for (int tag : nodes)
+        Tcl_ListObjAppendElement(interp, tags, Tcl_NewIntObj(tag));
+      Tcl_DictObjPut(interp, result, Tcl_NewIntObj(rank), tags);
+    }
+    Tcl_SetObjResult(interp, result);
+    return TCL_OK;
+  }
+
+  Domain *domain = G3_getDomain(G3_getRuntime(interp));
+  if (domain == nullptr) {
+    opserr << G3_ERROR_PROMPT << "a model must be defined before it is partitioned\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "-save") == 0) {
+    int np;
+    if (argc < 4) {
+      opserr << G3_ERROR_PROMPT << "want partition -save np prefix <options>\n";
+      return TCL_ERROR;
+    }
+    if (Tcl_GetInt(interp, argv[2], &np) != TCL_OK || np < 1) {
+      opserr << G3_ERROR_PROMPT << "invalid number of parts " << argv[2] << "\n";
+      return TCL_ERROR;
+    }
+
+    PartitionOptions options;
+    for (int i = 4; i < argc; i++)
+      if (parse_partition_option(interp, argc, argv, i, options) != TCL_OK)
+        return TCL_ERROR;
+
+    OpenSees::PartitionMetrics metrics;
+    if (savePartitions(model, *domain, np, argv[3], options, &metrics) != 0)
+      return TCL_ERROR;
+
+    Tcl_SetObjResult(interp, metrics_result(interp, metrics));
+    return TCL_OK;
+  }
+
+  else if (strcmp(argv[1], "-load") == 0) {
+    if (argc != 3) {
+      opserr << G3_ERROR_PROMPT << "want partition -load prefix\n";
+      return TCL_ERROR;
+    }
+    // the exchange is created collectively, so the processes agree that
+    // all of the parts were read before any of them creates it
+    const int loaded = loadPartition(model, *domain, part_name(argv[2], model.machine->getPID()));
+    int status = loaded;
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (status != 0) {
+      if (loaded == 0)
+        opserr << G3_ERROR_PROMPT << "another process failed to read its part of " << argv[2] << "\n";
+      return TCL_ERROR;
+    }
+
+    attachEigen(interp, model);
+    return TCL_OK;
+  }
+
+  opserr << G3_ERROR_PROMPT << "unknown option " << argv[1]
+         << ", want -save, -load or -neighbors\n";
+  return TCL_ERROR;
+}
+
+
+static std::string
+manifest_name(const char* prefix)
+{
+  return std::string(prefix) + ".manifest";
+}
+
+static int
+saveCheckpoint(DistributedModel& model, Domain& domain, const char* prefix)
+{
+  const int rank = model.machine->getPID(),
+            np   = model.machine->getNP();
+  const std::string name = part_name(prefix, rank);
+
+  // the nodes this process shares, by node
+  std::map<int, std::vector<int>> others;
+  for (const auto& [other, nodes] : model.neighbors)
+    for (int tag : nodes)
+      others[tag].push_back(other);
+
+  // the parts are overwritten in place, so the manifest of an earlier
+  // checkpoint under this prefix is removed before any of them is written
+  int status = 0;
+  if (rank == 0) {
+    const std::string manifest = manifest_name(prefix);
+    if (std::remove(manifest.c_str()) != 0 && std::ifstream(manifest))
+      status = -1;
+  }
+  MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if (status != 0) {
+    opserr << G3_ERROR_PROMPT << "failed to remove the manifest of checkpoint " << prefix << "\n";
+    return -1;
+  }
+
+  {
+    FileDatastore store(name.c_str(), domain, *model.broker);
+    if (store.commitState(0) < 0)
+      status = -1;
+  }
+  if (status == 0 && !write_interface(name, others))
+    status = -1;
+
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (status != 0) {
+    opserr << G3_ERROR_PROMPT << "failed to write checkpoint " << prefix
+           << "; it is incomplete and cannot be restored\n";
+    return -1;
+  }
+
+  // the manifest is renamed into place, so it is either absent or complete
+  if (rank == 0) {
+    const std::string manifest = manifest_name(prefix),
+                      partial  = manifest + ".partial";
+    std::ofstream file(partial);
+    file << np << " " << std::setprecision(17) << domain.getCurrentTime() << "\n";
+    file.close();
+    if (!file || std::rename(partial.c_str(), manifest.c_str()) != 0)
+      status = -1;
+  }
+  MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if (status != 0) {
+    opserr << G3_ERROR_PROMPT << "failed to write the manifest of checkpoint " << prefix << "\n";
+    return -1;
+  }
+  return 0;
+}
+
+//
+// Merge the parts of a checkpoint and partition the model again for np
+// processes; run by a single process
+//
+static int
+repartition(DistributedModel& model, const char* prefix, int parts, int np, const char* target)
+{
+  Domain whole;
+  for (int i = 0; i < parts; i++) {
+    const std::string name = part_name(prefix, i);
+    Domain piece;
+    FileDatastore store(name.c_str(), piece, *model.broker);
+    if (store.restoreState(0) < 0 || merge(piece, whole) != 0) {
+      opserr << G3_ERROR_PROMPT << "failed to read part " << i << " of checkpoint " << prefix << "\n";
+      return -1;
+    }
+  }
+  return savePartitions(model, whole, np, target);
+}
+
+//
+// Every process reads its part into a domain of its own and checks that
+// it is from the time in the manifest; the model is replaced only once
+// all of the parts have been read.
+//
+static int
+restoreCheckpoint(DistributedModel& model, Domain& domain, const char* prefix)
+{
+  const int rank = model.machine->getPID(),
+            np   = model.machine->getNP();
+
+  int parts = 0;
+  double time = 0.0;
+  if (rank == 0) {
+    std::ifstream manifest(manifest_name(prefix));
+    if (!(manifest >> parts >> time) || parts < 1)
+      parts = 0;
+  }
+  MPI_Bcast(&parts, 1, MPI_INT,    0, MPI_COMM_WORLD);
+  MPI_Bcast(&time,  1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  if (parts < 1) {
+    opserr << G3_ERROR_PROMPT << "checkpoint " << prefix << " is incomplete or missing\n";
+    return -1;
+  }
+
+  const std::string target = std::string(prefix) + ".np" + std::to_string(np);
+  int status = 0;
+  if (parts != np) {
+    if (rank == 0)
+      status = repartition(model, prefix, parts, np, target.c_str());
+    MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (status != 0)
+      return -1;
+  }
+
+  const std::map<int, std::vector<int>> neighbors = model.neighbors;
+  Domain piece;
+  status = loadPartition(model, piece, part_name(parts == np ? prefix : target.c_str(), rank));
+  if (status == 0 && piece.getCurrentTime() != time) {
+    opserr << G3_ERROR_PROMPT << "part " << rank << " of checkpoint " << prefix
+           << " is at time " << piece.getCurrentTime() << ", not " << time << "\n";
+    status = -1;
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (status != 0) {
+    opserr << G3_ERROR_PROMPT << "failed to restore checkpoint " << prefix
+           << "; the model is unchanged\n";
+    model.neighbors = neighbors;
+    return -1;
+  }
+
+  // the model is set aside rather than cleared, so that every process
+  // can put it back if any of them fails to take its part
+  const double current   = domain.getCurrentTime(),
+               committed = domain.getCommittedTime();
+  Domain previous;
+  const int aside = transfer(domain, previous);
+  status = aside == 0 ? transfer(piece, domain) : -1;
+
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (status != 0) {
+    if (aside == 0)
+      transfer(domain, piece);
+    transfer(previous, domain);
+    domain.setCurrentTime(current);
+    domain.setCommittedTime(committed);
+    opserr << G3_ERROR_PROMPT << "failed to restore checkpoint " << prefix
+           << "; the model is unchanged\n";
+    model.neighbors = neighbors;
+    return -1;
+  }
+
+  // the recorders and parameters refer to the components set aside
+  domain.removeRecorders();
+  for (int tag : get_tags<ParameterIter, Parameter>(domain.getParameters()))
+    delete domain.removeParameter(tag);
+  return 0;
+}
+
+static int
+TclCommand_checkpoint(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
+{
+  DistributedModel& model = *static_cast<DistributedModel*>(clientData);
+
+  if (argc != 3) {
+    opserr << G3_ERROR_PROMPT << "want checkpoint save|restore prefix\n";
+    return TCL_ERROR;
+  }
+
+  Domain *domain = G3_getDomain(G3_getRuntime(interp));
+  if (domain == nullptr) {
+    opserr << G3_ERROR_PROMPT << "a model must be defined before it is checkpointed\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "save") == 0)
+    return saveCheckpoint(model, *domain, argv[2]) == 0 ? TCL_OK : TCL_ERROR;
+
+  else if (strcmp(argv[1], "restore") == 0) {
+    // the result of restoreCheckpoint is agreed by all of the processes,
+    // so the exchange is created on all of them or on none
+    if (restoreCheckpoint(model, *domain, argv[2]) != 0)
+      return TCL_ERROR;
+    attachEigen(interp, model);
+    return TCL_OK;
+  }
+
+  opserr << G3_ERROR_PROMPT << "unknown option " << argv[1] << ", want save or restore\n";
+  return TCL_ERROR;
+}
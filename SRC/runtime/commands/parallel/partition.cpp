@@ -6,6 +6,7 @@
 //
 //
 #include <tcl.h>
+#include <string.h>
 #include <vector>
 #include <OPS_Globals.h>
 // #include <mpi.h>
@@ -22,11 +23,22 @@
 #include <DomainPartitioner.h>
 #include <domain/domain/partitioned/PartitionedDomain.h>
 #include <GraphPartitioner.h>
+#include <InterfacePartitioner.h>
 #include <Subdomain.h>
 #include <SubdomainIter.h>
 #include <MachineBroker.h>
 #include <StaticDomainDecompositionAnalysis.h>
 #include <TransientDomainDecompositionAnalysis.h>
+#include <DomainDecompositionAnalysis.h>
+#include <DomainDecompAlgo.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinSubstrSolver.h>
+#include <IncrementalIntegrator.h>
+#include <StaticIntegrator.h>
+#include <TransientIntegrator.h>
+#include <G3_Logging.h>
+#include "BasicAnalysisBuilder.h"
+#include "partitioning.h"
 
 // #  define MPIPP_H
 // #  include <DistributedSuperLU.h>
@@ -37,6 +49,8 @@
    FEM_ObjectBroker    *broker             = nullptr;
    DomainPartitioner   *DOMAIN_partitioner = nullptr;
    GraphPartitioner    *GRAPH_partitioner  = nullptr;
+   OpenSees::InterfacePartitioner *INTERFACE_partitioner = nullptr;
+   PartitionOptions     options;
 // LoadBalancer        *balancer           = nullptr;
    Channel             **channels          = nullptr;  
    int  num_subdomains    = 0;
@@ -45,13 +59,38 @@
    bool setMPIDSOEFlag    = false;
    int  main_partition    = 0;
    PartitionedDomain     theDomain;
+
+   // Analysis of the partitioned domain, and the commands it registered
+   // that are wrapped to keep the subdomain analyses in step
+   BasicAnalysisBuilder *builder = nullptr;
+   Tcl_CmdInfo           analyze, wipeAnalysis;
+
+   // Subdomains either condense their interior equations, and enter the
+   // interface system as super-elements, or take part in a solve of the
+   // full system by a distributed SOE
+   bool condense = true;
+
+   // Analyses sent to the subdomains, and the integrator and change stamp
+   // of the builder they were built from; the subdomain objects are only
+   // held until any component of the analysis changes
+   IncrementalIntegrator *attached = nullptr;
+   unsigned               stamp    = 0;
+   std::vector<DomainDecompositionAnalysis*> analyses;
+   std::vector<DomainDecompAlgo*>            algorithms;
+   std::vector<LinearSOE*>                   systems;
  };
 
 
 static int partitionModel(PartitionRuntime& part, int eleTag);
+static int attachAnalysis(PartitionRuntime& part);
+static void detachAnalysis(PartitionRuntime& part);
 static Tcl_CmdProc opsPartition;
+static Tcl_CmdProc analyzePartitioned;
+static Tcl_CmdProc wipePartitioned;
 static Tcl_CmdProc wipePP;
 extern Tcl_CmdProc TclCommand_specifyModel;
+extern int G3_AddTclDomainCommands(Tcl_Interp *, Domain*);
+extern BasicAnalysisBuilder* G3_AddTclAnalysisBuilder(Tcl_Interp *, Domain*);
 
 void 
 Init_PartitionRuntime(Tcl_Interp* interp, MachineBroker* theMachineBroker, FEM_ObjectBroker* theBroker)
@@ -79,26 +118,98 @@ Init_PartitionRuntime(Tcl_Interp* interp, MachineBroker* theMachineBroker, FEM_O
   Tcl_CreateCommand(interp, "partition", &opsPartition, (ClientData)part, (Tcl_CmdDeleteProc *)NULL);
   Tcl_CreateCommand(interp, "wipePP",    &wipePP,       (ClientData)part, (Tcl_CmdDeleteProc *)NULL);
   Tcl_CreateCommand(interp, "model",     &TclCommand_specifyModel,  (ClientData)&part->theDomain, (Tcl_CmdDeleteProc *)NULL);
-}
 
+  // The model command above is bound to the partitioned domain, so it
+  // does not create the domain and analysis commands itself
+  G3_AddTclDomainCommands(interp, &part->theDomain);
+  part->builder = G3_AddTclAnalysisBuilder(interp, &part->theDomain);
+
+  // Partition and attach the subdomain analyses before each analysis
+  Tcl_GetCommandInfo(interp, "analyze", &part->analyze);
+  Tcl_CreateCommand(interp, "analyze",   &analyzePartitioned, (ClientData)part, (Tcl_CmdDeleteProc *)NULL);
+  Tcl_GetCommandInfo(interp, "wipeAnalysis", &part->wipeAnalysis);
+  Tcl_CreateCommand(interp, "wipeAnalysis", &wipePartitioned, (ClientData)part, (Tcl_CmdDeleteProc *)NULL);
+}
 
 
+//
+// partition ?$eleTag? ?-condense | -distributed? <options>
+// partition -report ?-initial?
+//
+// The options of partitioning.h take effect when the model is first
+// partitioned. The report is the quality of the partition, as found by
+// Metis with -initial, and is empty until the model is partitioned.
+//
 int
 opsPartition(ClientData clientData, Tcl_Interp *interp, int argc,
              TCL_Char ** const argv)
 {
   PartitionRuntime& part = *static_cast<PartitionRuntime*>(clientData);
 
-  int eleTag;
-  if (argc == 2) {
-    if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK) {
-      ;
+  if (argc > 1 && strcmp(argv[1], "-report") == 0) {
+    if (part.INTERFACE_partitioner != nullptr && part.partitioned) {
+      const bool initial = argc > 2 && strcmp(argv[2], "-initial") == 0;
+      Tcl_SetObjResult(interp, metrics_result(interp, part.INTERFACE_partitioner->getMetrics(initial)));
     }
+    return TCL_OK;
+  }
+
+  int eleTag = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-condense") == 0)
+      part.condense = true;
+    else if (strcmp(argv[i], "-distributed") == 0)
+      part.condense = false;
+    else if (argv[i][0] == '-') {
+      if (parse_partition_option(interp, argc, argv, i, part.options) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (Tcl_GetInt(interp, argv[i], &eleTag) != TCL_OK) {
+      opserr << G3_ERROR_PROMPT << "invalid element tag or option " << argv[i] << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  // A change of method takes effect with the next analysis
+  if (part.attached != nullptr)
+    detachAnalysis(part);
+
+  if (partitionModel(part, eleTag) < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to partition the model\n";
+    return TCL_ERROR;
   }
-  partitionModel(part, eleTag);
   return TCL_OK;
 }
 
+static int
+analyzePartitioned(ClientData clientData, Tcl_Interp *interp, int argc,
+                   TCL_Char ** const argv)
+{
+  PartitionRuntime& part = *static_cast<PartitionRuntime*>(clientData);
+
+  if (part.num_subdomains > 1) {
+    if (partitionModel(part, 0) < 0) {
+      opserr << G3_ERROR_PROMPT << "failed to partition the model\n";
+      return TCL_ERROR;
+    }
+    if (attachAnalysis(part) != 0)
+      return TCL_ERROR;
+  }
+
+  return part.analyze.proc(part.analyze.clientData, interp, argc, argv);
+}
+
+static int
+wipePartitioned(ClientData clientData, Tcl_Interp *interp, int argc,
+                TCL_Char ** const argv)
+{
+  PartitionRuntime& part = *static_cast<PartitionRuntime*>(clientData);
+
+  // the subdomain analyses refer to the components about to be deleted
+  detachAnalysis(part);
+  return part.wipeAnalysis.proc(part.wipeAnalysis.clientData, interp, argc, argv);
+}
+
 static int
 partitionModel(PartitionRuntime& part, int eleTag)
 {
@@ -127,9 +238,12 @@ partitionModel(PartitionRuntime& part, int eleTag)
     //      part.balancer = new ShedHeaviest();
     // OPS_DOMAIN_partitioner = new DomainPartitioner(*OPS_GRAPH_partitioner, *part.balancer);
     part.GRAPH_partitioner = new Metis;
-    part.DOMAIN_partitioner = new DomainPartitioner(*part.GRAPH_partitioner);
+    part.INTERFACE_partitioner = new OpenSees::InterfacePartitioner(part.theDomain, *part.GRAPH_partitioner);
+    part.DOMAIN_partitioner = new DomainPartitioner(*part.INTERFACE_partitioner);
     part.theDomain.setPartitioner(part.DOMAIN_partitioner);
   }
+  if (setup_partitioner(*part.INTERFACE_partitioner, part.options) != 0)
+    return -1;
 
   result = part.theDomain.partition(part.num_subdomains, part.using_main_domain,
                                     part.main_partition, eleTag);
@@ -139,28 +253,130 @@ partitionModel(PartitionRuntime& part, int eleTag)
 
   part.partitioned = true;
 
-  DomainDecompositionAnalysis *theSubAnalysis;
+  if (!part.options.to.empty() && part.INTERFACE_partitioner->writeAssignment(part.options.to.c_str()) != 0) {
+    opserr << G3_ERROR_PROMPT << "failed to write the parts of the elements to " << part.options.to.c_str() << "\n";
+    return -1;
+  }
+
+  return result;
+}
+
+//
+// Send each subdomain the analysis it performs for the current analysis
+// of the partitioned domain.
+//
+// When condensing, a subdomain numbers its interface equations last,
+// factors its interior equations with a substructuring solver, and
+// returns the condensed tangent and residual on the interface. The
+// subdomains are then super-elements of the partitioned domain, and the
+// interface system is assembled and solved with the SOE of the analysis,
+// on the primary rank or distributed if that SOE is. The interior
+// response is recovered in parallel when the subdomains are updated.
+//
+// Otherwise, the subdomains form and assemble their contributions to the
+// full system, which the SOE of the analysis must solve in a distributed
+// way.
+//
+// The components of the analysis are those of the partitioned domain;
+// they are sent to the subdomains, which construct their own copies, and
+// so are not linked to the subdomain here.
+//
+static int
+attachAnalysis(PartitionRuntime& part)
+{
+  BasicAnalysisBuilder& builder = *part.builder;
+
+  IncrementalIntegrator *integrator = nullptr;
+  if (builder.CurrentAnalysisFlag == BasicAnalysisBuilder::STATIC_ANALYSIS)
+    integrator = builder.getStaticIntegrator();
+  else if (builder.CurrentAnalysisFlag == BasicAnalysisBuilder::TRANSIENT_ANALYSIS)
+    integrator = builder.getTransientIntegrator();
+
+  if (integrator == nullptr) {
+    opserr << G3_ERROR_PROMPT << "an analysis must be defined before the partitioned model is analyzed\n";
+    return -1;
+  }
+
+  if (integrator == part.attached && builder.getChangeStamp() == part.stamp)
+    return 0;
+
+  detachAnalysis(part);
+
+  ConstraintHandler *handler   = builder.getConstraintHandler();
+  DOF_Numberer      *numberer  = builder.getNumberer();
+  AnalysisModel     *model     = builder.getAnalysisModel();
+  EquiSolnAlgo      *algorithm = builder.getAlgorithm();
+  LinearSOE         *system    = builder.getLinearSOE();
+  ConvergenceTest   *test      = builder.getConvergenceTest();
+
+  if (handler == nullptr || numberer == nullptr || model == nullptr
+      || algorithm == nullptr || system == nullptr) {
+    opserr << G3_ERROR_PROMPT << "the analysis of the partitioned model is incomplete\n";
+    return -1;
+  }
+
   SubdomainIter &theSubdomains = part.theDomain.getSubdomains();
   Subdomain *theSub = nullptr;
-
-  void* the_static_analysis = nullptr;
-#if 0
-  // create the appropriate domain decomposition analysis
   while ((theSub = theSubdomains()) != nullptr) {
-    if (the_static_analysis != nullptr) {
+    DomainDecompositionAnalysis *theSubAnalysis = nullptr;
+
+    if (part.condense) {
+      ProfileSPDLinSubstrSolver *theSolver = new ProfileSPDLinSubstrSolver();
+      LinearSOE *theSOE = new ProfileSPDLinSOE(*theSolver);
+      DomainDecompAlgo *theAlgorithm = new DomainDecompAlgo();
+      theSubAnalysis = new DomainDecompositionAnalysis(
+          *theSub, *handler, *numberer, *model, *theAlgorithm,
+          *integrator, *theSOE, *theSolver, false);
+      part.algorithms.push_back(theAlgorithm);
+      part.systems.push_back(theSOE);
+
+    } else if (builder.CurrentAnalysisFlag == BasicAnalysisBuilder::STATIC_ANALYSIS) {
       theSubAnalysis = new StaticDomainDecompositionAnalysis(
-          *theSub, *theHandler, *theNumberer, *the_analysis_model, *theAlgorithm,
-          *theSOE, *theStaticIntegrator, theTest, false);
+          *theSub, *handler, *numberer, *model, *algorithm,
+          *system, *builder.getStaticIntegrator(), test, false);
 
     } else {
       theSubAnalysis = new TransientDomainDecompositionAnalysis(
-          *theSub, *theHandler, *theNumberer, *the_analysis_model, *theAlgorithm,
-          *theSOE, *theTransientIntegrator, theTest, false);
+          *theSub, *handler, *numberer, *model, *algorithm,
+          *system, *builder.getTransientIntegrator(), test, false);
     }
-    theSub->setDomainDecompAnalysis(*theSubAnalysis);
+
+    if (theSub->setDomainDecompAnalysis(*theSubAnalysis) < 0) {
+      opserr << G3_ERROR_PROMPT << "failed to set the analysis of subdomain "
+             << theSub->getTag() << "\n";
+      delete theSubAnalysis;
+      detachAnalysis(part);
+      return -1;
+    }
+    part.analyses.push_back(theSubAnalysis);
   }
-#endif
-  return result;
+
+  part.attached = integrator;
+  part.stamp    = builder.getChangeStamp();
+  return 0;
+}
+
+static void
+detachAnalysis(PartitionRuntime& part)
+{
+  if (part.partitioned) {
+    SubdomainIter &theSubdomains = part.theDomain.getSubdomains();
+    Subdomain *theSub = nullptr;
+    while ((theSub = theSubdomains()) != nullptr)
+      theSub->wipeAnalysis();
+  }
+
+  for (DomainDecompositionAnalysis *analysis : part.analyses)
+    delete analysis;
+  for (DomainDecompAlgo *algorithm : part.algorithms)
+    delete algorithm;
+  for (LinearSOE *system : part.systems)
+    delete system;
+
+  part.analyses.clear();
+  part.algorithms.clear();
+  part.systems.clear();
+  part.attached = nullptr;
 }
 
 
@@ -169,14 +385,9 @@ wipePP(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
   PartitionRuntime& part = *static_cast<PartitionRuntime*>(clientData);
 
-  if (part.partitioned == true && part.num_subdomains > 1) {
-    SubdomainIter &theSubdomains = part.theDomain.getSubdomains();
-    Subdomain *theSub =nullptr;
-    
-    // create the appropriate domain decomposition analysis
-    while ((theSub = theSubdomains()) != nullptr)
-      theSub->wipeAnalysis();
-  }
+  if (part.partitioned == true && part.num_subdomains > 1)
+    detachAnalysis(part);
+
   return TCL_OK;  
 }
 
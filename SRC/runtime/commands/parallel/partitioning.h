@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Options and results of the partition commands of the
+// parallel interpreters, which find the parts of a model with an
+// InterfacePartitioner over Metis:
+//
+//   -import $file    reuse the parts of the elements in file
+//   -export $file    write the parts of the elements to file
+//   -tolerance $tol  allowed excess of the heaviest part over the mean
+//   -metis           keep the parts found by Metis
+//
+#ifndef OpenSees_partitioning_h
+#define OpenSees_partitioning_h
+
+#include <tcl.h>
+#include <string.h>
+#include <string>
+#include <G3_Logging.h>
+#include <InterfacePartitioner.h>
+
+struct PartitionOptions {
+  std::string from;                  // file of a previous assignment
+  std::string to;                    // file for this assignment
+  double      tolerance = 0.05;
+  bool        refine    = true;
+};
+
+// Parse the option at argv[i], advancing i past its argument
+static inline int
+parse_partition_option(Tcl_Interp* interp, int argc, const char* const* argv, int& i,
+                       PartitionOptions& options)
+{
+  if (strcmp(argv[i], "-import") == 0 && i + 1 < argc)
+    options.from = argv[++i];
+  else if (strcmp(argv[i], "-export") == 0 && i + 1 < argc)
+    options.to = argv[++i];
+  else if (strcmp(argv[i], "-tolerance") == 0 && i + 1 < argc) {
+    if (Tcl_GetDouble(interp, argv[++i], &options.tolerance) != TCL_OK || options.tolerance < 0.0) {
+      opserr << G3_ERROR_PROMPT << "invalid tolerance " << argv[i] << "\n";
+      return TCL_ERROR;
+    }
+  }
+  else if (strcmp(argv[i], "-metis") == 0)
+    options.refine = false;
+  else {
+    opserr << G3_ERROR_PROMPT << "unknown option " << argv[i] << "\n";
+    return TCL_ERROR;
+  }
+  return TCL_OK;
+}
+
+// Apply the options to the partitioner before the model is partitioned
+static inline int
+setup_partitioner(OpenSees::InterfacePartitioner& partitioner, const PartitionOptions& options)
+{
+  partitioner.setTolerance(options.tolerance);
+  partitioner.setRefine(options.refine);
+  if (!options.from.empty()) {
+    std::map<int, int> parts;
+    if (OpenSees::InterfacePartitioner::readAssignment(options.from.c_str(), parts) != 0) {
+      opserr << G3_ERROR_PROMPT << "failed to read the parts of the elements from " << options.from.c_str() << "\n";
+      return -1;
+    }
+    partitioner.setAssignment(parts);
+  }
+  return 0;
+}
+
+//
+// A dictionary of the quality of a partition: edgeCut, interfaceNodes,
+// interfaceDOFs, cutConstraints and imbalance, and the elements and
+// dofs of each part
+//
+static inline Tcl_Obj*
+metrics_result(Tcl_Interp* interp, const OpenSees::PartitionMetrics& metrics)
+{
+  Tcl_Obj *result = Tcl_NewDictObj();
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("parts", -1),          Tcl_NewIntObj(metrics.numParts));
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("edgeCut", -1),        Tcl_NewIntObj(metrics.edgeCut));
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("interfaceNodes", -1), Tcl_NewIntObj(metrics.interfaceNodes));
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("interfaceDOFs", -1),  Tcl_NewIntObj(metrics.interfaceDOFs));
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("cutConstraints", -1), Tcl_NewIntObj(metrics.cutConstraints));
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("imbalance", -1),      Tcl_NewDoubleObj(metrics.imbalance));
+
+  Tcl_Obj *elements = Tcl_NewListObj(0, nullptr),
+          *dofs     = Tcl_NewListObj(0, nullptr);
+  for (int p = 0; p < metrics.numParts; p++) {
+    Tcl_ListObjAppendElement(interp, elements, Tcl_NewIntObj(metrics.elements[p]));
+    Tcl_ListObjAppendElement(interp, dofs,     Tcl_NewIntObj(metrics.dofs[p]));
+  }
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("elements", -1), elements);
+  Tcl_DictObjPut(interp, result, Tcl_NewStringObj("dofs", -1),     dofs);
+  return result;
+}
+
+#endif
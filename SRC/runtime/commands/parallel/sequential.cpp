@@ -8,6 +8,8 @@
 // for use in non-parallel interpreters
 //
 #include <tcl.h>
+#include <string.h>
+#include <Reduction.h>
 #define TCL_Char CONST84 char
 
 Tcl_CmdProc getPIDSequential;
@@ -16,6 +18,8 @@ Tcl_CmdProc opsBarrierSequential;
 Tcl_CmdProc opsSendSequential;
 Tcl_CmdProc opsRecvSequential;
 Tcl_CmdProc opsPartitionSequential;
+Tcl_ObjCmdProc collectiveSequential;
+Tcl_ObjCmdProc reductionSequential;
 
 void G3_InitTclSequentialAPI(Tcl_Interp* interp)
 {
@@ -25,6 +29,14 @@ void G3_InitTclSequentialAPI(Tcl_Interp* interp)
 //Tcl_CreateCommand(interp, "send",      &opsSendSequential, (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
   Tcl_CreateCommand(interp, "recv",      &opsRecvSequential, (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
   Tcl_CreateCommand(interp, "partition", &opsPartitionSequential, (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+
+  // with a single process the numeric collectives only return the values
+  // that the process contributes
+  static const char* collectives[] = {"broadcast", "gather", "scatter", "allreduce"};
+  for (const char* name : collectives)
+    Tcl_CreateObjCommand(interp, name, &collectiveSequential, (ClientData)name, nullptr);
+
+  Tcl_CreateObjCommand(interp, "reduction", &reductionSequential, (ClientData)NULL, nullptr);
 }
 
 
@@ -71,6 +83,84 @@ opsRecvSequential(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char
 }
 
 
+int
+collectiveSequential(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  const char *name = static_cast<const char*>(clientData);
+
+  // the values are the last argument; options take one argument,
+  // except for gather -all
+  Tcl_Obj *data = nullptr;
+  for (int i = 1; i < objc; i++) {
+    const char *arg = Tcl_GetString(objv[i]);
+    if (arg[0] == '-' && strcmp(arg, "-all") != 0 && i + 1 < objc)
+      i++;
+    else if (strcmp(arg, "-all") != 0)
+      data = objv[i];
+  }
+
+  if (data == nullptr) {
+    Tcl_SetObjResult(interp, Tcl_ObjPrintf("%s requires a list of values", name));
+    return TCL_ERROR;
+  }
+
+  if (strcmp(name, "scatter") == 0) {
+    int n;
+    Tcl_Obj **lists;
+    if (Tcl_ListObjGetElements(interp, data, &n, &lists) != TCL_OK)
+      return TCL_ERROR;
+    if (n != 1) {
+      Tcl_SetObjResult(interp, Tcl_NewStringObj("scatter requires a list of values for each of the 1 processes", -1));
+      return TCL_ERROR;
+    }
+    data = lists[0];
+  }
+
+  // convert to doubles as the parallel commands do
+  int n;
+  Tcl_Obj **items;
+  if (Tcl_ListObjGetElements(interp, data, &n, &items) != TCL_OK)
+    return TCL_ERROR;
+  Tcl_Obj *values = Tcl_NewListObj(0, nullptr);
+  for (int i = 0; i < n; i++) {
+    double value;
+    if (Tcl_GetDoubleFromObj(interp, items[i], &value) != TCL_OK) {
+      Tcl_DecrRefCount(values);
+      return TCL_ERROR;
+    }
+    Tcl_ListObjAppendElement(interp, values, Tcl_NewDoubleObj(value));
+  }
+
+  if (strcmp(name, "gather") == 0)
+    values = Tcl_NewListObj(1, &values);
+
+  Tcl_SetObjResult(interp, values);
+  return TCL_OK;
+}
+
+
+//
+// With a single process every summation gives the same result; the
+// selection is kept so that scripts may query it
+//
+int
+reductionSequential(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  if (objc > 1) {
+    OpenSees::Summation mode;
+    if (!OpenSees::parse_summation(Tcl_GetString(objv[1]), mode)) {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown summation %s, expected native, ordered or compensated",
+                                             Tcl_GetString(objv[1])));
+      return TCL_ERROR;
+    }
+    OpenSees::summation() = mode;
+  }
+
+  Tcl_SetObjResult(interp, Tcl_NewStringObj(OpenSees::summation_name(OpenSees::summation()), -1));
+  return TCL_OK;
+}
+
+
 #if 0
 int
 opsSendSequential(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
@@ -0,0 +1,143 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file implements the logging command, which configures
+// messages written through OPS_LOG.
+//
+//   logging level  $level ?$module?
+//   logging filter $spec          ;# e.g., warning,material=debug
+//   logging rate   $burst $seconds
+//   logging format text|json
+//   logging file   $path|stderr|stdout|opserr
+//   logging async  $bool
+//   logging flush
+//   logging message $level $module $text
+//
+// Messages go through opserr, and so follow logFile, until a file is
+// set; async only applies to a file. A message logged from a script is
+// filtered and rate limited like an OPS_LOG statement, with one site for
+// each level and module.
+//
+// Author: cmp
+//
+#include <string.h>
+#include <map>
+#include <string>
+#include <tcl.h>
+#include <Log.h>
+
+namespace Log = OpenSees::Log;
+
+int
+TclObjCommand_logging([[maybe_unused]] ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  if (objc < 2) {
+    Tcl_WrongNumArgs(interp, 1, objv, "level|filter|rate|format|file|async|flush|message ?args?");
+    return TCL_ERROR;
+  }
+
+  const char *action = Tcl_GetString(objv[1]);
+
+  if (strcmp(action, "flush") == 0) {
+    Log::flush();
+    return TCL_OK;
+  }
+
+  if (strcmp(action, "rate") == 0) {
+    int burst;
+    double seconds;
+    if (objc != 4) {
+      Tcl_WrongNumArgs(interp, 2, objv, "burst seconds");
+      return TCL_ERROR;
+    }
+    if (Tcl_GetIntFromObj(interp, objv[2], &burst) != TCL_OK
+        || Tcl_GetDoubleFromObj(interp, objv[3], &seconds) != TCL_OK)
+      return TCL_ERROR;
+
+    Log::setRate(burst, seconds);
+    return TCL_OK;
+  }
+
+  if (strcmp(action, "message") == 0) {
+    if (objc != 5) {
+      Tcl_WrongNumArgs(interp, 2, objv, "level module text");
+      return TCL_ERROR;
+    }
+    const char *name = Tcl_GetString(objv[2]);
+    Log::Level level;
+    if (Log::parseLevel(name, level) != 0) {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown level \"%s\"", name));
+      return TCL_ERROR;
+    }
+
+    // Sites are registered with the log, so they are never destroyed
+    static auto *sites = new std::map<std::string, Log::Site*>;
+    const std::string module = Tcl_GetString(objv[3]);
+    Log::Site *&site = (*sites)[std::string(name) + " " + module];
+    if (site == nullptr)
+      site = new Log::Site(Log::module(module.c_str()), level, "script", 0);
+
+    if (site->enabled())
+      Log::emit(*site, "%s", Tcl_GetString(objv[4]));
+    return TCL_OK;
+  }
+
+  if (objc < 3) {
+    Tcl_WrongNumArgs(interp, 2, objv, "value");
+    return TCL_ERROR;
+  }
+
+  const char *value = Tcl_GetString(objv[2]);
+
+  if (strcmp(action, "level") == 0) {
+    Log::Level level;
+    if (Log::parseLevel(value, level) != 0) {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown level \"%s\"", value));
+      return TCL_ERROR;
+    }
+    Log::setLevel(level, objc > 3 ? Tcl_GetString(objv[3]) : nullptr);
+    return TCL_OK;
+  }
+
+  else if (strcmp(action, "filter") == 0) {
+    if (Log::setFilter(value) != 0) {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("invalid filter \"%s\"", value));
+      return TCL_ERROR;
+    }
+    return TCL_OK;
+  }
+
+  else if (strcmp(action, "format") == 0) {
+    if (strcmp(value, "text") == 0)
+      Log::setFormat(Log::Format::Text);
+    else if (strcmp(value, "json") == 0)
+      Log::setFormat(Log::Format::JSON);
+    else {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown format \"%s\"", value));
+      return TCL_ERROR;
+    }
+    return TCL_OK;
+  }
+
+  else if (strcmp(action, "file") == 0) {
+    if (Log::setFile(value) != 0) {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("failed to open \"%s\"", value));
+      return TCL_ERROR;
+    }
+    return TCL_OK;
+  }
+
+  else if (strcmp(action, "async") == 0) {
+    int async;
+    if (Tcl_GetBooleanFromObj(interp, objv[2], &async) != TCL_OK)
+      return TCL_ERROR;
+    Log::setAsync(async != 0);
+    return TCL_OK;
+  }
+
+  Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown action \"%s\"", action));
+  return TCL_ERROR;
+}
@@ -0,0 +1,202 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file implements the profile command, which exposes
+// the scope profiler to the interpreter.
+//
+//   profile start ?-file $path?
+//   profile stop
+//   profile reset
+//   profile dump ?$path?
+//
+// While profiling, each OpenSees command is timed as a scope named after
+// the command, so that phases instrumented in the analysis classes are
+// reported beneath the command that ran them (e.g., "analyze/solve").
+// Commands are timed by swapping their object procedure for a wrapper;
+// their string procedure and client data are left untouched so that
+// lookups through Tcl_GetCommandInfo are unaffected.
+//
+// Author: cmp
+//
+#include <string>
+#include <sstream>
+#include <string.h>
+#include <tcl.h>
+#include <Profiler.h>
+
+using OpenSees::Profiler;
+using OpenSees::ProfileScope;
+
+namespace {
+
+struct WrappedCommand {
+  std::string       name;
+  Tcl_ObjCmdProc   *objProc;
+  ClientData        objClientData;
+  Tcl_CmdDeleteProc*deleteProc;
+  ClientData        deleteData;
+  bool              rewrap;
+};
+
+// Commands after which new commands may have been created
+const char* const rewrap_commands[] = {
+  "model", "opensees::model", "wipe", "wipeAnalysis", "_clearAnalysis", "source"
+};
+
+int wrap_commands(Tcl_Interp *interp);
+
+int
+profiled_command(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  // The command may redefine itself, which frees the record
+  WrappedCommand &command = *static_cast<WrappedCommand*>(clientData);
+  Tcl_ObjCmdProc *proc = command.objProc;
+  ClientData      data = command.objClientData;
+  const bool    rewrap = command.rewrap;
+
+  int status;
+  {
+    ProfileScope scope(command.name.c_str());
+    status = proc(data, interp, objc, objv);
+  }
+
+  if (rewrap)
+    wrap_commands(interp);
+
+  return status;
+}
+
+void
+delete_wrapped(ClientData clientData)
+{
+  WrappedCommand *command = static_cast<WrappedCommand*>(clientData);
+  if (command->deleteProc != nullptr)
+    command->deleteProc(command->deleteData);
+  delete command;
+}
+
+bool
+wrap_command(Tcl_Interp *interp, const char *name)
+{
+  Tcl_CmdInfo info;
+  if (Tcl_GetCommandInfo(interp, name, &info) != 1 || info.objProc == profiled_command)
+    return false;
+
+  bool rewrap = false;
+  for (const char *rewrap_name : rewrap_commands)
+    if (strcmp(name, rewrap_name) == 0)
+      rewrap = true;
+
+  // Only commands created with Tcl_CreateCommand are wrapped, along with
+  // the few object commands that create others; Tcl's own object commands
+  // may be invoked without their objProc.
+  if (info.isNativeObjectProc && !rewrap)
+    return false;
+
+  WrappedCommand *command = new WrappedCommand{
+    name, info.objProc, info.objClientData, info.deleteProc, info.deleteData, rewrap
+  };
+
+  info.objProc       = profiled_command;
+  info.objClientData = command;
+  info.deleteProc    = delete_wrapped;
+  info.deleteData    = command;
+  Tcl_SetCommandInfo(interp, name, &info);
+  return true;
+}
+
+int
+wrap_commands(Tcl_Interp *interp)
+{
+  Tcl_InterpState state = Tcl_SaveInterpState(interp, TCL_OK);
+
+  int count = 0;
+  if (Tcl_Eval(interp, "info commands") == TCL_OK) {
+    Tcl_Obj *names = Tcl_GetObjResult(interp);
+    Tcl_IncrRefCount(names);
+
+    int n;
+    Tcl_Obj **elements;
+    if (Tcl_ListObjGetElements(interp, names, &n, &elements) == TCL_OK)
+      for (int i = 0; i < n; i++)
+        count += wrap_command(interp, Tcl_GetString(elements[i]));
+
+    Tcl_DecrRefCount(names);
+  }
+
+  for (const char *name : rewrap_commands)
+    count += wrap_command(interp, name);
+
+  Tcl_RestoreInterpState(interp, state);
+  return count;
+}
+
+} // namespace
+
+
+int
+TclObjCommand_profile(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  if (objc < 2) {
+    Tcl_WrongNumArgs(interp, 1, objv, "start|stop|reset|dump ?options?");
+    return TCL_ERROR;
+  }
+
+  const char *action = Tcl_GetString(objv[1]);
+
+  if (strcmp(action, "start") == 0) {
+    for (int i = 2; i < objc; i++) {
+      if (strcmp(Tcl_GetString(objv[i]), "-file") == 0 && i+1 < objc)
+        Profiler::setOutput(Tcl_GetString(objv[++i]));
+      else {
+        Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown option \"%s\"", Tcl_GetString(objv[i])));
+        return TCL_ERROR;
+      }
+    }
+    wrap_commands(interp);
+    Profiler::enable(true);
+    return TCL_OK;
+  }
+
+  else if (strcmp(action, "stop") == 0) {
+    Profiler::enable(false);
+    return TCL_OK;
+  }
+
+  else if (strcmp(action, "reset") == 0) {
+    Profiler::reset();
+    return TCL_OK;
+  }
+
+  else if (strcmp(action, "dump") == 0) {
+    if (objc > 2) {
+      if (Profiler::dump(Tcl_GetString(objv[2])) != 0) {
+        Tcl_SetObjResult(interp, Tcl_ObjPrintf("failed to open \"%s\"", Tcl_GetString(objv[2])));
+        return TCL_ERROR;
+      }
+      return TCL_OK;
+    }
+    std::ostringstream summary;
+    Profiler::dump(summary);
+    Tcl_SetObjResult(interp, Tcl_NewStringObj(summary.str().c_str(), -1));
+    return TCL_OK;
+  }
+
+  Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown action \"%s\"", action));
+  return TCL_ERROR;
+}
+
+//
+// Called when the interpreter is created; wraps the initial commands
+// when profiling was enabled from the environment.
+//
+int
+OPS_InitProfile(Tcl_Interp *interp)
+{
+  if (Profiler::enabled())
+    wrap_commands(interp);
+  return TCL_OK;
+}
@@ -0,0 +1,229 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file implements the spectrum command, which computes
+// the response spectra of many ground motion records at once.
+//
+//   spectrum -periods {$T ...} ?-damp {$zeta ...}?
+//            ?-ductility {$mu ...}? ?-hardening $alpha?
+//            ?-scale $factor? ?-threads $n?
+//            -values $dt {$ag ...} | -file $dt $path | -series $dt $tag ...
+//
+// Records may be given any number of times, and are sampled every dt.
+// The result is a dictionary with keys Sd, Sv, PSv and PSa, each a list
+// of spectra indexed by record, damping ratio and period. When target
+// ductilities are given, the key Ay holds the yield strength per unit
+// mass indexed by record, damping ratio, ductility and period.
+//
+// A -file holds only the accelerations, separated by white space.
+//
+// Author: cmp
+//
+#include <string.h>
+#include <vector>
+#include <fstream>
+#include <tcl.h>
+#include <runtimeAPI.h>
+#include <G3_Logging.h>
+#include <TimeSeries.h>
+#include "ResponseSpectra.h"
+
+static int
+get_doubles(Tcl_Interp *interp, Tcl_Obj *list, std::vector<double>& values)
+{
+  int n;
+  Tcl_Obj **items;
+  if (Tcl_ListObjGetElements(interp, list, &n, &items) != TCL_OK)
+    return TCL_ERROR;
+
+  values.resize(n);
+  for (int i = 0; i < n; i++)
+    if (Tcl_GetDoubleFromObj(interp, items[i], &values[i]) != TCL_OK)
+      return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+int
+TclObjCommand_spectrum(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+  std::vector<double> periods, damping{0.05}, ductility;
+  double hardening = 0.0,
+         scale = 1.0;
+  int threads = 1;
+
+  std::vector<std::vector<double>> values;
+  std::vector<double> steps;
+
+  for (int i = 1; i < objc; i++) {
+    const char *option = Tcl_GetString(objv[i]);
+
+    // Options with one argument
+    if (i + 1 == objc) {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("missing argument to %s", option));
+      return TCL_ERROR;
+    }
+
+    if (strcmp(option, "-periods") == 0) {
+      if (get_doubles(interp, objv[++i], periods) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (strcmp(option, "-damp") == 0) {
+      if (get_doubles(interp, objv[++i], damping) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (strcmp(option, "-ductility") == 0) {
+      if (get_doubles(interp, objv[++i], ductility) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (strcmp(option, "-hardening") == 0) {
+      if (Tcl_GetDoubleFromObj(interp, objv[++i], &hardening) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (strcmp(option, "-scale") == 0) {
+      if (Tcl_GetDoubleFromObj(interp, objv[++i], &scale) != TCL_OK)
+        return TCL_ERROR;
+    }
+    else if (strcmp(option, "-threads") == 0) {
+      if (Tcl_GetIntFromObj(interp, objv[++i], &threads) != TCL_OK)
+        return TCL_ERROR;
+    }
+
+    // Records, each with a time step and a source
+    else if (strcmp(option, "-values") == 0 ||
+             strcmp(option, "-file")   == 0 ||
+             strcmp(option, "-series") == 0) {
+      double dt;
+      if (i + 2 >= objc) {
+        Tcl_WrongNumArgs(interp, i + 1, objv, "dt source");
+        return TCL_ERROR;
+      }
+      if (Tcl_GetDoubleFromObj(interp, objv[i+1], &dt) != TCL_OK)
+        return TCL_ERROR;
+      if (dt <= 0.0) {
+        Tcl_SetObjResult(interp, Tcl_ObjPrintf("time step of %s must be positive", option));
+        return TCL_ERROR;
+      }
+
+      std::vector<double> ag;
+      if (option[1] == 'v') {
+        if (get_doubles(interp, objv[i+2], ag) != TCL_OK)
+          return TCL_ERROR;
+      }
+      else if (option[1] == 'f') {
+        std::ifstream file(Tcl_GetString(objv[i+2]));
+        if (!file) {
+          Tcl_SetObjResult(interp, Tcl_ObjPrintf("failed to open \"%s\"", Tcl_GetString(objv[i+2])));
+          return TCL_ERROR;
+        }
+        double a;
+        while (file >> a)
+          ag.push_back(a);
+        if (file.bad() || !file.eof()) {
+          Tcl_SetObjResult(interp, Tcl_ObjPrintf("failed to read \"%s\" after %d values",
+                                                 Tcl_GetString(objv[i+2]), static_cast<int>(ag.size())));
+          return TCL_ERROR;
+        }
+      }
+      else {
+        int tag;
+        if (Tcl_GetIntFromObj(interp, objv[i+2], &tag) != TCL_OK)
+          return TCL_ERROR;
+        TimeSeries *series = G3_getTimeSeries(G3_getRuntime(interp), tag);
+        if (series == nullptr) {
+          Tcl_SetObjResult(interp, Tcl_ObjPrintf("no TimeSeries with tag %d", tag));
+          return TCL_ERROR;
+        }
+        const int n = static_cast<int>(series->getDuration()/dt + 1.0e-9) + 1;
+        ag.resize(n);
+        for (int j = 0; j < n; j++)
+          ag[j] = series->getFactor(j*dt);
+        delete series;
+      }
+
+      for (double &a : ag)
+        a *= scale;
+
+      values.push_back(std::move(ag));
+      steps.push_back(dt);
+      i += 2;
+    }
+    else {
+      Tcl_SetObjResult(interp, Tcl_ObjPrintf("unknown option \"%s\"", option));
+      return TCL_ERROR;
+    }
+  }
+
+  if (periods.empty()) {
+    Tcl_SetObjResult(interp, Tcl_NewStringObj("spectrum requires -periods", -1));
+    return TCL_ERROR;
+  }
+
+  std::vector<OpenSees::GroundMotion> records;
+  for (std::size_t r = 0; r < values.size(); r++)
+    records.push_back({values[r].data(), static_cast<int>(values[r].size()), steps[r]});
+
+  OpenSees::ResponseSpectra spectra(periods, damping);
+  if (!ductility.empty() && spectra.setDuctility(ductility, hardening) != 0)
+    return TCL_ERROR;
+
+  if (spectra.compute(records, threads) != 0)
+    return TCL_ERROR;
+
+  //
+  // Collect the results
+  //
+  const int nr = spectra.getNumRecords(),
+            nd = spectra.getNumDamping(),
+            np = spectra.getNumPeriods(),
+            nm = spectra.getNumDuctility();
+
+  using Quantity = double (OpenSees::ResponseSpectra::*)(int, int, int) const;
+  const std::pair<const char*, Quantity> quantities[] = {
+    {"Sd",  &OpenSees::ResponseSpectra::displacement},
+    {"Sv",  &OpenSees::ResponseSpectra::velocity},
+    {"PSv", &OpenSees::ResponseSpectra::pseudoVelocity},
+    {"PSa", &OpenSees::ResponseSpectra::pseudoAcceleration},
+  };
+
+  Tcl_Obj *result = Tcl_NewDictObj();
+  for (const auto& [name, quantity] : quantities) {
+    Tcl_Obj *byRecord = Tcl_NewListObj(0, nullptr);
+    for (int r = 0; r < nr; r++) {
+      Tcl_Obj *byDamping = Tcl_NewListObj(0, nullptr);
+      for (int d = 0; d < nd; d++) {
+        Tcl_Obj *spectrum = Tcl_NewListObj(0, nullptr);
+        for (int p = 0; p < np; p++)
+          Tcl_ListObjAppendElement(interp, spectrum, Tcl_NewDoubleObj((spectra.*quantity)(r, d, p)));
+        Tcl_ListObjAppendElement(interp, byDamping, spectrum);
+      }
+      Tcl_ListObjAppendElement(interp, byRecord, byDamping);
+    }
+    Tcl_DictObjPut(interp, result, Tcl_NewStringObj(name, -1), byRecord);
+  }
+
+  if (nm > 0) {
+    Tcl_Obj *byRecord = Tcl_NewListObj(0, nullptr);
+    for (int r = 0; r < nr; r++) {
+      Tcl_Obj *byDamping = Tcl_NewListObj(0, nullptr);
+      for (int d = 0; d < nd; d++) {
+        Tcl_Obj *byDuctility = Tcl_NewListObj(0, nullptr);
+        for (int m = 0; m < nm; m++) {
+          Tcl_Obj *spectrum = Tcl_NewListObj(0, nullptr);
+          for (int p = 0; p < np; p++)
+            Tcl_ListObjAppendElement(interp, spectrum, Tcl_NewDoubleObj(spectra.yieldStrength(r, d, m, p)));
+          Tcl_ListObjAppendElement(interp, byDuctility, spectrum);
+        }
+        Tcl_ListObjAppendElement(interp, byDamping, byDuctility);
+      }
+      Tcl_ListObjAppendElement(interp, byRecord, byDamping);
+    }
+    Tcl_DictObjPut(interp, result, Tcl_NewStringObj("Ay", -1), byRecord);
+  }
+
+  Tcl_SetObjResult(interp, result);
+  return TCL_OK;
+}
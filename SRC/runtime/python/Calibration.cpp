@@ -0,0 +1,279 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Batched material and section histories for calibration.
+//
+// uniaxial_history and section_history drive copies of a material or
+// section through a whole deformation history in native code. Each copy
+// is a "variant" whose parameters may be changed through setParameter
+// before the history is run, so that an optimizer can evaluate many
+// candidate parameter sets with one call. Variants are run without
+// holding the GIL; material variants are run in parallel with the
+// thread pool, and section variants one after the other.
+//
+//   parameters  names passed to setParameter, e.g. ["Fy", "E"]
+//   values      array[nv, np] with the value of each parameter for
+//               each variant
+//   target      optional history of the response to compare against;
+//               the sum of squared differences of each variant is
+//               returned as its residual
+//
+// The deformation history may be shared by all variants or given per
+// variant. Histories are committed step by step from the initial state.
+//
+// Parallel material variants rely on the material keeping its state in
+// its own members. A few materials use scratch storage shared by the
+// class (static Vector or Matrix members, or wrappers of sections or
+// elements); their histories must be run with threads = 1.
+//
+// Author: cmp
+//
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <tcl.h>
+#include <threads/thread_pool.hpp>
+
+#include <runtime/runtime/BasicModelBuilder.h>
+#include "Interpreter.h"
+#include <UniaxialMaterial.h>
+#include <SectionForceDeformation.h>
+#include <FrameSection.h>
+#include <Parameter.h>
+#include <Matrix.h>
+#include <Vector.h>
+
+using Array = py::array_t<double, py::array::c_style|py::array::forcecast>;
+
+//
+// Create the variants of an object and set their parameters. This is
+// done serially since setParameter is not required to be reentrant.
+//
+template <typename T>
+static std::vector<std::unique_ptr<T>>
+make_variants(T &base, int nv,
+              const std::vector<std::string> &parameters,
+              const Array *values)
+{
+  const int np = static_cast<int>(parameters.size());
+  if (np > 0 && (values == nullptr || values->ndim() != 2 || values->shape(1) != np))
+    throw std::invalid_argument("values must have shape (variants, parameters)");
+
+  std::vector<std::unique_ptr<T>> variants(nv);
+  for (int v = 0; v < nv; v++) {
+    variants[v].reset(static_cast<T*>(base.getCopy()));
+    if (variants[v] == nullptr)
+      throw std::runtime_error("failed to copy object " + std::to_string(base.getTag()));
+
+    variants[v]->revertToStart();
+
+    for (int p = 0; p < np; p++) {
+      const char *argv[] = {parameters[p].c_str()};
+      Parameter param(0, nullptr, nullptr, 0);
+      if (variants[v]->setParameter(argv, 1, param) < 0)
+        throw std::invalid_argument("unknown parameter \"" + parameters[p] + "\"");
+      param.update(values->at(v, p));
+    }
+  }
+  return variants;
+}
+
+static int
+num_variants(const Array &history, int rank, const Array *values)
+{
+  if (history.ndim() == rank + 1)
+    return static_cast<int>(history.shape(0));
+  if (values != nullptr && values->ndim() == 2)
+    return static_cast<int>(values->shape(0));
+  return 1;
+}
+
+static py::dict
+uniaxial_history(py::object interpaddr, int tag, Array strain,
+                 std::vector<std::string> parameters,
+                 std::optional<Array> values,
+                 std::optional<Array> target,
+                 unsigned threads)
+{
+  BasicModelBuilder *builder = get_model_builder(interpaddr);
+  UniaxialMaterial *base = builder->getTypedObject<UniaxialMaterial>(tag);
+  if (base == nullptr)
+    throw std::invalid_argument("no uniaxialMaterial with tag " + std::to_string(tag));
+
+  if (strain.ndim() != 1 && strain.ndim() != 2)
+    throw std::invalid_argument("strain must have shape (steps,) or (variants, steps)");
+
+  const Array *vals = values ? &*values : nullptr;
+  const int nv = num_variants(strain, 1, vals);
+  const int nt = static_cast<int>(strain.shape(strain.ndim() - 1));
+  const bool shared = strain.ndim() == 1;
+
+  if (!shared && vals != nullptr && vals->shape(0) != nv)
+    throw std::invalid_argument("strain and values have a different number of variants");
+
+  if (target && target->size() != nt && target->size() != nv*nt)
+    throw std::invalid_argument("target must have shape (steps,) or (variants, steps)");
+
+  auto variants = make_variants(*base, nv, parameters, vals);
+
+  Array stress({nv, nt}), tangent({nv, nt}), residual(nv);
+  py::array_t<int> status(nv);
+
+  const double *e = strain.data();
+  const double *y = target ? target->data() : nullptr;
+  const bool shared_target = target && target->size() == nt;
+  double *s = stress.mutable_data(), *k = tangent.mutable_data(), *r = residual.mutable_data();
+  int *ok = status.mutable_data();
+
+  {
+    py::gil_scoped_release release;
+
+    OpenSees::thread_pool pool(threads);
+    pool.detach_loop<int>(0, nv, [&](int v) {
+      UniaxialMaterial &material = *variants[v];
+      const double *ev = shared ? e : e + v*nt;
+      const double *yv = y == nullptr ? nullptr : (shared_target ? y : y + v*nt);
+      double *sv = s + v*nt, *kv = k + v*nt;
+
+      int res = 0;
+      double sum = 0.0;
+      for (int i = 0; i < nt; i++) {
+        res += material.setTrial(ev[i], sv[i], kv[i]);
+        res += material.commitState();
+        if (yv != nullptr)
+          sum += (sv[i] - yv[i])*(sv[i] - yv[i]);
+      }
+      r[v]  = sum;
+      ok[v] = res;
+    });
+    pool.wait();
+  }
+
+  py::dict result;
+  result["stress"]  = stress;
+  result["tangent"] = tangent;
+  result["status"]  = status;
+  if (target)
+    result["residual"] = residual;
+  return result;
+}
+
+static py::dict
+section_history(py::object interpaddr, int tag, Array deformation,
+                std::vector<std::string> parameters,
+                std::optional<Array> values,
+                std::optional<Array> target)
+{
+  BasicModelBuilder *builder = get_model_builder(interpaddr);
+  // Frame sections (e.g., Elastic, Fiber, Aggregator) are registered
+  // apart from the other sections
+  SectionForceDeformation *base =
+      builder->getTypedObject<FrameSection>(tag, BasicModelBuilder::SilentLookup);
+  if (base == nullptr)
+    base = builder->getTypedObject<SectionForceDeformation>(tag);
+  if (base == nullptr)
+    throw std::invalid_argument("no section with tag " + std::to_string(tag));
+
+  const int nd = base->getOrder();
+  if ((deformation.ndim() != 2 && deformation.ndim() != 3)
+      || deformation.shape(deformation.ndim() - 1) != nd)
+    throw std::invalid_argument("deformation must have shape (steps, order) or (variants, steps, order)");
+
+  const Array *vals = values ? &*values : nullptr;
+  const int nv = num_variants(deformation, 2, vals);
+  const int nt = static_cast<int>(deformation.shape(deformation.ndim() - 2));
+  const bool shared = deformation.ndim() == 2;
+
+  if (!shared && vals != nullptr && vals->shape(0) != nv)
+    throw std::invalid_argument("deformation and values have a different number of variants");
+
+  if (target && target->size() != nt*nd && target->size() != nv*nt*nd)
+    throw std::invalid_argument("target must have shape (steps, order) or (variants, steps, order)");
+
+  auto variants = make_variants(*base, nv, parameters, vals);
+
+  Array stress({nv, nt, nd}), tangent({nv, nt, nd, nd}), residual(nv);
+  py::array_t<int> status(nv);
+
+  const double *e = deformation.data();
+  const double *y = target ? target->data() : nullptr;
+  const bool shared_target = target && target->size() == nt*nd;
+  double *s = stress.mutable_data(), *k = tangent.mutable_data(), *r = residual.mutable_data();
+  int *ok = status.mutable_data();
+
+  // Sections are run one after the other: many of them return their
+  // resultant and tangent in storage shared by all instances of the
+  // class (e.g., ElasticSection3d, WSection2d, NDFiberSection2d), so
+  // copies run concurrently would overwrite each other's results.
+  {
+    py::gil_scoped_release release;
+
+    for (int v = 0; v < nv; v++) {
+      SectionForceDeformation &section = *variants[v];
+      const double *ev = shared ? e : e + v*nt*nd;
+      const double *yv = y == nullptr ? nullptr : (shared_target ? y : y + v*nt*nd);
+
+      // one work vector per variant rather than one per step
+      Vector ei(nd);
+
+      int res = 0;
+      double sum = 0.0;
+      for (int i = 0; i < nt; i++) {
+        for (int j = 0; j < nd; j++)
+          ei(j) = ev[i*nd + j];
+
+        res += section.setTrialSectionDeformation(ei);
+
+        const Vector &si = section.getStressResultant();
+        const Matrix &ki = section.getSectionTangent();
+        double *sv = s + (v*nt + i)*nd;
+        double *kv = k + (v*nt + i)*nd*nd;
+        for (int j = 0; j < nd; j++) {
+          sv[j] = si(j);
+          for (int l = 0; l < nd; l++)
+            kv[j*nd + l] = ki(j, l);
+          if (yv != nullptr)
+            sum += (sv[j] - yv[i*nd + j])*(sv[j] - yv[i*nd + j]);
+        }
+        res += section.commitState();
+      }
+      r[v]  = sum;
+      ok[v] = res;
+    }
+  }
+
+  py::dict result;
+  result["stress"]  = stress;
+  result["tangent"] = tangent;
+  result["status"]  = status;
+  if (target)
+    result["residual"] = residual;
+  return result;
+}
+
+void
+init_calibration_module(py::module &m)
+{
+  m.def ("uniaxial_history", &uniaxial_history,
+         py::arg("interpaddr"), py::arg("tag"), py::arg("strain"),
+         py::arg("parameters") = std::vector<std::string>{},
+         py::arg("values")     = py::none(),
+         py::arg("target")     = py::none(),
+         py::arg("threads")    = 0
+  );
+  m.def ("section_history", &section_history,
+         py::arg("interpaddr"), py::arg("tag"), py::arg("deformation"),
+         py::arg("parameters") = std::vector<std::string>{},
+         py::arg("values")     = py::none(),
+         py::arg("target")     = py::none()
+  );
+}
@@ -0,0 +1,29 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Access to the interpreter and the builders of a model
+// from the address of its Tcl interpreter, shared by the parts of the
+// OpenSeesPyRT module. The definitions are in OpenSeesPyRT.cpp.
+//
+// Author: cmp
+//
+#ifndef OpenSeesPyRT_Interpreter_h
+#define OpenSeesPyRT_Interpreter_h
+
+#include <pybind11/pybind11.h>
+#include <tcl.h>
+
+class BasicModelBuilder;
+
+// Initialize the Tcl stubs for the interpreter at interpaddr, once
+// per interpreter, and return it
+Tcl_Interp *get_interp(pybind11::object interpaddr);
+
+// The model builder is the client data of the model commands; throws
+// std::runtime_error if no model has been defined
+BasicModelBuilder *get_model_builder(pybind11::object interpaddr);
+
+#endif
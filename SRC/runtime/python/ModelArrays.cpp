@@ -0,0 +1,543 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Columnar export and import of a model.
+//
+// get_model returns the model as a dict of NumPy arrays, one array per
+// field, instead of printing it as JSON:
+//
+//   nodes             tag, ndf, crd[n,ndm], mass[n,ndf]
+//   elements          tag, type, offsets, nodes
+//   uniaxialMaterials tag, type
+//   nDMaterials       tag, type
+//   sections          tag, type
+//   sp                node, dof, value
+//   mp                retained, constrained, offsets, cdof, roffsets,
+//                     rdof, matrix
+//   patterns          tag, type
+//   loads             pattern, node, value[n,ndf]
+//
+// Variable length rows (element nodes, MP dofs) are stored in CSR form:
+// the entries of row i are [offsets[i], offsets[i+1]). The constraint
+// matrix of each MP is stored row by row, with its shape given by the
+// number of constrained and retained dofs. Class types are
+// stored as an index into the list in the "types" entry of the table.
+// Dofs are numbered from 1 as in the commands.
+//
+// set_model is the inverse for the parts of a model that are fully
+// described by the tables (nodes, constraints and nodal loads); elements,
+// materials and sections carry class-specific state and are still
+// created through their commands.
+//
+// Author: cmp
+//
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+namespace py = pybind11;
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <tcl.h>
+
+#include <runtime/runtime/BasicModelBuilder.h>
+#include "Interpreter.h"
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <SP_Constraint.h>
+#include <SP_ConstraintIter.h>
+#include <MP_Constraint.h>
+#include <MP_ConstraintIter.h>
+#include <LoadPattern.h>
+#include <LoadPatternIter.h>
+#include <NodalLoad.h>
+#include <NodalLoadIter.h>
+#include <Channel.h>
+#include <UniaxialMaterial.h>
+#include <NDMaterial.h>
+#include <SectionForceDeformation.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+
+
+template <typename T>
+static py::array_t<T>
+new_array(std::vector<py::ssize_t> shape)
+{
+  py::array_t<T> array(shape);
+  std::fill_n(array.mutable_data(), array.size(), T{});
+  return array;
+}
+
+// Maps class types to a dense index
+class TypeTable {
+public:
+  int operator()(const char *type) {
+    auto found = index.find(type);
+    if (found != index.end())
+      return found->second;
+    const int i = static_cast<int>(names.size());
+    index.emplace(type, i);
+    names.emplace_back(type);
+    return i;
+  }
+  py::list list() const {
+    py::list types;
+    for (const std::string &name : names)
+      types.append(name);
+    return types;
+  }
+private:
+  std::map<std::string, int> index;
+  std::vector<std::string> names;
+};
+
+template <typename T>
+static py::dict
+get_registry(BasicModelBuilder &builder)
+{
+  std::vector<std::pair<int, T*>> objects;
+  builder.forEachObject<T>([&](int tag, T* obj) {
+    objects.emplace_back(tag, obj);
+  });
+  std::sort(objects.begin(), objects.end(),
+            [](auto &a, auto &b) {return a.first < b.first;});
+
+  const py::ssize_t n = objects.size();
+  auto tag  = new_array<int>({n});
+  auto type = new_array<int>({n});
+  TypeTable types;
+  for (py::ssize_t i = 0; i < n; i++) {
+    tag.mutable_at(i)  = objects[i].first;
+    type.mutable_at(i) = types(objects[i].second->getClassType());
+  }
+
+  py::dict table;
+  table["tag"]   = tag;
+  table["type"]  = type;
+  table["types"] = types.list();
+  return table;
+}
+
+static py::dict
+get_nodes(Domain &domain, int ndm, int ndf)
+{
+  const py::ssize_t n = domain.getNumNodes();
+
+  // nodes may have been created with -ndf
+  NodeIter &iter = domain.getNodes();
+  Node *node;
+  while ((node = iter()) != nullptr)
+    ndf = std::max(ndf, node->getNumberDOF());
+
+  auto tag  = new_array<int>({n});
+  auto dofs = new_array<int>({n});
+  auto crd  = new_array<double>({n, ndm});
+  auto mass = new_array<double>({n, ndf});
+
+  py::ssize_t i = 0;
+  NodeIter &nodes = domain.getNodes();
+  while ((node = nodes()) != nullptr && i < n) {
+    tag.mutable_at(i)  = node->getTag();
+    dofs.mutable_at(i) = node->getNumberDOF();
+
+    const Vector &x = node->getCrds();
+    for (int j = 0; j < std::min(ndm, x.Size()); j++)
+      crd.mutable_at(i, j) = x(j);
+
+    const Matrix &m = node->getMass();
+    for (int j = 0; j < std::min(m.noRows(), ndf); j++)
+      mass.mutable_at(i, j) = m(j, j);
+    i++;
+  }
+
+  py::dict table;
+  table["tag"]  = tag;
+  table["ndf"]  = dofs;
+  table["crd"]  = crd;
+  table["mass"] = mass;
+  return table;
+}
+
+static py::dict
+get_elements(Domain &domain)
+{
+  const py::ssize_t n = domain.getNumElements();
+
+  std::vector<int> connectivity;
+  connectivity.reserve(2*n);
+
+  auto tag     = new_array<int>({n});
+  auto type    = new_array<int>({n});
+  auto offsets = new_array<int>({n + 1});
+  TypeTable types;
+
+  py::ssize_t i = 0;
+  ElementIter &elements = domain.getElements();
+  Element *element;
+  while ((element = elements()) != nullptr && i < n) {
+    tag.mutable_at(i)  = element->getTag();
+    type.mutable_at(i) = types(element->getClassType());
+    const ID &nodes = element->getExternalNodes();
+    for (int j = 0; j < nodes.Size(); j++)
+      connectivity.push_back(nodes(j));
+    offsets.mutable_at(++i) = static_cast<int>(connectivity.size());
+  }
+
+  py::array_t<int> nodes(connectivity.size(), connectivity.data());
+
+  py::dict table;
+  table["tag"]     = tag;
+  table["type"]    = type;
+  table["types"]   = types.list();
+  table["offsets"] = offsets;
+  table["nodes"]   = nodes;
+  return table;
+}
+
+static py::dict
+get_sp(Domain &domain)
+{
+  std::vector<int> node, dof;
+  std::vector<double> value;
+
+  SP_ConstraintIter &sps = domain.getSPs();
+  SP_Constraint *sp;
+  while ((sp = sps()) != nullptr) {
+    node.push_back(sp->getNodeTag());
+    dof.push_back(sp->getDOF_Number() + 1);
+    value.push_back(sp->getValue());
+  }
+
+  py::dict table;
+  table["node"]  = py::array_t<int>(node.size(), node.data());
+  table["dof"]   = py::array_t<int>(dof.size(), dof.data());
+  table["value"] = py::array_t<double>(value.size(), value.data());
+  return table;
+}
+
+static py::dict
+get_mp(Domain &domain)
+{
+  std::vector<int> retained, constrained, offsets{0}, cdof, roffsets{0}, rdof;
+  std::vector<double> matrix;
+
+  MP_ConstraintIter &mps = domain.getMPs();
+  MP_Constraint *mp;
+  while ((mp = mps()) != nullptr) {
+    retained.push_back(mp->getNodeRetained());
+    constrained.push_back(mp->getNodeConstrained());
+
+    const ID &c = mp->getConstrainedDOFs();
+    for (int i = 0; i < c.Size(); i++)
+      cdof.push_back(c(i) + 1);
+    offsets.push_back(static_cast<int>(cdof.size()));
+
+    const ID &r = mp->getRetainedDOFs();
+    for (int i = 0; i < r.Size(); i++)
+      rdof.push_back(r(i) + 1);
+    roffsets.push_back(static_cast<int>(rdof.size()));
+
+    // Ccr is stored row by row; its shape follows from the dof counts
+    const Matrix &Ccr = mp->getConstraint();
+    for (int i = 0; i < c.Size(); i++)
+      for (int j = 0; j < r.Size(); j++)
+        matrix.push_back(Ccr(i, j));
+  }
+
+  py::dict table;
+  table["retained"]    = py::array_t<int>(retained.size(), retained.data());
+  table["constrained"] = py::array_t<int>(constrained.size(), constrained.data());
+  table["offsets"]     = py::array_t<int>(offsets.size(), offsets.data());
+  table["cdof"]        = py::array_t<int>(cdof.size(), cdof.data());
+  table["roffsets"]    = py::array_t<int>(roffsets.size(), roffsets.data());
+  table["rdof"]        = py::array_t<int>(rdof.size(), rdof.data());
+  table["matrix"]      = py::array_t<double>(matrix.size(), matrix.data());
+  return table;
+}
+
+//
+// The reference load of a NodalLoad is the only Vector that its sendSelf
+// sends; this channel keeps it, so that the load is read without applying
+// it to the node.
+//
+class LoadChannel : public Channel {
+public:
+  const Vector &getLoad() const {return load;}
+
+  int sendVector(int dbTag, int commitTag, const Vector &v, ChannelAddress *a = nullptr) {
+    load = v;
+    return 0;
+  }
+  int sendID(int dbTag, int commitTag, const ID &, ChannelAddress *a = nullptr) {return 0;}
+
+  // Nothing else is sent by a NodalLoad
+  char *addToProgram() {return nullptr;}
+  int setUpConnection() {return -1;}
+  int setNextAddress(const ChannelAddress &) {return -1;}
+  ChannelAddress *getLastSendersAddress() {return nullptr;}
+  int sendObj(int, MovableObject &, ChannelAddress *a = nullptr) {return -1;}
+  int recvObj(int, MovableObject &, FEM_ObjectBroker &, ChannelAddress *a = nullptr) {return -1;}
+  int sendMsg(int, int, const Message &, ChannelAddress *a = nullptr) {return -1;}
+  int recvMsg(int, int, Message &, ChannelAddress *a = nullptr) {return -1;}
+  int recvMsgUnknownSize(int, int, Message &, ChannelAddress *a = nullptr) {return -1;}
+  int sendMatrix(int, int, const Matrix &, ChannelAddress *a = nullptr) {return -1;}
+  int recvMatrix(int, int, Matrix &, ChannelAddress *a = nullptr) {return -1;}
+  int recvVector(int, int, Vector &, ChannelAddress *a = nullptr) {return -1;}
+  int recvID(int, int, ID &, ChannelAddress *a = nullptr) {return -1;}
+
+private:
+  Vector load;
+};
+
+static void
+get_patterns(Domain &domain, int ndf, py::dict &model)
+{
+  std::vector<int> tags, types, pattern, node;
+  std::vector<double> value;
+  TypeTable names;
+
+  LoadPatternIter &patterns = domain.getLoadPatterns();
+  LoadPattern *thePattern;
+  while ((thePattern = patterns()) != nullptr) {
+    tags.push_back(thePattern->getTag());
+    types.push_back(names(thePattern->getClassType()));
+
+    NodalLoadIter &loads = thePattern->getNodalLoads();
+    NodalLoad *load;
+    while ((load = loads()) != nullptr) {
+      LoadChannel channel;
+      if (load->sendSelf(0, channel) < 0)
+        continue;
+      const Vector &p = channel.getLoad();
+
+      pattern.push_back(thePattern->getTag());
+      node.push_back(load->getNodeTag());
+      for (int i = 0; i < ndf; i++)
+        value.push_back(i < p.Size() ? p(i) : 0.0);
+    }
+  }
+
+  py::dict table;
+  table["tag"]   = py::array_t<int>(tags.size(), tags.data());
+  table["type"]  = py::array_t<int>(types.size(), types.data());
+  table["types"] = names.list();
+  model["patterns"] = table;
+
+  py::dict loads;
+  const py::ssize_t n = node.size();
+  loads["pattern"] = py::array_t<int>(n, pattern.data());
+  loads["node"]    = py::array_t<int>(n, node.data());
+  py::array_t<double> values({n, static_cast<py::ssize_t>(ndf)});
+  std::copy(value.begin(), value.end(), values.mutable_data());
+  loads["value"]   = values;
+  model["loads"] = loads;
+}
+
+static py::dict
+get_model(py::object interpaddr)
+{
+  BasicModelBuilder *builder = get_model_builder(interpaddr);
+  Domain *domain = builder->getDomain();
+
+  const int ndm = builder->getNDM();
+  int ndf = builder->getNDF();
+
+  py::dict model;
+  model["ndm"] = ndm;
+  model["ndf"] = ndf;
+
+  py::dict nodes = get_nodes(*domain, ndm, ndf);
+  ndf = static_cast<int>(nodes["mass"].cast<py::array>().shape(1));
+  model["nodes"]    = nodes;
+  model["elements"] = get_elements(*domain);
+
+  model["uniaxialMaterials"] = get_registry<UniaxialMaterial>(*builder);
+  model["nDMaterials"]       = get_registry<NDMaterial>(*builder);
+  model["sections"]          = get_registry<SectionForceDeformation>(*builder);
+
+  model["sp"] = get_sp(*domain);
+  model["mp"] = get_mp(*domain);
+  get_patterns(*domain, ndf, model);
+
+  return model;
+}
+
+//
+// Import
+//
+template <typename T>
+static py::array_t<T, py::array::c_style|py::array::forcecast>
+column(const py::dict &table, const char *name)
+{
+  return table[name].cast<py::array_t<T, py::array::c_style|py::array::forcecast>>();
+}
+
+static void
+set_nodes(BasicModelBuilder &builder, const py::dict &table)
+{
+  Domain *domain = builder.getDomain();
+  const int ndm = builder.getNDM();
+
+  auto tag = column<int>(table, "tag");
+  auto crd = column<double>(table, "crd");
+  const py::ssize_t n = tag.size();
+
+  if (crd.ndim() != 2 || crd.shape(0) != n || crd.shape(1) < ndm)
+    throw std::invalid_argument("node coordinates must have shape (n, ndm)");
+
+  py::array_t<int, py::array::c_style|py::array::forcecast> dofs;
+  if (table.contains("ndf"))
+    dofs = column<int>(table, "ndf");
+
+  py::array_t<double, py::array::c_style|py::array::forcecast> mass;
+  if (table.contains("mass"))
+    mass = column<double>(table, "mass");
+
+  for (py::ssize_t i = 0; i < n; i++) {
+    const int ndf = dofs.size() == n ? dofs.at(i) : builder.getNDF();
+
+    Node *node = nullptr;
+    switch (ndm) {
+    case 1:
+      node = new Node(tag.at(i), ndf, crd.at(i, 0));
+      break;
+    case 2:
+      node = new Node(tag.at(i), ndf, crd.at(i, 0), crd.at(i, 1));
+      break;
+    case 3:
+      node = new Node(tag.at(i), ndf, crd.at(i, 0), crd.at(i, 1), crd.at(i, 2));
+      break;
+    default:
+      throw std::invalid_argument("unsupported model dimension");
+    }
+
+    if (mass.ndim() == 2 && mass.shape(0) == n) {
+      Matrix m(ndf, ndf);
+      bool massive = false;
+      for (int j = 0; j < std::min<py::ssize_t>(ndf, mass.shape(1)); j++) {
+        m(j, j) = mass.at(i, j);
+        massive = massive || m(j, j) != 0.0;
+      }
+      if (massive)
+        node->setMass(m);
+    }
+
+    if (domain->addNode(node) == false) {
+      delete node;
+      throw std::runtime_error("failed to add node " + std::to_string(tag.at(i)));
+    }
+  }
+}
+
+static void
+set_sp(Domain &domain, const py::dict &table)
+{
+  auto node  = column<int>(table, "node");
+  auto dof   = column<int>(table, "dof");
+  auto value = column<double>(table, "value");
+
+  for (py::ssize_t i = 0; i < node.size(); i++) {
+    SP_Constraint *sp = new SP_Constraint(node.at(i), dof.at(i) - 1, value.at(i), true);
+    if (domain.addSP_Constraint(sp) == false) {
+      delete sp;
+      throw std::runtime_error("failed to add constraint to node " + std::to_string(node.at(i)));
+    }
+  }
+}
+
+static void
+set_mp(Domain &domain, const py::dict &table)
+{
+  auto retained    = column<int>(table, "retained");
+  auto constrained = column<int>(table, "constrained");
+  auto offsets     = column<int>(table, "offsets");
+  auto cdof        = column<int>(table, "cdof");
+  auto roffsets    = column<int>(table, "roffsets");
+  auto rdof        = column<int>(table, "rdof");
+  auto matrix      = column<double>(table, "matrix");
+
+  int k = 0;
+  for (py::ssize_t i = 0; i < retained.size(); i++) {
+    const int nc = offsets.at(i + 1) - offsets.at(i);
+    const int nr = roffsets.at(i + 1) - roffsets.at(i);
+
+    ID c(nc), r(nr);
+    for (int j = 0; j < nc; j++)
+      c(j) = cdof.at(offsets.at(i) + j) - 1;
+    for (int j = 0; j < nr; j++)
+      r(j) = rdof.at(roffsets.at(i) + j) - 1;
+
+    Matrix Ccr(nc, nr);
+    for (int j = 0; j < nc; j++)
+      for (int l = 0; l < nr; l++)
+        Ccr(j, l) = matrix.at(k++);
+
+    MP_Constraint *mp = new MP_Constraint(retained.at(i), constrained.at(i), Ccr, c, r);
+    if (domain.addMP_Constraint(mp) == false) {
+      delete mp;
+      throw std::runtime_error("failed to add constraint to node " + std::to_string(constrained.at(i)));
+    }
+  }
+}
+
+static void
+set_loads(BasicModelBuilder &builder, const py::dict &table)
+{
+  Domain *domain = builder.getDomain();
+
+  auto pattern = column<int>(table, "pattern");
+  auto node    = column<int>(table, "node");
+  auto value   = column<double>(table, "value");
+  if (value.ndim() != 2 || value.shape(0) != node.size())
+    throw std::invalid_argument("load values must have shape (n, ndf)");
+
+  for (py::ssize_t i = 0; i < node.size(); i++) {
+    Node *theNode = domain->getNode(node.at(i));
+    if (theNode == nullptr)
+      throw std::runtime_error("no node with tag " + std::to_string(node.at(i)));
+
+    const int ndf = theNode->getNumberDOF();
+    Vector p(ndf);
+    for (int j = 0; j < std::min<py::ssize_t>(ndf, value.shape(1)); j++)
+      p(j) = value.at(i, j);
+
+    NodalLoad *load = new NodalLoad(builder.getNodalLoadTag(), node.at(i), p, false);
+    if (domain->addNodalLoad(load, pattern.at(i)) == false) {
+      delete load;
+      throw std::runtime_error("failed to add load to pattern " + std::to_string(pattern.at(i)));
+    }
+    builder.incrNodalLoadTag();
+  }
+}
+
+static void
+set_model(py::object interpaddr, py::dict model)
+{
+  BasicModelBuilder *builder = get_model_builder(interpaddr);
+  Domain *domain = builder->getDomain();
+
+  if (model.contains("nodes"))
+    set_nodes(*builder, model["nodes"].cast<py::dict>());
+  if (model.contains("sp"))
+    set_sp(*domain, model["sp"].cast<py::dict>());
+  if (model.contains("mp"))
+    set_mp(*domain, model["mp"].cast<py::dict>());
+  if (model.contains("loads"))
+    set_loads(*builder, model["loads"].cast<py::dict>());
+}
+
+void
+init_model_module(py::module &m)
+{
+  m.def ("get_model", &get_model, py::arg("interpaddr"));
+  m.def ("set_model", &set_model, py::arg("interpaddr"), py::arg("model"));
+}
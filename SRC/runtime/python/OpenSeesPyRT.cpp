@@ -11,9 +11,18 @@
 #include <pybind11/stl.h>
 namespace py = pybind11;
 
+#include <memory>
+#include <string>
+#include <vector>
+#include <tcl.h>
+
 #include <G3_Runtime.h>
 #include <elementAPI.h> // G3_getRuntime/SafeBuilder
 #include <runtime/runtime/BasicModelBuilder.h>
+#include <runtime/runtime/BasicAnalysisBuilder.h>
+#include <runtime/runtime/CompressedRowSOE.h>
+#include <LinearSOE.h>
+#include "Interpreter.h"
 
 #include <Domain.h>
 #include <Vector.h>
@@ -72,6 +81,274 @@ get_builder(py::object interpaddr) {
     return std::unique_ptr<BasicModelBuilder, py::nodelete>((BasicModelBuilder*)builder_addr);
 } // , py::return_value_policy::reference
 
+//
+// Direct command dispatch
+//
+// Commands are invoked through Tcl_EvalObjv with one Tcl_Obj per
+// argument, so that Python numbers and arrays are passed without first
+// being joined into a script and re-parsed by Tcl. Integers and doubles
+// keep their internal representation and only produce a string if the
+// command asks for one.
+//
+Tcl_Interp *
+get_interp(py::object interpaddr)
+{
+  Tcl_Interp *interp = static_cast<Tcl_Interp*>(PyLong_AsVoidPtr(interpaddr.ptr()));
+
+  static Tcl_Interp *stubs = nullptr;
+  if (stubs != interp) {
+    Tcl_InitStubs(interp, "8.6", 0);
+    stubs = interp;
+  }
+  return interp;
+}
+
+BasicModelBuilder *
+get_model_builder(py::object interpaddr)
+{
+  Tcl_CmdInfo info;
+  if (Tcl_GetCommandInfo(get_interp(interpaddr), "uniaxialMaterial", &info) != 1 || info.clientData == nullptr)
+    throw std::runtime_error("no model has been defined");
+
+  return static_cast<BasicModelBuilder*>(info.clientData);
+}
+
+static Tcl_Obj *
+new_tcl_obj(py::handle arg)
+{
+  PyObject *obj = arg.ptr();
+
+  if (PyBool_Check(obj))
+    return Tcl_NewStringObj(obj == Py_True ? "True" : "False", -1);
+
+  if (PyLong_Check(obj))
+    return Tcl_NewWideIntObj(static_cast<Tcl_WideInt>(PyLong_AsLongLong(obj)));
+
+  if (PyFloat_Check(obj))
+    return Tcl_NewDoubleObj(PyFloat_AS_DOUBLE(obj));
+
+  if (PyUnicode_Check(obj)) {
+    Py_ssize_t size;
+    const char *str = PyUnicode_AsUTF8AndSize(obj, &size);
+    return Tcl_NewStringObj(str, static_cast<int>(size));
+  }
+
+  // One-dimensional numeric arrays are converted without going through
+  // Python objects
+  if (py::isinstance<py::array>(arg)) {
+    py::array array = py::reinterpret_borrow<py::array>(arg);
+    const char kind = array.dtype().kind();
+    if (array.ndim() == 1 && (kind == 'f' || kind == 'i' || kind == 'u')) {
+      Tcl_Obj *list = Tcl_NewListObj(0, nullptr);
+      if (kind == 'f') {
+        auto data = py::array_t<double, ARRAY_FLAGS>::ensure(array);
+        const double *ptr = data.data();
+        for (py::ssize_t i = 0; i < data.size(); i++)
+          Tcl_ListObjAppendElement(nullptr, list, Tcl_NewDoubleObj(ptr[i]));
+      } else {
+        auto data = py::array_t<long long, ARRAY_FLAGS>::ensure(array);
+        const long long *ptr = data.data();
+        for (py::ssize_t i = 0; i < data.size(); i++)
+          Tcl_ListObjAppendElement(nullptr, list, Tcl_NewWideIntObj(ptr[i]));
+      }
+      return list;
+    }
+  }
+
+  // NumPy scalars
+  if (PyIndex_Check(obj))
+    return Tcl_NewWideIntObj(static_cast<Tcl_WideInt>(py::cast<long long>(arg)));
+
+  if (py::isinstance<py::sequence>(arg)) {
+    Tcl_Obj *list = Tcl_NewListObj(0, nullptr);
+    for (py::handle item : arg)
+      Tcl_ListObjAppendElement(nullptr, list, new_tcl_obj(item));
+    return list;
+  }
+
+  if (PyNumber_Check(obj))
+    return Tcl_NewDoubleObj(py::cast<double>(arg));
+
+  std::string str = py::str(arg);
+  return Tcl_NewStringObj(str.c_str(), static_cast<int>(str.size()));
+}
+
+// Convert a single word of a command result
+static bool
+from_tcl_obj(Tcl_Obj *obj, py::object &value)
+{
+  Tcl_WideInt i;
+  double d;
+  if (Tcl_GetWideIntFromObj(nullptr, obj, &i) == TCL_OK)
+    value = py::int_(static_cast<long long>(i));
+  else if (Tcl_GetDoubleFromObj(nullptr, obj, &d) == TCL_OK)
+    value = py::float_(d);
+  else
+    return false;
+  return true;
+}
+
+static py::object
+invoke(py::object interpaddr, const std::string &name, py::sequence args,
+       bool as_list, bool as_string, bool as_array)
+{
+  Tcl_Interp *interp = get_interp(interpaddr);
+
+  const py::ssize_t nargs = py::len(args);
+  std::vector<Tcl_Obj*> objv;
+  objv.reserve(nargs + 1);
+  objv.push_back(Tcl_NewStringObj(name.c_str(), static_cast<int>(name.size())));
+  for (py::handle arg : args)
+    objv.push_back(new_tcl_obj(arg));
+
+  for (Tcl_Obj *obj : objv)
+    Tcl_IncrRefCount(obj);
+
+  const int status = Tcl_EvalObjv(interp, static_cast<int>(objv.size()), objv.data(), 0);
+
+  for (Tcl_Obj *obj : objv)
+    Tcl_DecrRefCount(obj);
+
+  Tcl_Obj *result = Tcl_GetObjResult(interp);
+
+  if (status != TCL_OK) {
+    const char *info = Tcl_GetVar(interp, "errorInfo", TCL_GLOBAL_ONLY);
+    throw std::runtime_error(info != nullptr ? info : Tcl_GetString(result));
+  }
+
+  int length;
+  const char *string = Tcl_GetStringFromObj(result, &length);
+  if (length == 0)
+    return py::none();
+
+  if (as_string)
+    return py::str(string, length);
+
+  int objc;
+  Tcl_Obj **words;
+  if (Tcl_ListObjGetElements(nullptr, result, &objc, &words) != TCL_OK || objc == 0)
+    return py::str(string, length);
+
+  if (as_array) {
+    py::array_t<double> array(objc);
+    double *ptr = static_cast<double*>(array.request().ptr);
+    for (int i = 0; i < objc; i++)
+      if (Tcl_GetDoubleFromObj(nullptr, words[i], &ptr[i]) != TCL_OK)
+        return py::str(string, length);
+    return array;
+  }
+
+  if (objc == 1 && !as_list) {
+    py::object value;
+    if (from_tcl_obj(words[0], value))
+      return value;
+    return py::str(string, length);
+  }
+
+  py::list values(objc);
+  for (int i = 0; i < objc; i++) {
+    py::object value;
+    if (!from_tcl_obj(words[i], value))
+      return py::str(string, length);
+    values[i] = value;
+  }
+  return values;
+}
+
+//
+// Linear system access
+//
+// The analysis builder is the client data of the analysis commands.
+//
+static BasicAnalysisBuilder *
+get_analysis_builder(Tcl_Interp *interp)
+{
+  Tcl_CmdInfo info;
+  if (Tcl_GetCommandInfo(interp, "printA", &info) != 1 || info.clientData == nullptr)
+    throw std::runtime_error("no analysis has been defined");
+
+  return static_cast<BasicAnalysisBuilder*>(info.clientData);
+}
+
+//
+// Assemble the tangent in compressed row form and return the tuple
+// (data, indices, indptr, n). The arrays are views of the storage of
+// the system they were assembled in, which is released when the last
+// of them is collected. If any of m, c or k is given, the tangent is
+// formed as m*M + c*C + k*K.
+//
+static py::tuple
+get_tangent(py::object interpaddr, py::object m, py::object c, py::object k)
+{
+  BasicAnalysisBuilder *builder = get_analysis_builder(get_interp(interpaddr));
+
+  const bool do_mck = !m.is_none() || !c.is_none() || !k.is_none();
+  const double mck[3] = {
+    m.is_none() ? 0.0 : m.cast<double>(),
+    c.is_none() ? 0.0 : c.cast<double>(),
+    k.is_none() ? 0.0 : k.cast<double>()
+  };
+
+  std::unique_ptr<CompressedRowSOE> system(new CompressedRowSOE());
+  if (builder->formTangent(*system, do_mck ? mck : nullptr) < 0)
+    throw std::runtime_error("failed to form the tangent");
+
+  const int n   = system->getNumEqn();
+  const int nnz = system->getNumNonzero();
+  if (n == 0)
+    throw std::runtime_error("linear system is empty");
+
+  CompressedRowSOE *owned = system.release();
+  py::capsule owner(owned, [](void *ptr) {
+    delete static_cast<CompressedRowSOE*>(ptr);
+  });
+
+  py::array_t<double> data(nnz, owned->getValues(), owner);
+  py::array_t<int> indices(nnz, owned->getColumns(), owner);
+  py::array_t<int> indptr(n + 1, owned->getRowStart(), owner);
+  indices.attr("setflags")(py::arg("write") = false);
+  indptr.attr("setflags")(py::arg("write") = false);
+
+  return py::make_tuple(data, indices, indptr, n);
+}
+
+//
+// Form the unbalance of the current analysis and return the right-hand
+// side of its system. Unless copy is true, the result is a read-only view
+// of the system's own vector; it is only valid until the system is
+// resized or the analysis is wiped.
+//
+static py::array_t<double>
+get_residual(py::object interpaddr, bool copy)
+{
+  BasicAnalysisBuilder *builder = get_analysis_builder(get_interp(interpaddr));
+
+  LinearSOE *system = builder->getLinearSOE();
+  if (system == nullptr)
+    throw std::runtime_error("no linear system has been defined");
+
+  if (builder->formUnbalance() < 0)
+    throw std::runtime_error("failed to form the unbalance");
+
+  const Vector &b = system->getB();
+  const int n = b.Size();
+  if (n == 0)
+    throw std::runtime_error("System of equations is empty");
+
+  if (copy) {
+    py::array_t<double> array(n);
+    double *ptr = static_cast<double*>(array.request().ptr);
+    for (int i = 0; i < n; i++)
+      ptr[i] = b(i);
+    return array;
+  }
+
+  double *data = &const_cast<Vector&>(b)[0];
+  py::array_t<double> array(n, data, py::capsule(data, [](void*) {}));
+  array.attr("setflags")(py::arg("write") = false);
+  return array;
+}
+
 class Channel;
 class FEM_ObjectBroker;
 class PyUniaxialMaterial : public UniaxialMaterial {
@@ -194,13 +471,6 @@ copy_vector(Vector vector)
   return array;
 }
 
-static Vector *
-new_vector(py::array_t<double> array)
-{
-  py::buffer_info info = array.request();
-  return new Vector(static_cast<double*>(info.ptr),(int)info.shape[0]);
-}
-
 py::array_t<double>
 copy_matrix(Matrix matrix)
 {
@@ -352,7 +622,8 @@ init_obj_module(py::module &m)
     })
     .def ("setTrialSectionDeformation", [](SectionForceDeformation& section,  
         py::array_t<double, py::array::c_style|py::array::forcecast> deformation) {
-      return section.setTrialSectionDeformation(*new_vector(deformation));
+      Vector e(deformation.mutable_data(), static_cast<int>(deformation.size()));
+      return section.setTrialSectionDeformation(e);
     }) 
     .def ("setTrialSectionDeformation", [](SectionForceDeformation& section, Vector &deformation) {
         return section.setTrialSectionDeformation(deformation);
@@ -360,7 +631,8 @@ init_obj_module(py::module &m)
     .def ("getSectionDeformation", &SectionForceDeformation::getSectionDeformation)
 
     .def ("getStressResultant",    [](SectionForceDeformation &section, py::array_t<double> deformation, bool commit=false) {
-        section.setTrialSectionDeformation(*new_vector(deformation));
+        Vector e(deformation.mutable_data(), static_cast<int>(deformation.size()));
+        section.setTrialSectionDeformation(e);
         if (commit) section.commitState();
         return copy_vector(section.getStressResultant());
     })
@@ -524,6 +796,22 @@ init_obj_module(py::module &m)
   // Module-Level Functions
   //
   m.def ("get_builder", &get_builder);
+  m.def ("invoke", &invoke,
+         py::arg("interpaddr"), py::arg("name"), py::arg("args"),
+         py::arg("as_list")   = false,
+         py::arg("as_string") = false,
+         py::arg("as_array")  = false
+  );
+  m.def ("get_tangent", &get_tangent,
+         py::arg("interpaddr"),
+         py::arg("m") = py::none(),
+         py::arg("c") = py::none(),
+         py::arg("k") = py::none()
+  );
+  m.def ("get_residual", &get_residual,
+         py::arg("interpaddr"),
+         py::arg("copy") = true
+  );
   m.def ("get_domain", [](G3_Runtime *rt)->std::unique_ptr<Domain, py::nodelete>{
       Domain *domain_addr = rt->m_domain;
       return std::unique_ptr<Domain, py::nodelete>((Domain*)domain_addr);
@@ -532,7 +820,12 @@ init_obj_module(py::module &m)
 
 }
 
+void init_model_module(py::module &m);
+void init_calibration_module(py::module &m);
+
 PYBIND11_MODULE(OpenSeesPyRT, m) {
   init_obj_module(m);
+  init_model_module(m);
+  init_calibration_module(m);
 }
 
@@ -25,6 +25,10 @@
 #include <TimeSeries.h>
 #include <LoadPattern.h>
 #include <float.h>
+#include <Profiler.h>
+#include "EventFunction.h"
+#include "DistributedEigen.h"
+#include <algorithm>
 
 // For eigen()
 #include <FE_EleIter.h>
@@ -34,6 +38,7 @@
 
 // Default concrete analysis classes
 #include <Newmark.h>
+#include <GimmeMCK.h>
 #include <EigenSOE.h>
 #include <SymBandEigenSolver.h>
 #include <SymBandEigenSOE.h>
@@ -81,6 +86,9 @@ BasicAnalysisBuilder::~BasicAnalysisBuilder()
 {
   this->wipe();
 
+  for (OpenSees::EventFunction* event : events)
+    delete event;
+
   if (theAnalysisModel != nullptr) {
     delete theAnalysisModel;
     theAnalysisModel = nullptr;
@@ -90,6 +98,7 @@ BasicAnalysisBuilder::~BasicAnalysisBuilder()
 void
 BasicAnalysisBuilder::wipe()
 {
+  changeStamp++;
 
   if (theAlgorithm != nullptr) {
       delete theAlgorithm;
@@ -223,6 +232,7 @@ BasicAnalysisBuilder::initialize(void)
 int
 BasicAnalysisBuilder::domainChanged(void)
 {
+  OpenSees::ProfileScope scope("domainChanged");
   Domain *domain = this->getDomain();
   int stamp = domain->hasDomainChanged();
   domainStamp = stamp;
@@ -333,6 +343,8 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
   int result = 0;
 
   for (int i=0; i<numSteps; i++) {
+      OpenSees::ProfileScope step("step");
+
       // This is used for parallelization
       result = theAnalysisModel->analysisStep(0.0);
       if (result < 0) {
@@ -359,7 +371,10 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       }
 
       if (flag & Increment) {
-        result = theStaticIntegrator->newStep();
+        {
+          OpenSees::ProfileScope scope("newStep");
+          result = theStaticIntegrator->newStep();
+        }
         if (result < 0) {
           opserr << "The Integrator failed at step: " << i
                 << " with domain at load factor " << theDomain->getCurrentTime() << "\n";
@@ -370,7 +385,10 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       }
 
       if (flag & Iterate) {
-        result = theAlgorithm->solveCurrentStep();
+        {
+          OpenSees::ProfileScope scope("solve");
+          result = theAlgorithm->solveCurrentStep();
+        }
         if (result < 0) {
           // Print error message if we have one
           if (AnalyzeFailedMessage.find(result) != AnalyzeFailedMessage.end()) {
@@ -395,7 +413,10 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       }
 
       if (flag & Commit) {
-        result = theStaticIntegrator->commit();
+        {
+          OpenSees::ProfileScope scope("commit");
+          result = theStaticIntegrator->commit();
+        }
         if (result < 0) {
           opserr << "StaticAnalysis::analyze - ";
           opserr << "the Integrator failed to commit";
@@ -457,6 +478,8 @@ BasicAnalysisBuilder::analyzeSubLevel(int level, double dT)
 int
 BasicAnalysisBuilder::analyzeStep(double dT)
 {
+  OpenSees::ProfileScope step("step");
+
   int result = 0;
   if (theAnalysisModel->analysisStep(dT) < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - the AnalysisModel failed";
@@ -475,7 +498,11 @@ BasicAnalysisBuilder::analyzeStep(double dT)
     }
   }
 
-  if (theTransientIntegrator->newStep(dT) < 0) {
+  {
+    OpenSees::ProfileScope scope("newStep");
+    result = theTransientIntegrator->newStep(dT);
+  }
+  if (result < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - the Integrator failed";
     opserr << " at time " << theDomain->getCurrentTime() << "\n";
     theDomain->revertToLastCommit();
@@ -483,7 +510,10 @@ BasicAnalysisBuilder::analyzeStep(double dT)
     return -2;
   }
 
-  result = theAlgorithm->solveCurrentStep();
+  {
+    OpenSees::ProfileScope scope("solve");
+    result = theAlgorithm->solveCurrentStep();
+  }
   if (result < 0) {
     if (AnalyzeFailedMessage.find(result) != AnalyzeFailedMessage.end()) {
         opserr << OpenSees::PromptAnalysisFailure << AnalyzeFailedMessage[result];
@@ -504,7 +534,10 @@ BasicAnalysisBuilder::analyzeStep(double dT)
     }    
   }
 
-  result = theTransientIntegrator->commit();
+  {
+    OpenSees::ProfileScope scope("commit");
+    result = theTransientIntegrator->commit();
+  }
   if (result < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - ";
     opserr << "the Integrator failed to commit";
@@ -558,8 +591,42 @@ BasicAnalysisBuilder::analyzeVariable(int numSteps, double dT, double dtMin, dou
   double currentTimeIncr = 0.0;
   double currentDt = dT;
 
+  //
+  // Event functions are evaluated at the last committed state (g0) and
+  // at each converged trial state (g1). When a step crosses an event it is
+  // rolled back and shortened to end just before the crossing; the
+  // remainder of the step is then retried until the step that crosses is
+  // no longer than the event tolerance.
+  //
+  const bool watch = !events.empty();
+  const double tolerance = eventTolerance > 0.0 ? eventTolerance
+                                                : std::max(dtMin, 1.0e-3*dT);
+  std::vector<OpenSees::EventFunction*> owner;
+  std::vector<int>    component;
+  std::vector<double> g0, g1;
+  stopped = false;
+
+  // when positive, a crossing lies within this time of the committed state
+  double bracket = 0.0;
+
+  if (watch) {
+    for (OpenSees::EventFunction* event : events) {
+      if (event->initialize(*theDomain) != 0)
+        return -1;
+      for (int i = 0; i < event->getNumValues(); i++) {
+        owner.push_back(event);
+        component.push_back(i);
+      }
+    }
+    g0.resize(owner.size());
+    g1.resize(owner.size());
+    for (std::size_t k = 0; k < owner.size(); k++)
+      g0[k] = owner[k]->evaluate(component[k]);
+  }
+
   // loop until analysis has performed the total time incr requested
   while (currentTimeIncr < totalTimeIncr) {
+    OpenSees::ProfileScope step("step");
 
     if (theAnalysisModel->analysisStep(currentDt) < 0) {
       opserr << "DirectIntegrationAnalysis::analyze() - the AnalysisModel failed in newStepDomain";
@@ -584,18 +651,48 @@ BasicAnalysisBuilder::analyzeVariable(int numSteps, double dT, double dtMin, dou
     // if a failure - we stop the analysis & resize time step if failure
     //
 
-    if (theTransientIntegrator->newStep(currentDt) < 0) {
-      result = -2;
+    {
+      OpenSees::ProfileScope scope("newStep");
+      if (theTransientIntegrator->newStep(currentDt) < 0) {
+        result = -2;
+      }
     }
 
 
     if (result >= 0) {
+      OpenSees::ProfileScope scope("solve");
       result = theAlgorithm->solveCurrentStep();
       if (result < 0) 
         result = -3;
     }    
 
+    // find the earliest crossing within the converged step
+    int crossing = -1;
+    if (result >= 0 && watch) {
+      double theta = 1.0;
+      for (std::size_t k = 0; k < owner.size(); k++) {
+        g1[k] = owner[k]->evaluate(component[k]);
+        if (owner[k]->crosses(g0[k], g1[k])) {
+          const double t = g0[k]/(g0[k] - g1[k]);
+          if (crossing < 0 || t < theta) {
+            crossing = static_cast<int>(k);
+            theta = t;
+          }
+        }
+      }
+
+      if (crossing >= 0 && currentDt > tolerance) {
+        theDomain->revertToLastCommit();
+        theTransientIntegrator->revertToLastStep();
+        bracket   = currentDt;
+        currentDt = std::max(std::min(theta*currentDt - 0.5*tolerance, 0.9*currentDt),
+                             0.5*tolerance);
+        continue;
+      }
+    }
+
     if (result >= 0) {
+      OpenSees::ProfileScope scope("commit");
       result = theTransientIntegrator->commit();
       if (result < 0) 
         result = -4;
@@ -604,8 +701,36 @@ BasicAnalysisBuilder::analyzeVariable(int numSteps, double dT, double dtMin, dou
     // if the time step was successful increment delta T for the analysis
     // otherwise revert the Domain to last committed state & see if can go on
 
-    if (result >= 0) 
+    if (result >= 0) {
       currentTimeIncr += currentDt;
+
+      if (watch) {
+        g0.swap(g1);
+
+        if (crossing >= 0) {
+          eventLog.emplace_back(theDomain->getCurrentTime(), owner[crossing]->getTag());
+          if (owner[crossing]->isTerminal()) {
+            stopped   = true;
+            stopEvent = eventLog.back();
+            return 0;
+          }
+
+          // restart with a short step that grows again below
+          bracket   = 0.0;
+          currentDt = tolerance;
+          continue;
+        }
+
+        if (bracket > 0.0) {
+          // retry the remainder of the step that crossed
+          bracket  -= currentDt;
+          if (bracket > 0.0) {
+            currentDt = std::max(bracket, 0.5*tolerance);
+            continue;
+          }
+        }
+      }
+    }
     else {
 
       // invoke the revertToLastCommit
@@ -622,20 +747,47 @@ BasicAnalysisBuilder::analyzeVariable(int numSteps, double dT, double dtMin, dou
       
       // if still here reset result for next loop
       result = 0;
+      bracket = 0.0;
     }
 
-    // now we determine a new delta T for next loop
-    currentDt = determineDt(currentDt, dtMin, dtMax, Jd, theTest);
+    // now we determine a new delta T for next loop; when watching for
+    // events the step grows gradually after having been shortened
+    double nextDt = determineDt(currentDt, dtMin, dtMax, Jd, theTest);
+    if (watch)
+      nextDt = std::min(nextDt, eventGrowth*currentDt);
+    currentDt = nextDt;
   }
 
 
   return 0;
 }
 
+int
+BasicAnalysisBuilder::addEvent(OpenSees::EventFunction* event)
+{
+  this->removeEvent(event->getTag());
+  events.push_back(event);
+  return 0;
+}
+
+int
+BasicAnalysisBuilder::removeEvent(int tag)
+{
+  for (auto it = events.begin(); it != events.end(); ++it) {
+    if ((*it)->getTag() == tag) {
+      delete *it;
+      events.erase(it);
+      return 0;
+    }
+  }
+  return -1;
+}
+
 
 void
 BasicAnalysisBuilder::set(ConstraintHandler* obj)
 {
+  changeStamp++;
   if (theHandler != nullptr)
     delete theHandler;
 
@@ -645,6 +797,7 @@ BasicAnalysisBuilder::set(ConstraintHandler* obj)
 void
 BasicAnalysisBuilder::set(DOF_Numberer* obj)
 {
+  changeStamp++;
   // free the old numberer
   if (theNumberer != nullptr)
     delete theNumberer;
@@ -660,6 +813,7 @@ BasicAnalysisBuilder::set(DOF_Numberer* obj)
 void
 BasicAnalysisBuilder::set(EquiSolnAlgo* obj)
 {
+  changeStamp++;
   if (theAlgorithm != nullptr)
     delete theAlgorithm;
 
@@ -676,6 +830,7 @@ BasicAnalysisBuilder::set(EquiSolnAlgo* obj)
 void
 BasicAnalysisBuilder::set(LinearSOE* obj, bool free)
 {
+  changeStamp++;
 
   // if free is false then we cant free either
   if ((theSOE != nullptr) && free && freeSOE)
@@ -704,6 +859,7 @@ BasicAnalysisBuilder::getLinearSOE() {
 void
 BasicAnalysisBuilder::set(StaticIntegrator& obj)
 {
+  changeStamp++;
   if (theStaticIntegrator != nullptr)
     delete theStaticIntegrator;
 
@@ -721,6 +877,7 @@ BasicAnalysisBuilder::set(StaticIntegrator& obj)
 void
 BasicAnalysisBuilder::set(TransientIntegrator& obj, bool free)
 {
+  changeStamp++;
 
   if ((theTransientIntegrator != nullptr) && free && freeTI)
     delete theTransientIntegrator;
@@ -741,6 +898,7 @@ BasicAnalysisBuilder::set(TransientIntegrator& obj, bool free)
 void
 BasicAnalysisBuilder::set(ConvergenceTest* obj)
 {
+  changeStamp++;
 
   if (theTest != nullptr)
     delete theTest;
@@ -753,6 +911,7 @@ BasicAnalysisBuilder::set(ConvergenceTest* obj)
 void
 BasicAnalysisBuilder::set(EigenSOE &theNewSOE)
 {
+  changeStamp++;
   // destroy the old one if not the same type
   if (theEigenSOE != nullptr) {
     if (theEigenSOE->getClassTag() != theNewSOE.getClassTag()) {
@@ -774,6 +933,7 @@ BasicAnalysisBuilder::set(EigenSOE &theNewSOE)
 void
 BasicAnalysisBuilder::fillDefaults(BasicAnalysisBuilder::CurrentAnalysis flag)
 {
+  changeStamp++;
 
   switch (flag) {
     case EMPTY_ANALYSIS:
@@ -909,6 +1069,19 @@ BasicAnalysisBuilder::eigen(int numMode, bool generalized, bool findSmallest)
   // for parallel processing, want all analysis doing an eigenvalue analysis
   result = theAnalysisModel->eigenAnalysis(numMode, generalized, findSmallest);
 
+  if (partition != nullptr) {
+    if (!generalized || !findSmallest) {
+      opserr << G3_ERROR_PROMPT << "eigen - only the lowest modes of the generalized problem "
+             << "can be found for a partitioned model\n";
+      return -1;
+    }
+    OpenSees::DistributedEigen solver(*this, *partition);
+    if (solver.solve(numMode) != 0)
+      return -4;
+    this->numEigen = numMode;
+    return 0;
+  }
+
   int stamp = the_Domain->hasDomainChanged();
 
   if (stamp != domainStamp) {
@@ -1022,6 +1195,24 @@ BasicAnalysisBuilder::getDomain()
   return theDomain;
 }
 
+ConstraintHandler*
+BasicAnalysisBuilder::getConstraintHandler()
+{
+  return theHandler;
+}
+
+DOF_Numberer*
+BasicAnalysisBuilder::getNumberer()
+{
+  return theNumberer;
+}
+
+AnalysisModel*
+BasicAnalysisBuilder::getAnalysisModel()
+{
+  return theAnalysisModel;
+}
+
 EquiSolnAlgo*
 BasicAnalysisBuilder::getAlgorithm()
 {
@@ -1058,3 +1249,77 @@ BasicAnalysisBuilder::formUnbalance()
     return -1;
 }
 
+//
+// Assemble the current tangent into the given system in place of the
+// analysis LinearSOE. If mck is given, the tangent is formed as
+// mck[0]*M + mck[1]*C + mck[2]*K. The domain is reverted to its last
+// committed state, and the original system is put back before returning.
+//
+int
+BasicAnalysisBuilder::formTangent(LinearSOE& system, const double* mck)
+{
+  // The objects of the analysis are linked back to the original system
+  // afterwards, so that none of them keeps a reference to the given one;
+  // if there is no system yet, the defaults of the analysis are made now
+  // rather than when it is first run.
+  if (theSOE == nullptr) {
+    this->fillDefaults(this->CurrentAnalysisFlag);
+    this->setLinks(this->CurrentAnalysisFlag);
+  }
+
+  // the system is swapped and put back below; the components are
+  // unchanged for anyone watching getChangeStamp()
+  const unsigned stamp = changeStamp;
+  LinearSOE *oldSOE = theSOE;
+  bool oldFreeSOE = freeSOE;
+
+  this->set(&system, false);
+
+  // invoke domainChanged which constructs a graph and passes
+  // it to the system so that it can size its storage
+  int status = this->domainChanged();
+
+  if (status < 0)
+    opserr << G3_ERROR_PROMPT << "formTangent - domainChanged() failed\n";
+
+  else if (mck != nullptr) {
+    // linked to the system only, so that the handler and algorithm
+    // never refer to it
+    GimmeMCK integrator(mck[0], mck[1], mck[2], 0.0);
+    integrator.setLinks(*theAnalysisModel, system, theTest);
+    status = integrator.formTangent(0);
+    integrator.revertToLastStep();
+  }
+
+  else if (theStaticIntegrator != nullptr) {
+    theStaticIntegrator->setLinks(*theAnalysisModel, system, theTest);
+    status = theStaticIntegrator->formTangent();
+    theStaticIntegrator->revertToLastStep();
+  }
+
+  else if (theTransientIntegrator != nullptr) {
+    theTransientIntegrator->setLinks(*theAnalysisModel, system, theTest);
+    status = theTransientIntegrator->formTangent(0);
+    theTransientIntegrator->revertToLastStep();
+  }
+
+  else {
+    opserr << G3_ERROR_PROMPT << "formTangent - no integrator has been set\n";
+    status = -1;
+  }
+
+  theDomain->revertToLastCommit();
+
+  // put the original system back; set() relinks the algorithm and
+  // eigen system to it, and the integrator that formed the tangent is
+  // relinked here since set() only links those of the current analysis
+  this->set(oldSOE, oldFreeSOE);
+  if (mck == nullptr && theStaticIntegrator != nullptr)
+    theStaticIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
+  else if (mck == nullptr && theTransientIntegrator != nullptr)
+    theTransientIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
+
+  changeStamp = stamp;
+  return status;
+}
+
@@ -27,6 +27,9 @@
 #ifndef BasicAnalysisBulider_h
 #define BasicAnalysisBulider_h
 
+#include <vector>
+#include <utility>
+
 class Domain;
 class G3_Table;
 class ConstraintHandler;
@@ -38,6 +41,10 @@ class EigenSOE;
 class StaticIntegrator;
 class TransientIntegrator;
 class ConvergenceTest;
+namespace OpenSees {
+  class EventFunction;
+  class PartitionInterface;
+}
 
 class BasicAnalysisBuilder
 {
@@ -79,9 +86,16 @@ public:
     void newEigenAnalysis(int typeSolver, double shift);
     int  eigen(int numMode, bool generalized, bool findSmallest);
     int  getNumEigen() {return numEigen;};
+    // Solve eigen problems of a model partitioned among processes with
+    // OpenSees::DistributedEigen; the builder does not take ownership
+    void setPartition(OpenSees::PartitionInterface* shared) {partition = shared;}
 
     int formUnbalance();
+    int formTangent(LinearSOE& system, const double* mck=nullptr);
 
+    ConstraintHandler*   getConstraintHandler();
+    DOF_Numberer*        getNumberer();
+    AnalysisModel*       getAnalysisModel();
     EquiSolnAlgo*        getAlgorithm();
     StaticIntegrator*    getStaticIntegrator();
     TransientIntegrator* getTransientIntegrator();
@@ -98,9 +112,27 @@ public:
     int analyzeSubLevel(int level, double dT);
     int analyzeVariable(int numSteps, double dT, double dtMin, double dtMax, int Jd);
 
+    // State events located by analyzeVariable; the builder takes
+    // ownership of the event functions
+    int  addEvent(OpenSees::EventFunction* event);
+    int  removeEvent(int tag);
+    int  getNumEvents() const {return static_cast<int>(events.size());}
+    void setEventTolerance(double dt) {eventTolerance = dt;}
+    void setEventGrowth(double factor) {eventGrowth = factor;}
+    // (time, tag) of each event located
+    const std::vector<std::pair<double,int>>& getEventLog() const {return eventLog;}
+    void clearEventLog() {eventLog.clear();}
+    // A terminal event ends the analysis successfully; this returns the
+    // (time, tag) of the one that ended the last analysis, if any
+    const std::pair<double,int>* getStopEvent() const {return stopped ? &stopEvent : nullptr;}
+
     void wipe();
 
-    
+    // Incremented whenever a component of the analysis is set, created
+    // or destroyed, so that objects built from the components (e.g. the
+    // analyses of subdomains) can tell when they are out of date
+    unsigned getChangeStamp() const {return changeStamp;}
+
     enum CurrentAnalysis  CurrentAnalysisFlag = EMPTY_ANALYSIS;
 
 private:
@@ -119,6 +151,7 @@ private:
     ConvergenceTest           *theTest;
 
     int domainStamp;
+    unsigned changeStamp = 0;
     int numEigen = 0;
 
     int numSubLevels = 0;
@@ -127,6 +160,14 @@ private:
     bool freeSOE = true;
     bool freeTI  = true;
 
+    std::vector<OpenSees::EventFunction*> events;
+    std::vector<std::pair<double,int>>    eventLog;
+    std::pair<double,int>                 stopEvent;
+    bool   stopped        = false;
+    double eventTolerance = 0.0;
+    double eventGrowth    = 2.0;
+
+    OpenSees::PartitionInterface* partition = nullptr;
 };
 
 #endif
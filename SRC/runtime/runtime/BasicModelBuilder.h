@@ -90,6 +90,18 @@ public:
     return findFreeTag(typeid(T).name(), tag);
   }
 
+  // Call apply(tag, T*) for each object of type T; returns the count
+  template <class T, class F> int forEachObject(F&& apply) const {
+    auto iter = m_registry.find(typeid(T).name());
+    if (iter == m_registry.end())
+      return 0;
+
+    for (auto const& [tag, obj] : iter->second)
+      apply(tag, (T*)(void*)obj);
+
+    return static_cast<int>(iter->second.size());
+  }
+
   int addSP_Constraint(int axisDirn, 
          double axisValue, 
          const ID &fixityCodes, 
@@ -0,0 +1,187 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Load pattern of the forces of a coupled solver.
+//
+#include "CoSimulationPattern.h"
+#include "CoupledSolver.h"
+#include <G3_Logging.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Vector.h>
+#include <OPS_Stream.h>
+
+#ifndef PATTERN_TAG_CoSimulationPattern
+#define PATTERN_TAG_CoSimulationPattern 20
+#endif
+
+namespace OpenSees {
+
+CoSimulationPattern::CoSimulationPattern(int tag, std::unique_ptr<CoupledSolver> coupled,
+                                         const std::vector<int>& nodes,
+                                         Exchange exchange, double factor)
+  : LoadPattern(tag, PATTERN_TAG_CoSimulationPattern),
+    solver(std::move(coupled)),
+    nodes(nodes),
+    exchange(exchange),
+    factor(factor),
+    domain(nullptr),
+    ncomp(solver->getNumComponents()),
+    current(solver->getTime()),
+    forces(nodes.size()*ncomp, 0.0),
+    status(0)
+{
+
+}
+
+
+CoSimulationPattern::~CoSimulationPattern()
+{
+  this->wait();
+}
+
+
+void
+CoSimulationPattern::setDomain(Domain* theDomain)
+{
+  LoadPattern::setDomain(theDomain);
+  domain = theDomain;
+
+  if (domain == nullptr)
+    return;
+
+  for (int tag : nodes) {
+    Node *node = domain->getNode(tag);
+    if (node != nullptr && node->getNumberDOF() < ncomp)
+      opserr << G3_WARN_PROMPT << "coupled node " << tag << " has fewer than "
+             << ncomp << " dofs; its forces are not applied\n";
+  }
+}
+
+
+void
+CoSimulationPattern::applyLoad(double time)
+{
+  if (domain == nullptr)
+    return;
+
+  if (time > current) {
+    switch (exchange) {
+      case Exchange::Staggered:
+        if (this->setVelocities() == 0)
+          status = solver->advance(time);
+        this->getForces();
+        break;
+
+      case Exchange::Concurrent:
+        // Forces of the advance to the previous exchange
+        this->wait();
+        this->getForces();
+        if (this->setVelocities() == 0)
+          worker = std::thread([this, time]() {
+            status = solver->advance(time);
+          });
+        break;
+    }
+    current = time;
+  }
+
+  Vector load;
+  for (std::size_t i = 0; i < nodes.size(); i++) {
+    Node *node = domain->getNode(nodes[i]);
+    if (node == nullptr || node->getNumberDOF() < ncomp)
+      continue;
+
+    load.resize(node->getNumberDOF());
+    load.Zero();
+    for (int j = 0; j < ncomp; j++)
+      load(j) = forces[i*ncomp + j];
+    node->addUnbalancedLoad(load, factor);
+  }
+}
+
+
+int
+CoSimulationPattern::setVelocities()
+{
+  std::vector<double> velocity(ncomp);
+  for (std::size_t i = 0; i < nodes.size(); i++) {
+    Node *node = domain->getNode(nodes[i]);
+    if (node == nullptr) {
+      opserr << G3_ERROR_PROMPT << "coupled node " << nodes[i] << " not found\n";
+      return -1;
+    }
+
+    const Vector& vel = node->getTrialVel();
+    for (int j = 0; j < ncomp; j++)
+      velocity[j] = j < vel.Size() ? vel(j) : 0.0;
+    solver->setVelocity(static_cast<int>(i), velocity.data());
+  }
+  return 0;
+}
+
+
+void
+CoSimulationPattern::getForces()
+{
+  if (status != 0) {
+    opserr << G3_WARN_PROMPT << "coupled solver failed to advance; "
+           << "the forces of its last exchange are applied\n";
+    status = 0;
+    return;
+  }
+
+  for (std::size_t i = 0; i < nodes.size(); i++)
+    solver->getForce(static_cast<int>(i), &forces[i*ncomp]);
+}
+
+
+void
+CoSimulationPattern::wait()
+{
+  if (worker.joinable())
+    worker.join();
+}
+
+
+int
+CoSimulationPattern::sendSelf(int commitTag, Channel& channel)
+{
+  opserr << G3_ERROR_PROMPT << "CoSimulationPattern cannot be sent\n";
+  return -1;
+}
+
+
+int
+CoSimulationPattern::recvSelf(int commitTag, Channel& channel, FEM_ObjectBroker& broker)
+{
+  opserr << G3_ERROR_PROMPT << "CoSimulationPattern cannot be received\n";
+  return -1;
+}
+
+
+LoadPattern*
+CoSimulationPattern::getCopy()
+{
+  // The coupled solver has a single instance
+  return nullptr;
+}
+
+
+void
+CoSimulationPattern::Print(OPS_Stream& s, int flag)
+{
+  s << "CoSimulationPattern, tag: " << this->getTag() << "\n";
+  s << "  exchange: "
+    << (exchange == Exchange::Concurrent ? "concurrent" : "staggered") << "\n";
+  s << "  time: " << current << "\n";
+  s << "  nodes:";
+  for (int tag : nodes)
+    s << " " << tag;
+  s << "\n";
+}
+
+} // namespace OpenSees
@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// CoSimulationPattern couples the structural model to a CoupledSolver
+// that runs in the same process, such as a material point model of a
+// debris flow or landslide. Each interface point of the solver is attached
+// to a structural node; when the loads of a step are applied, the trial
+// velocities of the nodes are passed to the solver, which is advanced to
+// the time of the step with as many of its own steps as it needs, and the
+// forces it returns are added to the unbalanced loads of the nodes.
+//
+// The exchange is one of
+//
+//   Staggered   the solver is advanced to the time of the step before the
+//               structure solves it, using the velocities of the start of
+//               the step; the two run one after the other
+//
+//   Concurrent  the solver is advanced to the time of the step on a
+//               separate thread while the structure solves it with the
+//               forces of the previous step, so that the forces lag by one
+//               step of the structure
+//
+// The solver does not go back in time: when the structure repeats a step
+// (e.g., after it failed to converge), the forces of the last exchange are
+// applied again.
+//
+#ifndef OpenSees_CoSimulationPattern_h
+#define OpenSees_CoSimulationPattern_h
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include <LoadPattern.h>
+
+class Domain;
+
+namespace OpenSees {
+
+class CoupledSolver;
+
+class CoSimulationPattern : public LoadPattern
+{
+public:
+  enum class Exchange {
+    Staggered,
+    Concurrent
+  };
+
+  // Attach point i of the solver to the node with tag nodes[i]
+  CoSimulationPattern(int tag, std::unique_ptr<CoupledSolver> solver,
+                      const std::vector<int>& nodes,
+                      Exchange exchange = Exchange::Staggered,
+                      double factor = 1.0);
+  ~CoSimulationPattern();
+
+  void setDomain(Domain* domain);
+  void applyLoad(double time);
+
+  int sendSelf(int commitTag, Channel& channel);
+  int recvSelf(int commitTag, Channel& channel, FEM_ObjectBroker& broker);
+  LoadPattern* getCopy();
+  void Print(OPS_Stream& s, int flag = 0);
+
+private:
+  int  setVelocities();
+  void getForces();
+  void wait();
+
+  std::unique_ptr<CoupledSolver> solver;
+  std::vector<int>    nodes;
+  Exchange            exchange;
+  double              factor;
+  Domain*             domain;
+
+  int                 ncomp;
+  double              current;     // time of the last exchange
+  std::vector<double> forces;      // applied to the nodes
+
+  std::thread         worker;      // advancing the solver, if concurrent
+  int                 status;      // of the last advance
+};
+
+} // namespace OpenSees
+
+#endif
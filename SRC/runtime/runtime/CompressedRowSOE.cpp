@@ -0,0 +1,213 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Assembly-only linear system in compressed row storage.
+//
+#include <algorithm>
+#include "CompressedRowSOE.h"
+#include <Matrix.h>
+#include <ID.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <OPS_Stream.h>
+
+CompressedRowSOE::CompressedRowSOE()
+  : LinearSOE(LinSOE_TAGS_CompressedRowSOE),
+    size(0), rowStartA(1, 0)
+{
+
+}
+
+CompressedRowSOE::~CompressedRowSOE()
+{
+
+}
+
+int
+CompressedRowSOE::getNumEqn(void) const
+{
+  return size;
+}
+
+int
+CompressedRowSOE::setSize(Graph &theGraph)
+{
+  size = theGraph.getNumVertex();
+
+  rowStartA.assign(size + 1, 0);
+  colA.clear();
+
+  // each row holds the diagonal and the adjacent equations
+  int nnz = 0;
+  for (int a = 0; a < size; a++) {
+    Vertex *theVertex = theGraph.getVertexPtr(a);
+    if (theVertex == nullptr) {
+      opserr << "WARNING CompressedRowSOE::setSize - vertex " << a
+             << " not in graph\n";
+      size = 0;
+      rowStartA.assign(1, 0);
+      A.clear();
+      return -1;
+    }
+    nnz += theVertex->getAdjacency().Size() + 1;
+  }
+  colA.reserve(nnz);
+
+  for (int a = 0; a < size; a++) {
+    Vertex *theVertex = theGraph.getVertexPtr(a);
+    const ID &theAdjacency = theVertex->getAdjacency();
+
+    const int start = static_cast<int>(colA.size());
+    colA.push_back(theVertex->getTag());
+    for (int i = 0; i < theAdjacency.Size(); i++)
+      colA.push_back(theAdjacency(i));
+
+    std::sort(colA.begin() + start, colA.end());
+    colA.erase(std::unique(colA.begin() + start, colA.end()), colA.end());
+    rowStartA[a + 1] = static_cast<int>(colA.size());
+  }
+
+  A.assign(colA.size(), 0.0);
+
+  if (B.Size() != size) {
+    B.resize(size);
+    X.resize(size);
+  }
+  B.Zero();
+  X.Zero();
+
+  return 0;
+}
+
+int
+CompressedRowSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+  if (fact == 0.0)
+    return 0;
+
+  const int idSize = id.Size();
+  if (idSize != m.noRows() || idSize != m.noCols()) {
+    opserr << "WARNING CompressedRowSOE::addA - Matrix and ID not of similar sizes\n";
+    return -1;
+  }
+
+  for (int i = 0; i < idSize; i++) {
+    const int row = id(i);
+    if (row < 0 || row >= size)
+      continue;
+
+    const int *first = colA.data() + rowStartA[row];
+    const int *last  = colA.data() + rowStartA[row + 1];
+    for (int j = 0; j < idSize; j++) {
+      const int col = id(j);
+      if (col < 0 || col >= size)
+        continue;
+
+      const int *loc = std::lower_bound(first, last, col);
+      if (loc != last && *loc == col)
+        A[loc - colA.data()] += fact * m(i, j);
+    }
+  }
+  return 0;
+}
+
+int
+CompressedRowSOE::addB(const Vector &v, const ID &id, double fact)
+{
+  if (fact == 0.0)
+    return 0;
+
+  const int idSize = id.Size();
+  if (idSize != v.Size()) {
+    opserr << "WARNING CompressedRowSOE::addB - Vector and ID not of similar sizes\n";
+    return -1;
+  }
+
+  for (int i = 0; i < idSize; i++) {
+    const int pos = id(i);
+    if (pos >= 0 && pos < size)
+      B(pos) += fact * v(i);
+  }
+  return 0;
+}
+
+int
+CompressedRowSOE::setB(const Vector &v, double fact)
+{
+  if (v.Size() != size) {
+    opserr << "WARNING CompressedRowSOE::setB - incompatible sizes "
+           << size << " and " << v.Size() << "\n";
+    return -1;
+  }
+
+  for (int i = 0; i < size; i++)
+    B(i) = fact * v(i);
+  return 0;
+}
+
+void
+CompressedRowSOE::zeroA(void)
+{
+  std::fill(A.begin(), A.end(), 0.0);
+}
+
+void
+CompressedRowSOE::zeroB(void)
+{
+  B.Zero();
+}
+
+void
+CompressedRowSOE::setX(int loc, double value)
+{
+  if (loc >= 0 && loc < size)
+    X(loc) = value;
+}
+
+void
+CompressedRowSOE::setX(const Vector &x)
+{
+  if (x.Size() == size)
+    X = x;
+}
+
+const Vector &
+CompressedRowSOE::getX(void)
+{
+  return X;
+}
+
+const Vector &
+CompressedRowSOE::getB(void)
+{
+  return B;
+}
+
+double
+CompressedRowSOE::normRHS(void)
+{
+  return B.Norm();
+}
+
+int
+CompressedRowSOE::solve(void)
+{
+  opserr << "WARNING CompressedRowSOE::solve - system has no solver\n";
+  return -1;
+}
+
+int
+CompressedRowSOE::sendSelf(int commitTag, Channel &theChannel)
+{
+  return 0;
+}
+
+int
+CompressedRowSOE::recvSelf(int commitTag, Channel &theChannel,
+                           FEM_ObjectBroker &theBroker)
+{
+  return 0;
+}
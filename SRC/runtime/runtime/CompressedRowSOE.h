@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// CompressedRowSOE is a LinearSOE that only stores the system; it
+// assembles A in compressed sparse row (CSR) form from the DOF graph and
+// has no solver. It is used to extract the tangent of an analysis
+// without forming a dense matrix; the row pointers, column indices and
+// values are exposed directly so that they can be wrapped by another
+// runtime (e.g., as a scipy.sparse.csr_matrix) without copying.
+//
+// Column indices within each row are sorted.
+//
+#ifndef CompressedRowSOE_h
+#define CompressedRowSOE_h
+
+#include <vector>
+#include <LinearSOE.h>
+#include <Vector.h>
+
+#ifndef LinSOE_TAGS_CompressedRowSOE
+#define LinSOE_TAGS_CompressedRowSOE 1979
+#endif
+
+class CompressedRowSOE : public LinearSOE
+{
+public:
+  CompressedRowSOE();
+  ~CompressedRowSOE();
+
+  int getNumEqn(void) const;
+  int setSize(Graph &theGraph);
+
+  int addA(const Matrix &, const ID &, double fact = 1.0);
+  int addB(const Vector &, const ID &, double fact = 1.0);
+  int setB(const Vector &, double fact = 1.0);
+
+  void zeroA(void);
+  void zeroB(void);
+
+  void setX(int loc, double value);
+  void setX(const Vector &x);
+  const Vector &getX(void);
+  const Vector &getB(void);
+  double normRHS(void);
+
+  int solve(void);
+
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+               FEM_ObjectBroker &theBroker);
+
+  // Compressed row storage
+  int getNumNonzero(void) const {return static_cast<int>(colA.size());}
+  const int *getRowStart(void) const {return rowStartA.data();}
+  const int *getColumns(void)  const {return colA.data();}
+  double    *getValues(void)         {return A.data();}
+
+private:
+  int size;
+  std::vector<int>    rowStartA;   // size + 1
+  std::vector<int>    colA;        // nnz
+  std::vector<double> A;           // nnz
+  Vector B, X;
+};
+
+#endif
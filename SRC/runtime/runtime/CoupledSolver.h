@@ -0,0 +1,46 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// CoupledSolver is the interface of a solver that runs in the same process
+// as the structural analysis and interacts with it at a set of interface
+// points, each attached to a structural node (see CoSimulationPattern).
+// The structure prescribes the velocity of the points; the solver
+// advances with its own time step, which may be smaller than that of the
+// structure, and returns the force that it exerts on each point averaged
+// over the advance.
+//
+#ifndef OpenSees_CoupledSolver_h
+#define OpenSees_CoupledSolver_h
+
+namespace OpenSees {
+
+class CoupledSolver
+{
+public:
+  virtual ~CoupledSolver() {}
+
+  // Number of interface points, and of the components of the velocity
+  // and force at each of them
+  virtual int getNumPoints() const = 0;
+  virtual int getNumComponents() const = 0;
+
+  // Time up to which the solver has advanced
+  virtual double getTime() const = 0;
+
+  // Velocity of point i while the solver advances
+  virtual int setVelocity(int i, const double* velocity) = 0;
+
+  // Advance the solver to time; returns 0 on success. The solver does not
+  // go back in time, and may stop within its own step of time.
+  virtual int advance(double time) = 0;
+
+  // Force on point i averaged over the last advance
+  virtual int getForce(int i, double* force) const = 0;
+};
+
+} // namespace OpenSees
+
+#endif
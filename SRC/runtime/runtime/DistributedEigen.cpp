@@ -0,0 +1,521 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Eigen analysis of partitioned models by LOBPCG.
+//
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include "DistributedEigen.h"
+#include "BasicAnalysisBuilder.h"
+#include "CompressedRowSOE.h"
+#include <G3_Logging.h>
+#include <AnalysisModel.h>
+#include <Vector.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinDirectSolver.h>
+
+extern "C" void dsyev_(char *jobz, char *uplo, int *n, double *A, int *lda,
+                       double *w, double *work, int *lwork, int *info);
+
+namespace OpenSees {
+
+// Factor of the mean eigenvalue used as the shift of the preconditioner
+static constexpr double ShiftRatio = 1.0e-3;
+
+// Directions of a Rayleigh-Ritz basis whose norm is below this factor of
+// the largest are dropped as dependent
+static constexpr double DependenceRatio = 1.0e-10;
+
+//
+// Weighted products of the columns of two blocks, C = A^T diag(w) B,
+// with C of size p by q stored by column with leading dimension ld
+//
+static void
+gram(int n, const double* A, int p, const double* B, int q,
+     const double* w, double* C, int ld)
+{
+  for (int j = 0; j < q; j++)
+    for (int i = 0; i < p; i++) {
+      const double *a = &A[static_cast<std::size_t>(i)*n],
+                   *b = &B[static_cast<std::size_t>(j)*n];
+      double sum = 0.0;
+      for (int e = 0; e < n; e++)
+        sum += w[e]*a[e]*b[e];
+      C[i + j*ld] = sum;
+    }
+}
+
+// Y = S C, for S with m columns and C of size m by q
+static void
+combine(int n, const double* S, int m, const double* C, int ldc, int q,
+        double* Y)
+{
+  std::fill(Y, Y + static_cast<std::size_t>(n)*q, 0.0);
+  for (int j = 0; j < q; j++) {
+    double *y = &Y[static_cast<std::size_t>(j)*n];
+    for (int i = 0; i < m; i++) {
+      const double c = C[i + j*ldc];
+      const double *s = &S[static_cast<std::size_t>(i)*n];
+      for (int e = 0; e < n; e++)
+        y[e] += c*s[e];
+    }
+  }
+}
+
+//
+// Solve the projected problem A c = theta B c. The basis may be
+// dependent, e.g. when it has more vectors than the model has equations,
+// and B is singular when the model has massless equations, so the
+// problem is solved in the span Z of the eigenvectors of G = A/a + B/b
+// (scaled to a unit diagonal) whose eigenvalues are not negligible. With
+// Z^T G Z = I, the eigenvectors y of Z^T (A/a) Z, with eigenvalues alpha,
+// give c = Z y with theta = (a alpha)/(b (1 - alpha)), which are
+// infinite for alpha = 1. On return the first r columns of A hold the
+// eigenvectors, with c^T B c = 1, for the r finite eigenvalues returned
+// in ascending order; -1 if the solve fails.
+//
+static int
+rayleigh_ritz(int m, std::vector<double>& A, std::vector<double>& B,
+              std::vector<double>& theta)
+{
+  double a = 0.0, b = 0.0;
+  for (int i = 0; i < m; i++) {
+    a = std::max(a, A[i + i*m]);
+    b = std::max(b, B[i + i*m]);
+  }
+  if (!(a > 0.0) || !(b > 0.0))
+    return -1;
+
+  std::vector<double> G(static_cast<std::size_t>(m)*m), d(m);
+  for (int i = 0; i < m; i++) {
+    const double g = A[i + i*m]/a + B[i + i*m]/b;
+    d[i] = g > 0.0 ? 1.0/std::sqrt(g) : 0.0;
+  }
+  for (int j = 0; j < m; j++)
+    for (int i = 0; i < m; i++) {
+      A[i + j*m] *= d[i]*d[j]/a;
+      G[i + j*m]  = A[i + j*m] + B[i + j*m]*d[i]*d[j]/b;
+    }
+
+  int info = 0, lwork = 64*m;
+  char jobz = 'V', uplo = 'U';
+  std::vector<double> work(lwork), s(m);
+  dsyev_(&jobz, &uplo, &m, G.data(), &m, s.data(), work.data(), &lwork, &info);
+  if (info != 0 || !(s[m-1] > 0.0))
+    return -1;
+
+  // Z = V S^(-1/2) over the retained eigenvectors V of G
+  int r = 0;
+  while (r < m && s[m-1-r] > DependenceRatio*s[m-1])
+    r++;
+  std::vector<double> Z(static_cast<std::size_t>(m)*r);
+  for (int k = 0; k < r; k++) {
+    const int v = m - 1 - k;
+    for (int i = 0; i < m; i++)
+      Z[i + k*m] = G[i + v*m]/std::sqrt(s[v]);
+  }
+
+  std::vector<double> AZ(Z.size()), C(static_cast<std::size_t>(r)*r), alpha(r);
+  for (int k = 0; k < r; k++)
+    for (int i = 0; i < m; i++) {
+      double sum = 0.0;
+      for (int j = 0; j < m; j++)
+        sum += A[i + j*m]*Z[j + k*m];
+      AZ[i + k*m] = sum;
+    }
+  for (int l = 0; l < r; l++)
+    for (int k = 0; k < r; k++) {
+      double sum = 0.0;
+      for (int i = 0; i < m; i++)
+        sum += Z[i + k*m]*AZ[i + l*m];
+      C[k + l*r] = sum;
+    }
+
+  dsyev_(&jobz, &uplo, &r, C.data(), &r, alpha.data(), work.data(), &lwork, &info);
+  if (info != 0)
+    return -1;
+
+  // theta increases with alpha, so the finite eigenvalues come first
+  int q = 0;
+  while (q < r && 1.0 - alpha[q] > DependenceRatio)
+    q++;
+
+  theta.resize(q);
+  for (int l = 0; l < q; l++) {
+    theta[l] = a*alpha[l]/(b*(1.0 - alpha[l]));
+    const double scale = 1.0/std::sqrt(b*(1.0 - alpha[l]));
+    for (int i = 0; i < m; i++) {
+      double sum = 0.0;
+      for (int k = 0; k < r; k++)
+        sum += Z[i + k*m]*C[k + l*r];
+      A[i + l*m] = scale*d[i]*sum;
+    }
+  }
+
+  return q;
+}
+
+int
+lobpcg(int n, int numModes, const EigenOperators& ops, double tol, int maxIter,
+       std::vector<double>& values, std::vector<double>& vectors)
+{
+  const double *w = ops.weight;
+  using Block = std::vector<double>;
+
+  double total = 0.0;
+  for (int e = 0; e < n; e++)
+    total += w[e];
+  ops.sum(&total, 1);
+  const int N = static_cast<int>(std::lround(total));
+
+  // a few guard vectors speed the convergence of the last modes; they
+  // are dropped when the model is small, in which case the Rayleigh-Ritz
+  // basis spans all of its equations and the solve is a dense one
+  const int b = std::max(numModes, std::min(N/3, numModes + std::max(2, numModes/2)));
+  if (numModes < 1 || numModes > N) {
+    opserr << G3_ERROR_PROMPT << "cannot find " << numModes << " modes of a model with "
+           << N << " equations\n";
+    return -1;
+  }
+
+  auto apply = [n](const std::function<void(const double*, double*)>& op,
+                   const double* X, int q, double* Y) {
+    for (int j = 0; j < q; j++)
+      op(&X[static_cast<std::size_t>(j)*n], &Y[static_cast<std::size_t>(j)*n]);
+  };
+
+  //
+  // Start from the preconditioner applied to random vectors, which also
+  // makes them consistent at shared equations; the random values of the
+  // processes must differ, or the block would span only as many
+  // directions as the largest part has equations
+  //
+  Block X(static_cast<std::size_t>(n)*b), KX(X.size()), MX(X.size());
+  {
+    std::mt19937 generator(ops.seed);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    Block random(X.size());
+    for (double &x : random)
+      x = uniform(generator);
+    apply(ops.T, random.data(), b, X.data());
+  }
+  apply(ops.K, X.data(), b, KX.data());
+  apply(ops.M, X.data(), b, MX.data());
+
+  Block A(b*b), B(b*b), theta;
+  gram(n, X.data(), b, KX.data(), b, w, A.data(), b);
+  gram(n, X.data(), b, MX.data(), b, w, B.data(), b);
+  ops.sum(A.data(), b*b);
+  ops.sum(B.data(), b*b);
+  if (rayleigh_ritz(b, A, B, theta) < b) {
+    opserr << G3_ERROR_PROMPT << "the initial vectors of the eigen analysis are dependent\n";
+    return -1;
+  }
+  {
+    Block Y(X.size());
+    combine(n, X.data(), b, A.data(), b, b, Y.data());  X.swap(Y);
+    combine(n, KX.data(), b, A.data(), b, b, Y.data()); KX.swap(Y);
+    combine(n, MX.data(), b, A.data(), b, b, Y.data()); MX.swap(Y);
+  }
+  std::vector<double> lambda(theta.begin(), theta.begin() + b);
+
+  // scale the columns of a block to unit M-norm
+  auto normalize = [n, w, &ops](double* Y, double* MY, int q) {
+    std::vector<double> norms(q, 0.0);
+    for (int j = 0; j < q; j++)
+      for (int e = 0; e < n; e++)
+        norms[j] += w[e]*Y[static_cast<std::size_t>(j)*n + e]*MY[static_cast<std::size_t>(j)*n + e];
+    ops.sum(norms.data(), q);
+    for (int j = 0; j < q; j++) {
+      const double scale = norms[j] > 0.0 ? 1.0/std::sqrt(norms[j]) : 1.0;
+      for (int e = 0; e < n; e++) {
+        Y[static_cast<std::size_t>(j)*n + e]  *= scale;
+        MY[static_cast<std::size_t>(j)*n + e] *= scale;
+      }
+    }
+  };
+
+  Block P;
+  std::vector<int> active;
+  bool converged = false;
+
+  for (int iter = 0; iter < maxIter; iter++) {
+    //
+    // Residuals and their norms, relative to those of K x and lambda M x
+    //
+    Block R(X.size());
+    for (int j = 0; j < b; j++)
+      for (int e = 0; e < n; e++) {
+        const std::size_t k = static_cast<std::size_t>(j)*n + e;
+        R[k] = KX[k] - lambda[j]*MX[k];
+      }
+
+    std::vector<double> norms(3*b, 0.0);
+    for (int j = 0; j < b; j++)
+      for (int e = 0; e < n; e++) {
+        const std::size_t k = static_cast<std::size_t>(j)*n + e;
+        norms[3*j]   += w[e]*R[k]*R[k];
+        norms[3*j+1] += w[e]*KX[k]*KX[k];
+        norms[3*j+2] += w[e]*MX[k]*MX[k];
+      }
+    ops.sum(norms.data(), 3*b);
+
+    std::vector<int> next;
+    converged = true;
+    for (int j = 0; j < b; j++) {
+      const double scale = std::sqrt(norms[3*j+1]) + std::fabs(lambda[j])*std::sqrt(norms[3*j+2]),
+                   error = std::sqrt(norms[3*j])/std::max(scale, 1.0e-300);
+      if (error > tol) {
+        next.push_back(j);
+        if (j < numModes)
+          converged = false;
+      }
+    }
+    if (converged)
+      break;
+
+    // the search directions P are kept for the columns that remain active
+    const bool haveP = !P.empty();
+    active = next;
+    const int a = static_cast<int>(active.size());
+
+    //
+    // Preconditioned residuals, M-orthogonal to X
+    //
+    Block W(static_cast<std::size_t>(n)*a), KW(W.size()), MW(W.size());
+    for (int i = 0; i < a; i++)
+      ops.T(&R[static_cast<std::size_t>(active[i])*n], &W[static_cast<std::size_t>(i)*n]);
+    apply(ops.M, W.data(), a, MW.data());
+    {
+      Block C(b*a);
+      gram(n, MX.data(), b, W.data(), a, w, C.data(), b);
+      ops.sum(C.data(), b*a);
+      for (int j = 0; j < a; j++)
+        for (int i = 0; i < b; i++)
+          for (int e = 0; e < n; e++) {
+            W[static_cast<std::size_t>(j)*n + e]  -= C[i + j*b]*X[static_cast<std::size_t>(i)*n + e];
+            MW[static_cast<std::size_t>(j)*n + e] -= C[i + j*b]*MX[static_cast<std::size_t>(i)*n + e];
+          }
+    }
+    normalize(W.data(), MW.data(), a);
+    apply(ops.K, W.data(), a, KW.data());
+
+    // Directions of the previous step for the active columns
+    Block Q, KQ, MQ;
+    if (haveP) {
+      Q.resize(W.size());
+      KQ.resize(W.size());
+      MQ.resize(W.size());
+      for (int i = 0; i < a; i++)
+        std::copy_n(&P[static_cast<std::size_t>(active[i])*n], n, &Q[static_cast<std::size_t>(i)*n]);
+      apply(ops.M, Q.data(), a, MQ.data());
+      normalize(Q.data(), MQ.data(), a);
+      apply(ops.K, Q.data(), a, KQ.data());
+    }
+
+    //
+    // Rayleigh-Ritz on [X W P], or on [X W] when that fails
+    //
+    Block S, KS, MS;
+    for (int attempt = haveP ? 0 : 1; attempt < 2; attempt++) {
+      const bool useP = attempt == 0;
+      const int m = b + a + (useP ? a : 0);
+
+      S.assign(static_cast<std::size_t>(n)*m, 0.0);
+      KS.assign(S.size(), 0.0);
+      MS.assign(S.size(), 0.0);
+      const std::size_t offsetW = static_cast<std::size_t>(n)*b,
+                        offsetP = static_cast<std::size_t>(n)*(b + a);
+      std::copy(X.begin(),  X.end(),  S.begin());
+      std::copy(KX.begin(), KX.end(), KS.begin());
+      std::copy(MX.begin(), MX.end(), MS.begin());
+      std::copy(W.begin(),  W.end(),  S.begin()  + offsetW);
+      std::copy(KW.begin(), KW.end(), KS.begin() + offsetW);
+      std::copy(MW.begin(), MW.end(), MS.begin() + offsetW);
+      if (useP) {
+        std::copy(Q.begin(),  Q.end(),  S.begin()  + offsetP);
+        std::copy(KQ.begin(), KQ.end(), KS.begin() + offsetP);
+        std::copy(MQ.begin(), MQ.end(), MS.begin() + offsetP);
+      }
+
+      A.assign(m*m, 0.0);
+      B.assign(m*m, 0.0);
+      gram(n, S.data(), m, KS.data(), m, w, A.data(), m);
+      gram(n, S.data(), m, MS.data(), m, w, B.data(), m);
+      ops.sum(A.data(), m*m);
+      ops.sum(B.data(), m*m);
+      for (int j = 0; j < m; j++)
+        for (int i = 0; i < j; i++) {
+          A[i + j*m] = A[j + i*m] = 0.5*(A[i + j*m] + A[j + i*m]);
+          B[i + j*m] = B[j + i*m] = 0.5*(B[i + j*m] + B[j + i*m]);
+        }
+
+      if (rayleigh_ritz(m, A, B, theta) >= b) {
+        // new iterates, and directions from the W and P components
+        combine(n, S.data(), m, A.data(), m, b, X.data());
+        P.assign(X.size(), 0.0);
+        combine(n, S.data() + offsetW, m - b, A.data() + b, m, b, P.data());
+        std::copy_n(theta.begin(), b, lambda.begin());
+        break;
+      }
+      if (!useP) {
+        opserr << G3_ERROR_PROMPT << "eigen analysis broke down at iteration " << iter + 1 << "\n";
+        return -1;
+      }
+    }
+
+    // the products are formed again rather than updated, since the
+    // rounding errors of updates grow quickly near convergence
+    apply(ops.K, X.data(), b, KX.data());
+    apply(ops.M, X.data(), b, MX.data());
+  }
+
+  if (!converged) {
+    opserr << G3_ERROR_PROMPT << "eigen analysis did not converge in " << maxIter << " iterations\n";
+    return -1;
+  }
+
+  values.assign(lambda.begin(), lambda.begin() + numModes);
+  vectors.assign(X.begin(), X.begin() + static_cast<std::size_t>(n)*numModes);
+  return 0;
+}
+
+
+DistributedEigen::DistributedEigen(BasicAnalysisBuilder& builder, PartitionInterface& partition)
+  : builder(builder), partition(partition), tolerance(1.0e-8), maxIterations(500)
+{
+
+}
+
+//
+// Products with a local matrix, completed across the partition
+//
+static std::function<void(const double*, double*)>
+product(CompressedRowSOE& A, PartitionInterface& partition)
+{
+  const int     n        = A.getNumEqn();
+  const int    *rowStart = A.getRowStart();
+  const int    *columns  = A.getColumns();
+  const double *values   = A.getValues();
+
+  return [=, &partition](const double* x, double* y) {
+    for (int i = 0; i < n; i++) {
+      double sum = 0.0;
+      for (int j = rowStart[i]; j < rowStart[i+1]; j++)
+        sum += values[j]*x[columns[j]];
+      y[i] = sum;
+    }
+    partition.assemble(y);
+  };
+}
+
+static double
+diagonal(CompressedRowSOE& A, int i)
+{
+  const int *rowStart = A.getRowStart(),
+            *columns  = A.getColumns();
+  const int *j = std::lower_bound(columns + rowStart[i], columns + rowStart[i+1], i);
+  return (j != columns + rowStart[i+1] && *j == i) ? A.getValues()[j - columns] : 0.0;
+}
+
+int
+DistributedEigen::solve(int numModes, double shift)
+{
+  //
+  // Local mass and stiffness
+  //
+  CompressedRowSOE mass, stiffness;
+  const double m[3] = {1.0, 0.0, 0.0},
+               k[3] = {0.0, 0.0, 1.0};
+  if (builder.formTangent(mass, m) < 0 || builder.formTangent(stiffness, k) < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to form the local mass and stiffness\n";
+    return -1;
+  }
+  const int n = stiffness.getNumEqn();
+
+  //
+  // Preconditioner, K + shift M factored over this part; the shift is a
+  // small fraction of the mean eigenvalue so that parts without supports
+  // are not singular
+  //
+  if (partition.setup(*builder.getDomain(), n) != 0)
+    return -1;
+
+  // equations shared by c processes are weighted by 1/c
+  std::vector<double> weight(n, 1.0);
+  partition.assemble(weight.data());
+  for (double &x : weight)
+    x = 1.0/x;
+
+  if (shift <= 0.0) {
+    double trace[2] = {0.0, 0.0};
+    for (int i = 0; i < n; i++) {
+      trace[0] += weight[i]*diagonal(stiffness, i);
+      trace[1] += weight[i]*diagonal(mass, i);
+    }
+    partition.sum(trace, 2);
+    if (!(trace[1] > 0.0)) {
+      opserr << G3_ERROR_PROMPT << "eigen analysis requires mass\n";
+      return -1;
+    }
+    shift = ShiftRatio*trace[0]/trace[1];
+  }
+
+  ProfileSPDLinSOE local(*(new ProfileSPDLinDirectSolver()));
+  const double a[3] = {shift, 0.0, 1.0};
+  if (builder.formTangent(local, a) < 0 || local.getNumEqn() != n) {
+    opserr << G3_ERROR_PROMPT << "failed to form the local preconditioner\n";
+    return -1;
+  }
+
+  double failed = 0.0;
+  Vector rhs(n);
+  EigenOperators ops;
+  ops.weight = weight.data();
+  ops.seed   = 5489u + static_cast<unsigned>(partition.getRank());
+  ops.sum = [&](double* values, int count) {partition.sum(values, count);};
+  ops.K = product(stiffness, partition);
+  ops.M = product(mass, partition);
+  ops.T = [&](const double* r, double* z) {
+    for (int i = 0; i < n; i++)
+      rhs(i) = std::sqrt(weight[i])*r[i];
+    local.setB(rhs);
+    if (local.solve() < 0)
+      failed = 1.0;
+    const Vector &x = local.getX();
+    for (int i = 0; i < n; i++)
+      z[i] = std::sqrt(weight[i])*x(i);
+    partition.assemble(z);
+  };
+
+  std::vector<double> values, vectors;
+  int status = lobpcg(n, numModes, ops, tolerance, maxIterations, values, vectors);
+
+  partition.sum(&failed, 1);
+  if (failed > 0.0) {
+    opserr << G3_ERROR_PROMPT << "failed to factor the local preconditioner\n";
+    return -1;
+  }
+  if (status != 0)
+    return status;
+
+  //
+  // Store the eigenpairs; each process sets the components at its nodes
+  //
+  AnalysisModel *model = builder.getAnalysisModel();
+  model->setNumEigenvectors(numModes);
+  Vector lambda(numModes);
+  for (int i = 0; i < numModes; i++) {
+    lambda(i) = values[i];
+    model->setEigenvector(i + 1, Vector(&vectors[static_cast<std::size_t>(i)*n], n));
+  }
+  model->setEigenvalues(lambda);
+
+  return 0;
+}
+
+} // namespace OpenSees
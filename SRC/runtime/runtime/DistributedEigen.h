@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// DistributedEigen finds the lowest eigenpairs of K phi = lambda M phi for
+// a model that is partitioned among processes, each of which holds the
+// elements of its part and a copy of the nodes on its boundary. Neither
+// matrix is gathered: each process assembles its own K and M, and
+// products with the global matrices are completed by adding the values
+// at shared equations across processes.
+//
+// The eigenpairs are found with the locally optimal block preconditioned
+// conjugate gradient method (LOBPCG; Knyazev, SIAM J. Sci. Comput. 23,
+// 2001), which requires only these products and a preconditioner. The
+// preconditioner is additive Schwarz: each process factors K + sigma M
+// over its part, and the corrections of the parts are summed with the
+// weights of a partition of unity. Inner products count each shared
+// equation once, so all processes agree on the Rayleigh-Ritz projections
+// and hold identical values at shared equations.
+//
+// The eigenvectors are mass normalized and left distributed: each
+// process stores the components at its own nodes.
+//
+#ifndef OpenSees_DistributedEigen_h
+#define OpenSees_DistributedEigen_h
+
+#include <vector>
+#include <functional>
+
+class Domain;
+class BasicAnalysisBuilder;
+
+namespace OpenSees {
+
+//
+// Communication among the processes sharing a partitioned model
+//
+class PartitionInterface
+{
+public:
+  virtual ~PartitionInterface() {}
+
+  // Called once the equations of the local model have been numbered
+  virtual int  setup(Domain& domain, int numEqn) = 0;
+
+  // Add the values at shared equations of all processes to x
+  virtual void assemble(double* x) = 0;
+
+  // Sum n values over all processes
+  virtual void sum(double* values, int n) = 0;
+
+  // Rank of this process among those sharing the model
+  virtual int getRank() = 0;
+};
+
+
+//
+// Block eigen solver on vectors distributed by equation; each operator
+// maps a consistent local vector to a consistent local vector
+//
+struct EigenOperators {
+  std::function<void(const double*, double*)> K, M, T;
+  std::function<void(double*, int)> sum;
+  const double* weight;     // weight of each equation in inner products
+  unsigned seed = 5489u;    // of the start vectors; differs by process
+};
+
+int lobpcg(int numEqn, int numModes, const EigenOperators& ops,
+           double tol, int maxIter,
+           std::vector<double>& values, std::vector<double>& vectors);
+
+
+class DistributedEigen
+{
+public:
+  DistributedEigen(BasicAnalysisBuilder& builder, PartitionInterface& partition);
+
+  void setTolerance(double tol)    {tolerance = tol;}
+  void setMaxIterations(int max)   {maxIterations = max;}
+
+  // Find the numModes lowest eigenpairs and store them with the nodes
+  // and the domain; a shift of zero selects one from the matrices
+  int solve(int numModes, double shift = 0.0);
+
+private:
+  BasicAnalysisBuilder& builder;
+  PartitionInterface&   partition;
+  double tolerance;
+  int    maxIterations;
+};
+
+} // namespace OpenSees
+
+#endif
@@ -0,0 +1,179 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Event functions of nodal and element response.
+//
+#include "EventFunction.h"
+#include <G3_Logging.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Element.h>
+#include <Response.h>
+#include <Information.h>
+#include <DummyStream.h>
+#include <Vector.h>
+
+namespace OpenSees {
+
+NodeEvent::NodeEvent(int tag, int node, int dof, double threshold,
+                     Quantity quantity, Direction direction, bool terminal)
+  : EventFunction(tag, direction, terminal),
+    nodeTag(node), dof(dof), threshold(threshold), quantity(quantity),
+    node(nullptr)
+{
+
+}
+
+int
+NodeEvent::initialize(Domain& domain)
+{
+  node = domain.getNode(nodeTag);
+  if (node == nullptr || dof < 0 || dof >= node->getNumberDOF()) {
+    opserr << G3_ERROR_PROMPT << "event " << this->getTag() << " - invalid node "
+           << nodeTag << " or dof " << dof + 1 << "\n";
+    node = nullptr;
+    return -1;
+  }
+  return 0;
+}
+
+double
+NodeEvent::evaluate(int)
+{
+  switch (quantity) {
+    case Velocity:
+      return node->getTrialVel()(dof) - threshold;
+    case Acceleration:
+      return node->getTrialAccel()(dof) - threshold;
+    default:
+      return node->getTrialDisp()(dof) - threshold;
+  }
+}
+
+
+GapEvent::GapEvent(int tag, int i, int j, int dof, double gap,
+                   Direction direction, bool terminal)
+  : EventFunction(tag, direction, terminal),
+    iTag(i), jTag(j), dof(dof), gap(gap),
+    iNode(nullptr), jNode(nullptr)
+{
+
+}
+
+int
+GapEvent::initialize(Domain& domain)
+{
+  iNode = domain.getNode(iTag);
+  jNode = domain.getNode(jTag);
+  if (iNode == nullptr || jNode == nullptr || dof < 0
+      || dof >= iNode->getNumberDOF() || dof >= jNode->getNumberDOF()) {
+    opserr << G3_ERROR_PROMPT << "event " << this->getTag() << " - invalid nodes "
+           << iTag << " and " << jTag << " or dof " << dof + 1 << "\n";
+    iNode = jNode = nullptr;
+    return -1;
+  }
+  return 0;
+}
+
+double
+GapEvent::evaluate(int)
+{
+  return gap + jNode->getTrialDisp()(dof) - iNode->getTrialDisp()(dof);
+}
+
+
+ElementEvent::ElementEvent(int tag, int element,
+                           const std::vector<std::string>& response,
+                           int component, double threshold,
+                           Direction direction, bool terminal)
+  : EventFunction(tag, direction, terminal),
+    elementTag(element), arguments(response), component(component),
+    threshold(threshold), response(nullptr)
+{
+
+}
+
+ElementEvent::~ElementEvent()
+{
+  if (response != nullptr)
+    delete response;
+}
+
+int
+ElementEvent::initialize(Domain& domain)
+{
+  if (response != nullptr) {
+    delete response;
+    response = nullptr;
+  }
+
+  Element *element = domain.getElement(elementTag);
+  if (element == nullptr) {
+    opserr << G3_ERROR_PROMPT << "event " << this->getTag() << " - no element with tag "
+           << elementTag << "\n";
+    return -1;
+  }
+
+  std::vector<const char*> argv;
+  for (const std::string& arg : arguments)
+    argv.push_back(arg.c_str());
+
+  DummyStream dummy;
+  response = element->setResponse(argv.data(), static_cast<int>(argv.size()), dummy);
+  if (response == nullptr || response->getResponse() < 0) {
+    opserr << G3_ERROR_PROMPT << "event " << this->getTag() << " - element "
+           << elementTag << " has no such response\n";
+    return -1;
+  }
+
+  if (component < 0 || component >= response->getInformation().getData().Size()) {
+    opserr << G3_ERROR_PROMPT << "event " << this->getTag() << " - response of element "
+           << elementTag << " has no component " << component + 1 << "\n";
+    return -1;
+  }
+  return 0;
+}
+
+double
+ElementEvent::evaluate(int)
+{
+  response->getResponse();
+  return response->getInformation().getData()(component) - threshold;
+}
+
+
+SourceEvent::SourceEvent(int tag, int element, Direction direction, bool terminal)
+  : EventFunction(tag, direction, terminal),
+    elementTag(element), source(nullptr)
+{
+
+}
+
+int
+SourceEvent::initialize(Domain& domain)
+{
+  source = dynamic_cast<EventSource*>(domain.getElement(elementTag));
+  if (source == nullptr) {
+    opserr << G3_ERROR_PROMPT << "event " << this->getTag() << " - element "
+           << elementTag << " does not exist or reports no events\n";
+    return -1;
+  }
+  return 0;
+}
+
+int
+SourceEvent::getNumValues()
+{
+  return source == nullptr ? 0 : source->getNumEvents();
+}
+
+double
+SourceEvent::evaluate(int i)
+{
+  return source->getEventFunction(i);
+}
+
+} // namespace OpenSees
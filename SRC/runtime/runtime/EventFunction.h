@@ -0,0 +1,174 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Event functions are scalar functions of the trial state whose zero
+// crossings mark a state event, such as the closure of a gap, first
+// yield or fracture. BasicAnalysisBuilder::analyzeVariable evaluates them
+// after each converged step; when one changes sign, the step is rolled
+// back to the last committed state and shortened until the crossing is
+// located to within a time tolerance.
+//
+// Elements that know their own events (e.g., contact or fracture
+// elements) may implement EventSource, and are watched by adding a
+// SourceEvent for them. Any other quantity an element or its materials
+// report through setResponse can be watched with an ElementEvent.
+//
+#ifndef OpenSees_EventFunction_h
+#define OpenSees_EventFunction_h
+
+#include <vector>
+#include <string>
+
+class Domain;
+class Node;
+class Element;
+class Response;
+
+namespace OpenSees {
+
+//
+// Interface implemented by elements or materials that define event
+// functions of their own trial state
+//
+class EventSource
+{
+public:
+  virtual ~EventSource() {}
+  virtual int    getNumEvents() = 0;
+  virtual double getEventFunction(int i) = 0;
+};
+
+
+class EventFunction
+{
+public:
+  enum Direction : int {
+    Falling = -1,
+    Either  =  0,
+    Rising  =  1
+  };
+
+  EventFunction(int tag, Direction direction = Either, bool terminal = false)
+    : tag(tag), direction(direction), terminal(terminal) {}
+
+  virtual ~EventFunction() {}
+
+  // Look up the objects the function depends on; called at the start of
+  // each analysis
+  virtual int    initialize(Domain& domain) = 0;
+
+  virtual int    getNumValues() {return 1;}
+  virtual double evaluate(int i) = 0;
+
+  int  getTag() const {return tag;}
+  bool isTerminal() const {return terminal;}
+
+  // True if the change from g0 to g1 is a crossing in the watched direction
+  bool crosses(double g0, double g1) const {
+    if (g0 == 0.0)
+      return false;
+    if (direction != Falling && g0 < 0.0 && g1 >= 0.0)
+      return true;
+    if (direction != Rising  && g0 > 0.0 && g1 <= 0.0)
+      return true;
+    return false;
+  }
+
+private:
+  int tag;
+  Direction direction;
+  bool terminal;
+};
+
+
+//
+// Trial displacement, velocity or acceleration of a node less a threshold
+//
+class NodeEvent : public EventFunction
+{
+public:
+  enum Quantity {Displacement, Velocity, Acceleration};
+
+  NodeEvent(int tag, int node, int dof, double threshold,
+            Quantity quantity = Displacement,
+            Direction direction = Either, bool terminal = false);
+
+  int    initialize(Domain&);
+  double evaluate(int);
+
+private:
+  int nodeTag, dof;
+  double threshold;
+  Quantity quantity;
+  Node *node;
+};
+
+
+//
+// Gap between two nodes along a dof, gap + u_j - u_i, which closes when
+// it falls to zero
+//
+class GapEvent : public EventFunction
+{
+public:
+  GapEvent(int tag, int iNode, int jNode, int dof, double gap,
+           Direction direction = Falling, bool terminal = false);
+
+  int    initialize(Domain&);
+  double evaluate(int);
+
+private:
+  int iTag, jTag, dof;
+  double gap;
+  Node *iNode, *jNode;
+};
+
+
+//
+// Component of an element response, as requested with the arguments
+// of the eleResponse command, less a threshold
+//
+class ElementEvent : public EventFunction
+{
+public:
+  ElementEvent(int tag, int element, const std::vector<std::string>& response,
+               int component, double threshold,
+               Direction direction = Either, bool terminal = false);
+  ~ElementEvent();
+
+  int    initialize(Domain&);
+  double evaluate(int);
+
+private:
+  int elementTag;
+  std::vector<std::string> arguments;
+  int component;
+  double threshold;
+  Response *response;
+};
+
+
+//
+// Event functions reported by an element that implements EventSource
+//
+class SourceEvent : public EventFunction
+{
+public:
+  SourceEvent(int tag, int element,
+              Direction direction = Either, bool terminal = false);
+
+  int    initialize(Domain&);
+  int    getNumValues();
+  double evaluate(int i);
+
+private:
+  int elementTag;
+  EventSource *source;
+};
+
+} // namespace OpenSees
+
+#endif
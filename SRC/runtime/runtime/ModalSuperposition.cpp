@@ -0,0 +1,258 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Modal superposition for uniform base excitation.
+//
+#include <cmath>
+#include <memory>
+#include <algorithm>
+#include "ModalSuperposition.h"
+#include "Oscillator.h"
+#include "BasicAnalysisBuilder.h"
+#include "CompressedRowSOE.h"
+#include <G3_Logging.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <DOF_Group.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <LinearSOE.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinDirectSolver.h>
+
+namespace OpenSees {
+
+ModalSuperposition::ModalSuperposition(BasicAnalysisBuilder& builder)
+  : builder(builder), numEqn(0)
+{
+
+}
+
+
+int
+ModalSuperposition::setup(int direction, int numModes,
+                          const std::vector<double>& damping,
+                          bool staticCorrection)
+{
+  modes.clear();
+  responses.clear();
+
+  Domain *domain = builder.getDomain();
+  const int numEigen = builder.getNumEigen();
+  if (numEigen <= 0) {
+    opserr << G3_ERROR_PROMPT << "modal superposition requires an eigen analysis\n";
+    return -1;
+  }
+
+  if (numModes <= 0 || numModes > numEigen)
+    numModes = numEigen;
+
+  if (damping.size() != 1 && damping.size() < static_cast<std::size_t>(numModes)) {
+    opserr << G3_ERROR_PROMPT << "expected one damping ratio or one for each of the "
+           << numModes << " modes\n";
+    return -1;
+  }
+
+  //
+  // Form the mass matrix; this also numbers the DOF_Groups
+  //
+  CompressedRowSOE mass;
+  const double m[3] = {1.0, 0.0, 0.0};
+  if (builder.formTangent(mass, m) < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to form the mass matrix\n";
+    return -1;
+  }
+  numEqn = mass.getNumEqn();
+
+  //
+  // Gather the mode shapes and the influence vector by equation
+  //
+  shapes.assign(static_cast<std::size_t>(numEqn)*numModes, 0.0);
+  std::vector<double> influence(numEqn, 0.0);
+
+  NodeIter &theNodes = domain->getNodes();
+  Node *node;
+  while ((node = theNodes()) != nullptr) {
+    DOF_Group *group = node->getDOF_GroupPtr();
+    if (group == nullptr)
+      continue;
+
+    const ID &eqn = group->getID();
+    const Matrix &phi = node->getEigenvectors();
+    for (int i = 0; i < eqn.Size() && i < phi.noRows(); i++) {
+      const int e = eqn(i);
+      if (e < 0 || e >= numEqn)
+        continue;
+
+      if (i == direction)
+        influence[e] = 1.0;
+
+      for (int n = 0; n < numModes && n < phi.noCols(); n++)
+        shapes[n*numEqn + e] = phi(i, n);
+    }
+  }
+
+  //
+  // Modal masses and participation factors
+  //
+  const int    *rowStart = mass.getRowStart();
+  const int    *columns  = mass.getColumns();
+  const double *values   = mass.getValues();
+
+  auto multiply = [&](const double* x, std::vector<double>& y) {
+    for (int i = 0; i < numEqn; i++) {
+      double sum = 0.0;
+      for (int j = rowStart[i]; j < rowStart[i+1]; j++)
+        sum += values[j]*x[columns[j]];
+      y[i] = sum;
+    }
+  };
+
+  std::vector<double> Mi(numEqn), Mphi(numEqn);
+  multiply(influence.data(), Mi);
+
+  const Vector &lambda = domain->getEigenvalues();
+  for (int n = 0; n < numModes; n++) {
+    const double *phi = &shapes[n*numEqn];
+    multiply(phi, Mphi);
+
+    double Mn = 0.0, Ln = 0.0;
+    for (int i = 0; i < numEqn; i++) {
+      Mn += phi[i]*Mphi[i];
+      Ln += phi[i]*Mi[i];
+    }
+
+    const double zeta = damping.size() == 1 ? damping[0] : damping[n];
+    if (lambda(n) <= 0.0 || Mn <= 0.0) {
+      opserr << G3_ERROR_PROMPT << "mode " << n + 1
+             << " has a non-positive eigenvalue or modal mass\n";
+      modes.clear();
+      return -1;
+    }
+    if (zeta < 0.0 || zeta >= 1.0) {
+      opserr << G3_ERROR_PROMPT << "damping ratio of mode " << n + 1
+             << " must be in [0, 1)\n";
+      modes.clear();
+      return -1;
+    }
+    modes.push_back({std::sqrt(lambda(n)), zeta, Ln/Mn});
+  }
+
+  //
+  // Static response of the truncated modes, K^-1 M i less the static
+  // response of the retained modes
+  //
+  residual.assign(numEqn, 0.0);
+  if (!staticCorrection)
+    return 0;
+
+  // Use the system of the analysis when one has been defined; the
+  // system owns its solver
+  LinearSOE *system = builder.getLinearSOE();
+  std::unique_ptr<LinearSOE> defaultSystem;
+  if (system == nullptr) {
+    defaultSystem.reset(new ProfileSPDLinSOE(*(new ProfileSPDLinDirectSolver())));
+    system = defaultSystem.get();
+  }
+
+  const double k[3] = {0.0, 0.0, 1.0};
+  if (builder.formTangent(*system, k) < 0 || system->getNumEqn() != numEqn) {
+    opserr << G3_ERROR_PROMPT << "failed to form the stiffness matrix\n";
+    modes.clear();
+    return -1;
+  }
+
+  Vector b(Mi.data(), numEqn);
+  system->setB(b);
+  if (system->solve() < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to solve for the static correction, "
+              "the stiffness may be singular\n";
+    modes.clear();
+    return -1;
+  }
+
+  const Vector &x = system->getX();
+  for (int i = 0; i < numEqn; i++) {
+    double sum = 0.0;
+    for (int n = 0; n < numModes; n++)
+      sum += modes[n].gamma*shapes[n*numEqn + i]/(modes[n].omega*modes[n].omega);
+    residual[i] = x(i) - sum;
+  }
+
+  return 0;
+}
+
+
+int
+ModalSuperposition::addResponse(int tag, int dof)
+{
+  Node *node = builder.getDomain()->getNode(tag);
+  if (node == nullptr || node->getDOF_GroupPtr() == nullptr)
+    return -1;
+
+  const ID &eqn = node->getDOF_GroupPtr()->getID();
+  if (dof < 0 || dof >= eqn.Size() || eqn(dof) < 0 || eqn(dof) >= numEqn)
+    return -1;
+
+  responses.push_back(eqn(dof));
+  return static_cast<int>(responses.size()) - 1;
+}
+
+
+int
+ModalSuperposition::integrate(const double* ag, int numSteps, double dt,
+                              double* peak, double* history) const
+{
+  if (modes.empty() || dt <= 0.0 || numSteps < 0)
+    return -1;
+
+  const int nm = static_cast<int>(modes.size()),
+            nr = static_cast<int>(responses.size());
+
+  std::vector<LinearRecurrence> recurrence;
+  recurrence.reserve(nm);
+  for (const Mode& mode : modes)
+    recurrence.emplace_back(mode.omega, mode.zeta, dt);
+
+  // Mode shapes and static correction at the response equations
+  std::vector<double> phi(nr*nm), correction(nr);
+  for (int r = 0; r < nr; r++) {
+    for (int n = 0; n < nm; n++)
+      phi[r*nm + n] = shapes[n*numEqn + responses[r]];
+    correction[r] = residual[responses[r]];
+    peak[r] = 0.0;
+  }
+
+  std::vector<double> q(nm, 0.0), v(nm, 0.0);
+  for (int i = 0; i < numSteps; i++) {
+    if (i > 0) {
+      for (int n = 0; n < nm; n++) {
+        const LinearRecurrence &c = recurrence[n];
+        const double p0 = -modes[n].gamma*ag[i-1],
+                     p1 = -modes[n].gamma*ag[i];
+        const double qn = c.A *q[n] + c.B *v[n] + c.C *p0 + c.D *p1;
+        v[n]            = c.Ap*q[n] + c.Bp*v[n] + c.Cp*p0 + c.Dp*p1;
+        q[n] = qn;
+      }
+    }
+
+    for (int r = 0; r < nr; r++) {
+      double u = -correction[r]*ag[i];
+      for (int n = 0; n < nm; n++)
+        u += phi[r*nm + n]*q[n];
+
+      peak[r] = std::max(peak[r], std::fabs(u));
+      if (history != nullptr)
+        history[static_cast<std::size_t>(r)*numSteps + i] = u;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace OpenSees
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// ModalSuperposition integrates the transient response of a linear model
+// to uniform base excitation in the basis of the eigenpairs computed by
+// the last eigen analysis.
+//
+// Each modal equation
+//
+//   q'' + 2 zeta w q' + w^2 q = -Gamma ag(t)
+//
+// is integrated exactly for ground accelerations that vary linearly over
+// each step (Chopra, Dynamics of Structures, Sec. 5.2), so the step size
+// is limited only by the sampling of the record. The contribution of the
+// truncated modes is approximated by their static response (the "missing
+// mass" correction), which requires one solution with the stiffness of
+// the model.
+//
+// The modal properties are formed once by setup(); integrate() only reads
+// them, so many records may be processed concurrently against the same
+// set of modes.
+//
+#ifndef ModalSuperposition_h
+#define ModalSuperposition_h
+
+#include <vector>
+
+class BasicAnalysisBuilder;
+
+namespace OpenSees {
+
+class ModalSuperposition
+{
+public:
+  ModalSuperposition(BasicAnalysisBuilder& builder);
+
+  // Form the modal properties for excitation in the nodal degree of
+  // freedom `direction` (0-based) using the first numModes modes (all
+  // computed modes when numModes is 0). `damping` holds one ratio per
+  // mode, or a single ratio for all modes.
+  int setup(int direction, int numModes, const std::vector<double>& damping,
+            bool staticCorrection = true);
+
+  // Add the displacement of a node relative to the base as a response
+  // quantity; returns its index, or -1 if the node or dof has no equation.
+  int addResponse(int node, int dof);
+
+  int    getNumModes() const {return static_cast<int>(modes.size());}
+  int    getNumResponses() const {return static_cast<int>(responses.size());}
+  double getParticipation(int mode) const {return modes[mode].gamma;}
+
+  // Integrate a ground acceleration record sampled at numSteps points
+  // spaced dt apart, starting from rest. The peak absolute value of each
+  // response is written to peak, and, when history is not null, the
+  // response at every step to history[r*numSteps + i].
+  int integrate(const double* ag, int numSteps, double dt,
+                double* peak, double* history = nullptr) const;
+
+private:
+  struct Mode {
+    double omega, zeta, gamma;
+  };
+
+  BasicAnalysisBuilder& builder;
+
+  std::vector<Mode>   modes;
+  int                 numEqn;
+  std::vector<double> shapes;       // numEqn x numModes, column major
+  std::vector<double> residual;     // static response of truncated modes
+
+  std::vector<int>    responses;    // equation of each response
+};
+
+} // namespace OpenSees
+
+#endif
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Exact integration of a linear single degree of freedom oscillator with
+// unit mass,
+//
+//   q'' + 2 zeta w q' + w^2 q = p(t),
+//
+// for a force that varies linearly over each step. The coefficients of
+// the recurrence are those of Chopra, Dynamics of Structures, Table 5.2.1:
+//
+//   q[i+1] = A  q[i] + B  v[i] + C  p[i] + D  p[i+1]
+//   v[i+1] = A' q[i] + B' v[i] + C' p[i] + D' p[i+1]
+//
+// They depend only on w, zeta and the step size, and are valid for
+// w > 0 and 0 <= zeta < 1.
+//
+#ifndef OpenSees_Oscillator_h
+#define OpenSees_Oscillator_h
+
+#include <cmath>
+
+namespace OpenSees {
+
+struct LinearRecurrence {
+  double A, B, C, D, Ap, Bp, Cp, Dp;
+
+  LinearRecurrence(double w, double z, double dt)
+  {
+    const double k  = w*w,
+                 r  = std::sqrt(1.0 - z*z),
+                 wd = w*r,
+                 e  = std::exp(-z*w*dt),
+                 s  = std::sin(wd*dt),
+                 c  = std::cos(wd*dt);
+
+    A  = e*(z/r*s + c);
+    B  = e*s/wd;
+    C  = (2.0*z/(w*dt) + e*(((1.0 - 2.0*z*z)/(wd*dt) - z/r)*s
+                            - (1.0 + 2.0*z/(w*dt))*c))/k;
+    D  = (1.0 - 2.0*z/(w*dt) + e*((2.0*z*z - 1.0)/(wd*dt)*s + 2.0*z/(w*dt)*c))/k;
+
+    Ap = -e*w/r*s;
+    Bp =  e*(c - z/r*s);
+    Cp = (-1.0/dt + e*((w/r + z/(dt*r))*s + c/dt))/k;
+    Dp = (1.0 - e*(z/r*s + c))/(k*dt);
+  }
+};
+
+} // namespace OpenSees
+
+#endif
@@ -0,0 +1,328 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Elastic and constant-ductility response spectra.
+//
+#include <cmath>
+#include <algorithm>
+#include "ResponseSpectra.h"
+#include "Oscillator.h"
+#include <G3_Logging.h>
+#include <threads/thread_pool.hpp>
+
+namespace OpenSees {
+
+// Number of periods advanced together through a record
+static constexpr int BlockSize = 32;
+
+// Minimum number of steps per period for the inelastic oscillator
+static constexpr int StepsPerPeriod = 30;
+
+// Weakest strength, relative to the elastic strength, searched for a
+// target ductility
+static constexpr double MinStrength = 1.0e-3;
+
+ResponseSpectra::ResponseSpectra(const std::vector<double>& periods,
+                                 const std::vector<double>& damping)
+  : periods(periods), damping(damping), hardening(0.0), numRecords(0), numFailed(0)
+{
+
+}
+
+int
+ResponseSpectra::setDuctility(const std::vector<double>& targets, double alpha)
+{
+  for (double mu : targets)
+    if (mu < 1.0) {
+      opserr << G3_ERROR_PROMPT << "target ductility must be at least 1\n";
+      return -1;
+    }
+
+  if (alpha < 0.0 || alpha >= 1.0) {
+    opserr << G3_ERROR_PROMPT << "hardening ratio must be in [0, 1)\n";
+    return -1;
+  }
+
+  ductility = targets;
+  hardening = alpha;
+  return 0;
+}
+
+double
+ResponseSpectra::pseudoVelocity(int r, int d, int p) const
+{
+  if (periods[p] <= 0.0)
+    return 0.0;
+  return 2.0*M_PI/periods[p]*sd[index(r, d, p)];
+}
+
+double
+ResponseSpectra::pseudoAcceleration(int r, int d, int p) const
+{
+  if (periods[p] <= 0.0)
+    return pga[r];
+  const double w = 2.0*M_PI/periods[p];
+  return w*w*sd[index(r, d, p)];
+}
+
+//
+// Peak displacements and velocities of a block of oscillators with the
+// same damping ratio, starting from rest.
+//
+static void
+elastic_block(const GroundMotion& record, double zeta,
+              const double* w, int count, double* sd, double* sv)
+{
+  double A[BlockSize],  B[BlockSize],  C[BlockSize],  D[BlockSize],
+         Ap[BlockSize], Bp[BlockSize], Cp[BlockSize], Dp[BlockSize],
+         q[BlockSize],  v[BlockSize],  qmax[BlockSize], vmax[BlockSize];
+
+  for (int j = 0; j < count; j++) {
+    const LinearRecurrence c(w[j], zeta, record.dt);
+    A[j]  = c.A;  B[j]  = c.B;  C[j]  = c.C;  D[j]  = c.D;
+    Ap[j] = c.Ap; Bp[j] = c.Bp; Cp[j] = c.Cp; Dp[j] = c.Dp;
+    q[j] = v[j] = qmax[j] = vmax[j] = 0.0;
+  }
+
+  const double *ag = record.accel;
+  for (int i = 1; i < record.size; i++) {
+    const double p0 = -ag[i-1],
+                 p1 = -ag[i];
+    for (int j = 0; j < count; j++) {
+      const double qn = A[j] *q[j] + B[j] *v[j] + C[j] *p0 + D[j] *p1,
+                   vn = Ap[j]*q[j] + Bp[j]*v[j] + Cp[j]*p0 + Dp[j]*p1;
+      q[j] = qn;
+      v[j] = vn;
+      qmax[j] = std::max(qmax[j], std::fabs(qn));
+      vmax[j] = std::max(vmax[j], std::fabs(vn));
+    }
+  }
+
+  for (int j = 0; j < count; j++) {
+    sd[j] = qmax[j];
+    sv[j] = vmax[j];
+  }
+}
+
+//
+// Ductility demand of a bilinear oscillator with unit mass and yield
+// strength fy; the return map follows sdfResponse.
+//
+double
+ResponseSpectra::ductilityDemand(const GroundMotion& record, double w, double zeta, double fy) const
+{
+  const double gamma = 0.5,
+               beta  = 0.25,
+               tol   = 1.0e-10;
+  const int maxIter = 10;
+
+  const double k    = w*w,
+               c    = 2.0*zeta*w,
+               Hkin = hardening/(1.0 - hardening)*k,
+               kp   = k*Hkin/(k + Hkin);
+
+  const double T  = 2.0*M_PI/w;
+  const int nsub  = std::max(1, static_cast<int>(std::ceil(StepsPerPeriod*record.dt/T)));
+  const double dt = record.dt/nsub;
+
+  const double a1 = 1.0/(beta*dt*dt) + gamma/(beta*dt)*c,
+               a2 = 1.0/(beta*dt) + (gamma/beta - 1.0)*c,
+               a3 = 0.5/beta - 1.0 + dt*(0.5*gamma/beta - 1.0)*c;
+
+  double u0 = 0.0, v0 = 0.0, fs0 = 0.0, up0 = 0.0, kT0 = k,
+         a0 = -record.accel[0];
+  double umax = 0.0;
+
+  for (int i = 1; i < record.size; i++) {
+    const double ag0 = record.accel[i-1],
+                 dag = (record.accel[i] - ag0)/nsub;
+
+    for (int s = 1; s <= nsub; s++) {
+      const double phat = -(ag0 + s*dag) + a1*u0 + a2*v0 + a3*a0;
+
+      double u = u0, fs = fs0, kT = kT0, up = up0;
+      double R = phat - fs - a1*u;
+      const double R0 = R == 0.0 ? 1.0 : R;
+
+      for (int iter = 0; iter < maxIter && std::fabs(R/R0) > tol; iter++) {
+        u += R/(kT + a1);
+
+        fs = k*(u - up0);
+        const double ftrial = std::fabs(fs - Hkin*up0) - fy;
+        if (ftrial > 0.0) {
+          const double dg = ftrial/(k + Hkin);
+          if (fs < 0.0) {
+            fs += dg*k;
+            up  = up0 - dg;
+          } else {
+            fs -= dg*k;
+            up  = up0 + dg;
+          }
+          kT = kp;
+        } else {
+          up = up0;
+          kT = k;
+        }
+        R = phat - fs - a1*u;
+      }
+
+      const double v = gamma/(beta*dt)*(u - u0) + (1.0 - gamma/beta)*v0 + dt*(1.0 - 0.5*gamma/beta)*a0,
+                   a = (u - u0)/(beta*dt*dt) - v0/(beta*dt) - (0.5/beta - 1.0)*a0;
+
+      u0 = u; v0 = v; a0 = a; fs0 = fs; kT0 = kT; up0 = up;
+      umax = std::max(umax, std::fabs(u));
+    }
+  }
+
+  return umax*k/fy;
+}
+
+int
+ResponseSpectra::compute(const std::vector<GroundMotion>& records, int threads)
+{
+  for (double T : periods)
+    if (T < 0.0) {
+      opserr << G3_ERROR_PROMPT << "periods must not be negative\n";
+      return -1;
+    }
+
+  for (double zeta : damping)
+    if (zeta < 0.0 || zeta >= 1.0) {
+      opserr << G3_ERROR_PROMPT << "damping ratios must be in [0, 1)\n";
+      return -1;
+    }
+
+  for (std::size_t r = 0; r < records.size(); r++)
+    if (records[r].size < 1 || records[r].dt <= 0.0 || records[r].accel == nullptr) {
+      opserr << G3_ERROR_PROMPT << "record " << int(r) + 1 << " is empty or has no time step\n";
+      return -1;
+    }
+
+  numRecords = static_cast<int>(records.size());
+  numFailed  = 0;
+  const int np = getNumPeriods(),
+            nd = getNumDamping(),
+            nm = getNumDuctility();
+
+  pga.assign(numRecords, 0.0);
+  sd.assign(static_cast<std::size_t>(numRecords)*nd*np, 0.0);
+  sv.assign(sd.size(), 0.0);
+  ay.assign(sd.size()*nm, 0.0);
+
+  for (int r = 0; r < numRecords; r++)
+    for (int i = 0; i < records[r].size; i++)
+      pga[r] = std::max(pga[r], std::fabs(records[r].accel[i]));
+
+  // Zero periods are rigid and have no relative response; the remaining
+  // periods are integrated in blocks
+  std::vector<int>    active;
+  std::vector<double> omega;
+  for (int p = 0; p < np; p++)
+    if (periods[p] > 0.0) {
+      active.push_back(p);
+      omega.push_back(2.0*M_PI/periods[p]);
+    }
+  const int na = static_cast<int>(active.size()),
+            nblocks = (na + BlockSize - 1)/BlockSize;
+
+  thread_pool pool(std::max(1, threads));
+
+  pool.detach_loop<int>(0, numRecords*nd*nblocks, [&](int task) {
+    const int b = task % nblocks,
+              d = (task / nblocks) % nd,
+              r = task / (nblocks*nd);
+    const int first = b*BlockSize,
+              count = std::min(BlockSize, na - first);
+
+    double bsd[BlockSize], bsv[BlockSize];
+    elastic_block(records[r], damping[d], &omega[first], count, bsd, bsv);
+    for (int j = 0; j < count; j++) {
+      sd[index(r, d, active[first + j])] = bsd[j];
+      sv[index(r, d, active[first + j])] = bsv[j];
+    }
+  });
+  pool.wait();
+
+  if (nm == 0)
+    return 0;
+
+  // Searches that do not reach the target above MinStrength; each task
+  // writes its own entries, which are reported once the pool is done
+  std::vector<char> failed(ay.size(), 0);
+
+  // The cost of the search varies strongly with period, so the tasks
+  // are split into more blocks than threads to balance the load
+  const int tasks = numRecords*nd*np;
+  pool.detach_loop<int>(0, tasks, [&](int task) {
+    const int p = task % np,
+              d = (task / np) % nd,
+              r = task / (np*nd);
+    const std::size_t i = index(r, d, p);
+
+    if (periods[p] <= 0.0 || sd[i] == 0.0) {
+      // a rigid oscillator remains elastic under its peak inertial force
+      for (int m = 0; m < nm; m++)
+        ay[i*nm + m] = periods[p] <= 0.0 ? pga[r] : 0.0;
+      return;
+    }
+
+    const double w  = 2.0*M_PI/periods[p],
+                 fe = w*w*sd[i];
+
+    for (int m = 0; m < nm; m++) {
+      if (ductility[m] <= 1.0) {
+        ay[i*nm + m] = fe;
+        continue;
+      }
+
+      // Step down from the elastic strength until the demand reaches
+      // the target, then bisect the bracket
+      double hi = 1.0, lo = 1.0;
+      bool found = false;
+      while (lo > MinStrength) {
+        lo = std::max(MinStrength, 0.8*hi);
+        if (ductilityDemand(records[r], w, damping[d], lo*fe) >= ductility[m]) {
+          found = true;
+          break;
+        }
+        hi = lo;
+      }
+
+      if (found) {
+        while (hi/lo - 1.0 > 1.0e-3) {
+          const double mid = std::sqrt(lo*hi);
+          if (ductilityDemand(records[r], w, damping[d], mid*fe) >= ductility[m])
+            lo = mid;
+          else
+            hi = mid;
+        }
+        ay[i*nm + m] = std::sqrt(lo*hi)*fe;
+      } else {
+        // the strength is below the range searched; MinStrength*fe is
+        // an upper bound
+        ay[i*nm + m] = MinStrength*fe;
+        failed[i*nm + m] = 1;
+      }
+    }
+  }, std::min<std::size_t>(tasks, 16*pool.get_thread_count()));
+  pool.wait();
+
+  for (int r = 0; r < numRecords; r++)
+    for (int d = 0; d < nd; d++)
+      for (int p = 0; p < np; p++)
+        for (int m = 0; m < nm; m++)
+          if (failed[index(r, d, p)*nm + m]) {
+            numFailed++;
+            opserr << G3_WARN_PROMPT << "record " << r + 1 << " did not reach a ductility of "
+                   << ductility[m] << " at period " << periods[p] << " and damping " << damping[d]
+                   << " with a strength above " << MinStrength
+                   << " of the elastic strength; that bound is reported\n";
+          }
+
+  return 0;
+}
+
+} // namespace OpenSees
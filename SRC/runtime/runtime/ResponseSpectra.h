@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// ResponseSpectra computes the response spectra of a set of ground motion
+// records over a grid of periods and damping ratios.
+//
+// Elastic spectra are integrated with the exact recurrence for piecewise
+// linear excitation (Oscillator.h). The oscillators of a block of periods
+// are advanced together through each record so that the inner loop runs
+// over contiguous arrays of coefficients and state.
+//
+// Constant-ductility spectra are found for a bilinear oscillator with
+// kinematic hardening integrated by the average acceleration method. For
+// each target ductility, the largest yield strength whose ductility
+// demand reaches the target is found by a geometric search from the
+// elastic strength downward, refined by bisection. A search that does
+// not reach the target above 1e-3 of the elastic strength is reported.
+//
+// Records, damping ratios and blocks of periods are distributed over a
+// thread pool.
+//
+#ifndef OpenSees_ResponseSpectra_h
+#define OpenSees_ResponseSpectra_h
+
+#include <vector>
+#include <cstddef>
+
+namespace OpenSees {
+
+struct GroundMotion {
+  const double *accel;
+  int           size;
+  double        dt;
+};
+
+class ResponseSpectra
+{
+public:
+  ResponseSpectra(const std::vector<double>& periods,
+                  const std::vector<double>& damping);
+
+  // Target ductilities for inelastic spectra and the ratio of post-yield
+  // to elastic stiffness
+  int setDuctility(const std::vector<double>& ductility, double hardening);
+
+  int compute(const std::vector<GroundMotion>& records, int threads = 1);
+
+  int getNumRecords()   const {return numRecords;}
+  int getNumPeriods()   const {return static_cast<int>(periods.size());}
+  int getNumDamping()   const {return static_cast<int>(damping.size());}
+  int getNumDuctility() const {return static_cast<int>(ductility.size());}
+
+  // Elastic spectra, for record r, damping ratio d and period p
+  double displacement(int r, int d, int p) const {return sd[index(r, d, p)];}
+  double velocity(int r, int d, int p) const {return sv[index(r, d, p)];}
+  double pseudoVelocity(int r, int d, int p) const;
+  double pseudoAcceleration(int r, int d, int p) const;
+
+  // Yield strength per unit mass that attains ductility m
+  double yieldStrength(int r, int d, int m, int p) const {
+    return ay[index(r, d, p)*ductility.size() + m];
+  }
+
+  // Number of yield strengths that were not found by compute(); each
+  // is reported with a warning and holds an upper bound
+  int getNumFailed() const {return numFailed;}
+
+private:
+  std::size_t index(int r, int d, int p) const {
+    return (static_cast<std::size_t>(r)*damping.size() + d)*periods.size() + p;
+  }
+
+  double ductilityDemand(const GroundMotion&, double w, double zeta, double fy) const;
+
+  std::vector<double> periods, damping, ductility;
+  double hardening;
+
+  int numRecords;
+  int numFailed;
+  std::vector<double> pga;
+  std::vector<double> sd, sv, ay;
+};
+
+} // namespace OpenSees
+
+#endif
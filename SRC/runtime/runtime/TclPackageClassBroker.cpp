@@ -132,6 +132,8 @@ using namespace OpenSees::Hash::literals;
 #include "MembranePlateFiberSection.h"
 #include "Bidirectional.h"
 #include "LayeredShellFiberSection.h" // Yuli Huang & Xinzheng Lu
+#include "MultiSurfaceSection2d.h"
+#include "ShapeSection2d.h"
 
 // NDMaterials
 #include "ElasticIsotropicPlaneStrain2D.h"
@@ -1202,6 +1204,12 @@ TclPackageClassBroker::getNewSection(int classTag)
   case SEC_TAG_Bidirectional:
     return new Bidirectional();
 
+  case SEC_TAG_MultiSurfaceSection2d:
+    return new MultiSurfaceSection2d();
+
+  case SEC_TAG_ShapeSection2d:
+    return new ShapeSection2d();
+
   default:
     opserr << "TclPackageClassBroker::getNewSection - ";
     opserr << " - no section type exists for class tag ";
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: A minimal harness for reproducible benchmarks.
+//
+// A benchmark is registered with a group, a name and a setup function.
+// The setup function builds the workload once and returns the body of
+// one iteration, which returns the number of items it processed (e.g.,
+// strain steps, fibers or equations), or a negative value on failure.
+// A setup function that fails returns an empty body, and the benchmark
+// is reported as failed; one whose workload needs a component that is
+// not part of this build (e.g., a solver library) returns unavailable(),
+// and the benchmark is reported as skipped.
+//
+// Each benchmark is run for one warm-up iteration, then in batches of
+// iterations sized to last at least a minimum time; the median, minimum
+// and maximum time per iteration over the batches are reported.
+// Workloads draw their random numbers from a generator seeded with
+// Options::seed so that runs on different builds can be compared.
+//
+#ifndef OpenSees_Benchmark_h
+#define OpenSees_Benchmark_h
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace OpenSees {
+namespace Benchmark {
+
+struct Options {
+  std::string filter;          // run benchmarks whose "group/name" contains filter
+  int         repeat   = 5;    // number of timed batches
+  double      min_time = 0.1;  // minimum duration of a batch, in seconds
+  unsigned    seed     = 2024;
+  int         size     = 1;    // scale factor applied to workload sizes
+};
+
+using Body  = std::function<std::int64_t()>;
+using Setup = std::function<Body(const Options&, std::mt19937&)>;
+
+// Returned by the body of a benchmark that is unavailable in this build
+constexpr std::int64_t Unavailable = INT64_MIN;
+
+inline Body
+unavailable()
+{
+  return []() -> std::int64_t { return Unavailable; };
+}
+
+struct Case {
+  std::string group;
+  std::string name;
+  Setup       setup;
+};
+
+struct Result {
+  std::string  group;
+  std::string  name;
+  bool         skipped = false;
+  bool         failed  = false;
+  std::int64_t iterations = 0;  // iterations per batch
+  std::int64_t items      = 0;  // items per iteration
+  double       median_ns  = 0;
+  double       min_ns     = 0;
+  double       max_ns     = 0;
+};
+
+class Registry {
+public:
+  void add(const char* group, const char* name, Setup setup) {
+    cases.push_back(Case{group, name, std::move(setup)});
+  }
+
+  const std::vector<Case>& all() const {
+    return cases;
+  }
+
+private:
+  std::vector<Case> cases;
+};
+
+//
+// A cyclic history of n points with growing amplitude and a small random
+// perturbation, as seen by a material point in a nonlinear analysis
+//
+inline std::vector<double>
+cyclic_history(int n, double amplitude, std::mt19937& random, int cycles=8)
+{
+  std::uniform_real_distribution<double> noise(-0.02, 0.02);
+  std::vector<double> history(n);
+  for (int i = 0; i < n; i++) {
+    const double t = static_cast<double>(i)/n;
+    history[i] = amplitude*t*(std::sin(2.0*M_PI*cycles*t) + noise(random));
+  }
+  return history;
+}
+
+} // namespace Benchmark
+} // namespace OpenSees
+
+// Each file of workloads adds its benchmarks to the registry
+void add_material_benchmarks(OpenSees::Benchmark::Registry&);
+void add_section_benchmarks(OpenSees::Benchmark::Registry&);
+void add_solver_benchmarks(OpenSees::Benchmark::Registry&);
+void add_recorder_benchmarks(OpenSees::Benchmark::Registry&);
+void add_mpm_benchmarks(OpenSees::Benchmark::Registry&);
+
+#endif
@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Helpers for benchmarks that drive a model through the
+// interpreter.
+//
+#ifndef OpenSees_Benchmark_Interpreter_h
+#define OpenSees_Benchmark_Interpreter_h
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tcl.h>
+
+extern "C" int Openseesrt_Init(Tcl_Interp *interp);
+
+namespace OpenSees {
+namespace Benchmark {
+
+using Interpreter = std::shared_ptr<Tcl_Interp>;
+
+inline Interpreter
+create_interpreter()
+{
+  static bool found = false;
+  if (!found) {
+    Tcl_FindExecutable(nullptr);
+    found = true;
+  }
+
+  Tcl_Interp *interp = Tcl_CreateInterp();
+  if (Tcl_Init(interp) != TCL_OK || Openseesrt_Init(interp) != TCL_OK) {
+    Tcl_DeleteInterp(interp);
+    return nullptr;
+  }
+  return Interpreter(interp, [](Tcl_Interp *interp) {
+    Tcl_Eval(interp, "wipe");
+    Tcl_DeleteInterp(interp);
+  });
+}
+
+//
+// A plane strain cantilever wall of n by 4n quadrilaterals, fixed at
+// its base and loaded laterally at its top; (n+1)(4n+1) nodes with two
+// degrees of freedom each.
+//
+inline std::string
+wall_script(int n)
+{
+  const int nx = n, ny = 4*n;
+  const auto node = [nx](int i, int j) { return 1 + j*(nx + 1) + i; };
+
+  std::ostringstream s;
+  s << "model basic -ndm 2 -ndf 2\n"
+    << "nDMaterial ElasticIsotropic 1 29000.0 0.3\n";
+
+  for (int j = 0; j <= ny; j++)
+    for (int i = 0; i <= nx; i++)
+      s << "node " << node(i, j) << " " << i << ".0 " << j << ".0\n";
+
+  int tag = 1;
+  for (int j = 0; j < ny; j++)
+    for (int i = 0; i < nx; i++)
+      s << "element Quad " << tag++ << " "
+        << node(i, j)   << " " << node(i+1, j) << " "
+        << node(i+1, j+1) << " " << node(i, j+1) << " 1.0 PlaneStrain 1\n";
+
+  for (int i = 0; i <= nx; i++)
+    s << "fix " << node(i, 0) << " 1 1\n";
+
+  s << "pattern Plain 1 Linear {\n";
+  for (int i = 0; i <= nx; i++)
+    s << "  load " << node(i, ny) << " 1.0 0.0\n";
+  s << "}\n";
+
+  return s.str();
+}
+
+inline int
+num_wall_nodes(int n)
+{
+  return (n + 1)*(4*n + 1);
+}
+
+} // namespace Benchmark
+} // namespace OpenSees
+
+#endif
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""
+Compare the results of two runs of the benchmark suite.
+
+    python compare.py base.json new.json [--threshold 0.1]
+
+Benchmarks are matched by group and name. A benchmark is reported as a
+regression when its median time grew by more than the threshold and its
+fastest batch is slower than the median of the base run, so that noise
+in a single batch is not reported. The exit status is 1 when any
+regression is found.
+"""
+import sys
+import json
+import argparse
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data, {
+        (b["group"], b["name"]): b for b in data["benchmarks"] if b.get("status") == "ok"
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("base")
+    parser.add_argument("new")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative change in median time reported as a regression")
+    args = parser.parse_args()
+
+    base_info, base = load(args.base)
+    new_info,  new  = load(args.new)
+
+    for key in "seed", "size":
+        if base_info.get(key) != new_info.get(key):
+            print(f"warning: runs used a different {key} "
+                  f"({base_info.get(key)} and {new_info.get(key)})", file=sys.stderr)
+
+    print(f"{'benchmark':44} {base_info.get('revision', ''):>12} {new_info.get('revision', ''):>12} {'change':>9}")
+
+    regressions = []
+    for key in sorted(set(base) | set(new)):
+        name = "/".join(key)
+        if key not in base or key not in new:
+            print(f"{name:44} {'-' if key not in base else '':>12} {'-' if key not in new else '':>12}")
+            continue
+
+        b, n = base[key], new[key]
+        change = n["median_ns"]/b["median_ns"] - 1.0
+        flag = ""
+        if change > args.threshold and n["min_ns"] > b["median_ns"]:
+            flag = "  slower"
+            regressions.append(name)
+        elif change < -args.threshold and n["median_ns"] < b["min_ns"]:
+            flag = "  faster"
+
+        print(f"{name:44} {b['median_ns']*1e-6:10.3f}ms {n['median_ns']*1e-6:10.3f}ms {100*change:+8.1f}%{flag}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s): " + ", ".join(regressions))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
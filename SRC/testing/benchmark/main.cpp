@@ -0,0 +1,204 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Driver for the benchmark suite.
+//
+//   benchmark ?--filter $text? ?--repeat $n? ?--min-time $seconds?
+//             ?--seed $n? ?--size $n? ?--json $file? ?--list?
+//
+// Results are printed as a table and, with --json, written in a form
+// that compare.py can diff against the results of another build.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+#include "Benchmark.h"
+
+#ifndef OPS_BENCHMARK_REVISION
+#  define OPS_BENCHMARK_REVISION "unknown"
+#endif
+
+using namespace OpenSees::Benchmark;
+
+static double
+seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static Result
+run(const Case& test, const Options& options)
+{
+  Result result;
+  result.group = test.group;
+  result.name  = test.name;
+
+  std::mt19937 random(options.seed);
+  Body body = test.setup(options, random);
+  if (!body) {
+    result.failed = true;
+    return result;
+  }
+
+  // Warm up, and size batches to last at least min_time
+  auto start = std::chrono::steady_clock::now();
+  result.items = body();
+  if (result.items == Unavailable) {
+    result.skipped = true;
+    return result;
+  }
+  if (result.items < 0) {
+    result.failed = true;
+    return result;
+  }
+  const double once = std::max(seconds_since(start), 1e-9);
+  result.iterations = std::max<std::int64_t>(1, static_cast<std::int64_t>(options.min_time/once));
+
+  std::vector<double> times;
+  for (int r = 0; r < options.repeat; r++) {
+    start = std::chrono::steady_clock::now();
+    for (std::int64_t i = 0; i < result.iterations; i++)
+      if (body() < 0) {
+        result.failed = true;
+        return result;
+      }
+    times.push_back(1e9*seconds_since(start)/result.iterations);
+  }
+
+  std::sort(times.begin(), times.end());
+  result.median_ns = times[times.size()/2];
+  result.min_ns    = times.front();
+  result.max_ns    = times.back();
+  return result;
+}
+
+static void
+write_json(std::ostream& s, const Options& options, const std::vector<Result>& results)
+{
+  s << "{\n"
+    << "  \"schema\": 1,\n"
+    << "  \"revision\": \"" << (std::getenv("OPENSEES_REVISION") ? std::getenv("OPENSEES_REVISION")
+                                                                 : OPS_BENCHMARK_REVISION) << "\",\n"
+#if defined(__VERSION__)
+    << "  \"compiler\": \"" << __VERSION__ << "\",\n"
+#endif
+    << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+    << "  \"seed\": " << options.seed << ",\n"
+    << "  \"size\": " << options.size << ",\n"
+    << "  \"repeat\": " << options.repeat << ",\n"
+    << "  \"benchmarks\": [";
+
+  bool first = true;
+  for (const Result& r : results) {
+    s << (first ? "\n" : ",\n") << std::setprecision(10)
+      << "    {\"group\": \"" << r.group << "\", \"name\": \"" << r.name << "\"";
+    first = false;
+
+    if (r.skipped || r.failed) {
+      s << ", \"status\": \"" << (r.skipped ? "skipped" : "failed") << "\"}";
+      continue;
+    }
+    s << ", \"status\": \"ok\""
+      << ", \"iterations\": " << r.iterations
+      << ", \"items\": "      << r.items
+      << ", \"median_ns\": "  << r.median_ns
+      << ", \"min_ns\": "     << r.min_ns
+      << ", \"max_ns\": "     << r.max_ns
+      << ", \"items_per_second\": " << (r.median_ns > 0 ? 1e9*r.items/r.median_ns : 0.0)
+      << "}";
+  }
+  s << "\n  ]\n}\n";
+}
+
+static void
+print_usage()
+{
+  std::cerr << "usage: benchmark [--filter text] [--repeat n] [--min-time seconds]\n"
+               "                 [--seed n] [--size n] [--json file] [--list]\n";
+}
+
+int
+main(int argc, char **argv)
+{
+  Options options;
+  const char *json = nullptr;
+  bool list = false;
+
+  for (int i = 1; i < argc; i++) {
+    const bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--filter") == 0 && has_value)
+      options.filter = argv[++i];
+    else if (strcmp(argv[i], "--repeat") == 0 && has_value)
+      options.repeat = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "--min-time") == 0 && has_value)
+      options.min_time = atof(argv[++i]);
+    else if (strcmp(argv[i], "--seed") == 0 && has_value)
+      options.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+    else if (strcmp(argv[i], "--size") == 0 && has_value)
+      options.size = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "--json") == 0 && has_value)
+      json = argv[++i];
+    else if (strcmp(argv[i], "--list") == 0)
+      list = true;
+    else {
+      print_usage();
+      return 1;
+    }
+  }
+
+  Registry registry;
+  add_material_benchmarks(registry);
+  add_section_benchmarks(registry);
+  add_solver_benchmarks(registry);
+  add_recorder_benchmarks(registry);
+  add_mpm_benchmarks(registry);
+
+  std::vector<Result> results;
+  for (const Case& test : registry.all()) {
+    const std::string path = test.group + "/" + test.name;
+    if (!options.filter.empty() && path.find(options.filter) == std::string::npos)
+      continue;
+
+    if (list) {
+      std::cout << path << "\n";
+      continue;
+    }
+
+    Result result = run(test, options);
+    std::cout << std::left << std::setw(44) << path << std::right;
+    if (result.skipped)
+      std::cout << "  skipped\n";
+    else if (result.failed)
+      std::cout << "  FAILED\n";
+    else
+      std::cout << std::fixed << std::setprecision(3)
+                << std::setw(14) << result.median_ns*1e-6 << " ms"
+                << std::setw(16) << std::setprecision(0)
+                << 1e9*result.items/result.median_ns << " items/s\n";
+    std::cout.flush();
+    results.push_back(result);
+  }
+
+  if (json != nullptr) {
+    std::ofstream file(json);
+    if (!file.is_open()) {
+      std::cerr << "failed to open " << json << "\n";
+      return 1;
+    }
+    write_json(file, options, results);
+  }
+
+  for (const Result& r : results)
+    if (r.failed)
+      return 2;
+  return 0;
+}
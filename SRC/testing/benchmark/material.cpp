@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Material state determination benchmarks.
+//
+// Each iteration drives a material from its initial state through a
+// cyclic strain history, committing every step; an item is one step.
+//
+#include <memory>
+#include "Benchmark.h"
+
+#include <Vector.h>
+#include <UniaxialMaterial.h>
+#include <NDMaterial.h>
+#include <Steel01.h>
+#include <Steel02.h>
+#include <Concrete02.h>
+#include <ElasticIsotropicMaterial.h>
+#include <J2Plasticity.h>
+
+using namespace OpenSees::Benchmark;
+
+static Setup
+uniaxial(std::function<UniaxialMaterial*()> create, double amplitude)
+{
+  return [=](const Options& options, std::mt19937& random) -> Body {
+    std::shared_ptr<UniaxialMaterial> material(create());
+    if (material == nullptr)
+      return nullptr;
+
+    auto strain = std::make_shared<std::vector<double>>(
+        cyclic_history(10000*options.size, amplitude, random));
+
+    return [material, strain]() -> std::int64_t {
+      material->revertToStart();
+      for (double e : *strain) {
+        if (material->setTrialStrain(e) != 0)
+          return -1;
+        material->commitState();
+      }
+      return static_cast<std::int64_t>(strain->size());
+    };
+  };
+}
+
+static Setup
+multiaxial(std::function<NDMaterial*()> create, double amplitude)
+{
+  return [=](const Options& options, std::mt19937& random) -> Body {
+    std::shared_ptr<NDMaterial> base(create());
+    if (base == nullptr)
+      return nullptr;
+
+    std::shared_ptr<NDMaterial> material(base->getCopy("ThreeDimensional"));
+    if (material == nullptr)
+      return nullptr;
+
+    // A proportional history in a fixed, random direction of strain space
+    const int n = 5000*options.size;
+    std::vector<double> path = cyclic_history(n, amplitude, random);
+    std::normal_distribution<double> normal;
+    double direction[6];
+    for (double &d : direction)
+      d = normal(random);
+
+    auto strain = std::make_shared<std::vector<Vector>>(n, Vector(6));
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < 6; j++)
+        (*strain)[i](j) = path[i]*direction[j];
+
+    return [material, strain]() -> std::int64_t {
+      material->revertToStart();
+      for (const Vector &e : *strain) {
+        if (material->setTrialStrain(e) != 0)
+          return -1;
+        material->commitState();
+      }
+      return static_cast<std::int64_t>(strain->size());
+    };
+  };
+}
+
+void
+add_material_benchmarks(Registry& registry)
+{
+  registry.add("uniaxial", "Steel01", uniaxial([]() {
+    return new Steel01(1, 60.0, 29000.0, 0.02);
+  }, 0.02));
+
+  registry.add("uniaxial", "Steel02", uniaxial([]() {
+    return new Steel02(1, 60.0, 29000.0, 0.02, 20.0, 0.925, 0.15);
+  }, 0.02));
+
+  registry.add("uniaxial", "Concrete02", uniaxial([]() {
+    return new Concrete02(1, -5.0, -0.002, -1.0, -0.006, 0.1, 0.5, 250.0);
+  }, 0.004));
+
+  registry.add("nD", "ElasticIsotropic", multiaxial([]() {
+    return new ElasticIsotropicMaterial(1, 29000.0, 0.3);
+  }, 0.01));
+
+  registry.add("nD", "J2Plasticity", multiaxial([]() {
+    return new J2Plasticity(1, 0, 24000.0, 11000.0, 60.0, 80.0, 10.0, 100.0);
+  }, 0.02));
+}
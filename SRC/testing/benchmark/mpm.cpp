@@ -0,0 +1,218 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Material point method step benchmarks.
+//
+// Each iteration is one step of the explicit solver of SRC/mpm,
+// mpm::MPMExplicit, on a column of linear elastic material points
+// settling under gravity on a regular mesh whose base is fixed. The
+// input is generated in a temporary directory and read as for the
+// CoSimulation pattern; an item is one particle update.
+//
+// The MPM solvers are compiled into the runtime only when it is built
+// with OPS_USE_MPM; otherwise the benchmarks are reported as skipped.
+//
+#include "Benchmark.h"
+
+#if defined(OPS_BENCHMARK_MPM)
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include "mpm_explicit.h"
+
+using namespace OpenSees::Benchmark;
+
+namespace {
+
+//
+// Write the input of a column of particles, ppc by ppc in each cell of
+// the middle half of an nx by ny mesh and up to half its height, and
+// return the number of particles
+//
+std::int64_t
+write_column(const std::filesystem::path& directory, int nx, int ny, int ppc,
+             std::mt19937& random)
+{
+  const double h = 1.0;
+
+  std::ofstream mesh(directory / "mesh.txt");
+  mesh << "! " << nx << " x " << ny << " ED2Q4 cells\n"
+       << (nx + 1)*(ny + 1) << " " << nx*ny << "\n";
+  for (int j = 0; j <= ny; j++)
+    for (int i = 0; i <= nx; i++)
+      mesh << h*i << " " << h*j << "\n";
+  for (int j = 0; j < ny; j++)
+    for (int i = 0; i < nx; i++) {
+      const int n = j*(nx + 1) + i;
+      mesh << n << " " << n + 1 << " " << n + nx + 2 << " " << n + nx + 1 << "\n";
+    }
+
+  // The base of the mesh is fixed
+  std::ofstream constraints(directory / "velocity-constraints.txt");
+  for (int i = 0; i <= nx; i++)
+    constraints << i << " 0 0.0\n" << i << " 1 0.0\n";
+
+  // Particles are slightly perturbed from their regular positions
+  std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+  std::ostringstream points;
+  std::int64_t np = 0;
+  for (int j = 0; j < ny/2; j++)
+    for (int i = nx/4; i < nx - nx/4; i++)
+      for (int b = 0; b < ppc; b++)
+        for (int a = 0; a < ppc; a++, np++)
+          points << h*(i + (a + 0.5 + jitter(random))/ppc) << " "
+                 << h*(j + (b + 0.5 + jitter(random))/ppc) << "\n";
+
+  std::ofstream particles(directory / "particles.txt");
+  particles << "! " << ppc << " by " << ppc << " material points in each cell\n"
+            << np << "\n" << points.str();
+
+  std::ofstream input(directory / "mpm.json");
+  input << R"({
+  "title": "Elastic column settling under gravity",
+  "mesh": {
+    "mesh": "mesh.txt",
+    "io_type": "Ascii2D",
+    "node_type": "N2D",
+    "cell_type": "ED2Q4",
+    "check_duplicates": false,
+    "boundary_conditions": {
+      "velocity_constraints": [{"file": "velocity-constraints.txt"}]
+    }
+  },
+  "particles": [{
+    "generator": {
+      "type": "file",
+      "location": "particles.txt",
+      "io_type": "Ascii2D",
+      "particle_type": "P2D",
+      "material_id": 0,
+      "pset_id": 0,
+      "check_duplicates": false
+    }
+  }],
+  "materials": [{
+    "id": 0,
+    "type": "LinearElastic2D",
+    "density": 2000.0,
+    "youngs_modulus": 1.0e6,
+    "poisson_ratio": 0.3
+  }],
+  "external_loading_conditions": {
+    "gravity": [0.0, -9.81]
+  },
+  "analysis": {
+    "type": "MPMExplicit2D",
+    "mpm_scheme": "usl",
+    "velocity_update": false,
+    "dt": 1.0e-4,
+    "nsteps": 1000000000
+  },
+  "post_processing": {
+    "path": "results/",
+    "output_steps": 1000000000
+  }
+})";
+
+  if (!mesh || !constraints || !particles || !input)
+    return -1;
+  return np;
+}
+
+} // namespace
+
+static Setup
+column(int cells, int ppc)
+{
+  return [=](const Options& options, std::mt19937& random) -> Body {
+    const int nx = cells*options.size;
+
+    auto directory = std::make_shared<std::filesystem::path>(
+        std::filesystem::temp_directory_path()
+        / ("opensees-benchmark-mpm-" + std::to_string(nx) + "-" + std::to_string(ppc)));
+    const auto discard = [directory]() {
+      std::error_code error;
+      std::filesystem::remove_all(*directory, error);
+    };
+
+    std::error_code error;
+    std::filesystem::create_directories(*directory, error);
+
+    const std::int64_t particles = write_column(*directory, nx, 2*nx, ppc, random);
+    if (error || particles < 0) {
+      std::cerr << "failed to write the MPM input to " << directory->string() << "\n";
+      discard();
+      return nullptr;
+    }
+
+    // The solver logs every step
+    spdlog::set_level(spdlog::level::warn);
+
+    // The input is read by its command line parser
+    std::vector<std::string> args {"mpm", "-f", directory->string() + "/", "-i", "mpm.json"};
+    std::vector<char*> argv;
+    for (std::string& arg : args)
+      argv.push_back(&arg[0]);
+
+    std::shared_ptr<mpm::MPMExplicit<2>> solver;
+    try {
+      auto io = std::make_shared<mpm::IO>(static_cast<int>(argv.size()), argv.data());
+      solver = std::make_shared<mpm::MPMExplicit<2>>(io);
+      if (!solver->initialise_analysis()) {
+        solver.reset();
+        discard();
+        return nullptr;
+      }
+    } catch (std::exception& error) {
+      std::cerr << "failed to create the MPM analysis; " << error.what() << "\n";
+      solver.reset();
+      discard();
+      return nullptr;
+    }
+
+    // The solver is deleted before its input and results are removed
+    std::shared_ptr<mpm::MPMExplicit<2>> model(solver.get(),
+        [solver, discard](mpm::MPMExplicit<2>*) mutable {
+      solver.reset();
+      discard();
+    });
+
+    return [model, particles]() -> std::int64_t {
+      try {
+        model->solve_step();
+      } catch (std::exception& error) {
+        std::cerr << "MPM step failed; " << error.what() << "\n";
+        return -1;
+      }
+      return particles;
+    };
+  };
+}
+
+void
+add_mpm_benchmarks(Registry& registry)
+{
+  registry.add("mpm", "explicit/32x64/ppc2", column(32, 2));
+  registry.add("mpm", "explicit/32x64/ppc4", column(32, 4));
+}
+
+#else
+
+using namespace OpenSees::Benchmark;
+
+void
+add_mpm_benchmarks(Registry& registry)
+{
+  const Setup unavailable = [](const Options&, std::mt19937&) -> Body {
+    return OpenSees::Benchmark::unavailable();
+  };
+  registry.add("mpm", "explicit/32x64/ppc2", unavailable);
+  registry.add("mpm", "explicit/32x64/ppc4", unavailable);
+}
+
+#endif
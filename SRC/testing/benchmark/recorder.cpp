@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Recorder throughput benchmarks.
+//
+// A node recorder for the displacements of every node of a generated
+// mesh is invoked through the record command; an item is one recorded
+// value. Output is written to a temporary file that is removed when the
+// benchmark finishes.
+//
+#include <cstdio>
+#include <filesystem>
+#include "Benchmark.h"
+#include "Interpreter.h"
+
+using namespace OpenSees::Benchmark;
+
+static Setup
+node_recorder(const char* format, int n)
+{
+  const std::string option = format;
+  return [=](const Options& options, std::mt19937&) -> Body {
+    Interpreter interp = create_interpreter();
+    if (interp == nullptr)
+      return nullptr;
+
+    const int size  = n*options.size;
+    const int nodes = num_wall_nodes(size);
+    if (Tcl_Eval(interp.get(), wall_script(size).c_str()) != TCL_OK)
+      return nullptr;
+
+    auto path = std::make_shared<std::filesystem::path>(
+        std::filesystem::temp_directory_path() / ("opensees-benchmark" + option + ".out"));
+
+    const std::string recorder =
+        "recorder Node " + option + " {" + path->string() + "} -time "
+        "-nodeRange 1 " + std::to_string(nodes) + " -dof 1 2 disp\n";
+
+    if (Tcl_Eval(interp.get(), recorder.c_str()) != TCL_OK)
+      return nullptr;
+
+    const std::int64_t values = 2*nodes;
+
+    // The interpreter is deleted before the file is removed so that the
+    // recorder has closed it
+    Interpreter model(interp.get(), [interp, path](Tcl_Interp*) mutable {
+      interp.reset();
+      std::error_code error;
+      std::filesystem::remove(*path, error);
+    });
+
+    return [model, values]() -> std::int64_t {
+      if (Tcl_Eval(model.get(), "record") != TCL_OK)
+        return -1;
+      return values;
+    };
+  };
+}
+
+void
+add_recorder_benchmarks(Registry& registry)
+{
+  registry.add("recorder", "Node/text",   node_recorder("-file",   20));
+  registry.add("recorder", "Node/csv",    node_recorder("-csv",    20));
+  registry.add("recorder", "Node/binary", node_recorder("-binary", 20));
+  registry.add("recorder", "Node/xml",    node_recorder("-xml",    20));
+}
@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Fiber section state determination benchmarks.
+//
+// A reinforced concrete rectangle is discretized into concrete fibers
+// with a ring of steel fibers near its perimeter, and driven through a
+// cyclic history of axial strain and curvature; an item is one step.
+//
+#include <algorithm>
+#include <memory>
+#include "Benchmark.h"
+
+#include <Vector.h>
+#include <Steel02.h>
+#include <Concrete02.h>
+#include <ElasticMaterial.h>
+#include <FiberSection2d.h>
+#include <FiberSection3d.h>
+
+using namespace OpenSees::Benchmark;
+
+// Section dimensions
+static constexpr double Depth = 24.0,
+                        Width = 18.0,
+                        Cover = 2.0,
+                        Bar   = 0.79;
+
+static Body
+run_history(std::shared_ptr<SectionForceDeformation> section,
+            std::shared_ptr<std::vector<Vector>> history)
+{
+  return [section, history]() -> std::int64_t {
+    section->revertToStart();
+    for (const Vector &e : *history) {
+      if (section->setTrialSectionDeformation(e) != 0)
+        return -1;
+      section->getStressResultant();
+      section->getSectionTangent();
+      section->commitState();
+    }
+    return static_cast<std::int64_t>(history->size());
+  };
+}
+
+static std::shared_ptr<std::vector<Vector>>
+make_history(int n, int order, std::mt19937& random)
+{
+  // Axial strain varies slowly; curvatures follow cyclic histories
+  std::vector<double> axial = cyclic_history(n, 0.0005, random, 2);
+  std::vector<double> kz    = cyclic_history(n, 0.0010, random);
+  std::vector<double> ky    = cyclic_history(n, 0.0005, random, 5);
+
+  auto history = std::make_shared<std::vector<Vector>>(n, Vector(order));
+  for (int i = 0; i < n; i++) {
+    Vector &e = (*history)[i];
+    e(0) = axial[i] - 0.0002;
+    e(1) = kz[i];
+    if (order > 2) {
+      e(2) = ky[i];
+      e(3) = 0.0;
+    }
+  }
+  return history;
+}
+
+static Setup
+fiber_section_2d(int layers)
+{
+  return [=](const Options& options, std::mt19937& random) -> Body {
+    Concrete02 concrete(1, -5.0, -0.002, -1.0, -0.006, 0.1, 0.5, 250.0);
+    Steel02    steel(2, 60.0, 29000.0, 0.02, 20.0, 0.925, 0.15);
+
+    const int nc = layers*options.size;
+    auto section = std::make_shared<FiberSection2d>(1, nc + 8);
+
+    const double dy = Depth/nc;
+    for (int i = 0; i < nc; i++)
+      section->addFiber(concrete, dy*Width, -0.5*Depth + (i + 0.5)*dy);
+
+    for (int i = 0; i < 4; i++) {
+      section->addFiber(steel, Bar,  0.5*Depth - Cover);
+      section->addFiber(steel, Bar, -0.5*Depth + Cover);
+    }
+
+    return run_history(section, make_history(2000, 2, random));
+  };
+}
+
+static Setup
+fiber_section_3d(int grid)
+{
+  return [=](const Options& options, std::mt19937& random) -> Body {
+    Concrete02 concrete(1, -5.0, -0.002, -1.0, -0.006, 0.1, 0.5, 250.0);
+    Steel02    steel(2, 60.0, 29000.0, 0.02, 20.0, 0.925, 0.15);
+    ElasticMaterial torsion(3, 1.0e6);
+
+    const int ny = grid*options.size, nz = grid*options.size;
+    auto section = std::make_shared<FiberSection3d>(1, ny*nz + 4*(ny + nz), torsion);
+
+    const double dy = Depth/ny, dz = Width/nz;
+    for (int i = 0; i < ny; i++)
+      for (int j = 0; j < nz; j++)
+        section->addFiber(concrete, dy*dz, -0.5*Depth + (i + 0.5)*dy, -0.5*Width + (j + 0.5)*dz);
+
+    // Perimeter bars
+    const double yb = 0.5*Depth - Cover, zb = 0.5*Width - Cover;
+    for (int i = 0; i < ny; i++) {
+      const double y = -yb + 2.0*yb*i/std::max(1, ny - 1);
+      section->addFiber(steel, Bar, y, -zb);
+      section->addFiber(steel, Bar, y,  zb);
+    }
+    for (int j = 0; j < nz; j++) {
+      const double z = -zb + 2.0*zb*j/std::max(1, nz - 1);
+      section->addFiber(steel, Bar, -yb, z);
+      section->addFiber(steel, Bar,  yb, z);
+    }
+
+    return run_history(section, make_history(1000, 4, random));
+  };
+}
+
+void
+add_section_benchmarks(Registry& registry)
+{
+  registry.add("section", "FiberSection2d/20",  fiber_section_2d(20));
+  registry.add("section", "FiberSection2d/100", fiber_section_2d(100));
+  registry.add("section", "FiberSection3d/10x10", fiber_section_3d(10));
+  registry.add("section", "FiberSection3d/20x20", fiber_section_3d(20));
+}
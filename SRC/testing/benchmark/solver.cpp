@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Assembly, factorization and solution benchmarks.
+//
+// Each iteration performs one linear static step of a generated mesh,
+// which assembles and factors the stiffness and solves for the
+// displacements with the given system of equations; an item is one
+// equation. Systems that are not available in this build are skipped.
+//
+#include <iostream>
+#include "Benchmark.h"
+#include "Interpreter.h"
+
+using namespace OpenSees::Benchmark;
+
+static Setup
+linear_step(const char* system, int n)
+{
+  const std::string command = system;
+  return [=](const Options& options, std::mt19937&) -> Body {
+    Interpreter interp = create_interpreter();
+    if (interp == nullptr)
+      return nullptr;
+
+    const int size = n*options.size;
+    if (Tcl_Eval(interp.get(), wall_script(size).c_str()) != TCL_OK) {
+      std::cerr << Tcl_GetStringResult(interp.get()) << "\n";
+      return nullptr;
+    }
+
+    // The system command fails for a solver library that is not built
+    if (Tcl_Eval(interp.get(), ("system " + command).c_str()) != TCL_OK)
+      return unavailable();
+
+    const std::string analysis =
+        "numberer RCM\n"
+        "constraints Plain\n"
+        "algorithm Linear\n"
+        "integrator LoadControl 1.0\n"
+        "analysis Static\n";
+
+    if (Tcl_Eval(interp.get(), analysis.c_str()) != TCL_OK) {
+      std::cerr << Tcl_GetStringResult(interp.get()) << "\n";
+      return nullptr;
+    }
+
+    const std::int64_t equations = 2*(num_wall_nodes(size) - (size + 1));
+
+    return [interp, equations]() -> std::int64_t {
+      if (Tcl_Eval(interp.get(), "analyze 1") != TCL_OK)
+        return -1;
+      return equations;
+    };
+  };
+}
+
+void
+add_solver_benchmarks(Registry& registry)
+{
+  for (const char *system : {"ProfileSPD", "BandGeneral", "BandSPD", "UmfPack", "SparseSYM", "Mumps"}) {
+    registry.add("solver", (std::string(system) + "/20").c_str(), linear_step(system, 20));
+    registry.add("solver", (std::string(system) + "/40").c_str(), linear_step(system, 40));
+  }
+}
@@ -0,0 +1,291 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Per-thread scope trees and their JSON summaries.
+//
+#include "Profiler.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace OpenSees {
+
+namespace {
+
+struct Stat {
+  std::uint64_t count = 0;
+  std::int64_t  total = 0;
+  std::int64_t  self  = 0;
+  std::int64_t  min   = std::numeric_limits<std::int64_t>::max();
+  std::int64_t  max   = 0;
+
+  void add(const Stat& other) {
+    count += other.count;
+    total += other.total;
+    self  += other.self;
+    min    = std::min(min, other.min);
+    max    = std::max(max, other.max);
+  }
+};
+
+struct Node {
+  std::string      name;
+  int              parent;
+  std::vector<int> children;
+  Stat             stat;
+  std::int64_t     nested = 0;   // time spent in children
+};
+
+struct ThreadProfile {
+  int id;
+  int current = 0;
+  std::vector<Node> nodes;
+
+  explicit ThreadProfile(int id) : id(id) {
+    nodes.push_back(Node{"", -1, {}, {}, 0});
+  }
+
+  std::string path(int i) const {
+    std::string p = nodes[i].name;
+    for (int n = nodes[i].parent; n > 0; n = nodes[n].parent)
+      p = nodes[n].name + "/" + p;
+    return p;
+  }
+};
+
+struct Registry {
+  std::mutex lock;
+  std::vector<std::unique_ptr<ThreadProfile>> threads;
+  std::string output;
+  int rank = -1;
+};
+
+Registry &
+registry()
+{
+  // never destroyed, so that it is still available to the
+  // exit handler and to threads that finish late
+  static Registry *r = new Registry;
+  return *r;
+}
+
+ThreadProfile &
+local()
+{
+  thread_local ThreadProfile *profile = nullptr;
+  if (profile == nullptr) {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    r.threads.emplace_back(new ThreadProfile(static_cast<int>(r.threads.size())));
+    profile = r.threads.back().get();
+  }
+  return *profile;
+}
+
+// Scope names come from commands and may hold any character
+void
+write_escaped(std::ostream& s, const std::string& text)
+{
+  for (const char c : text) {
+    switch (c) {
+      case '"':  s << "\\\""; break;
+      case '\\': s << "\\\\"; break;
+      case '\n': s << "\\n";  break;
+      case '\t': s << "\\t";  break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char code[8];
+          std::snprintf(code, sizeof(code), "\\u%04x", c);
+          s << code;
+        } else
+          s << c;
+    }
+  }
+}
+
+void
+write_stat(std::ostream& s, const std::string& path, const Stat& stat)
+{
+  s << "{\"path\": \"";
+  write_escaped(s, path);
+  s << "\""
+    << ", \"count\": "    << stat.count
+    << ", \"total_ns\": " << stat.total
+    << ", \"self_ns\": "  << stat.self
+    << ", \"min_ns\": "   << (stat.count ? stat.min : 0)
+    << ", \"max_ns\": "   << stat.max
+    << "}";
+}
+
+void
+write_at_exit()
+{
+  Registry &r = registry();
+  if (r.output.empty())
+    return;
+
+  std::string file = r.output;
+  if (r.rank >= 0) {
+    const std::size_t dot = file.rfind('.');
+    const std::string rank = "." + std::to_string(r.rank);
+    if (dot == std::string::npos || file.find('/', dot) != std::string::npos)
+      file += rank;
+    else
+      file.insert(dot, rank);
+  }
+  Profiler::dump(file);
+}
+
+// Enable profiling from the environment before main
+const bool from_environment = []() {
+  const char *file = std::getenv("OPENSEES_PROFILE");
+  if (file != nullptr && *file != '\0') {
+    Profiler::setOutput(file);
+    Profiler::enable(true);
+  }
+  return true;
+}();
+
+} // namespace
+
+
+std::atomic<bool> Profiler::active{false};
+
+void
+Profiler::enable(bool on)
+{
+  active.store(on, std::memory_order_relaxed);
+}
+
+void
+Profiler::setRank(int rank)
+{
+  Registry &r = registry();
+  std::lock_guard<std::mutex> guard(r.lock);
+  r.rank = rank;
+}
+
+void
+Profiler::setOutput(const std::string& file)
+{
+  Registry &r = registry();
+  std::lock_guard<std::mutex> guard(r.lock);
+  if (r.output.empty() && !file.empty())
+    std::atexit(write_at_exit);
+  r.output = file;
+}
+
+void
+Profiler::reset()
+{
+  Registry &r = registry();
+  std::lock_guard<std::mutex> guard(r.lock);
+  for (auto &thread : r.threads)
+    for (Node &node : thread->nodes) {
+      node.stat   = Stat{};
+      node.nested = 0;
+    }
+}
+
+int
+Profiler::enter(const char* name)
+{
+  ThreadProfile &profile = local();
+  const int parent = profile.current;
+
+  for (int child : profile.nodes[parent].children)
+    if (std::strcmp(profile.nodes[child].name.c_str(), name) == 0)
+      return profile.current = child;
+
+  const int child = static_cast<int>(profile.nodes.size());
+  profile.nodes.push_back(Node{name, parent, {}, {}, 0});
+  profile.nodes[parent].children.push_back(child);
+  return profile.current = child;
+}
+
+void
+Profiler::leave(int i, std::int64_t elapsed)
+{
+  ThreadProfile &profile = local();
+  Node &node = profile.nodes[i];
+
+  node.stat.count++;
+  node.stat.total += elapsed;
+  node.stat.min    = std::min(node.stat.min, elapsed);
+  node.stat.max    = std::max(node.stat.max, elapsed);
+
+  if (node.parent > 0)
+    profile.nodes[node.parent].nested += elapsed;
+
+  profile.current = node.parent;
+}
+
+void
+Profiler::dump(std::ostream& s)
+{
+  Registry &r = registry();
+  std::lock_guard<std::mutex> guard(r.lock);
+
+  std::map<std::string, Stat> combined;
+
+  s << "{\n  \"rank\": " << (r.rank < 0 ? 0 : r.rank) << ",\n"
+    << "  \"clock\": \"steady_clock\",\n"
+    << "  \"threads\": [";
+
+  bool first_thread = true;
+  for (const auto &thread : r.threads) {
+    s << (first_thread ? "\n" : ",\n")
+      << "    {\"thread\": " << thread->id << ", \"scopes\": [";
+    first_thread = false;
+
+    bool first = true;
+    for (std::size_t i = 1; i < thread->nodes.size(); i++) {
+      const Node &node = thread->nodes[i];
+      if (node.stat.count == 0)
+        continue;
+
+      Stat stat = node.stat;
+      stat.self = stat.total - node.nested;
+
+      const std::string path = thread->path(static_cast<int>(i));
+      combined[path].add(stat);
+
+      s << (first ? "\n      " : ",\n      ");
+      write_stat(s, path, stat);
+      first = false;
+    }
+    s << "\n    ]}";
+  }
+  s << "\n  ],\n  \"scopes\": [";
+
+  bool first = true;
+  for (const auto &[path, stat] : combined) {
+    s << (first ? "\n    " : ",\n    ");
+    write_stat(s, path, stat);
+    first = false;
+  }
+  s << "\n  ]\n}\n";
+}
+
+int
+Profiler::dump(const std::string& file)
+{
+  std::ofstream stream(file);
+  if (!stream.is_open())
+    return -1;
+  dump(stream);
+  return 0;
+}
+
+} // namespace OpenSees
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Low-overhead instrumentation with nested named scopes.
+//
+// A ProfileScope measures the time between its construction and
+// destruction with a monotonic nanosecond clock and charges it to a node
+// in a per-thread tree of scopes, so that a scope opened inside another
+// is reported under the path of its parent (e.g., "analyze/solve").
+// When profiling is disabled a scope costs a single relaxed atomic load.
+//
+// Each thread accumulates into its own tree without locking; trees are
+// merged by path when a summary is written. Summaries are JSON and hold
+// the count, total, self, minimum and maximum time of each path, per
+// thread and combined, tagged with the process rank.
+//
+// Profiling is enabled with Profiler::enable, or by setting the
+// environment variable OPENSEES_PROFILE to the file the summary should
+// be written to at exit.
+//
+#ifndef OpenSees_Profiler_h
+#define OpenSees_Profiler_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace OpenSees {
+
+class Profiler
+{
+public:
+  static bool enabled() {
+    return active.load(std::memory_order_relaxed);
+  }
+
+  static std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  static void enable(bool on = true);
+  static void setRank(int rank);
+
+  // Write a summary to file at exit; a rank set with setRank is
+  // inserted before the extension of file.
+  static void setOutput(const std::string& file);
+
+  // Zero all statistics
+  static void reset();
+
+  // Write a JSON summary; summaries should be written while the
+  // instrumented threads are idle
+  static void dump(std::ostream& stream);
+  static int  dump(const std::string& file);
+
+  // Used by ProfileScope
+  static int  enter(const char* name);
+  static void leave(int node, std::int64_t elapsed);
+
+private:
+  static std::atomic<bool> active;
+};
+
+class ProfileScope
+{
+public:
+  explicit ProfileScope(const char* name) {
+    if (Profiler::enabled()) {
+      node  = Profiler::enter(name);
+      start = Profiler::now();
+    }
+  }
+
+  ~ProfileScope() {
+    if (node >= 0)
+      Profiler::leave(node, Profiler::now() - start);
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  int node = -1;
+  std::int64_t start = 0;
+};
+
+} // namespace OpenSees
+
+#endif
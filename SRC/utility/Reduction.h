@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Reproducible summation. The terms of a sum that are computed by several
+// processes are normally added in whatever order the communication
+// library chooses, so the last bits of the result can change from one
+// run to the next, and can differ between processes that should hold
+// the same value. The summation selected for a run sets how such sums
+// are formed:
+//
+//   native       in the order of the library (e.g., MPI_Allreduce);
+//                fastest, but not reproducible
+//
+//   ordered      the terms are added in the order of the processes that
+//                computed them, so results are bit-identical between runs
+//                on the same number of processes, and on every process
+//                of a run
+//
+//   compensated  as ordered, with compensated (Neumaier) addition, whose
+//                error does not grow with the number of terms; results
+//                are reproducible as with ordered, and change much less
+//                with the number of processes
+//
+// Cost: a reproducible reduction of n values over p processes gathers
+// all p contributions on every process, which moves and stores n p
+// values where MPI_Allreduce moves n. Compensated addition takes about
+// four times the arithmetic of plain addition. The vectors reduced
+// during an analysis (norms, projections, values at shared nodes) are
+// small, so this is usually minor next to assembly and solution, but it
+// grows with the number of processes.
+//
+// The sum over the processes of an MPI communicator, allreduce_sum, is
+// declared in ReductionMPI.h, so that this header needs no MPI.
+//
+#ifndef OpenSees_Reduction_h
+#define OpenSees_Reduction_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace OpenSees {
+
+enum class Summation : int {
+  Native,
+  Ordered,
+  Compensated
+};
+
+// The summation selected for this run
+inline Summation&
+summation()
+{
+  static Summation mode = Summation::Native;
+  return mode;
+}
+
+inline const char*
+summation_name(Summation mode)
+{
+  switch (mode) {
+    case Summation::Ordered:     return "ordered";
+    case Summation::Compensated: return "compensated";
+    default:                     return "native";
+  }
+}
+
+inline bool
+parse_summation(const char* name, Summation& mode)
+{
+  if (std::strcmp(name, "native") == 0)
+    mode = Summation::Native;
+  else if (std::strcmp(name, "ordered") == 0)
+    mode = Summation::Ordered;
+  else if (std::strcmp(name, "compensated") == 0)
+    mode = Summation::Compensated;
+  else
+    return false;
+  return true;
+}
+
+
+//
+// Neumaier's variant of Kahan summation
+//
+class CompensatedSum
+{
+public:
+  void add(double x) {
+    const double t = sum + x;
+    if (std::fabs(sum) >= std::fabs(x))
+      correction += (sum - t) + x;
+    else
+      correction += (x - t) + sum;
+    sum = t;
+  }
+  double value() const {return sum + correction;}
+
+private:
+  double sum = 0.0, correction = 0.0;
+};
+
+
+//
+// Sum count contributions to each of n values; contribution k to value i
+// is parts[k*n + i], and the contributions are added in the order of k
+//
+inline void
+sum_ordered(const double* parts, int count, int n, double* result,
+            Summation mode = summation())
+{
+  for (int i = 0; i < n; i++) {
+    if (mode == Summation::Compensated) {
+      CompensatedSum sum;
+      for (int k = 0; k < count; k++)
+        sum.add(parts[static_cast<std::size_t>(k)*n + i]);
+      result[i] = sum.value();
+    }
+    else {
+      double sum = 0.0;
+      for (int k = 0; k < count; k++)
+        sum += parts[static_cast<std::size_t>(k)*n + i];
+      result[i] = sum;
+    }
+  }
+}
+
+} // namespace OpenSees
+
+#endif
@@ -0,0 +1,40 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Sums over the processes of an MPI communicator with the summation
+// selected for the run (see Reduction.h).
+//
+#ifndef OpenSees_ReductionMPI_h
+#define OpenSees_ReductionMPI_h
+
+#include <cstddef>
+#include <vector>
+#include <mpi.h>
+#include "Reduction.h"
+
+namespace OpenSees {
+
+//
+// Sum n values over the processes of comm, in place, with the summation
+// selected for the run
+//
+inline int
+allreduce_sum(double* values, int n, MPI_Comm comm, Summation mode = summation())
+{
+  if (mode == Summation::Native)
+    return MPI_Allreduce(MPI_IN_PLACE, values, n, MPI_DOUBLE, MPI_SUM, comm);
+
+  int np;
+  MPI_Comm_size(comm, &np);
+  std::vector<double> parts(static_cast<std::size_t>(n)*np);
+  const int status = MPI_Allgather(values, n, MPI_DOUBLE, parts.data(), n, MPI_DOUBLE, comm);
+  sum_ordered(parts.data(), np, n, values, mode);
+  return status;
+}
+
+} // namespace OpenSees
+
+#endif
@@ -0,0 +1,120 @@
+# Messages written through the logging command
+#
+#   OpenSees logging.tcl
+#
+# Messages logged from the script are filtered by level and module, rate
+# limited to a burst in each interval, and counted rather than written
+# when they repeat. Until a file is set they are written through opserr,
+# at once, and so follow logFile; once a file is set they are buffered
+# until they are flushed.
+
+puts "logging.tcl: filtering, rate limiting and output of logged messages"
+
+set testOK 0
+
+proc readLog {path} {
+  set file [open $path r]
+  set lines [split [string trimright [read $file] "\n"] "\n"]
+  close $file
+  return $lines
+}
+
+proc check {name lines expected} {
+  global testOK
+  if {[llength $lines] != [llength $expected]} {
+    puts "failed-> $name: logged {$lines}, expected [llength $expected] lines"
+    set testOK -1
+    return
+  }
+  foreach line $lines pattern $expected {
+    if {![string match $pattern $line]} {
+      puts "failed-> $name: logged \"$line\", expected \"$pattern\""
+      set testOK -1
+    }
+  }
+}
+
+# Messages written through opserr follow logFile, in order with the
+# rest of its output
+logFile logging.opserr -noEcho
+logging message warning sink "through opserr"
+logFile logging.closed -noEcho
+check "opserr" [readLog logging.opserr] {{*\[sink\] through opserr}}
+
+logging file logging.log
+
+# Filtering by level and by module
+logging message info   filter "hidden by the default level"
+logging message error  filter "shown above the default level"
+logging level info filter
+logging message info   filter "shown at the level of the module"
+logging message debug  filter "hidden below the level of the module"
+logging filter error,filter=debug
+logging message debug  filter "shown by the filter"
+logging message warning other "hidden by the default of the filter"
+logging filter warning
+logging flush
+check "filter" [readLog logging.log] {
+  {*\[filter\] shown above the default level}
+  {*\[filter\] shown at the level of the module}
+  {*\[filter\] shown by the filter}
+}
+
+# Rate limiting and repeats
+file delete logging.log
+logging file logging.log
+logging rate 3 60
+for {set i 1} {$i <= 10} {incr i} {
+  logging message warning rate "message $i"
+}
+for {set i 1} {$i <= 2} {incr i} {
+  logging message error repeat "the same message"
+}
+logging flush
+check "rate" [readLog logging.log] {
+  {*\[rate\] message 1}
+  {*\[rate\] message 2}
+  {*\[rate\] message 3}
+  {*\[repeat\] the same message}
+  {*\[rate\] 7 similar messages from script:0 were suppressed}
+  {*\[repeat\] 1 similar messages from script:0 were suppressed}
+}
+logging rate 10 10
+
+# One JSON object per line
+file delete logging.log
+logging file logging.log
+logging format json
+logging message warning json "a \"quoted\" message"
+logging flush
+logging format text
+check "json" [readLog logging.log] [list \
+  {{"time": *, "level": "warning", "module": "json", *"message": "a \\"quoted\\" message", "suppressed": 0}}]
+
+# Invalid commands
+foreach command {
+  {logging}
+  {logging level loud}
+  {logging filter warning,material=loud}
+  {logging rate 3}
+  {logging format xml}
+  {logging file no/such/directory/logging.log}
+  {logging async maybe}
+  {logging message loud filter "text"}
+  {logging message warning filter}
+  {logging unknown 1}
+} {
+  if {![catch $command]} {
+    puts "failed-> \"$command\" succeeded"
+    set testOK -1
+  }
+}
+
+logging file opserr
+file delete logging.log logging.opserr
+
+if {$testOK == 0} {
+  puts "PASSED Verification Test logging.tcl \n\n"
+} else {
+  puts "FAILED Verification Test logging.tcl \n\n"
+}
@@ -0,0 +1,169 @@
+# Scopes timed by the profile command
+#
+#   OpenSees profile.tcl
+#
+# While profiling, every OpenSees command is timed as a scope named after
+# it, including the commands created by model after profiling started,
+# and the phases of each analysis step are reported beneath the command
+# that ran them. Nothing is counted once profiling stops, and reset
+# clears the counts. Summaries are JSON, with names escaped.
+
+puts "profile.tcl: timing of commands and analysis phases"
+
+set testOK 0
+
+# Renamed before any command is wrapped
+rename setPrecision "set\"Precision\\"
+
+# The combined scopes of a summary, as a dictionary from each path to
+# {count total self min max}
+proc scopes {summary} {
+  set combined [string range $summary [string last "\"scopes\": \[" $summary] end]
+  set pattern [join [list \
+    {\{"path": "((?:[^"\\]|\\.)*)", } \
+    {"count": (\d+), "total_ns": (-?\d+), "self_ns": (-?\d+), } \
+    {"min_ns": (-?\d+), "max_ns": (-?\d+)\}}] ""]
+  set scopes [dict create]
+  foreach {match path count total self min max} [regexp -all -inline $pattern $combined] {
+    dict set scopes $path [list $count $total $self $min $max]
+  }
+  return $scopes
+}
+
+proc count {scopes path} {
+  if {![dict exists $scopes $path]} {
+    return 0
+  }
+  return [lindex [dict get $scopes $path] 0]
+}
+
+proc check {name result expected} {
+  global testOK
+  if {$result != $expected} {
+    puts "failed-> $name: $result, expected $expected"
+    set testOK -1
+  }
+}
+
+proc truss {} {
+  model basic -ndm 2 -ndf 2
+  node 1   0.0  0.0
+  node 2 144.0  0.0
+  node 3 168.0  0.0
+  node 4  72.0 96.0
+  fix 1 1 1
+  fix 2 1 1
+  fix 3 1 1
+  uniaxialMaterial Elastic 1 3000.0
+  element truss 1 1 4 10.0 1
+  element truss 2 2 4  5.0 1
+  element truss 3 3 4  5.0 1
+  timeSeries Linear 1
+  pattern Plain 1 1 {
+    load 4 100.0 -50.0
+  }
+  system BandSPD
+  numberer RCM
+  constraints Plain
+  integrator LoadControl 0.25
+  algorithm Linear
+  analysis Static
+}
+
+# Commands created by model after profiling started are timed
+wipe
+profile reset
+profile start
+truss
+analyze 4
+profile stop
+
+set summary [profile dump]
+set scopes  [scopes $summary]
+
+if {![string match "\{\n  \"rank\": 0,\n  \"clock\": \"steady_clock\",*" $summary]} {
+  puts "failed-> summary begins with \"[string range $summary 0 40]\""
+  set testOK -1
+}
+check "node"         [count $scopes node]         4
+check "element"      [count $scopes element]      3
+check "analyze"      [count $scopes analyze]      1
+check "analyze/step" [count $scopes analyze/step] 4
+foreach phase {newStep solve commit} {
+  check "analyze/step/$phase" [count $scopes analyze/step/$phase] 4
+}
+check "profile" [count $scopes profile] 0
+
+dict for {path stat} $scopes {
+  lassign $stat count total self min max
+  if {$count < 1 || $self < 0 || $self > $total || $min > $max
+      || $min*$count > $total || $total > $max*$count} {
+    puts "failed-> inconsistent times for $path: $stat"
+    set testOK -1
+  }
+}
+
+# Time in the phases of a step is not time of the step itself
+if {[dict exists $scopes analyze/step]} {
+  lassign [dict get $scopes analyze/step] count total self
+  set phases 0
+  dict for {path stat} $scopes {
+    if {[string match analyze/step/* $path] && [llength [split $path /]] == 3} {
+      incr phases [lindex $stat 1]
+    }
+  }
+  check "self time of analyze/step" $self [expr {$total - $phases}]
+}
+
+# Nothing is counted once profiling stops
+analyze 2
+check "analyze/step after stop" [count [scopes [profile dump]] analyze/step] 4
+
+# Profiling again adds to the counts, and reset clears them
+profile start
+analyze 2
+profile stop
+check "analyze/step after restart" [count [scopes [profile dump]] analyze/step] 6
+profile reset
+check "scopes after reset" [dict size [scopes [profile dump]]] 0
+
+# Names are escaped in the summary; a command is named as it was when
+# profiling first started
+profile start
+set name "set\"Precision\\"
+$name 6
+profile stop
+if {[string first {"path": "set\"Precision\\"} [profile dump]] < 0} {
+  puts "failed-> the name of a renamed command is not escaped"
+  set testOK -1
+}
+rename $name setPrecision
+
+# A summary written to a file is the one returned
+profile dump profile.json
+set file [open profile.json r]
+set written [read $file]
+close $file
+file delete profile.json
+check "written summary" [string equal $written [profile dump]] 1
+
+foreach command {
+  {profile}
+  {profile pause}
+  {profile start -output profile.json}
+  {profile dump no-such-directory/profile.json}
+} {
+  if {![catch $command]} {
+    puts "failed-> \"$command\" succeeded"
+    set testOK -1
+  }
+}
+profile stop
+profile reset
+wipe
+
+if {$testOK == 0} {
+  puts "PASSED Verification Test profile.tcl \n\n"
+} else {
+  puts "FAILED Verification Test profile.tcl \n\n"
+}
@@ -0,0 +1,64 @@
+# Co-simulation with an explicit material point model
+#
+#   OpenSees mpmCoupled.tcl
+#
+# An elastic block of 2 x 2 cells (mpm.json, mesh.txt, particles.txt)
+# falls under gravity onto the centre node of its background mesh, which
+# follows a structural node held by springs. The block must push the
+# structural node, and the analysis must carry on, with the forces of the
+# last exchange, once it runs past the 0.1 s of the MPM input.
+
+set testOK 0
+
+set dir [file normalize [file dirname [info script]]]
+
+wipe
+model basic -ndm 2 -ndf 2
+
+node 1 1.0 1.0 -mass 100.0 100.0
+node 2 1.0 1.0
+fix 2 1 1
+
+uniaxialMaterial Elastic 1 1.0e6
+element zeroLength 1 2 1 -mat 1 1 -dir 1 2
+
+pattern CoSimulation 1 -mpm mpm.json -dir $dir/ -nodes {1 4}
+
+constraints Plain
+numberer Plain
+system BandGeneral
+test NormDispIncr 1.0e-10 10
+algorithm Newton
+integrator Newmark 0.5 0.25
+analysis Transient
+
+# Within the MPM run
+if {[analyze 50 0.001] != 0} {
+  puts "failed-> the coupled analysis failed within the MPM run"
+  set testOK -1
+}
+set u [nodeDisp 1 2]
+if {!($u == $u) || $u == 0.0} {
+  puts "failed-> the coupled node moved by $u under the weight of the block"
+  set testOK -1
+}
+
+# Past the end of the MPM run
+if {[analyze 100 0.001] != 0} {
+  puts "failed-> the coupled analysis failed past the end of the MPM run"
+  set testOK -1
+}
+set u [nodeDisp 1 2]
+if {!($u == $u) || abs($u) > 1.0} {
+  puts "failed-> the coupled node moved by $u past the end of the MPM run"
+  set testOK -1
+}
+
+wipe
+file delete -force $dir/results
+
+if {$testOK == 0} {
+  puts "PASSED Verification Test mpmCoupled.tcl \n\n"
+} else {
+  puts "FAILED Verification Test mpmCoupled.tcl \n\n"
+}
@@ -0,0 +1,151 @@
+# Checkpoints of a partitioned model
+#
+#   mpiexec -n 2 OpenSeesMP checkpointMP.tcl
+#
+# Process 0 loads a cantilever column of 8 elastic beams to a load factor
+# of 0.5 and partitions it among the processes, which then load their
+# parts and save a checkpoint. The checkpoint must restore, on every
+# process, the time and the displacements of the nodes of its part. A
+# checkpoint of one part more than there are processes, as left by a
+# larger job, must be merged and partitioned again when it is restored.
+# A checkpoint without a manifest, or one that is missing, must fail to
+# restore and leave the model unchanged.
+
+set pid [getPID]
+set np  [getNP]
+
+set testOK 0
+set tol    1.0e-12
+
+proc buildModel {} {
+  wipe
+  model basic -ndm 2 -ndf 3
+  geomTransf Linear 1
+  for {set i 0} {$i <= 8} {incr i} {
+    node [expr {$i + 1}] 0.0 [expr {12.0*$i}]
+  }
+  fix 1 1 1 1
+  for {set i 1} {$i <= 8} {incr i} {
+    element elasticBeamColumn $i $i [expr {$i + 1}] 10.0 29000.0 100.0 1
+  }
+  timeSeries Linear 1
+  pattern Plain 1 1 {
+    load 9 10.0 0.0 0.0
+  }
+}
+
+# Load the model to a factor of 0.5, and return the lateral displacement
+# of each node
+proc loadModel {} {
+  buildModel
+  constraints Plain
+  numberer Plain
+  system BandGeneral
+  algorithm Linear
+  integrator LoadControl 0.25
+  analysis Static
+  analyze 2
+  set disp {}
+  for {set node 1} {$node <= 9} {incr node} {
+    lappend disp $node [nodeDisp $node 1]
+  }
+  wipeAnalysis
+  return $disp
+}
+
+# Check that this process holds a part of the model at the time and with
+# the displacements of the whole model
+proc checkPart {name reference} {
+  global testOK tol pid
+  set nodes [getNodeTags]
+  if {[llength $nodes] == 0} {
+    puts "failed-> $name: process $pid holds no nodes"
+    set testOK -1
+  }
+  if {[getTime] != 0.5} {
+    puts "failed-> $name: process $pid is at time [getTime], not 0.5"
+    set testOK -1
+  }
+  foreach node $nodes {
+    set exact [dict get $reference $node]
+    if {abs([nodeDisp $node 1] - $exact) > $tol*abs($exact) + $tol} {
+      puts "failed-> $name: node $node of process $pid is displaced [nodeDisp $node 1], not $exact"
+      set testOK -1
+    }
+  }
+}
+
+if {$pid == 0} {
+  set reference [broadcast [loadModel]]
+  partition -save $np column
+} else {
+  set reference [broadcast]
+}
+barrier
+
+# Checkpoint of the parts, restored into empty models
+wipe
+model basic -ndm 2 -ndf 3
+partition -load column
+checkpoint save saved
+
+wipe
+model basic -ndm 2 -ndf 3
+checkpoint restore saved
+checkPart "restore" $reference
+
+# Failed restores leave the model unchanged
+set nodes [getNodeTags]
+if {![catch {checkpoint restore missing}]} {
+  puts "failed-> process $pid restored a missing checkpoint"
+  set testOK -1
+}
+barrier
+if {$pid == 0} {
+  file rename saved.manifest saved.manifest.kept
+}
+barrier
+if {![catch {checkpoint restore saved}]} {
+  puts "failed-> process $pid restored a checkpoint without a manifest"
+  set testOK -1
+}
+if {[getNodeTags] != $nodes} {
+  puts "failed-> process $pid holds nodes [getNodeTags] after a failed restore, not $nodes"
+  set testOK -1
+}
+checkPart "failed restore" $reference
+
+# Checkpoint of one more part than there are processes
+barrier
+if {$pid == 0} {
+  loadModel
+  partition -save [expr {$np + 1}] larger
+  set manifest [open larger.manifest w]
+  puts $manifest "[expr {$np + 1}] 0.5"
+  close $manifest
+}
+barrier
+
+wipe
+model basic -ndm 2 -ndf 3
+if {[catch {checkpoint restore larger} message]} {
+  puts "failed-> process $pid failed to restore a checkpoint of [expr {$np + 1}] parts: $message"
+  set testOK -1
+} else {
+  checkPart "restore of [expr {$np + 1}] parts" $reference
+}
+
+set testOK [lindex [allreduce -op min [list $testOK]] 0]
+
+barrier
+if {$pid == 0} {
+  foreach file [glob -nocomplain column.* saved.* larger.*] {
+    file delete $file
+  }
+  if {$testOK == 0} {
+    puts "PASSED Verification Test checkpointMP.tcl \n\n"
+  } else {
+    puts "FAILED Verification Test checkpointMP.tcl \n\n"
+  }
+}
+wipe
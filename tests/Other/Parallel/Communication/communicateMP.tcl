@@ -0,0 +1,185 @@
+# Collectives and non-blocking messages of lists of doubles
+#
+#   mpiexec -n 3 OpenSeesMP communicateMP.tcl
+#
+# Every process must receive, value for value, the lists given to
+# broadcast, gather, scatter and allreduce, including lists whose length
+# differs by process. A collective that fails on one process must fail on
+# every process. Messages sent with isend are received with irecv without
+# their length being known: at once when they have arrived, or when the
+# request is waited on or tested. Two receives of the same source and tag
+# take the messages in the order they were sent, whichever is completed
+# first.
+
+set pid [getPID]
+set np  [getNP]
+
+set testOK 0
+
+proc check {name result expected} {
+  global testOK pid
+  if {[llength $result] != [llength $expected]} {
+    puts "failed-> $name: process $pid received {$result}, expected {$expected}"
+    set testOK -1
+    return
+  }
+  foreach value $result exact $expected {
+    if {[llength $exact] != 1} {
+      check $name $value $exact
+    } elseif {$value != $exact} {
+      puts "failed-> $name: process $pid received {$result}, expected {$expected}"
+      set testOK -1
+      return
+    }
+  }
+}
+
+# The values given by process p
+proc values {p} {
+  set values {}
+  for {set i 0} {$i <= $p} {incr i} {
+    lappend values [expr {$p + 1.0/($i + 3)}]
+  }
+  return $values
+}
+
+set last [expr {$np - 1}]
+set all {}
+for {set p 0} {$p < $np} {incr p} {
+  lappend all [values $p]
+}
+
+#
+# Collectives
+#
+if {$pid == 0} {
+  check "broadcast" [broadcast {1.5 -2.25 1.0e300}] {1.5 -2.25 1.0e300}
+} else {
+  check "broadcast" [broadcast] {1.5 -2.25 1.0e300}
+}
+if {$pid == $last} {
+  check "broadcast -root" [broadcast -root $last [values $last]] [values $last]
+} else {
+  check "broadcast -root" [broadcast -root $last] [values $last]
+}
+
+set gathered [gather -root $last [values $pid]]
+if {$pid == $last} {
+  check "gather" $gathered $all
+} else {
+  check "gather" $gathered {}
+}
+check "gather -all" [gather -all [values $pid]] $all
+
+if {$pid == 0} {
+  check "scatter" [scatter $all] [values $pid]
+} else {
+  check "scatter" [scatter] [values $pid]
+}
+
+set sum 0.0
+set product 1.0
+for {set p 0} {$p < $np} {incr p} {
+  set sum [expr {$sum + $p + 0.5}]
+  set product [expr {$product*($p + 0.5)}]
+}
+set mine [expr {$pid + 0.5}]
+check "allreduce" [allreduce [list $mine 1.0]] [list $sum $np.0]
+check "allreduce -op prod" [allreduce -op prod [list $mine]] [list $product]
+check "allreduce -op min"  [allreduce -op min  [list $mine [expr {-$mine}]]] [list 0.5 [expr {-$last - 0.5}]]
+check "allreduce -op max"  [allreduce -op max  [list $mine [expr {-$mine}]]] [list [expr {$last + 0.5}] -0.5]
+
+# A collective that fails on any process fails on all of them
+foreach {name command} [list \
+    "a root without values"  {broadcast -root 0 {*}[expr {$pid == 0 ? {} : {{1.0}}}]} \
+    "different roots"        {broadcast -root $pid {1.0}} \
+    "a short scatter"        {scatter [expr {$pid == 0 ? {{1.0}} : {}}]} \
+    "different lengths"      {allreduce [lrepeat [expr {$pid + 1}] 1.0]} \
+    "an unknown operation"   {allreduce -op [expr {$pid == $last ? "mean" : "sum"}] {1.0}} \
+    "a gather to a root and to all" {gather {*}[expr {$pid == 0 ? "-all" : ""}] {1.0}}] {
+  # with one process, only an invalid argument can fail
+  if {$np == 1 && $name ni {"a root without values" "an unknown operation"}} {
+    continue
+  }
+  if {![catch $command]} {
+    puts "failed-> a collective with $name succeeded on process $pid"
+    set testOK -1
+  }
+}
+
+# The processes are still in step after the failures
+set pids {}
+for {set p 0} {$p < $np} {incr p} {
+  lappend pids [list $p]
+}
+check "gather -all after failures" [gather -all [list $pid]] $pids
+
+#
+# Messages, which need another process
+#
+if {$np > 1} {
+  set next     [expr {($pid + 1) % $np}]
+  set previous [expr {($pid + $np - 1) % $np}]
+
+  # A receive posted before its message is sent, completed by waitRequest
+  set receive [irecv -pid $previous -tag 5]
+  barrier
+  set send [isend -pid $next -tag 5 [values $pid]]
+  check "waitRequest of an early receive" [waitRequest $receive] [values $previous]
+  check "waitRequest of a send" [waitRequest $send] {}
+
+  # A receive from any process, completed by testRequest
+  set send [isend -pid $next -tag 6 [values $pid]]
+  set receive [irecv -pid ANY -tag 6]
+  set tests 0
+  while {[set result [testRequest $receive]] == {}} {
+    if {[incr tests] > 1000000} {
+      break
+    }
+  }
+  check "testRequest of a receive from any process" [lindex $result 0] [values $previous]
+  waitRequest $send
+
+  # Two messages of the same source and tag, both there when received,
+  # which the marker sent after them shows
+  set first  [isend -pid $next -tag 7 [values $pid]]
+  set second [isend -pid $next -tag 7 [list $pid.0]]
+  set marker [isend -pid $next -tag 8 {}]
+  waitRequest [irecv -pid $previous -tag 8]
+  foreach send [list $first $second $marker] {
+    waitRequest $send
+  }
+  set a [irecv -pid $previous -tag 7]
+  set b [irecv -pid $previous -tag 7]
+  check "second of two receives" [waitRequest $b] [list $previous.0]
+  check "first of two receives"  [waitRequest $a] [values $previous]
+
+  # A completed request is released
+  if {![catch {waitRequest $a}]} {
+    puts "failed-> process $pid waited again on a completed request"
+    set testOK -1
+  }
+}
+
+foreach command {
+  {isend -pid 0 {1.0}}
+  {isend -tag 1 {1.0}}
+  {irecv -pid ANY -tag -1}
+  {testRequest -1}
+} {
+  if {$pid == 0 && ![catch $command]} {
+    puts "failed-> \"$command\" succeeded"
+    set testOK -1
+  }
+}
+
+set testOK [lindex [allreduce -op min [list $testOK]] 0]
+
+barrier
+if {$pid == 0} {
+  if {$testOK == 0} {
+    puts "PASSED Verification Test communicateMP.tcl \n\n"
+  } else {
+    puts "FAILED Verification Test communicateMP.tcl \n\n"
+  }
+}
@@ -0,0 +1,75 @@
+# Modes of a partitioned model against those of the whole model
+#
+#   mpiexec -n 3 OpenSeesMP eigenMP.tcl
+#
+# Process 0 finds the modes of a cantilever column of 8 elastic beams,
+# 24 equations in all, and partitions it among the processes, which then
+# load their parts and find the modes again with the distributed solver.
+# The 3 lowest modes are found with guard vectors; 10 modes leave no room
+# for them in a model of this size, so the solver works on a block of
+# just the modes asked for, and its Rayleigh-Ritz basis spans all of the
+# equations once it holds more vectors than there are equations.
+
+set pid [getPID]
+set np  [getNP]
+
+set testOK 0
+set tol    1.0e-6
+
+proc buildModel {} {
+  wipe
+  model basic -ndm 2 -ndf 3
+  geomTransf Linear 1
+  for {set i 0} {$i <= 8} {incr i} {
+    node [expr {$i + 1}] 0.0 [expr {12.0*$i}] -mass 0.1 0.1 1.0
+  }
+  fix 1 1 1 1
+  for {set i 1} {$i <= 8} {incr i} {
+    element elasticBeamColumn $i $i [expr {$i + 1}] 10.0 29000.0 100.0 1
+  }
+}
+
+# Modes of the whole model, which process 0 then partitions
+if {$pid == 0} {
+  buildModel
+  set serial [broadcast [eigen -fullGenLapack 10]]
+  partition -save $np column
+} else {
+  set serial [broadcast]
+}
+barrier
+
+# Modes of the partitioned model
+wipe
+model basic -ndm 2 -ndf 3
+partition -load column
+
+foreach numModes {3 10} {
+  set distributed [eigen $numModes]
+  if {[llength $distributed] != $numModes} {
+    puts "failed-> process $pid found [llength $distributed] of $numModes modes"
+    set testOK -1
+    continue
+  }
+  foreach lambda $distributed exact [lrange $serial 0 [expr {$numModes - 1}]] {
+    if {abs($lambda - $exact) > $tol*$exact} {
+      puts "failed-> process $pid: eigenvalue $lambda of $numModes modes, serial $exact"
+      set testOK -1
+    }
+  }
+}
+
+set testOK [lindex [allreduce -op min [list $testOK]] 0]
+
+barrier
+if {$pid == 0} {
+  foreach file [glob -nocomplain column.*] {
+    file delete $file
+  }
+  if {$testOK == 0} {
+    puts "PASSED Verification Test eigenMP.tcl \n\n"
+  } else {
+    puts "FAILED Verification Test eigenMP.tcl \n\n"
+  }
+}
+wipe
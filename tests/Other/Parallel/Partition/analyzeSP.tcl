@@ -0,0 +1,125 @@
+# Analyses of a partitioned model
+#
+#   mpiexec -n 3 OpenSeesSP analyzeSP.tcl
+#
+# Before each analyze the model is partitioned if needed, and each
+# subdomain is sent the analysis it performs, condensing its interior
+# equations onto the interface. A cantilever of elastic beams under a
+# load at its tip must deflect as the exact solution, with the subdomain
+# analyses rebuilt whenever the algorithm, system, integrator or whole
+# analysis of the model changes.
+
+set np [getNP]
+
+set testOK 0
+set tol    1.0e-8
+
+set L  96.0
+set E  29000.0
+set A  10.0
+set I  100.0
+set P  2.5
+set ne 8
+set tip [expr {$ne + 1}]
+
+proc check {name lambda} {
+  global testOK tol L E A I P ne
+  # deflection of a cantilever under a load lambda*P at its tip
+  for {set i 1} {$i <= $ne + 1} {incr i} {
+    set x [expr {$L*($i - 1)/$ne}]
+    set exact [list [expr {$lambda*$P*$x/($E*$A)}] \
+                    [expr {$lambda*$P*$x*$x*(3*$L - $x)/(6*$E*$I)}]]
+    foreach dof {1 2} value $exact {
+      set u [nodeDisp $i $dof]
+      if {abs($u - $value) > $tol*$lambda*$P*$L*$L*$L/($E*$I)} {
+        puts "failed-> $name: node $i dof $dof displaced $u, exact $value"
+        set testOK -1
+        return
+      }
+    }
+  }
+}
+
+wipe
+model basic -ndm 2 -ndf 3
+geomTransf Linear 1
+for {set i 1} {$i <= $tip} {incr i} {
+  node $i [expr {$L*($i - 1)/$ne}] 0.0
+}
+fix 1 1 1 1
+for {set i 1} {$i <= $ne} {incr i} {
+  element elasticBeamColumn $i $i [expr {$i + 1}] $A $E $I 1
+}
+timeSeries Linear 1
+pattern Plain 1 1 {
+  load $tip $P $P 0.0
+}
+
+if {![catch {partition -unknown}]} {
+  puts "failed-> partition accepted an unknown option"
+  set testOK -1
+}
+
+# The subdomains cannot be sent an analysis before it is defined
+if {$np > 1 && ![catch {analyze 1}]} {
+  puts "failed-> the partitioned model was analyzed without an analysis"
+  set testOK -1
+}
+
+constraints Plain
+numberer RCM
+system BandGeneral
+test NormDispIncr 1.0e-10 10
+algorithm Linear
+integrator LoadControl 1.0
+analysis Static
+
+if {[analyze 1] != 0} {
+  puts "failed-> the first analysis failed"
+  set testOK -1
+}
+check "LoadControl" 1.0
+
+# A new algorithm and system, then a new integrator
+algorithm Newton
+if {[analyze 1] != 0} {
+  puts "failed-> the analysis failed after a new algorithm"
+  set testOK -1
+}
+check "Newton" 2.0
+
+system ProfileSPD
+integrator LoadControl 0.5
+if {[analyze 2] != 0} {
+  puts "failed-> the analysis failed after a new system and integrator"
+  set testOK -1
+}
+check "ProfileSPD" 3.0
+
+# A new analysis, controlled by the displacement at the tip
+wipeAnalysis
+constraints Plain
+numberer RCM
+system BandGeneral
+test NormDispIncr 1.0e-10 10
+algorithm Newton
+integrator DisplacementControl $tip 2 [expr {$P*$L*$L*$L/(3*$E*$I)}]
+analysis Static
+
+if {[analyze 1] != 0} {
+  puts "failed-> the analysis failed after wipeAnalysis"
+  set testOK -1
+}
+check "DisplacementControl" 4.0
+if {abs([getTime] - 4.0) > $tol} {
+  puts "failed-> the load factor is [getTime], expected 4.0"
+  set testOK -1
+}
+
+wipe
+
+if {$testOK == 0} {
+  puts "PASSED Verification Test analyzeSP.tcl \n\n"
+} else {
+  puts "FAILED Verification Test analyzeSP.tcl \n\n"
+}
@@ -0,0 +1,164 @@
+# Partitions of a building with rigid diaphragms
+#
+#   mpiexec -n 1 OpenSeesMP diaphragmMP.tcl
+#
+# Each floor of a three storey building, with 3 x 3 columns and beams
+# between them, is a rigid diaphragm whose retained node, at the center
+# of the floor, has no elements. The partition must keep the nodes of
+# each floor on a common part, report no cut constraints, and leave
+# elements on every part. When a single diaphragm ties together the
+# whole model, keeping it on one part would empty the others; the parts
+# must then keep their elements and the constraints be reported as cut.
+
+set pid [getPID]
+
+set testOK 0
+
+# nodes of the elements of the last model, by node
+set connected [dict create]
+
+proc element_at {tag args} {
+  global connected
+  foreach node $args {
+    dict lappend connected $node $tag
+  }
+}
+
+proc buildBuilding {storeys} {
+  global connected
+  set connected [dict create]
+  wipe
+  model basic -ndm 3 -ndf 6
+  geomTransf Linear 1 1.0 0.0 0.0
+  geomTransf Linear 2 0.0 0.0 1.0
+
+  set floors {}
+  set tag 0
+  for {set f 0} {$f <= $storeys} {incr f} {
+    set nodes {}
+    for {set i 0} {$i < 3} {incr i} {
+      for {set j 0} {$j < 3} {incr j} {
+        set node [expr {100*$f + 3*$i + $j + 1}]
+        node $node [expr {240.0*$i}] [expr {240.0*$j}] [expr {144.0*$f}]
+        lappend nodes $node
+        if {$f == 0} {
+          fix $node 1 1 1 1 1 1
+          continue
+        }
+        element elasticBeamColumn [incr tag] [expr {$node - 100}] $node 100.0 29000.0 11200.0 500.0 400.0 400.0 1
+        element_at $tag [expr {$node - 100}] $node
+        if {$i > 0} {
+          element elasticBeamColumn [incr tag] [expr {$node - 3}] $node 20.0 29000.0 11200.0 100.0 800.0 100.0 2
+          element_at $tag [expr {$node - 3}] $node
+        }
+        if {$j > 0} {
+          element elasticBeamColumn [incr tag] [expr {$node - 1}] $node 20.0 29000.0 11200.0 100.0 800.0 100.0 2
+          element_at $tag [expr {$node - 1}] $node
+        }
+      }
+    }
+    if {$f > 0} {
+      set center [expr {1000 + $f}]
+      node $center 240.0 240.0 [expr {144.0*$f}]
+      fix $center 0 0 1 1 1 0
+      rigidDiaphragm 3 $center {*}$nodes
+      lappend floors $nodes
+    }
+  }
+  return $floors
+}
+
+# the parts of the elements, by element tag, from a file of "tag part"
+proc read_parts {file} {
+  set parts [dict create]
+  set fp [open $file r]
+  foreach {tag part} [read $fp] {
+    dict set parts $tag $part
+  }
+  close $fp
+  return $parts
+}
+
+proc check_parts {name report np} {
+  global testOK
+  set elements [dict get $report elements]
+  if {[llength $elements] != $np} {
+    puts "failed-> $name: [llength $elements] parts reported of $np"
+    set testOK -1
+  }
+  foreach count $elements {
+    if {$count == 0} {
+      puts "failed-> $name: a part has no elements, $elements"
+      set testOK -1
+    }
+  }
+}
+
+if {$pid == 0} {
+
+  # Diaphragms at each floor
+  foreach np {2 3} {
+    set floors [buildBuilding 3]
+    set report [partition -save $np building -export building.parts]
+    check_parts "building in $np parts" $report $np
+    if {[dict get $report cutConstraints] != 0} {
+      puts "failed-> building in $np parts: [dict get $report cutConstraints] constraints cut"
+      set testOK -1
+    }
+
+    # the parts holding elements at every node of each floor
+    set parts [read_parts building.parts]
+    foreach nodes $floors {
+      set common {}
+      foreach node $nodes {
+        set at {}
+        foreach element [dict get $connected $node] {
+          lappend at [dict get $parts $element]
+        }
+        if {$node == [lindex $nodes 0]} {
+          set common [lsort -unique $at]
+        } else {
+          set common [lmap p $common {expr {$p in $at ? $p : [continue]}}]
+        }
+      }
+      if {[llength $common] == 0} {
+        puts "failed-> building in $np parts: floor of nodes $nodes is on no common part"
+        set testOK -1
+      }
+    }
+  }
+
+  # A single diaphragm that ties together every element
+  wipe
+  model basic -ndm 3 -ndf 6
+  geomTransf Linear 1 1.0 0.0 0.0
+  set tops {}
+  for {set k 0} {$k < 4} {incr k} {
+    node [expr {$k + 1}]  [expr {240.0*($k % 2)}] [expr {240.0*($k / 2)}] 0.0
+    node [expr {$k + 11}] [expr {240.0*($k % 2)}] [expr {240.0*($k / 2)}] 144.0
+    fix [expr {$k + 1}] 1 1 1 1 1 1
+    element elasticBeamColumn [expr {$k + 1}] [expr {$k + 1}] [expr {$k + 11}] 100.0 29000.0 11200.0 500.0 400.0 400.0 1
+    lappend tops [expr {$k + 11}]
+  }
+  node 99 120.0 120.0 144.0
+  fix 99 0 0 1 1 1 0
+  rigidDiaphragm 3 99 {*}$tops
+
+  set report [partition -save 2 table]
+  check_parts "single diaphragm" $report 2
+  if {[dict get $report cutConstraints] == 0} {
+    puts "failed-> single diaphragm: no constraint reported cut across 2 parts"
+    set testOK -1
+  }
+
+  foreach file [glob -nocomplain building.* table.*] {
+    file delete $file
+  }
+  if {$testOK == 0} {
+    puts "PASSED Verification Test diaphragmMP.tcl \n\n"
+  } else {
+    puts "FAILED Verification Test diaphragmMP.tcl \n\n"
+  }
+}
+barrier
+wipe
@@ -0,0 +1,84 @@
+# Loads of a partitioned model that fail on one process
+#
+#   mpiexec -n 2 OpenSeesMP loadMP.tcl
+#
+# Process 0 partitions a cantilever column of 8 elastic beams among the
+# processes and removes the interface of the last part. The load of the
+# parts must then fail on every process, rather than leave the others
+# waiting for the last one to set up the exchange of the eigen solver.
+# Once the interface is put back, the parts load and their modes are
+# those of the whole model.
+
+set pid [getPID]
+set np  [getNP]
+
+set testOK 0
+set tol    1.0e-6
+set last   [expr {$np - 1}]
+
+proc buildModel {} {
+  wipe
+  model basic -ndm 2 -ndf 3
+  geomTransf Linear 1
+  for {set i 0} {$i <= 8} {incr i} {
+    node [expr {$i + 1}] 0.0 [expr {12.0*$i}] -mass 0.1 0.1 1.0
+  }
+  fix 1 1 1 1
+  for {set i 1} {$i <= 8} {incr i} {
+    element elasticBeamColumn $i $i [expr {$i + 1}] 10.0 29000.0 100.0 1
+  }
+}
+
+if {$pid == 0} {
+  buildModel
+  set serial [broadcast [eigen -fullGenLapack 3]]
+  partition -save $np column
+  file rename column.$last.interface column.$last.kept
+} else {
+  set serial [broadcast]
+}
+barrier
+
+# Part of the model is missing
+wipe
+model basic -ndm 2 -ndf 3
+if {![catch {partition -load column}]} {
+  puts "failed-> process $pid loaded its part although part $last is incomplete"
+  set testOK -1
+}
+barrier
+
+if {$pid == 0} {
+  file rename column.$last.kept column.$last.interface
+}
+barrier
+
+# All of the model is there
+wipe
+model basic -ndm 2 -ndf 3
+if {[catch {partition -load column} message]} {
+  puts "failed-> process $pid failed to load its part: $message"
+  set testOK -1
+} else {
+  foreach lambda [eigen 3] exact $serial {
+    if {abs($lambda - $exact) > $tol*$exact} {
+      puts "failed-> process $pid: eigenvalue $lambda, serial $exact"
+      set testOK -1
+    }
+  }
+}
+
+set testOK [lindex [allreduce -op min [list $testOK]] 0]
+
+barrier
+if {$pid == 0} {
+  foreach file [glob -nocomplain column.*] {
+    file delete $file
+  }
+  if {$testOK == 0} {
+    puts "PASSED Verification Test loadMP.tcl \n\n"
+  } else {
+    puts "FAILED Verification Test loadMP.tcl \n\n"
+  }
+}
+wipe
@@ -0,0 +1,83 @@
+# Failed saves of a partitioned model
+#
+#   mpiexec -n 1 OpenSeesMP saveMP.tcl
+#
+# A partition that cannot be written, to a prefix or an export file in a
+# directory that does not exist, must fail and leave the model of the
+# process as it was. A partition that can be written moves the model
+# into the parts and leaves the domain empty.
+
+set pid [getPID]
+
+set testOK 0
+
+proc buildModel {} {
+  wipe
+  model basic -ndm 2 -ndf 3
+  geomTransf Linear 1
+  for {set i 0} {$i <= 8} {incr i} {
+    node [expr {$i + 1}] 0.0 [expr {12.0*$i}]
+  }
+  fix 1 1 1 1
+  for {set i 1} {$i <= 8} {incr i} {
+    element elasticBeamColumn $i $i [expr {$i + 1}] 10.0 29000.0 100.0 1
+  }
+  timeSeries Linear 1
+  pattern Plain 1 1 {
+    load 9 10.0 0.0 0.0
+  }
+}
+
+if {$pid == 0} {
+  buildModel
+  set nodes    [getNodeTags]
+  set elements [getEleTags]
+
+  foreach {name options} {
+    "unwritable prefix" {2 no/such/directory/column}
+    "unwritable export" {2 column -export no/such/directory/column.parts}
+  } {
+    if {![catch {partition -save {*}$options}]} {
+      puts "failed-> $name: partition -save $options succeeded"
+      set testOK -1
+    }
+    if {[getNodeTags] != $nodes || [getEleTags] != $elements} {
+      puts "failed-> $name: the model holds nodes {[getNodeTags]} and elements {[getEleTags]}"
+      set testOK -1
+    }
+  }
+
+  # the model is intact, so it can still be analyzed
+  constraints Plain
+  numberer Plain
+  system BandGeneral
+  algorithm Linear
+  integrator LoadControl 1.0
+  analysis Static
+  if {[analyze 1] != 0 || [nodeDisp 9 1] <= 0.0} {
+    puts "failed-> the model does not analyze after the failed saves"
+    set testOK -1
+  }
+  wipeAnalysis
+
+  set report [partition -save 2 column]
+  if {[llength [getNodeTags]] != 0 || [llength [getEleTags]] != 0} {
+    puts "failed-> the model remains in the domain after it is saved"
+    set testOK -1
+  }
+  if {[tcl::mathop::+ {*}[dict get $report elements]] != [llength $elements]} {
+    puts "failed-> the parts hold [dict get $report elements] elements of [llength $elements]"
+    set testOK -1
+  }
+
+  foreach file [glob -nocomplain column.*] {
+    file delete $file
+  }
+  if {$testOK == 0} {
+    puts "PASSED Verification Test saveMP.tcl \n\n"
+  } else {
+    puts "FAILED Verification Test saveMP.tcl \n\n"
+  }
+}
+barrier
+wipe
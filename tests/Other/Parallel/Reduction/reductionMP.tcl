@@ -0,0 +1,75 @@
+# Reproducible sums over processes
+#
+#   mpiexec -n 3 OpenSeesMP reductionMP.tcl
+#
+# Under "reduction ordered", allreduce adds the values of the processes in
+# the order of the processes, so every process must hold, bit for bit, the
+# sum formed here one process after another, whatever the order in which
+# the messages arrive, and repeating the sum must give the same result.
+# The values are chosen so that their sums depend on that order. An
+# unknown summation must fail on every process and leave the selection
+# unchanged.
+
+set pid [getPID]
+set np  [getNP]
+
+set testOK 0
+
+proc contribution {p} {
+  return [list [expr {1.0/($p + 3)}] [expr {$p % 2 ? 1.0e16 : -1.0e16}] [expr {0.1*($p + 1)}]]
+}
+
+if {[reduction ordered] != "ordered"} {
+  puts "failed-> process $pid did not select ordered sums"
+  set testOK -1
+}
+
+# Sums in the order of the processes
+set exact {0.0 0.0 0.0}
+for {set p 0} {$p < $np} {incr p} {
+  set sum {}
+  foreach s $exact v [contribution $p] {
+    lappend sum [expr {$s + $v}]
+  }
+  set exact $sum
+}
+
+set first [allreduce -op sum [contribution $pid]]
+for {set i 0} {$i < 5} {incr i} {
+  set sum [allreduce -op sum [contribution $pid]]
+  foreach value $sum expected $exact repeated $first {
+    if {$value != $expected || $value != $repeated} {
+      puts "failed-> process $pid: sum $value, in process order $expected, first $repeated"
+      set testOK -1
+    }
+  }
+}
+
+# The same value on every process
+foreach value [broadcast -root 0 [expr {$pid == 0 ? $first : {}}]] mine $first {
+  if {$value != $mine} {
+    puts "failed-> process $pid holds $mine, process 0 $value"
+    set testOK -1
+  }
+}
+
+# An unknown summation fails everywhere, even if named on one process only
+if {![catch {reduction [expr {$pid == $np - 1 ? "unknown" : "compensated"}]}]} {
+  puts "failed-> process $pid accepted a summation unknown to process [expr {$np - 1}]"
+  set testOK -1
+}
+if {[reduction] != "ordered"} {
+  puts "failed-> process $pid changed its summation to [reduction] after a failure"
+  set testOK -1
+}
+
+reduction native
+set testOK [lindex [allreduce -op min [list $testOK]] 0]
+
+if {$pid == 0} {
+  if {$testOK == 0} {
+    puts "PASSED Verification Test reductionMP.tcl \n\n"
+  } else {
+    puts "FAILED Verification Test reductionMP.tcl \n\n"
+  }
+}
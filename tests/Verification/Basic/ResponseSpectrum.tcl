@@ -0,0 +1,96 @@
+# spectrum - response spectra of a step in ground acceleration
+#
+# Under a ground acceleration that is a constant a0 from t = 0, an
+# oscillator of frequency w and damping ratio zeta starting from rest
+# reaches the peak displacement
+#
+#     Sd = a0/w^2 (1 + exp(-zeta pi/sqrt(1 - zeta^2)))
+#
+# so that PSa = 2 a0 when undamped, and the undamped peak velocity is
+# a0/w. An undamped elastic-perfectly plastic oscillator of yield strength
+# fy (per unit mass) reaches the ductility
+#
+#     mu = 1/(2 (1 - a0/fy))
+#
+# by equating the work of the inertial force to the energy it stores, so
+# that a ductility mu needs fy = 2 mu a0/(2 mu - 1).
+
+puts "ResponseSpectrum.tcl: response spectra of a step in ground acceleration"
+
+set testOK 0
+
+set a0   1.0
+set dt   0.001
+set periods   {0.0 0.5 1.0 2.0}
+set damping   {0.0 0.05}
+set ductility {1.0 2.0 4.0}
+
+set ag [lrepeat 4001 $a0]
+set spectra [spectrum -periods $periods -damp $damping -ductility $ductility -values $dt $ag]
+
+proc check {name value expected tol} {
+  global testOK
+  if {abs($value - $expected) > $tol*abs($expected)} {
+    puts "failed-> $name = $value, expected $expected"
+    set testOK -1
+  }
+}
+
+# Elastic spectra
+foreach zeta $damping Sd [lindex [dict get $spectra Sd] 0] \
+                      Sv [lindex [dict get $spectra Sv] 0] \
+                     PSa [lindex [dict get $spectra PSa] 0] {
+  foreach T $periods sd $Sd sv $Sv psa $PSa {
+    if {$T == 0.0} {
+      check "PSa(T = 0)" $psa $a0 1.0e-12
+      continue
+    }
+    set w [expr {2.0*acos(-1.0)/$T}]
+    set exact [expr {$a0/($w*$w)*(1.0 + exp(-$zeta*acos(-1.0)/sqrt(1.0 - $zeta*$zeta)))}]
+    check "Sd(T = $T, zeta = $zeta)" $sd $exact 1.0e-5
+    if {$zeta == 0.0} {
+      check "PSa(T = $T)" $psa [expr {2.0*$a0}] 1.0e-5
+      check "Sv(T = $T)"  $sv  [expr {$a0/$w}]  1.0e-5
+    }
+  }
+}
+
+# Constant-ductility spectra of the undamped oscillator
+foreach mu $ductility Ay [lindex [dict get $spectra Ay] 0 0] {
+  foreach T $periods ay $Ay {
+    if {$T == 0.0} {
+      check "Ay(T = 0, mu = $mu)" $ay $a0 1.0e-12
+    } elseif {$mu == 1.0} {
+      check "Ay(T = $T, mu = 1)" $ay [expr {2.0*$a0}] 1.0e-5
+    } else {
+      check "Ay(T = $T, mu = $mu)" $ay [expr {2.0*$mu*$a0/(2.0*$mu - 1.0)}] 1.0e-3
+    }
+  }
+}
+
+# A record file must hold only accelerations
+set file [open spectrum.tmp w]
+puts $file "$a0 $a0 $a0"
+close $file
+if {[catch {spectrum -periods {1.0} -file $dt spectrum.tmp} result]} {
+  puts "failed-> a file of accelerations was not read: $result"
+  set testOK -1
+}
+set file [open spectrum.tmp w]
+puts $file "$a0 $a0 x $a0"
+close $file
+if {![catch {spectrum -periods {1.0} -file $dt spectrum.tmp}]} {
+  puts "failed-> a file with an invalid value was read"
+  set testOK -1
+}
+file delete spectrum.tmp
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test ResponseSpectrum.tcl \n\n"
+    puts $results "| PASSED |  ResponseSpectrum.tcl"
+} else {
+    puts "FAILED Verification Test ResponseSpectrum.tcl \n\n"
+    puts $results "FAILED : ResponseSpectrum.tcl"
+}
+close $results
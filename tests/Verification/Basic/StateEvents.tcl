@@ -0,0 +1,113 @@
+# StateEvents - located events of an undamped oscillator
+#
+# An undamped oscillator of period T = 1 released from rest position with
+# a velocity v0 moves as
+#
+#     u = A sin(2 pi t),   A = v0/(2 pi)
+#
+# so that it rises through A/2 at t = 1/12, closes a gap of 0.8 A at
+# t = asin(0.8)/(2 pi) and reaches its peak, where the velocity falls
+# to zero, at t = 1/4. Variable transient analysis with steps of up to
+# 0.001 must locate each event to within the event tolerance. The peak
+# is a -stop event: it ends the analysis, which returns 0, and is
+# reported by stateEvent stopped. Once it is removed, the analysis
+# carries on and locates the events of the next cycle.
+
+puts "StateEvents.tcl: located events of an undamped oscillator"
+
+set testOK 0
+
+set PI  [expr {2.0*asin(1.0)}]
+set v0  1.0
+set A   [expr {$v0/(2.0*$PI)}]
+set tol 1.0e-4
+
+wipe
+model basic -ndm 1 -ndf 1
+node 1 0.0
+node 2 0.0 -mass 1.0
+fix 1 1
+uniaxialMaterial Elastic 1 [expr {4.0*$PI*$PI}]
+element zeroLength 1 1 2 -mat 1 -dir 1
+
+setNodeVel 2 1 $v0 -commit
+
+stateEvent node 1 2 1 [expr {0.5*$A}] -rising
+stateEvent gap  2 2 1 1 [expr {0.8*$A}]
+stateEvent node 3 2 1 0.0 -vel -falling -stop
+stateEvent tolerance $tol
+
+constraints Plain
+numberer Plain
+system ProfileSPD
+test NormDispIncr 1.0e-12 10
+algorithm Newton
+integrator Newmark 0.5 0.25
+analysis Transient
+
+proc checkEvents {name log expected} {
+  global testOK tol
+  if {[llength $log] != [llength $expected]} {
+    puts "failed-> $name: located events $log, expected [llength $expected]"
+    set testOK -1
+    return
+  }
+  foreach event $log exact $expected {
+    lassign $event time tag
+    lassign $exact  t    t0
+    if {$tag != $t0 || abs($time - $t) > $tol} {
+      puts "failed-> $name: event $tag located at $time, expected event $t0 at $t"
+      set testOK -1
+    }
+  }
+}
+
+# First quarter cycle, ended by the peak
+set result [analyze 2000 0.001 1.0e-6 0.001 2]
+if {$result != 0} {
+  puts "failed-> analyze returned $result at the -stop event"
+  set testOK -1
+}
+checkEvents "first cycle" [stateEvent log -clear] [list \
+    [list [expr {1.0/12.0}] 1] \
+    [list [expr {asin(0.8)/(2.0*$PI)}] 2] \
+    [list 0.25 3]]
+
+set stopped [stateEvent stopped]
+if {[llength $stopped] != 2 || [lindex $stopped 1] != 3 ||
+    abs([lindex $stopped 0] - 0.25) > $tol} {
+  puts "failed-> stateEvent stopped returned {$stopped}, expected event 3 at 0.25"
+  set testOK -1
+}
+if {abs([nodeDisp 2 1] - $A) > 1.0e-4*$A} {
+  puts "failed-> displacement [nodeDisp 2 1] at the peak, expected $A"
+  set testOK -1
+}
+
+# Next cycle, without the -stop event
+stateEvent remove 3
+set result [analyze 1000 0.001 1.0e-6 0.001 2]
+if {$result != 0} {
+  puts "failed-> analyze returned $result in the next cycle"
+  set testOK -1
+}
+checkEvents "next cycle" [stateEvent log -clear] [list \
+    [list [expr {1.0 + 1.0/12.0}] 1] \
+    [list [expr {1.0 + asin(0.8)/(2.0*$PI)}] 2]]
+
+if {[llength [stateEvent stopped]] != 0} {
+  puts "failed-> stateEvent stopped returned {[stateEvent stopped]} for an analysis that ran to its end"
+  set testOK -1
+}
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test StateEvents.tcl \n\n"
+    puts $results "| PASSED |  StateEvents.tcl"
+} else {
+    puts "FAILED Verification Test StateEvents.tcl \n\n"
+    puts $results "FAILED : StateEvents.tcl"
+}
+close $results
@@ -0,0 +1,102 @@
+# modalHistory - modal superposition against a direct transient analysis
+#
+# A two storey shear building (masses 2 and 4, storey stiffness 200) is
+# excited at its base by the first 15 s of the El Centro record, with 5%
+# damping in both modes. modalHistory integrates the two modal equations
+# exactly for the piecewise linear record; the direct analysis integrates
+# the same model with Newmark's average acceleration method and modal
+# damping, in 10 steps for each step of the record. The displacement
+# histories of both storeys must agree to within 0.1% of their peaks.
+
+puts "modalHistory.tcl: modal superposition against a direct transient analysis"
+
+set testOK 0
+
+set g     386.1
+set zeta  0.05
+set dt    0.02
+set nsub  10
+set tol   1.0e-3
+
+# first 751 points of the record, in g
+source ReadRecord.tcl
+ReadRecord elCentro.at2 elCentro.dat dt nPts
+set fp [open elCentro.dat r]
+set ag [lrange [read $fp] 0 750]
+close $fp
+
+proc buildModel {} {
+  wipe
+  model Basic -ndm 1 -ndf 1
+  node 1 0.
+  node 2 0. -mass 2.0
+  node 3 0. -mass 4.0
+
+  uniaxialMaterial Elastic 1 200.0
+  element zeroLength 1 1 2 -mat 1 -dir 1
+  element zeroLength 2 2 3 -mat 1 -dir 1
+
+  fix 1 1
+
+  constraints Plain
+  system FullGeneral
+  numberer Plain
+  algorithm Linear
+  integrator Newmark 0.5 0.25
+  analysis Transient
+}
+
+# Modal superposition
+buildModel
+eigen -fullGenLapack 2
+set modal [lindex [modalHistory 1 $dt -damp $zeta $zeta -scale $g -values $ag \
+                                      -history -node 2 1 -node 3 1] 0]
+
+# Direct integration
+buildModel
+timeSeries Path 1 -dt $dt -values $ag -factor $g
+pattern UniformExcitation 1 1 -accel 1
+eigen -fullGenLapack 2
+modalDamping $zeta
+
+set direct2 {0.0}
+set direct3 {0.0}
+for {set i 1} {$i < [llength $ag]} {incr i} {
+  if {[analyze $nsub [expr {$dt/$nsub}]] != 0} {
+    puts "failed-> direct analysis failed at step $i"
+    set testOK -1
+    break
+  }
+  lappend direct2 [nodeDisp 2 1]
+  lappend direct3 [nodeDisp 3 1]
+}
+
+foreach node {2 3} history [list [lindex $modal 0] [lindex $modal 1]] direct [list $direct2 $direct3] {
+  if {[llength $history] != [llength $direct]} {
+    puts "failed-> node $node: modalHistory returned [llength $history] values, expected [llength $direct]"
+    set testOK -1
+    continue
+  }
+
+  set peak 0.0
+  set error 0.0
+  foreach u $history v $direct {
+    set peak  [expr {max($peak, abs($v))}]
+    set error [expr {max($error, abs($u - $v))}]
+  }
+  puts [format "  node %d: peak %.5f, largest difference %.3e" $node $peak $error]
+  if {$peak == 0.0 || $error > $tol*$peak} {
+    puts "failed-> node $node differs from the direct analysis by $error (peak $peak)"
+    set testOK -1
+  }
+}
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test modalHistory.tcl \n\n"
+    puts $results "| PASSED |  modalHistory.tcl"
+} else {
+    puts "FAILED Verification Test modalHistory.tcl \n\n"
+    puts $results "FAILED : modalHistory.tcl"
+}
+close $results
@@ -0,0 +1,64 @@
+# IMK deterioration springs - regression of the shared state engine
+#
+# The IMKBilin, IMKPeakOriented and IMKPinching springs are driven along a
+# cyclic history of growing amplitude that reaches capping, cyclic
+# deterioration and failure, with three trial strains in every step. The
+# committed stress and tangent must be bitwise identical to those of the
+# implementations that preceded IMKDeterioration.h, which are recorded in
+# IMKDeterioration.dat.
+
+puts "IMKDeterioration.tcl: Regression of the IMK deterioration springs"
+
+set testOK 0
+
+wipe
+model basic -ndm 1 -ndf 1
+
+set bb {0.02 0.05 0.2 20. 1.1 0.2  0.02 0.05 0.2 20. 1.1 0.2}
+uniaxialMaterial IMKBilin        1 1000. {*}$bb  1. 1. 1.     1. 1. 1.     1. 1.
+uniaxialMaterial IMKPeakOriented 2 1000. {*}$bb  1. 1. 1. 1.  1. 1. 1. 1.  1. 1.
+uniaxialMaterial IMKPinching     3 1000. {*}$bb  1. 1. 1. 1.  1. 1. 1. 1.  1. 1. 0.5 0.5
+
+# read the reference response
+set file [open [file join [file dirname [info script]] IMKDeterioration.dat] r]
+foreach line [split [read $file] "\n"] {
+  if {[string index $line 0] == "#" || [llength $line] != 5} continue
+  lassign $line mat step strain stress tangent
+  lappend reference($mat) [list $strain $stress $tangent]
+}
+close $file
+
+foreach mat {1 2 3} {
+  set failed 0
+  invoke UniaxialMaterial $mat {
+    set e 0.0
+    foreach step $reference($mat) {
+      lassign $step target stress tangent
+      foreach k {1 2 3} {
+        strain [expr {$e + ($target - $e)*$k/3.0}]
+      }
+      commit
+      set e $target
+      if {[stress] != $stress || [tangent] != $tangent} {
+        if {$failed == 0} {
+          puts "failed-> material $mat strain $target: [stress] [tangent], want $stress $tangent"
+        }
+        incr failed
+      }
+    }
+  }
+  if {$failed != 0} {
+    puts "failed-> material $mat differs at $failed of [llength $reference($mat)] steps"
+    set testOK -1
+  }
+}
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test IMKDeterioration.tcl \n\n"
+    puts $results "| PASSED |  IMKDeterioration.tcl"
+} else {
+    puts "FAILED Verification Test IMKDeterioration.tcl \n\n"
+    puts $results "FAILED : IMKDeterioration.tcl"
+}
+close $results
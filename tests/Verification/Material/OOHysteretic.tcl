@@ -0,0 +1,71 @@
+# OOHysteretic - regression of the cached degradation rules
+#
+# Two OOHysteretic materials, one with the same rules in both directions
+# and one with different unloading, stiffness and strength rules for each
+# direction, are driven along a cyclic history with three trial strains in
+# every step. The committed stress and tangent must be bitwise identical to
+# those of the implementation that evaluated every rule through its virtual
+# interface on each call, which are recorded in OOHysteretic.dat.
+
+puts "OOHysteretic.tcl: Regression of the OOHysteretic degradation rules"
+
+set testOK 0
+
+wipe
+model basic -ndm 1 -ndf 1
+
+hystereticBackbone   Trilinear 1 0.002 400. 0.01 450. 0.03 100.
+unloadingRule        Takeda    1 1.0 0.4
+unloadingRule        Energy    2 300000. 1.0
+stiffnessDegradation Pincheira 1 1.5 0.2 0.1 0.9
+stiffnessDegradation Ductility 2 0.1 1.0
+strengthDegradation  Energy    1 200000. 1.0
+strengthDegradation  Ductility 2 0.02 1.5
+
+#                           tag  bb+ unl+ stf+ str+  bb- unl- stf- str-  pinchX pinchY
+uniaxialMaterial OOHysteretic 1   1   1    1    1                         0.3    0.4
+uniaxialMaterial OOHysteretic 2   1   2    2    2    1   1    1    1      0.2    0.6
+
+# read the reference response
+set file [open [file join [file dirname [info script]] OOHysteretic.dat] r]
+foreach line [split [read $file] "\n"] {
+  if {[string index $line 0] == "#" || [llength $line] != 5} continue
+  lassign $line mat step strain stress tangent
+  lappend reference($mat) [list $strain $stress $tangent]
+}
+close $file
+
+foreach mat {1 2} {
+  set failed 0
+  invoke UniaxialMaterial $mat {
+    set e 0.0
+    foreach step $reference($mat) {
+      lassign $step target stress tangent
+      foreach k {1 2 3} {
+        strain [expr {$e + ($target - $e)*$k/3.0}]
+      }
+      commit
+      set e $target
+      if {[stress] != $stress || [tangent] != $tangent} {
+        if {$failed == 0} {
+          puts "failed-> material $mat strain $target: [stress] [tangent], want $stress $tangent"
+        }
+        incr failed
+      }
+    }
+  }
+  if {$failed != 0} {
+    puts "failed-> material $mat differs at $failed of [llength $reference($mat)] steps"
+    set testOK -1
+  }
+}
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test OOHysteretic.tcl \n\n"
+    puts $results "| PASSED |  OOHysteretic.tcl"
+} else {
+    puts "FAILED Verification Test OOHysteretic.tcl \n\n"
+    puts $results "FAILED : OOHysteretic.tcl"
+}
+close $results
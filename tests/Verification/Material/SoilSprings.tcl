@@ -0,0 +1,74 @@
+# soilSprings - p-y springs of soft clay against Matlock (1970)
+#
+# A pile of diameter b = 0.5 m in a uniform soft clay (cu = 20 kPa,
+# e50 = 0.02, submerged unit weight 8 kN/m3) has springs at 1 m spacing.
+# Matlock gives the ultimate resistance per unit length
+#
+#     pu = min(3 + gamma*z/cu + 0.5*z/b, 9) cu b
+#
+# which is 58 kN/m at a depth of 2 m and 9 cu b = 90 kN/m below the
+# transition depth of 4.3 m, and y50 = 2.5 b e50. The curve
+#
+#     p/pu = 0.5 (y/y50)^(1/3),   p = pu beyond y = 8 y50
+#
+# is approximated by PySimple1 to within 5% of pu.
+
+puts "SoilSprings.tcl: p-y springs of soft clay against Matlock (1970)"
+
+set testOK 0
+
+wipe
+model basic -ndm 1 -ndf 1
+
+set b     0.5
+set cu    20.0
+set e50   0.02
+set gamma 8.0
+set y50   [expr {2.5*$b*$e50}]
+
+set tags [soilSprings py 1 -elevation {0 -1 -2 -3 -4 -5 -6 -7} \
+                           -layers {0} {-10} {1} \
+                           -field gamma "$gamma" "$gamma" \
+                           -field b     "$b"     "$b"     \
+                           -field cu    "$cu"    "$cu"    \
+                           -field e50   "$e50"   "$e50"]
+
+if {$tags != {1 2 3 4 5 6 7 8}} {
+  puts "failed-> soilSprings returned tags $tags"
+  set testOK -1
+}
+
+# spring tag, depth and tributary length of the springs that are checked
+foreach {tag depth length} {3 2.0 1.0  7 6.0 1.0} {
+  set pu [expr {min(3.0 + $gamma*$depth/$cu + 0.5*$depth/$b, 9.0)*$cu*$b*$length}]
+
+  # monotonic push through increasing displacements
+  set e 0.0
+  foreach ratio {1 2 4 8 40} {
+    set y [expr {$ratio*$y50}]
+    set p [expr {$ratio < 8 ? 0.5*$pu*pow($ratio, 1.0/3.0) : $pu}]
+    set tol [expr {$ratio < 40 ? 0.05*$pu : 0.001*$pu}]
+
+    invoke UniaxialMaterial $tag {
+      for {set i 1} {$i <= 200} {incr i} {
+        strain [expr {$e + ($y - $e)*$i/200.0}] -commit
+      }
+      set stress [stress]
+    }
+    set e $y
+    if {abs($stress - $p) > $tol} {
+      puts "failed-> spring $tag at y = $ratio y50: p = $stress, Matlock gives $p"
+      set testOK -1
+    }
+  }
+}
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test SoilSprings.tcl \n\n"
+    puts $results "| PASSED |  SoilSprings.tcl"
+} else {
+    puts "FAILED Verification Test SoilSprings.tcl \n\n"
+    puts $results "FAILED : SoilSprings.tcl"
+}
+close $results
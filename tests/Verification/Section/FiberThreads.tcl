@@ -0,0 +1,121 @@
+# FiberThreads - fiber sums of 3D sections in fiber order
+#
+# FiberSection3d and FrameFiberSection3d may set their fibers on several
+# threads (OPS_FIBER_THREADS), but they must sum the fiber responses in
+# fiber order, so that the section responses are bitwise the same as those
+# of a serial build. Each section is bent about both axes through a few
+# deformations, and its stress resultant and tangent must equal, exactly,
+# the sums
+#
+#     N  = sum E A e,   Mz = sum -y E A e,   My = sum z E A e
+#
+# with e = e0 - y kz + z ky, formed here one fiber after another. The
+# fibers have areas and coordinates that make these sums depend on the
+# order in which they are taken.
+
+puts "FiberThreads.tcl: fiber sums of 3D sections in fiber order"
+
+set testOK 0
+
+set E  29000.0
+set GJ 1.7e5
+
+# y z A of each fiber
+set fibers {
+   0.31  -1.7   0.11
+  -2.9    0.23  1.3
+   7.1    3.3   0.017
+  -0.07  -5.1   2.9
+   4.4   -0.9   0.37
+  -6.3    2.1   0.071
+   1.9    6.7   1.1
+  -3.7   -3.3   0.23
+   0.013  0.57  7.3
+   5.9   -6.1   0.43
+  -1.1    1.3   0.19
+   2.3   -2.7   3.7
+}
+
+proc reference {deform} {
+  global E GJ fibers
+  lassign $deform e0 e1 e2 e3
+
+  set A 0.0; set Qz 0.0; set Qy 0.0
+  foreach {y z a} $fibers {
+    set A  [expr {$A + $a}]
+    set Qz [expr {$Qz + $y*$a}]
+    set Qy [expr {$Qy + $z*$a}]
+  }
+  set yBar [expr {$Qz/$A}]
+  set zBar [expr {$Qy/$A}]
+
+  set s {0.0 0.0 0.0}
+  set k {0.0 0.0 0.0 0.0 0.0 0.0}
+  foreach {yi zi a} $fibers {
+    set y [expr {$yi - $yBar}]
+    set z [expr {$zi - $zBar}]
+    set strain [expr {$e0 - $y*$e1 + $z*$e2}]
+    set EA  [expr {$E*$a}]
+    set fs0 [expr {($E*$strain)*$a}]
+    lassign $k k00 k01 k02 k11 k22 k12
+    set k [list [expr {$k00 + $EA}]       [expr {$k01 + -$y*$EA}]    [expr {$k02 + $z*$EA}] \
+                [expr {$k11 + $y*$y*$EA}] [expr {$k22 + $z*$z*$EA}] [expr {$k12 + -$y*$z*$EA}]]
+    lassign $s N Mz My
+    set s [list [expr {$N + $fs0}] [expr {$Mz + -$y*$fs0}] [expr {$My + $z*$fs0}]]
+  }
+  lassign $k k00 k01 k02 k11 k22 k12
+  return [list [list {*}$s [expr {$GJ*$e3}]] \
+               [list $k00 $k01 $k02 0.0  $k01 $k11 $k12 0.0 \
+                     $k02 $k12 $k22 0.0  0.0  0.0  0.0  $GJ]]
+}
+
+wipe
+model basic -ndm 3 -ndf 6
+uniaxialMaterial Elastic 1 $E
+
+foreach {tag type} {1 Fiber 2 FrameFiber} {
+  section $type $tag -GJ $GJ {
+    foreach {y z a} $fibers {
+      fiber $y $z $a 1
+    }
+  }
+}
+
+foreach {tag name} {1 FiberSection3d 2 FrameFiberSection3d} {
+  foreach deform {
+    {0.0013  0.0  0.0  0.0}
+    {-0.0007 0.00031 0.0  0.001}
+    {0.00021 -0.00017 0.00043 -0.0003}
+    {-0.0011 0.00097 -0.00061 0.0021}
+  } {
+    invoke section $tag {
+      update {*}$deform
+      set stress  [stress]
+      set tangent [tangent]
+    }
+    lassign [reference $deform] s k
+    foreach label {N Mz My T} value $stress exact $s {
+      if {$value != $exact} {
+        puts "failed-> $name $label = $value at $deform, fiber sum $exact"
+        set testOK -1
+      }
+    }
+    foreach value $tangent exact $k {
+      if {$value != $exact} {
+        puts "failed-> $name tangent $tangent at $deform, fiber sum $k"
+        set testOK -1
+        break
+      }
+    }
+  }
+}
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test FiberThreads.tcl \n\n"
+    puts $results "| PASSED |  FiberThreads.tcl"
+} else {
+    puts "FAILED Verification Test FiberThreads.tcl \n\n"
+    puts $results "FAILED : FiberThreads.tcl"
+}
+close $results
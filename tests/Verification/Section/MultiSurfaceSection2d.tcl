@@ -0,0 +1,105 @@
+# MultiSurfaceSection2d - moment capacity under constant axial load
+#
+# The interaction diagram is the hexagon
+#
+#     (1000, 0)  (500, 80)  (-500, 80)  (-2000, 0)  (-500, -80)  (500, -80)
+#
+# A zeroLengthSection is loaded by a constant axial force P and then by a
+# growing curvature. The moment must reach the edge of the diagram at P,
+# that is 80 for -500 <= P <= 500, and 80 (1000 - P)/500 for P > 500,
+# while the axial force stays at P. A section with the least number of
+# vertices (a triangle) is also created, and one with an odd number of
+# coordinates must be rejected.
+
+puts "MultiSurfaceSection2d.tcl: moment capacity of a multi-surface P-Mz section"
+
+set testOK 0
+set tol 1.0e-8
+
+set E  200.0
+set A  10.0
+set Iz 50.0
+set diagram {1000. 0.  500. 80.  -500. 80.  -2000. 0.  -500. -80.  500. -80.}
+
+foreach {P Mu} {0.0 80.0  -400.0 80.0  750.0 40.0} {
+
+  wipe
+  model basic -ndm 2 -ndf 3
+
+  section MultiSurfaceSection2d 1 $E $A $Iz {*}$diagram
+
+  node 1 0.0 0.0
+  node 2 0.0 0.0
+  fix 1 1 1 1
+  fix 2 0 1 0
+  element zeroLengthSection 1 1 2 1
+
+  pattern Plain 1 Constant {
+    load 2 $P 0.0 0.0
+  }
+  system BandGeneral
+  test NormUnbalance 1.0e-10 20
+  numberer Plain
+  constraints Plain
+  algorithm Newton
+  integrator LoadControl 0.0
+  analysis Static
+  analyze 1
+  loadConst -time 0.0
+
+  # curvature to five times the yield curvature at P = 0
+  set dK [expr {5.0*80.0/($E*$Iz)/50}]
+  pattern Plain 2 Linear {
+    load 2 0.0 0.0 1.0
+  }
+  integrator DisplacementControl 2 3 $dK
+  analysis Static
+
+  # the moment equals the load factor
+  set ok [analyze 1]
+  set M1 [getTime]
+  set ok [expr {$ok + [analyze 49]}]
+  set M  [getTime]
+  set N  [lindex [eleResponse 1 force] 3]
+
+  if {$ok != 0} {
+    puts "failed-> analysis failed for P = $P"
+    set testOK -1
+    continue
+  }
+  # the first step remains elastic
+  if {abs($M1 - $dK*$E*$Iz) > $tol*$Mu} {
+    puts "failed-> elastic moment $M1 for P = $P, want [expr {$dK*$E*$Iz}]"
+    set testOK -1
+  }
+  if {abs($M - $Mu) > $tol*$Mu} {
+    puts "failed-> moment $M for P = $P, want $Mu"
+    set testOK -1
+  }
+  if {abs($N - $P) > $tol*1000.0} {
+    puts "failed-> axial force $N for P = $P"
+    set testOK -1
+  }
+}
+
+# three vertices are enough; an odd number of coordinates is an error
+wipe
+model basic -ndm 2 -ndf 3
+if {[catch {section MultiSurfaceSection2d 2 $E $A $Iz 1000. 0. -1000. 100. -1000. -100.}]} {
+  puts "failed-> section with three vertices was rejected"
+  set testOK -1
+}
+if {![catch {section MultiSurfaceSection2d 3 $E $A $Iz 1000. 0. -1000. 100. -1000. -100. 500.}]} {
+  puts "failed-> section with an odd number of coordinates was accepted"
+  set testOK -1
+}
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test MultiSurfaceSection2d.tcl \n\n"
+    puts $results "| PASSED |  MultiSurfaceSection2d.tcl"
+} else {
+    puts "FAILED Verification Test MultiSurfaceSection2d.tcl \n\n"
+    puts $results "FAILED : MultiSurfaceSection2d.tcl"
+}
+close $results
@@ -0,0 +1,98 @@
+# ShapeSection2d - elastic and inelastic response of a wide-flange shape
+#
+# A W14x90 (d = 14.0, tw = 0.44, bf = 14.5, tf = 0.71) of elastic-perfectly
+# plastic steel is bent to a curvature ductility of 20 in a
+# zeroLengthSection. The first step must give the elastic stiffness
+#
+#     I = bf d^3/12 - (bf - tw)(d - 2 tf)^3/12
+#
+# and the last the moment of a fully plastic section less the part of the
+# web that remains elastic within c = (d/2)/20 of the neutral axis,
+#
+#     M = fy (Z - tw c^2/3),   Z = bf tf (d - tf) + tw (d - 2 tf)^2/4
+#
+# Options that the command does not know must be rejected.
+
+puts "ShapeSection2d.tcl: moment-curvature of a wide-flange Shape2d section"
+
+set testOK 0
+
+set E  29000.0
+set fy 50.0
+set d  14.0
+set tw 0.44
+set bf 14.5
+set tf 0.71
+
+set I [expr {$bf*pow($d,3)/12.0 - ($bf - $tw)*pow($d - 2*$tf,3)/12.0}]
+set Z [expr {$bf*$tf*($d - $tf) + $tw*pow($d - 2*$tf,2)/4.0}]
+set c [expr {0.5*$d/20.0}]
+set Mu [expr {$fy*($Z - $tw*$c*$c/3.0)}]
+
+wipe
+model basic -ndm 2 -ndf 3
+
+uniaxialMaterial ElasticPP 1 $E [expr {$fy/$E}]
+section Shape2d 1 1 WF $d $tw $bf $tf -tol 1.0e-4
+
+node 1 0.0 0.0
+node 2 0.0 0.0
+fix 1 1 1 1
+fix 2 0 1 0
+element zeroLengthSection 1 1 2 1
+
+# curvature ductility of 20 in 50 steps
+set dK [expr {20.0*$fy/$E/(0.5*$d)/50}]
+pattern Plain 1 Linear {
+  load 2 0.0 0.0 1.0
+}
+system BandGeneral
+test NormUnbalance 1.0e-8 20
+numberer Plain
+constraints Plain
+algorithm Newton
+integrator DisplacementControl 2 3 $dK
+analysis Static
+
+# the moment equals the load factor
+set ok [analyze 1]
+set M1 [getTime]
+set ok [expr {$ok + [analyze 49]}]
+set M  [getTime]
+
+if {$ok != 0} {
+  puts "failed-> analysis failed"
+  set testOK -1
+}
+if {abs($M1 - $E*$I*$dK) > 1.0e-10*$E*$I*$dK} {
+  puts "failed-> elastic moment $M1, want [expr {$E*$I*$dK}]"
+  set testOK -1
+}
+if {abs($M - $Mu) > 1.0e-4*$Mu} {
+  puts "failed-> moment $M at a ductility of 20, want $Mu"
+  set testOK -1
+}
+
+# unknown options and a missing tolerance are errors
+if {![catch {section Shape2d 2 1 WF $d $tw $bf $tf -tol}]} {
+  puts "failed-> -tol without a value was accepted"
+  set testOK -1
+}
+if {![catch {section Shape2d 3 1 WF $d $tw $bf $tf -tolerance 1.0e-3}]} {
+  puts "failed-> unknown option -tolerance was accepted"
+  set testOK -1
+}
+if {![catch {section Shape2d 4 1 Pipe 10.75 0.365 0.1}]} {
+  puts "failed-> extra dimension was accepted"
+  set testOK -1
+}
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "PASSED Verification Test ShapeSection2d.tcl \n\n"
+    puts $results "| PASSED |  ShapeSection2d.tcl"
+} else {
+    puts "FAILED Verification Test ShapeSection2d.tcl \n\n"
+    puts $results "FAILED : ShapeSection2d.tcl"
+}
+close $results
@@ -11,6 +11,9 @@ source sdofTransient.tcl
 source SmallEigen.tcl
 source NewmarkIntegrator.tcl
 source mdofModal.tcl
+source modalHistory.tcl
+source ResponseSpectrum.tcl
+source StateEvents.tcl
 cd ..
 
 source Truss/PlanarTruss.tcl
@@ -28,3 +31,13 @@ source Plane/QuadBending.tcl
 source Shell/PinchedCylinder.tcl
 source Shell/PlanarShearWall.tcl
 
+
+# Materials
+source Material/IMKDeterioration.tcl
+source Material/OOHysteretic.tcl
+source Material/SoilSprings.tcl
+
+# Sections
+source Section/MultiSurfaceSection2d.tcl
+source Section/ShapeSection2d.tcl
+source Section/FiberThreads.tcl
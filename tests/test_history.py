@@ -0,0 +1,143 @@
+"""
+Model.materialHistory and Model.sectionHistory drive copies of a
+uniaxialMaterial or section through a deformation history in native
+code, with the parameters of each copy set through setParameter. Each
+copy must respond as the object driven and committed step by step.
+"""
+import numpy as np
+import opensees.openseespy as ops
+from opensees.tcl import InterpreterError
+
+
+def _steel01(strain, Fy, E, b):
+    # elastic predictor, returned to the bounds of bilinear kinematic
+    # hardening
+    stress = []
+    s, e0 = 0.0, 0.0
+    for e in strain:
+        s += E*(e - e0)
+        s = min(max(s, b*E*e - Fy*(1 - b)), b*E*e + Fy*(1 - b))
+        stress.append(s)
+        e0 = e
+    return np.array(stress)
+
+
+def _cycles(amplitude, steps=40):
+    # two cycles of growing amplitude
+    t = np.linspace(0.0, 4.0*np.pi, steps)
+    return amplitude*t/t[-1]*np.sin(t)
+
+
+def _materials():
+    model = ops.Model("basic", ndm=2, ndf=2)
+    model.uniaxialMaterial("Elastic", 1, 200.0)
+    model.uniaxialMaterial("Steel01", 2, 50.0, 29000.0, 0.02)
+    return model
+
+
+def test_material_history():
+    model = _materials()
+    strain = _cycles(4*50.0/29000.0)
+
+    result = model.materialHistory(2, strain)
+    assert result["stress"].shape == (1, len(strain))
+    assert result["tangent"].shape == (1, len(strain))
+    assert list(result["status"]) == [0]
+    assert "residual" not in result
+    assert np.allclose(result["stress"][0], _steel01(strain, 50.0, 29000.0, 0.02),
+                       rtol=1e-12, atol=1e-10)
+    # the history yields, and every tangent is on one of the two branches
+    tangent = result["tangent"][0]
+    assert np.any(np.isclose(tangent, 0.02*29000.0))
+    assert np.all(np.isclose(tangent, 29000.0) | np.isclose(tangent, 0.02*29000.0))
+
+    # a strain history for each variant
+    strains = np.array([strain, -2*strain])
+    result = model.materialHistory(1, strains)
+    assert result["stress"].shape == (2, len(strain))
+    assert np.allclose(result["stress"], 200.0*strains, rtol=1e-12)
+
+
+def test_variants():
+    model = _materials()
+    strain = _cycles(4*50.0/29000.0)
+    values = np.array([[50.0, 29000.0],
+                       [60.0, 29000.0],
+                       [50.0, 20000.0]])
+
+    result = model.materialHistory(2, strain, ["Fy", "E"], values)
+    assert result["stress"].shape == (3, len(strain))
+    assert list(result["status"]) == [0, 0, 0]
+    for (Fy, E), stress in zip(values, result["stress"]):
+        assert np.allclose(stress, _steel01(strain, Fy, E, 0.02), rtol=1e-12, atol=1e-10)
+
+    # the variants do not depend on the number of threads
+    serial = model.materialHistory(2, strain, ["Fy", "E"], values, threads=1)
+    assert np.array_equal(serial["stress"],  result["stress"])
+    assert np.array_equal(serial["tangent"], result["tangent"])
+
+    # the material of the model keeps its own parameters
+    base = model.materialHistory(2, strain)
+    assert np.array_equal(base["stress"][0], result["stress"][0])
+
+    # the residual is the sum of squared differences from the target
+    target = result["stress"][1]
+    fit = model.materialHistory(2, strain, ["Fy", "E"], values, target=target)
+    assert fit["residual"][1] == 0.0
+    assert np.allclose(fit["residual"], np.sum((result["stress"] - target)**2, axis=1),
+                       rtol=1e-12)
+    assert all(r > 0.0 for r in np.delete(fit["residual"], 1))
+
+
+def test_material_errors():
+    model = _materials()
+    strain = np.linspace(0.0, 0.01, 5)
+    for args, kwds in [
+        ((99, strain), {}),
+        ((1, strain, ["E"]), {}),
+        ((1, strain, ["E"], np.ones((2, 2))), {}),
+        ((1, strain, ["Q"], np.ones((2, 1))), {}),
+        ((1, np.ones((2, 2, 5))), {}),
+        ((1, np.ones((2, 5)), ["E"], np.ones((3, 1))), {}),
+        ((1, strain), {"target": np.ones(4)}),
+    ]:
+        try:
+            model.materialHistory(*args, **kwds)
+            assert False, f"materialHistory{args} did not raise"
+        except InterpreterError:
+            pass
+
+
+def test_section_history():
+    E, A, Iz, Iy, G, J = 29000.0, 10.0, 100.0, 50.0, 11200.0, 20.0
+    model = ops.Model("basic", ndm=3, ndf=6)
+    model.section("Elastic", 1, E, A, Iz, Iy, G, J)
+
+    # axial strain, two curvatures and twist
+    t = np.linspace(0.0, 1.0, 7)
+    deformation = np.array([1e-3*t, 2e-4*t, -1e-4*t, 5e-4*np.sin(t)]).T
+    stiffness = np.array([E*A, E*Iz, E*Iy, G*J])
+
+    result = model.sectionHistory(1, deformation)
+    assert result["stress"].shape  == (1, len(t), 4)
+    assert result["tangent"].shape == (1, len(t), 4, 4)
+    assert list(result["status"]) == [0]
+    assert np.allclose(result["stress"][0], deformation*stiffness, rtol=1e-12)
+    for tangent in result["tangent"][0]:
+        assert np.array_equal(tangent, np.diag(stiffness))
+
+    # the modulus scales the axial and flexural resultants, not the twist
+    values = np.array([[E], [2*E]])
+    scaled = model.sectionHistory(1, deformation, ["E"], values,
+                                  target=result["stress"][0])
+    assert np.allclose(scaled["stress"][1][:, :3], 2*result["stress"][0][:, :3], rtol=1e-12)
+    assert np.allclose(scaled["stress"][1][:, 3],    result["stress"][0][:, 3],  rtol=1e-12)
+    assert scaled["residual"][0] == 0.0
+    assert scaled["residual"][1] > 0.0
+
+    # the deformation must have one column for each resultant
+    try:
+        model.sectionHistory(1, deformation[:, :2])
+        assert False, "a deformation of the wrong order was accepted"
+    except InterpreterError:
+        pass
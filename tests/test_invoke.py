@@ -0,0 +1,94 @@
+"""
+Commands of opensees.openseespy are passed to the interpreter as typed
+words when the arguments need no Tcl substitution, and as a script
+otherwise. This checks the conversion of the arguments and that both
+paths give the same model.
+"""
+import numpy as np
+import opensees.openseespy as ops
+from opensees.openseespy import _as_obj_args
+from opensees.tcl import InterpreterError
+
+
+def test_words():
+    assert _as_obj_args((1, 2.5, "Elastic"), {}) == [1, 2.5, "Elastic"]
+    # the items of a tuple are separate words, as when they are joined
+    # into a script
+    assert _as_obj_args((1, ("a", 2)), {}) == [1, "a", 2]
+    assert _as_obj_args((1, ""), {}) == [1]
+    assert _as_obj_args((True,), {}) == [True]
+    assert _as_obj_args((np.float64(1.5),), {}) == [np.float64(1.5)]
+
+    # keywords
+    assert _as_obj_args((), {"fact": 2.0}) == ["-fact", 2.0]
+    assert _as_obj_args((), {"ignore_this": True}) == ["-ignore-this"]
+    assert _as_obj_args((), {"ignore_this": False}) == []
+
+    # lists are passed as a single word
+    assert _as_obj_args(([1, [2, 3]],), {}) == [[1, [2, 3]]]
+    a = np.array([1.0, 2.0])
+    words = _as_obj_args((a,), {})
+    assert len(words) == 1 and words[0] is a
+
+
+def test_substitution():
+    # these need the Tcl parser
+    assert _as_obj_args(("two words",), {}) is None
+    for special in "{}[]$\"\\;":
+        assert _as_obj_args((f"a{special}b",), {}) is None
+    assert _as_obj_args(({"fiber": [0, 0, 1, 1]},), {}) is None
+    assert _as_obj_args(([1, "a b"],), {}) is None
+    assert _as_obj_args((np.array(["a"]),), {}) is None
+    assert _as_obj_args((object(),), {}) is None
+    assert _as_obj_args((), {"key": "a b"}) is None
+
+    # nested in a tuple, tuples and lists are joined as their str()
+    assert _as_obj_args((1, ("a", (2, 3))), {}) is None
+    assert _as_obj_args(((1, [2, 3]),), {}) is None
+
+
+def _truss(model):
+    model.node(1,   0.0,  0.0)
+    model.node(2, 144.0,  0.0)
+    model.node(3, 168.0,  0.0)
+    model.node(4,  72.0, 96.0)
+    model.fix(1, 1, 1)
+    model.fix(2, (1, 1))
+    model.fix(3, 1, 1)
+    model.uniaxialMaterial("Elastic", 1, 3000.0)
+    model.element("truss", 1, 1, 4, 10.0, 1)
+    model.element("truss", 2, 2, 4,  5.0, 1)
+    model.element("truss", 3, 3, 4,  5.0, 1)
+    model.timeSeries("Linear", 1)
+    model.pattern("Plain", 1, 1, fact=1.0)
+    model.load(4, *np.array([100.0, -50.0]))
+
+    model.system("BandSPD")
+    model.numberer("RCM")
+    model.constraints("Plain")
+    model.integrator("LoadControl", 1.0)
+    model.algorithm("Linear")
+    model.analysis("Static")
+    assert model.analyze(1) == 0
+    return model.nodeDisp(4)
+
+
+def test_dispatch():
+    direct = ops.Model("basic", ndm=2, ndf=2)
+
+    script = ops.Model("basic", ndm=2, ndf=2)
+    # force every command through the Tcl parser
+    script._openseespy._dispatch = None
+
+    u = _truss(direct)
+    v = _truss(script)
+    assert all(abs(a - b) < 1e-12 for a, b in zip(u, v))
+    assert abs(u[0] - 0.530) < 1e-3 and abs(u[1] + 0.178) < 1e-3
+
+    # errors are reported the same way on both paths
+    for model in direct, script:
+        try:
+            model.nodeDisp(99)
+            assert False, "nodeDisp of a missing node did not raise"
+        except InterpreterError:
+            pass
@@ -0,0 +1,67 @@
+"""
+Model.asarrays exports a model as columnar arrays and Model.fromarrays
+imports the nodes, constraints and nodal loads of such an export. A model
+rebuilt from the arrays of another must export the same arrays.
+"""
+import numpy as np
+import opensees.openseespy as ops
+from opensees.tcl import InterpreterError
+
+
+def _frame(model):
+    model.node(1, 0.0, 0.0)
+    model.node(2, 0.0, 3.0, "-mass", 10.0, 10.0, 0.0)
+    model.node(3, 4.0, 3.0, "-mass", 10.0, 10.0, 0.0)
+    model.node(4, 4.0, 0.0)
+    model.fix(1, 1, 1, 1)
+    model.fix(4, 1, 1, 0)
+    model.equalDOF(2, 3, 1, 2)
+
+    model.timeSeries("Linear", 1)
+    model.pattern("Plain", 1, 1)
+    model.load(2, 5.0, -20.0, 0.0)
+    model.load(3, 0.0, -20.0, 1.5)
+    model.load(3, 2.0, 0.0, 0.0)
+
+
+def _assert_tables_equal(a, b):
+    assert a.keys() == b.keys()
+    for key in a:
+        if isinstance(a[key], dict):
+            _assert_tables_equal(a[key], b[key])
+        else:
+            assert np.array_equal(np.asarray(a[key]), np.asarray(b[key])), key
+
+
+def test_round_trip():
+    source = ops.Model("basic", ndm=2, ndf=3)
+    _frame(source)
+    arrays = source.asarrays()
+
+    assert list(arrays["nodes"]["tag"]) == [1, 2, 3, 4]
+    assert np.array_equal(arrays["nodes"]["mass"][1], [10.0, 10.0, 0.0])
+    assert len(arrays["sp"]["node"]) == 5
+    assert list(arrays["mp"]["retained"]) == [2]
+    assert list(arrays["mp"]["constrained"]) == [3]
+
+    loads = arrays["loads"]
+    assert list(loads["pattern"]) == [1, 1, 1]
+    assert sorted(map(tuple, loads["value"])) == sorted([(5.0, -20.0, 0.0),
+                                                         (0.0, -20.0, 1.5),
+                                                         (2.0,   0.0, 0.0)])
+
+    target = ops.Model("basic", ndm=2, ndf=3)
+    target.timeSeries("Linear", 1)
+    target.pattern("Plain", 1, 1)
+    target.fromarrays(arrays)
+    copy = target.asarrays()
+
+    for table in "nodes", "sp", "mp", "loads":
+        _assert_tables_equal(arrays[table], copy[table])
+
+    # Importing the nodes again is an error
+    try:
+        target.fromarrays({"nodes": arrays["nodes"]})
+        assert False, "duplicate nodes were imported"
+    except InterpreterError:
+        pass
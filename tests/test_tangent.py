@@ -0,0 +1,94 @@
+"""
+Model.getTangent and Model.getResidual read the linear system of the
+analysis from the compiled module, as compressed rows, or parse the
+output of printA and printB otherwise. Both must give the same system
+for a small truss.
+"""
+import numpy as np
+import opensees.openseespy as ops
+
+
+def _truss():
+    model = ops.Model("basic", ndm=2, ndf=2)
+    model.node(1,   0.0,  0.0)
+    model.node(2, 144.0,  0.0)
+    model.node(3, 168.0,  0.0)
+    model.node(4,  72.0, 96.0, "-mass", 2.0, 3.0)
+    model.node(5, 120.0, 96.0, "-mass", 1.0, 1.0)
+    model.fix(1, 1, 1)
+    model.fix(2, 1, 1)
+    model.fix(3, 1, 1)
+    model.uniaxialMaterial("Elastic", 1, 3000.0)
+    model.element("truss", 1, 1, 4, 10.0, 1)
+    model.element("truss", 2, 2, 4,  5.0, 1)
+    model.element("truss", 3, 3, 5,  5.0, 1)
+    model.element("truss", 4, 4, 5,  8.0, 1)
+    model.element("truss", 5, 2, 5,  4.0, 1)
+    model.timeSeries("Constant", 1)
+    model.pattern("Plain", 1, 1)
+    model.load(4, 100.0, -50.0)
+    model.load(5,   0.0, -25.0)
+
+    model.system("BandGeneral")
+    model.numberer("Plain")
+    model.constraints("Plain")
+    model.integrator("LoadControl", 1.0)
+    model.algorithm("Linear")
+    model.analysis("Static")
+    return model
+
+
+def _text(model, method, **kwds):
+    # read the system through printA/printB
+    openseespy = model._openseespy
+    saved = openseespy._tangent, openseespy._residual
+    openseespy._tangent = openseespy._residual = None
+    try:
+        return getattr(model, method)(**kwds)
+    finally:
+        openseespy._tangent, openseespy._residual = saved
+
+
+def test_tangent():
+    model = _truss()
+
+    dense  = model.getTangent()
+    sparse = model.getTangent(sparse=True)
+    text   = _text(model, "getTangent")
+
+    assert dense.shape == (4, 4)
+    assert sparse.shape == (4, 4)
+    assert np.array_equal(sparse.toarray(), dense)
+    assert np.allclose(dense, text, rtol=1e-12, atol=0.0)
+    assert np.allclose(dense, dense.T, rtol=1e-12, atol=0.0)
+    # the four free dofs are all coupled through element 4
+    assert sparse.nnz == 16
+
+    # m*M + c*C + k*K, with the masses on the diagonal
+    mass = model.getTangent(m=1.0)
+    assert np.allclose(mass, _text(model, "getTangent", m=1.0), rtol=1e-12, atol=0.0)
+    assert sorted(np.diag(mass)) == [1.0, 1.0, 2.0, 3.0]
+    assert np.count_nonzero(mass - np.diag(np.diag(mass))) == 0
+    assert np.allclose(model.getTangent(m=2.0, k=1.0), 2.0*mass + dense, rtol=1e-12)
+
+
+def test_residual():
+    model = _truss()
+
+    # before the analysis, the unbalance is the load on the free dofs
+    residual = model.getResidual()
+    assert sorted(residual) == [-50.0, -25.0, 0.0, 100.0]
+    assert np.array_equal(residual, _text(model, "getResidual"))
+
+    view = model.getResidual(copy=False)
+    assert not view.flags.writeable
+    assert np.array_equal(view, residual)
+
+    # a linear step leaves no unbalance, and its displacements solve
+    # the tangent for the loads
+    K = model.getTangent()
+    assert model.analyze(1) == 0
+    assert np.allclose(model.getResidual(), 0.0, atol=1e-10)
+    u = np.linalg.solve(K, residual)
+    disp = sorted(model.nodeDisp(4) + model.nodeDisp(5))
+    assert np.allclose(sorted(u), disp, rtol=1e-10)